@@ -0,0 +1,198 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef BACKGROUND_TRACEREADER_H
+#define BACKGROUND_TRACEREADER_H
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <optional>
+#include <thread>
+
+#include "ChampSim/instruction.h"
+#include "ChampSim/tracereader.h"
+#include "ProjectConfiguration.h" // User file
+
+#if (USER_CODES == ENABLE)
+#if (BACKGROUND_TRACE_DECOMPRESSION == ENABLE)
+
+namespace champsim
+{
+/** @brief
+ *  A bounded ring with one producer thread and one consumer thread. Each side owns one index and only reads the other's, so no lock is needed.
+ *  The indexes grow without wrapping, and their difference is the number of occupied slots.
+ */
+template<typename T, std::size_t N>
+class spsc_ring
+{
+    static_assert((N & (N - 1)) == 0, "The capacity must be a power of two");
+
+    std::array<std::optional<T>, N> slots {};
+    alignas(64) std::atomic<std::size_t> head {0}; // The next slot to pop, written by the consumer
+    alignas(64) std::atomic<std::size_t> tail {0}; // The next slot to push, written by the producer
+
+public:
+    bool empty() const { return head.load(std::memory_order_acquire) == tail.load(std::memory_order_acquire); }
+
+    bool try_push(T&& value)
+    {
+        auto current = tail.load(std::memory_order_relaxed);
+        if (current - head.load(std::memory_order_acquire) == N)
+            return false;
+
+        slots[current % N] = std::move(value);
+        tail.store(current + 1, std::memory_order_release);
+        return true;
+    }
+
+    std::optional<T> try_pop()
+    {
+        auto current = head.load(std::memory_order_relaxed);
+        if (current == tail.load(std::memory_order_acquire))
+            return std::nullopt;
+
+        std::optional<T> value {std::move(slots[current % N])};
+        slots[current % N].reset();
+        head.store(current + 1, std::memory_order_release);
+        return value;
+    }
+};
+
+/** @brief
+ *  A trace reader that runs another one (e.g., a bulk_tracereader, which decompresses and inflates the trace) on a producer thread of its own,
+ *  so the decompression overlaps with the simulation. The instructions reach the core through a spsc_ring of BACKGROUND_TRACE_BUFFER_ENTRIES.
+ *  The producer stops when the reader ends or when this is destroyed, and waits while the ring is full.
+ */
+template<typename R>
+class background_tracereader
+{
+    struct shared_state
+    {
+        R reader;
+        std::optional<ooo_model_instr> pending {}; // Read from the reader, but not pushed yet when the producer stopped
+        spsc_ring<ooo_model_instr, BACKGROUND_TRACE_BUFFER_ENTRIES> ring {};
+        std::atomic<bool> done {false}; // The reader ended, no more instructions will be pushed
+        std::atomic<bool> stop {false}; // The producer has to stop, since the consumer is gone or skips instructions
+        std::thread producer {};
+
+        explicit shared_state(R&& r): reader(std::move(r)) {}
+
+        void produce()
+        {
+            while (! stop.load(std::memory_order_relaxed) && (pending.has_value() || ! reader.eof()))
+            {
+                if (! pending.has_value())
+                    pending = reader();
+                while (! ring.try_push(std::move(*pending)))
+                {
+                    if (stop.load(std::memory_order_relaxed))
+                        return;
+                    std::this_thread::yield();
+                }
+                pending.reset();
+            }
+            done.store(true, std::memory_order_release);
+        }
+    };
+
+    std::unique_ptr<shared_state> state;
+
+    void start()
+    {
+        state->stop.store(false, std::memory_order_relaxed);
+        state->done.store(false, std::memory_order_relaxed);
+        state->producer = std::thread {[s = state.get()] { s->produce(); }};
+    }
+
+    void halt()
+    {
+        state->stop.store(true, std::memory_order_relaxed);
+        state->producer.join();
+    }
+
+    // Wait until the ring has an instruction, or the reader ended
+    void wait() const
+    {
+        while (state->ring.empty() && ! state->done.load(std::memory_order_acquire))
+            std::this_thread::yield();
+    }
+
+public:
+    explicit background_tracereader(R&& reader): state(std::make_unique<shared_state>(std::move(reader))) { start(); }
+
+    background_tracereader(background_tracereader&&)            = default;
+    background_tracereader& operator=(background_tracereader&&) = delete;
+
+    ~background_tracereader()
+    {
+        if (state != nullptr)
+            halt();
+    }
+
+    ooo_model_instr operator()()
+    {
+        auto instr = state->ring.try_pop();
+        while (! instr.has_value())
+        {
+            // The reader ended and its instructions were all consumed, so none will come (check eof() before reading)
+            if (state->done.load(std::memory_order_acquire) && state->ring.empty())
+            {
+                std::printf("%s: Read past the end of the trace.\n", __func__);
+                abort();
+            }
+            std::this_thread::yield();
+            instr = state->ring.try_pop();
+        }
+        return *std::move(instr);
+    }
+
+    // Skip the instructions read ahead first, then let the reader skip the rest while the producer is stopped
+    uint64_t skip(uint64_t count)
+    {
+        halt();
+
+        uint64_t skipped = 0;
+        while (skipped < count && state->ring.try_pop().has_value())
+            skipped++;
+        if (skipped < count && state->pending.has_value())
+        {
+            state->pending.reset();
+            skipped++;
+        }
+        if (skipped < count)
+            skipped += skip_instructions(state->reader, count - skipped);
+
+        start();
+        return skipped;
+    }
+
+    // Whether the reader ended and every instruction it read has been consumed, which can only be known after waiting for the producer
+    bool eof() const
+    {
+        wait();
+        return state->ring.empty();
+    }
+};
+} // namespace champsim
+
+#endif // BACKGROUND_TRACE_DECOMPRESSION
+#endif // USER_CODES
+
+#endif
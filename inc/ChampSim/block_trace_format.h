@@ -0,0 +1,68 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef BLOCK_TRACE_FORMAT_H
+#define BLOCK_TRACE_FORMAT_H
+
+#include <array>
+#include <cstdint>
+
+// The layout of a block trace on disk, without the simulator, so the tracers can write block traces themselves
+namespace champsim
+{
+/** @brief
+ *  A seekable trace container (.cbt). The records of a trace are grouped into blocks of at most records_per_block records, and each block is
+ *  compressed by itself with xz, so any block can be decompressed without the blocks before it. An index of the blocks follows them:
+ *
+ *      header | block 0 | block 1 | ... | index_entry of each block | footer
+ *
+ *  Reaching the n-th record of a trace only decompresses the block that holds it.
+ */
+namespace block_trace
+{
+constexpr std::array<char, 8> MAGIC          = {'C', 'H', 'A', 'M', 'P', 'B', 'L', 'K'};
+constexpr uint32_t VERSION                   = 1;
+constexpr uint32_t DEFAULT_RECORDS_PER_BLOCK = 1u << 16; // 4 MiB of input_instr before compression
+constexpr const char* FILE_EXTENSION         = ".cbt";
+
+struct header
+{
+    std::array<char, 8> magic;
+    uint32_t version;
+    uint32_t record_size;
+    uint32_t records_per_block;
+    uint32_t reserved;
+};
+
+struct index_entry
+{
+    uint64_t offset;       // Where the compressed block begins in the file
+    uint64_t size;         // Bytes of the compressed block
+    uint64_t first_record; // The number of records before the block
+    uint64_t records;
+};
+
+struct footer
+{
+    uint64_t index_offset;
+    uint64_t blocks;
+    uint64_t records;
+    std::array<char, 8> magic;
+};
+} // namespace block_trace
+} // namespace champsim
+
+#endif
@@ -19,6 +19,7 @@
 
 #include <cstdint>
 #include <exception>
+#include <string>
 #include <vector>
 
 #include "ChampSim/environment.h"
@@ -42,7 +43,20 @@ constexpr bool debug_print = false;
 #endif
 
 #if (USER_CODES == ENABLE)
-std::vector<phase_stats> main(environment& env, std::vector<phase_info>& phases, std::vector<tracereader>& traces);
+// The checkpoint files of a simulation, an empty name means no such file
+struct checkpoint_files
+{
+    std::string save;    // Save the state into this file after the warmup phase
+    std::string restore; // Restore the state from this file instead of running the warmup phase
+};
+
+std::vector<phase_stats> main(environment& env, std::vector<phase_info>& phases, std::vector<tracereader>& traces, const checkpoint_files& checkpoint = {});
+
+// Save the state, with the traces of the phase that the state was simulated from
+void save_checkpoint(environment& env, const std::string& file_name, const phase_info& phase);
+
+// Restore the state, and skip the instructions retired before the checkpoint in the traces of the phase, which must be the traces saved
+void restore_checkpoint(environment& env, const std::string& file_name, const phase_info& phase, std::vector<tracereader>& traces);
 #endif // USER_CODES
 
 } // namespace champsim
@@ -0,0 +1,294 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef CHECKPOINT_H
+#define CHECKPOINT_H
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <map>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "ChampSim/util/detect.h"
+#include "ProjectConfiguration.h" // User file
+
+#if (USER_CODES == ENABLE)
+
+namespace champsim
+{
+
+class checkpoint_archive;
+
+/** @brief
+ *  How a type is saved into and restored from a checkpoint archive.
+ *  Classes with a member function checkpoint(archive) archive themselves, trivially copyable types are archived as bytes,
+ *  and the standard containers are specialized below.
+ */
+template<typename T, typename Enable = void>
+struct checkpoint_traits;
+
+/** @brief
+ *  A compact binary image of the simulator state, made of named sections.
+ *  The same checkpoint() functions save and restore the state, since the archive knows its direction: operator& writes the value into the
+ *  current section when saving, and reads it back when restoring. Every section is looked up by name, so a component whose section is missing
+ *  (e.g., a memory of another organization) keeps its initial state instead of reading the state of something else.
+ */
+class checkpoint_archive
+{
+public:
+    using participant_type = std::function<void(checkpoint_archive&)>;
+
+    // Register the state that lives outside the components (e.g., the tables of the branch predictor and replacement modules)
+    struct participant
+    {
+        explicit participant(participant_type function) { participants().push_back(std::move(function)); }
+    };
+
+    // An empty archive to save into
+    checkpoint_archive() = default;
+
+    // An archive to restore from, read from the file
+    explicit checkpoint_archive(const std::string& file_name);
+
+    void write(const std::string& file_name) const;
+
+    bool is_saving() const { return saving; }
+
+    // Switch to the named section. When restoring, return false if the archive doesn't have it.
+    bool section(const std::string& name);
+
+    bool has_section(const std::string& name) const { return sections.count(name) != 0; }
+
+    // Check that the restored section was read up to its end, since the rest would be the state of something this configuration doesn't have
+    void close_section();
+
+    // Save or restore the registered state of the modules
+    void checkpoint_participants();
+
+    template<typename T>
+    checkpoint_archive& operator&(T& value)
+    {
+        checkpoint_traits<T>::checkpoint(*this, value);
+        return *this;
+    }
+
+    // Save the value, or check that the restored value is the same, e.g., for the geometry of the tables
+    template<typename T>
+    void expect(const T& value, const std::string& what)
+    {
+        T archived = value;
+        *this & archived;
+        if (archived != value)
+            mismatch(what);
+    }
+
+    void bytes(void* data, std::size_t size);
+
+private:
+    static std::vector<participant_type>& participants();
+
+    [[noreturn]] void mismatch(const std::string& what) const;
+
+    bool saving = true;
+    std::map<std::string, std::vector<char>> sections {};
+    std::vector<char>* current = nullptr;
+    std::string current_name {};
+    std::size_t position = 0;
+};
+
+namespace detail
+{
+template<typename T>
+using checkpoint_member = decltype(std::declval<T&>().checkpoint(std::declval<checkpoint_archive&>()));
+
+// Archive the number of elements, then restore the container with the number of elements read back
+template<typename C>
+std::size_t checkpoint_size(checkpoint_archive& archive, const C& container)
+{
+    auto size = std::size(container);
+    archive & size;
+    return size;
+}
+
+// Same, but resize the sequence container. The elements that can't be constructed alone (e.g., tables with a geometry) must keep their number.
+template<typename C>
+void checkpoint_resize(checkpoint_archive& archive, C& container)
+{
+    auto size = checkpoint_size(archive, container);
+    if constexpr (std::is_default_constructible_v<typename C::value_type>)
+        container.resize(size);
+    else
+        assert(size == std::size(container));
+}
+} // namespace detail
+
+template<typename T, typename Enable>
+struct checkpoint_traits
+{
+    static void checkpoint(checkpoint_archive& archive, T& value)
+    {
+        if constexpr (champsim::is_detected_v<detail::checkpoint_member, T>)
+            value.checkpoint(archive);
+        else
+        {
+            static_assert(std::is_trivially_copyable_v<T>, "Add a checkpoint() member function or a checkpoint_traits specialization for this type");
+            archive.bytes(&value, sizeof(T));
+        }
+    }
+};
+
+template<typename T, std::size_t N>
+struct checkpoint_traits<T[N], std::enable_if_t<! std::is_trivially_copyable_v<T>>>
+{
+    static void checkpoint(checkpoint_archive& archive, T (&value)[N])
+    {
+        for (auto& element : value)
+            archive & element;
+    }
+};
+
+template<typename T, std::size_t N>
+struct checkpoint_traits<std::array<T, N>, std::enable_if_t<! std::is_trivially_copyable_v<T>>>
+{
+    static void checkpoint(checkpoint_archive& archive, std::array<T, N>& value)
+    {
+        for (auto& element : value)
+            archive & element;
+    }
+};
+
+template<typename T, typename A>
+struct checkpoint_traits<std::vector<T, A>>
+{
+    static void checkpoint(checkpoint_archive& archive, std::vector<T, A>& value)
+    {
+        detail::checkpoint_resize(archive, value);
+        if constexpr (std::is_same_v<T, bool>)
+        {
+            // Pack the bits into bytes, since the tables of bits may be as large as the memory in data blocks
+            for (std::size_t i = 0; i < std::size(value); i += 8)
+            {
+                uint8_t bits = 0;
+                for (std::size_t j = i; j < std::min(i + 8, std::size(value)); j++)
+                    bits |= uint8_t(value[j]) << (j - i);
+                archive & bits;
+                for (std::size_t j = i; j < std::min(i + 8, std::size(value)); j++)
+                    value[j] = (bits >> (j - i)) & 1;
+            }
+        }
+        else if constexpr (std::is_trivially_copyable_v<T> && ! champsim::is_detected_v<detail::checkpoint_member, T>)
+            archive.bytes(std::data(value), std::size(value) * sizeof(T));
+        else
+        {
+            for (auto& element : value)
+                archive & element;
+        }
+    }
+};
+
+template<typename T, typename A>
+struct checkpoint_traits<std::deque<T, A>>
+{
+    static void checkpoint(checkpoint_archive& archive, std::deque<T, A>& value)
+    {
+        detail::checkpoint_resize(archive, value);
+        for (auto& element : value)
+            archive & element;
+    }
+};
+
+template<typename C, typename Tr, typename A>
+struct checkpoint_traits<std::basic_string<C, Tr, A>>
+{
+    static void checkpoint(checkpoint_archive& archive, std::basic_string<C, Tr, A>& value)
+    {
+        value.resize(detail::checkpoint_size(archive, value));
+        archive.bytes(std::data(value), std::size(value) * sizeof(C));
+    }
+};
+
+template<typename T1, typename T2>
+struct checkpoint_traits<std::pair<T1, T2>>
+{
+    static void checkpoint(checkpoint_archive& archive, std::pair<T1, T2>& value) { archive & value.first & value.second; }
+};
+
+template<typename... Ts>
+struct checkpoint_traits<std::tuple<Ts...>>
+{
+    static void checkpoint(checkpoint_archive& archive, std::tuple<Ts...>& value)
+    {
+        std::apply([&archive](auto&... elements)
+            { (archive & ... & elements); }, value);
+    }
+};
+
+/** @brief
+ *  The associative containers are restored by inserting the archived elements again, since their keys are constant.
+ */
+template<typename M>
+struct checkpoint_map_traits
+{
+    static void checkpoint(checkpoint_archive& archive, M& value)
+    {
+        auto size = detail::checkpoint_size(archive, value);
+        if (archive.is_saving())
+        {
+            for (auto& [key, mapped] : value)
+            {
+                auto archived_key = key;
+                archive & archived_key & mapped;
+            }
+        }
+        else
+        {
+            value.clear();
+            for (std::size_t i = 0; i < size; i++)
+            {
+                typename M::key_type key {};
+                typename M::mapped_type mapped {};
+                archive & key & mapped;
+                value.emplace(std::move(key), std::move(mapped));
+            }
+        }
+    }
+};
+
+template<typename K, typename V, typename C, typename A>
+struct checkpoint_traits<std::map<K, V, C, A>> : checkpoint_map_traits<std::map<K, V, C, A>>
+{
+};
+
+template<typename K, typename V, typename H, typename E, typename A>
+struct checkpoint_traits<std::unordered_map<K, V, H, E, A>> : checkpoint_map_traits<std::unordered_map<K, V, H, E, A>>
+{
+};
+
+} // namespace champsim
+
+#endif // USER_CODES
+
+#endif
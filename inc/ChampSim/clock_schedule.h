@@ -0,0 +1,66 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef CLOCK_SCHEDULE_H
+#define CLOCK_SCHEDULE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+#include "ChampSim/operable.h"
+#include "ProjectConfiguration.h" // User file
+
+#if (USER_CODES == ENABLE)
+
+namespace champsim
+{
+
+/** @brief
+ *  The order in which the operables tick in every cycle of a phase.
+ *  After every cycle, the operables are ordered by their fractional clocks (leap_operation). Those clocks only depend on each operable's CLOCK_SCALE,
+ *  so the sequence of orders is known when the phase begins and, for the usual clock ratios, becomes periodic after a few cycles. The sequence is
+ *  computed once here, and the main loop just walks through it instead of sorting the operables every cycle.
+ */
+class clock_schedule
+{
+public:
+    using order_type                         = std::vector<std::reference_wrapper<operable>>;
+
+    // The longest sequence of orders to precompute, beyond which the operables are sorted every cycle as before
+    constexpr static std::size_t MAX_LENGTH = 4096;
+
+    explicit clock_schedule(order_type operables);
+
+    // The order of the current cycle
+    const order_type& order() const { return calendar[slot]; }
+
+    // Move to the order of the cycle after the next cycles
+    void advance(uint64_t cycles = 1);
+
+private:
+    std::vector<order_type> calendar {};
+    std::size_t repeat_begin = 0; // The calendar continues from this slot after its last slot
+    std::size_t slot         = 0;
+    bool sorting             = false; // No period is found, calendar[0] is sorted every cycle
+};
+
+} // namespace champsim
+
+#endif // USER_CODES
+
+#endif
@@ -37,6 +37,17 @@ struct environment
     virtual std::vector<std::reference_wrapper<CACHE>> cache_view()         = 0;
     virtual std::vector<std::reference_wrapper<PageTableWalker>> ptw_view() = 0;
     virtual std::vector<std::reference_wrapper<operable>> operable_view()   = 0;
+
+    // The memory controller, whose type depends on the memory standards
+    virtual operable& dram_view() = 0;
+
+    // The operables private to each CPU (indexed by CPU), which only reach the rest of the system through the shared caches and page table walkers
+    virtual std::vector<std::vector<std::reference_wrapper<operable>>> private_view() = 0;
+
+#if (FUNCTIONAL_WARMUP == ENABLE)
+    // Pass a request that misses all caches to the memory controller in functional warmup
+    virtual void functional_memory_access(const channel::request_type& packet) = 0;
+#endif // FUNCTIONAL_WARMUP
 };
 } // namespace champsim
 
@@ -51,6 +62,14 @@ struct environment
     virtual std::vector<std::reference_wrapper<PageTableWalker>> ptw_view() = 0;
     virtual MEMORY_CONTROLLER& dram_view()                                  = 0;
     virtual std::vector<std::reference_wrapper<operable>> operable_view()   = 0;
+
+    // The operables private to each CPU (indexed by CPU), which only reach the rest of the system through the shared caches and page table walkers
+    virtual std::vector<std::vector<std::reference_wrapper<operable>>> private_view() = 0;
+
+#if (FUNCTIONAL_WARMUP == ENABLE)
+    // Pass a request that misses all caches to the memory controller in functional warmup
+    virtual void functional_memory_access(const channel::request_type& packet) = 0;
+#endif // FUNCTIONAL_WARMUP
 };
 } // namespace champsim
 
@@ -0,0 +1,68 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FUNCTIONAL_WARMUP_H
+#define FUNCTIONAL_WARMUP_H
+
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <vector>
+
+#include "ChampSim/environment.h"
+#include "ChampSim/instruction.h"
+#include "ProjectConfiguration.h" // User file
+
+#if (USER_CODES == ENABLE)
+#if (FUNCTIONAL_WARMUP == ENABLE)
+
+namespace champsim
+{
+
+/** @brief
+ *  Warm up the environment without timing. Each instruction predicts its branch, fetches its cache line and accesses its data at once, walking
+ *  through the TLBs, page table walkers, caches and memory controller without the out-of-order pipeline and the memory queues.
+ *  The components are connected when it is constructed and disconnected when it is destructed, so it only lives during the warmup phase.
+ */
+class functional_warmup
+{
+    using level_type = std::function<channel::response_type(const channel::request_type&)>;
+
+    environment& env;
+
+    // The components whose clocks advance with the instructions
+    std::vector<std::reference_wrapper<operable>> clocked {};
+
+    // The L1I and L1D of each CPU
+    std::map<uint32_t, std::pair<level_type, level_type>> first_levels {};
+
+public:
+    explicit functional_warmup(environment& env);
+    ~functional_warmup();
+
+    functional_warmup(const functional_warmup&)            = delete;
+    functional_warmup& operator=(const functional_warmup&) = delete;
+
+    // Warm up with an instruction of the CPU, and retire it
+    void operate(O3_CPU& cpu, ooo_model_instr& instr);
+};
+
+} // namespace champsim
+
+#endif // FUNCTIONAL_WARMUP
+#endif // USER_CODES
+
+#endif
@@ -21,14 +21,27 @@
 #include <lzma.h>
 #include <zlib.h>
 
+#include <atomic>
 #include <cassert>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
 #include <iostream>
+#include <limits>
 #include <memory>
 
+#include "ProjectConfiguration.h" // User file
+
 namespace champsim
 {
 namespace decomp_tags
 {
+#if (USER_CODES == ENABLE)
+// The threads decoding each xz stream. More than one only helps streams of several blocks (e.g., compressed by xz -T0).
+inline uint32_t decoder_threads = 1;
+#endif // USER_CODES
+
 enum class status_t
 {
     CAN_CONTINUE,
@@ -178,7 +191,28 @@ struct lzma_tag_t
     static inflate_state_type new_inflate_state()
     {
         inflate_state_type state {new state_type};
-        *state   = LZMA_STREAM_INIT;
+        *state = LZMA_STREAM_INIT;
+
+#if (USER_CODES == ENABLE) && (LZMA_VERSION >= 50040002)
+        // The blocks are decoded by the threads and returned in order
+        if (decoder_threads > 1)
+        {
+            lzma_mt options {};
+            options.flags              = flags;
+            options.threads            = decoder_threads;
+            options.memlimit_threading = std::numeric_limits<uint64_t>::max();
+            options.memlimit_stop      = std::numeric_limits<uint64_t>::max();
+            auto ret                   = ::lzma_stream_decoder_mt(state.get(), &options);
+            assert(ret == LZMA_OK);
+            return state;
+        }
+#elif (USER_CODES == ENABLE)
+        // liblzma decodes on several threads only from 5.4.0 on
+        static std::atomic<bool> warned {false};
+        if (decoder_threads > 1 && ! warned.exchange(true))
+            std::printf("%s: liblzma %s cannot decode on several threads, so xz traces are decoded on one thread.\n", __func__, LZMA_VERSION_STRING);
+#endif // USER_CODES, LZMA_VERSION
+
         auto ret = ::lzma_stream_decoder(state.get(), std::numeric_limits<uint64_t>::max(), flags);
         assert(ret == LZMA_OK);
         return state;
@@ -0,0 +1,125 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MEMORY_TRACE_H
+#define MEMORY_TRACE_H
+
+#include <array>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <deque>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "ChampSim/inf_stream.h"
+#include "ProjectConfiguration.h" // User file
+
+#if (USER_CODES == ENABLE)
+
+namespace champsim
+{
+/** @brief
+ *  The binary memory trace (.mtrace.gz) written with PRINT_MEMORY_TRACE, i.e., every request the memory controller sends to the memories. It is a
+ *  gzip stream of fixed-size records after a header:
+ *
+ *      header | record x requests
+ *
+ *  The simulator fills a buffer of records and hands it to a thread that compresses and writes it, so recording costs a copy per request.
+ *  --replay-memory-trace feeds the requests of a trace back into a memory controller.
+ */
+namespace memory_trace
+{
+constexpr std::array<char, 8> MAGIC    = {'C', 'H', 'A', 'M', 'P', 'M', 'T', 'R'};
+constexpr uint32_t VERSION             = 2;
+constexpr const char* FILE_EXTENSION   = ".mtrace.gz";
+constexpr std::size_t BUFFER_RECORDS   = 1u << 16; // 2 MiB of records compressed at a time
+constexpr std::size_t PENDING_BUFFERS  = 4;        // Buffers waiting for compression before the simulator waits for the compressing thread
+constexpr uint8_t ORIGIN_SWAPPING      = 0xff;     // The origin of the requests of the swapping unit
+constexpr uint32_t NO_CPU              = UINT32_MAX;
+
+struct header
+{
+    std::array<char, 8> magic;
+    uint32_t version;
+    uint32_t record_size;
+};
+
+struct record
+{
+    uint64_t cycle;            // The cycle of the memory controller sending the request
+    uint64_t address;          // Hardware address at byte granularity, across the memories
+    uint64_t physical_address; // The address before the OS-transparent management remaps it, which replaying the trace starts from
+    uint32_t cpu;
+    uint8_t memory;            // The memory receiving the request
+    char type;                 // 'R' or 'W'
+    uint8_t origin;            // access_type of the load or store causing the request, or ORIGIN_SWAPPING
+    uint8_t accepted;          // Whether the memory takes the request, otherwise it is sent again later
+};
+
+// Compress the records into a file on a thread of its own
+class writer
+{
+    std::FILE* file;
+    std::string file_name;
+    std::vector<record> filling {};
+
+    std::mutex mutex;
+    std::condition_variable changed;
+    std::deque<std::vector<record>> pending {};
+    bool closing = false;
+    std::thread compressor;
+
+    void submit();
+    void compress();
+
+public:
+    writer(std::FILE* file, const std::string& file_name);
+    ~writer();
+
+    writer(const writer&)            = delete;
+    writer& operator=(const writer&) = delete;
+
+    void write(const record& r)
+    {
+        filling.push_back(r);
+        if (std::size(filling) == BUFFER_RECORDS)
+            submit();
+    }
+};
+
+// Read the records of a memory trace in order
+class reader
+{
+    inf_istream<decomp_tags::gzip_tag_t<>> stream;
+    std::string file_name;
+    std::vector<record> buffer {};
+    std::size_t position = 0;
+
+public:
+    explicit reader(const std::string& file_name);
+
+    std::optional<record> next();
+};
+} // namespace memory_trace
+} // namespace champsim
+
+#endif // USER_CODES
+
+#endif
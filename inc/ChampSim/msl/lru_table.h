@@ -142,6 +142,14 @@ public:
         return std::exchange(*hit, {}).data;
     }
 
+    // Save or restore the contents and their recency, e.g., for checkpoints
+    template<typename Archive>
+    void checkpoint(Archive& archive)
+    {
+        archive.expect(std::pair {NUM_SET, NUM_WAY}, "table geometry");
+        archive & access_count & block;
+    }
+
     lru_table(std::size_t sets, std::size_t ways, SetProj set_proj, TagProj tag_proj)
     : set_projection(set_proj), tag_projection(tag_proj), NUM_SET(sets), NUM_WAY(ways)
     {
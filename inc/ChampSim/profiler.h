@@ -0,0 +1,145 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+#include "ProjectConfiguration.h" // User file
+
+#if (USER_CODES == ENABLE)
+
+namespace champsim
+{
+class environment;
+
+/** @brief
+ *  A wall-clock profiler of the simulator itself (--profile). Each profiled piece of code (e.g., the operate() of an operable, or the tick of a
+ *  Ramulator controller) has an entry, named after it, which counts its calls and the host time spent in them. The time is read from the
+ *  time-stamp counter where there is one, and calibrated against the steady clock when reported. The times of nested entries are included in
+ *  the times of the entries around them (e.g., the ticks of the memories are part of MEMORY_CONTROLLER). The entries are counted atomically, since
+ *  the private hierarchies of the CPUs operate on threads of their own with PARALLEL_CORE_SIMULATION.
+ */
+namespace profiler
+{
+// Whether the entries are being updated, set by --profile
+extern bool enabled;
+
+struct entry
+{
+    std::string name;
+    std::atomic<uint64_t> calls {0};
+    std::atomic<uint64_t> ticks {0};
+};
+
+// The counts of an entry at a point of time
+struct count
+{
+    uint64_t calls = 0;
+    uint64_t ticks = 0;
+};
+
+// What an entry spent during a phase
+struct record
+{
+    std::string name;
+    uint64_t calls;
+    double seconds;
+};
+
+// What the entries spent during a phase, which took seconds of host time
+struct report
+{
+    double seconds = 0;
+    std::vector<record> records {};
+};
+
+// The state of all entries at a point of time, to report what happened since then
+struct snapshot
+{
+    std::vector<count> counts; // Of the entries in the order they were added
+    uint64_t ticks;
+    std::chrono::steady_clock::time_point time;
+};
+
+inline uint64_t now()
+{
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return static_cast<uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+#endif
+}
+
+// Return the entry of this name, adding it at the first time. The entries are never moved, so the reference can be kept.
+entry& get(const std::string& name);
+
+// Name the operables of the environment after their components
+void attach(environment& env);
+
+snapshot take_snapshot();
+
+// The entries called since the snapshot, the most expensive first
+report since(const snapshot& start);
+
+#if (SIMULATION_PROFILER == ENABLE)
+// Count a call of the entry and the time until the end of this scope
+class scope
+{
+    entry* profiled;
+    uint64_t start;
+
+public:
+    explicit scope(entry* profiled): profiled(enabled ? profiled : nullptr), start(this->profiled != nullptr ? now() : 0) {}
+
+    explicit scope(entry& profiled): scope(&profiled) {}
+
+    ~scope()
+    {
+        if (profiled != nullptr)
+        {
+            profiled->ticks.fetch_add(now() - start, std::memory_order_relaxed);
+            profiled->calls.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    scope(const scope&)            = delete;
+    scope& operator=(const scope&) = delete;
+};
+#else
+class scope
+{
+public:
+    explicit scope(entry*) {}
+
+    explicit scope(entry&) {}
+};
+#endif // SIMULATION_PROFILER
+} // namespace profiler
+} // namespace champsim
+
+#endif // USER_CODES
+
+#endif
@@ -0,0 +1,103 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef SYNTHETIC_TRACEREADER_H
+#define SYNTHETIC_TRACEREADER_H
+
+#include <cstdint>
+#include <random>
+#include <string>
+
+#include "ChampSim/instruction.h"
+#include "ChampSim/trace_instruction.h"
+#include "ProjectConfiguration.h" // User file
+
+#if (USER_CODES == ENABLE) && (SYNTHETIC_TRACES == ENABLE)
+
+namespace champsim
+{
+enum class synthetic_pattern
+{
+    STREAM,  // Every word of the footprint in order
+    STRIDE,  // Every stride bytes of the footprint in order
+    RANDOM,  // Cache lines of the footprint drawn uniformly
+    ZIPFIAN, // Cache lines of the footprint drawn with a zipfian distribution, so a few hot lines scattered over the footprint take most accesses
+    CHASE    // Cache lines of the footprint in a pseudo-random cycle, each load depending on the one before it
+};
+
+/** @brief
+ *  The parameters of a synthetic trace, given in place of a trace file as
+ *
+ *      synthetic:<pattern>[,<key>=<value>...]
+ *
+ *  where the pattern is stream, stride, random, zipfian or chase, and the keys are the names of the members below. Sizes take the suffixes K,
+ *  M and G (binary), e.g., synthetic:zipfian,footprint=4G,writes=0.3,skew=0.9.
+ */
+struct synthetic_trace_parameters
+{
+    synthetic_pattern pattern = synthetic_pattern::STREAM;
+    uint64_t footprint        = 256ull << 20; // Bytes accessed from the base address
+    uint64_t stride           = 4096;         // Bytes between the accesses of stride
+    double writes             = 0;            // The fraction of the memory accesses that are stores
+    double skew               = 0.99;         // The exponent of zipfian, in (0, 1)
+    uint32_t gap              = 2;            // Instructions without memory accesses after each memory access
+    uint32_t loop             = 64;           // Instructions of the loop the trace runs, including the branch closing it
+    uint64_t length           = 0;            // Instructions before the trace ends, or never with 0
+    uint64_t seed             = 1;            // Added to the CPU, so the cores draw different addresses
+    uint64_t base             = 1ull << 32;   // The virtual address of the footprint
+};
+
+bool is_synthetic_trace(const std::string& name);
+
+synthetic_trace_parameters parse_synthetic_trace(const std::string& name);
+
+/** @brief
+ *  Generate the instructions of a synthetic trace instead of reading them from a file, so the same stream can be reproduced anywhere from its
+ *  name. The instructions form a loop of parameters.loop instructions closed by a taken conditional branch, where every (gap + 1)-th
+ *  instruction accesses the next address of the pattern.
+ */
+class synthetic_tracereader
+{
+    uint8_t cpu;
+    synthetic_trace_parameters parameters;
+    std::mt19937_64 generator;
+    std::uniform_real_distribution<double> uniform {0.0, 1.0};
+
+    uint64_t lines;         // Cache lines in the footprint, a power of two for chase
+    uint64_t position = 0;  // Instructions generated
+    uint64_t cursor   = 0;  // The next word, stride or line of stream, stride and chase
+    uint64_t accesses = 0;  // Memory accesses generated
+
+    // The constants of the zipfian generator of Gray et al., "Quickly Generating Billion-Record Synthetic Databases"
+    double zeta_n = 0, zeta_2 = 0, alpha = 0, eta = 0;
+
+    uint64_t next_address();
+    input_instr next_record();
+
+public:
+    synthetic_tracereader(uint8_t cpu_idx, std::string name);
+
+    ooo_model_instr operator()();
+
+    uint64_t skip(uint64_t count);
+
+    bool eof() const { return parameters.length > 0 && position >= parameters.length; }
+};
+} // namespace champsim
+
+#endif // USER_CODES, SYNTHETIC_TRACES
+
+#endif
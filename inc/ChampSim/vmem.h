@@ -59,6 +59,9 @@ public:
     std::size_t available_ppages() const;
     std::pair<uint64_t, uint64_t> va_to_pa(uint32_t cpu_num, uint64_t vaddr);
     std::pair<uint64_t, uint64_t> get_pte_pa(uint32_t cpu_num, uint64_t vaddr, std::size_t level);
+
+    // Save or restore the page mappings and page tables, e.g., for checkpoints
+    void checkpoint(champsim::checkpoint_archive& archive);
 };
 #else
 
@@ -93,6 +96,9 @@ public:
     std::size_t available_ppages() const;
     std::pair<uint64_t, uint64_t> va_to_pa(uint32_t cpu_num, uint64_t vaddr);
     std::pair<uint64_t, uint64_t> get_pte_pa(uint32_t cpu_num, uint64_t vaddr, std::size_t level);
+
+    // Save or restore the page mappings and page tables, e.g., for checkpoints
+    void checkpoint(champsim::checkpoint_archive& archive);
 };
 
 #endif // RAMULATOR
@@ -73,6 +73,14 @@ public:
     long clk = 0;
     DRAM<T>* channel;
 
+#if (USER_CODES == ENABLE)
+    long issued_commands = 0; // the commands issued to the channel, which are the only changes to its state
+
+    CompletionQueue* completions = nullptr; // where the reads without a callback complete, e.g., those of the memory controller of ChampSim
+
+    static_assert(int(T::Level::MAX) <= AddrVec::MAX_LEVELS, "The levels of the standard don't fit in the address vector of a request");
+#endif // USER_CODES
+
     Scheduler<T>* scheduler; // determines the highest priority request whose commands will be issued
     RowPolicy<T>* rowpolicy; // determines the row-policy (e.g., closed-row vs. open-row)
     RowTable<T>* rowtable;   // tracks metadata about rows (e.g., which are open and for how long)
@@ -300,6 +308,29 @@ public:
         }
     }
 
+#if (USER_CODES == ENABLE)
+    // Move the request into its queue, or into pending if it is served by a write in the write queue, so the caller's request is left empty
+    bool enqueue(Request& req)
+    {
+        Queue& queue = get_queue(req.type);
+        if (queue.max == queue.size())
+            return false;
+
+        req.arrive = clk;
+        // shortcut for read requests, if a write to same addr exists
+        // necessary for coherence
+        if (req.type == Request::Type::READ && find_if(writeq.q.begin(), writeq.q.end(),
+                                                   [&req](const Request& wreq)
+                                                   { return req.addr == wreq.addr; }) != writeq.q.end())
+        {
+            req.depart = clk + 1;
+            pending.push_back(std::move(req));
+        }
+        else
+            queue.q.push_back(std::move(req));
+        return true;
+    }
+#else
     bool enqueue(Request& req)
     {
         Queue& queue = get_queue(req.type);
@@ -320,6 +351,7 @@ public:
         }
         return true;
     }
+#endif // USER_CODES
 
 #if (USER_CODES == ENABLE)
     unsigned int queue_size(Request& req)
@@ -354,7 +386,17 @@ public:
                     channel->update_serving_requests(
                         req.addr_vec.data(), -1, clk);
                 }
+#if (USER_CODES == ENABLE)
+                if (req.callback)
+                    req.callback(req);
+                else
+                {
+                    assert(completions);
+                    completions->push_back(std::move(req));
+                }
+#else
                 req.callback(req);
+#endif // USER_CODES
                 pending.pop_front();
             }
         }
@@ -413,8 +455,8 @@ public:
         if (! is_valid_req)
         {
             // we couldn't find a command to schedule -- let's try to be speculative
-            auto cmd           = T::Command::PRE;
-            vector<int> victim = rowpolicy->get_victim(cmd);
+            auto cmd       = T::Command::PRE;
+            AddrVec victim = rowpolicy->get_victim(cmd);
             if (! victim.empty())
             {
                 issue_cmd(cmd, victim);
@@ -481,8 +523,12 @@ public:
             if (channel->spec->is_opening(cmd))
             {
                 // promote the request that caused issuing activation to actq
+#if (USER_CODES == ENABLE)
+                actq.q.splice(actq.q.end(), queue->q, req);
+#else
                 actq.q.push_back(*req);
                 queue->q.erase(req);
+#endif // USER_CODES
             }
 
             return;
@@ -492,7 +538,11 @@ public:
         if (req->type == Request::Type::READ)
         {
             req->depart = clk + channel->spec->read_latency;
+#if (USER_CODES == ENABLE)
+            pending.push_back(std::move(*req)); // the request is removed from the queue below
+#else
             pending.push_back(*req);
+#endif // USER_CODES
         }
 
         if (req->type == Request::Type::WRITE)
@@ -511,11 +561,20 @@ public:
         return channel->check(cmd, req->addr_vec.data(), clk);
     }
 
-    bool is_ready(typename T::Command cmd, const vector<int>& addr_vec)
+    bool is_ready(typename T::Command cmd, const AddrVec& addr_vec)
     {
         return channel->check(cmd, addr_vec.data(), clk);
     }
 
+#if (USER_CODES == ENABLE)
+    // The earliest clock when the first command of a request can be issued, which holds until another command is issued
+    long get_ready_clk(list<Request>::iterator req)
+    {
+        typename T::Command cmd = get_first_cmd(req);
+        return channel->get_next(cmd, req->addr_vec.data());
+    }
+#endif // USER_CODES
+
     bool is_row_hit(list<Request>::iterator req)
     {
         // cmd must be decided by the request type, not the first cmd
@@ -523,7 +582,7 @@ public:
         return channel->check_row_hit(cmd, req->addr_vec.data());
     }
 
-    bool is_row_hit(typename T::Command cmd, const vector<int>& addr_vec)
+    bool is_row_hit(typename T::Command cmd, const AddrVec& addr_vec)
     {
         return channel->check_row_hit(cmd, addr_vec.data());
     }
@@ -535,7 +594,7 @@ public:
         return channel->check_row_open(cmd, req->addr_vec.data());
     }
 
-    bool is_row_open(typename T::Command cmd, const vector<int>& addr_vec)
+    bool is_row_open(typename T::Command cmd, const AddrVec& addr_vec)
     {
         return channel->check_row_open(cmd, addr_vec.data());
     }
@@ -556,6 +615,60 @@ public:
         return clk <= channel->end_of_refreshing;
     }
 
+#if (IDLE_CYCLE_SKIPPING == ENABLE)
+    // For telling how many upcoming ticks can neither issue a command nor finish a read
+    long idle_ticks()
+    {
+        // Only the open-row policy (or an empty row table) never issues speculative precharges
+        if (rowpolicy->type != RowPolicy<T>::Type::Opened && rowtable->open_rows > 0)
+            return 0;
+
+        // The refresh only acts once every nREFI (DSARP, which refreshes per bank, is specialized)
+        long ticks = refresh->refreshed + channel->spec->speed_entry.nREFI - refresh->clk - 1;
+        if (pending.size())
+            ticks = std::min(ticks, pending[0].depart - clk - 1);
+
+        // A queued request waits for the timing of its first command, which only another command can change
+        for (auto queue : {&actq, &readq, &writeq, &otherq})
+        {
+            for (auto req = queue->q.begin(); req != queue->q.end() && ticks > 0; ++req)
+                ticks = std::min(ticks, get_ready_clk(req) - clk - 1);
+        }
+
+        return std::max(ticks, 0l);
+    }
+
+    // Fast-forward over ticks reported by idle_ticks(), keeping the per-tick statistics
+    void skip_ticks(long ticks)
+    {
+        if (ticks <= 0)
+            return;
+
+        clk += ticks;
+        refresh->clk += ticks;
+        req_queue_length_sum += ticks * (readq.size() + writeq.size() + pending.size());
+        read_req_queue_length_sum += ticks * (readq.size() + pending.size());
+        write_req_queue_length_sum += ticks * writeq.size();
+
+        // The queues keep their sizes, so the first skipped tick decides the write mode of all of them
+        if (! write_mode)
+            write_mode = writeq.size() > (unsigned int) (wr_high_watermark * writeq.max) || readq.size() == 0;
+        else
+            write_mode = ! (writeq.size() < (unsigned int) (wr_low_watermark * writeq.max) && readq.size() != 0);
+    }
+#endif // IDLE_CYCLE_SKIPPING
+
+#if (USER_CODES == ENABLE)
+    // Save or restore the state of the channel and its open rows, e.g., for checkpoints. The queued requests are not kept.
+    template<typename Archive>
+    void checkpoint(Archive& archive)
+    {
+        archive & clk & write_mode & *rowtable & refresh->clk & refresh->refreshed;
+        channel->checkpoint(archive);
+        issued_commands++; // what the scheduler derived from the channel before does not hold after a restore
+    }
+#endif // USER_CODES
+
     void set_high_writeq_watermark(const float watermark)
     {
         wr_high_watermark = watermark;
@@ -587,7 +700,7 @@ private:
 
     // upgrade to an autoprecharge command
     void cmd_issue_autoprecharge(typename T::Command& cmd,
-        const vector<int>& addr_vec)
+        const AddrVec& addr_vec)
     {
         // currently, autoprecharge is only used with closed row policy
         if (channel->spec->is_accessing(cmd) && rowpolicy->type == RowPolicy<T>::Type::ClosedAP)
@@ -596,7 +709,7 @@ private:
             Queue* queue = write_mode ? &writeq : &readq;
 
             auto begin   = addr_vec.begin();
-            vector<int> rowgroup(begin, begin + int(T::Level::Row) + 1);
+            AddrVec rowgroup(begin, begin + int(T::Level::Row) + 1);
 
             int num_row_hits = 0;
 
@@ -605,7 +718,7 @@ private:
                 if (is_row_hit(itr))
                 {
                     auto begin2 = itr->addr_vec.begin();
-                    vector<int> rowgroup2(begin2, begin2 + int(T::Level::Row) + 1);
+                    AddrVec rowgroup2(begin2, begin2 + int(T::Level::Row) + 1);
                     if (rowgroup == rowgroup2)
                         num_row_hits++;
                 }
@@ -619,7 +732,7 @@ private:
                     if (is_row_hit(itr))
                     {
                         auto begin2 = itr->addr_vec.begin();
-                        vector<int> rowgroup2(begin2, begin2 + int(T::Level::Row) + 1);
+                        AddrVec rowgroup2(begin2, begin2 + int(T::Level::Row) + 1);
                         if (rowgroup == rowgroup2)
                             num_row_hits++;
                     }
@@ -641,11 +754,14 @@ private:
         }
     }
 
-    void issue_cmd(typename T::Command cmd, const vector<int>& addr_vec)
+    void issue_cmd(typename T::Command cmd, const AddrVec& addr_vec)
     {
         cmd_issue_autoprecharge(cmd, addr_vec);
         assert(is_ready(cmd, addr_vec));
         channel->update(cmd, addr_vec.data(), clk);
+#if (USER_CODES == ENABLE)
+        issued_commands++;
+#endif // USER_CODES
 
         if (cmd == T::Command::PRE)
         {
@@ -682,19 +798,24 @@ private:
         }
     }
 
-    vector<int> get_addr_vec(typename T::Command cmd, list<Request>::iterator req)
+    AddrVec get_addr_vec(typename T::Command cmd, list<Request>::iterator req)
     {
         return req->addr_vec;
     }
 };
 
 template<>
-vector<int> Controller<SALP>::get_addr_vec(
+AddrVec Controller<SALP>::get_addr_vec(
     SALP::Command cmd, list<Request>::iterator req);
 
 template<>
 bool Controller<SALP>::is_ready(list<Request>::iterator req);
 
+#if (USER_CODES == ENABLE)
+template<>
+long Controller<SALP>::get_ready_clk(list<Request>::iterator req);
+#endif // USER_CODES
+
 template<>
 void Controller<ALDRAM>::update_temp(ALDRAM::Temp current_temperature);
 
@@ -703,7 +824,12 @@ void Controller<TLDRAM>::tick();
 
 template<>
 void Controller<TLDRAM>::cmd_issue_autoprecharge(typename TLDRAM::Command& cmd,
-    const vector<int>& addr_vec);
+    const AddrVec& addr_vec);
+
+#if (IDLE_CYCLE_SKIPPING == ENABLE)
+template<>
+long Controller<DSARP>::idle_ticks();
+#endif // IDLE_CYCLE_SKIPPING
 
 } /*namespace ramulator*/
 
@@ -10,6 +10,7 @@
 #include <type_traits>
 #include <vector>
 
+#include "ProjectConfiguration.h" // User file
 #include "Ramulator/Statistics.h"
 
 using namespace std;
@@ -90,6 +91,20 @@ public:
 
     void finish(long dram_cycles);
 
+#if (USER_CODES == ENABLE)
+    // Save or restore the bank and row states and the command history of this level and all levels below, e.g., for checkpoints
+    template<typename Archive>
+    void checkpoint(Archive& archive)
+    {
+        archive & state & row_state & cur_clk & next & prev;
+        for (auto child : children)
+            child->checkpoint(archive);
+
+        if (! nodes.empty())
+            flatten_ready(); // the root derives its table from the restored timings
+    }
+#endif // USER_CODES
+
 private:
     // Constructor
     DRAM() {}
@@ -120,6 +135,26 @@ private:
     // Helper Functions
     void update_state(typename T::Command cmd, const int* addr);
     void update_timing(typename T::Command cmd, const int* addr, long clk);
+
+#if (USER_CODES == ENABLE)
+    // The root (i.e., the channel) keeps the nodes of the tree in preorder, so that checks and updates don't recurse through the children.
+    // The subtree of nodes[i] is nodes[i] to nodes[ends[i] - 1], and ready[cmd * nodes.size() + i] is the latest next[cmd] of nodes[i] and its
+    // ancestors, so that a check is a single read and delaying a command at a subtree updates a contiguous range.
+    vector<DRAM<T>*> nodes;
+    vector<int> ends;
+    vector<long> ready;
+    int strides[int(T::Level::MAX)] = {}; // The nodes in the subtree of a node at each level, which is the same for all nodes of a level
+    int depth                       = 0;  // The deepest level of the nodes
+
+    void flatten(DRAM<T>* root);
+    void flatten_ready();
+
+    // The index in nodes of the node where the check of a command to an address stops
+    int get_index(typename T::Command cmd, const int* addr) const;
+
+    // Delay a command at nodes[index] and its subtree
+    void delay(int index, typename T::Command cmd, long future);
+#endif // USER_CODES
 }; /* class DRAM */
 
 // register statistics
@@ -224,8 +259,72 @@ DRAM<T>::DRAM(T* spec, typename T::Level level): spec(spec), level(level), id(0)
         child->id      = i;
         children.push_back(child);
     }
+
+#if (USER_CODES == ENABLE)
+    if (level == T::Level::Channel)
+    {
+        flatten(this); // I am the root of the tree
+        ready.resize(nodes.size() * int(T::Command::MAX));
+        flatten_ready();
+    }
+#endif // USER_CODES
+}
+
+#if (USER_CODES == ENABLE)
+template<typename T>
+void DRAM<T>::flatten(DRAM<T>* root)
+{
+    int index = root->nodes.size();
+    root->nodes.push_back(this);
+    root->ends.push_back(0);
+    for (auto child : children)
+        child->flatten(root);
+    root->ends[index] = root->nodes.size();
+
+    // The tree is uniform, so the index of a node follows from its address
+    int size = root->ends[index] - index;
+    assert(root->strides[int(level)] == 0 || root->strides[int(level)] == size);
+    root->strides[int(level)] = size;
+    root->depth               = max(root->depth, int(level));
+}
+
+template<typename T>
+void DRAM<T>::flatten_ready()
+{
+    fill(ready.begin(), ready.end(), -1);
+    for (int cmd = 0; cmd < int(T::Command::MAX); cmd++)
+    {
+        long* row = &ready[cmd * nodes.size()];
+        for (size_t i = 0; i < nodes.size(); i++)
+            for (int j = i; j < ends[i]; j++)
+                row[j] = max(row[j], nodes[i]->next[cmd]);
+    }
+}
+
+template<typename T>
+int DRAM<T>::get_index(typename T::Command cmd, const int* addr) const
+{
+    // Go down as the recursive check would, until the scope of the command, an unspecified level or the deepest level
+    int index = 0;
+    for (int l = int(level); l < int(spec->scope[int(cmd)]) && l < depth && addr[l + 1] >= 0; l++)
+        index += 1 + addr[l + 1] * strides[l + 1];
+    return index;
 }
 
+template<typename T>
+void DRAM<T>::delay(int index, typename T::Command cmd, long future)
+{
+    long& node_next = nodes[index]->next[int(cmd)];
+    if (future <= node_next)
+        return;
+
+    node_next = future;
+    long* row = &ready[int(cmd) * nodes.size()];
+    for (int i = index; i < ends[index]; i++)
+        row[i] = max(row[i], future);
+}
+#endif // USER_CODES
+
 template<typename T>
 DRAM<T>::~DRAM()
 {
@@ -262,6 +361,15 @@ typename T::Command DRAM<T>::decode(typename T::Command cmd, const int* addr)
 }
 
 // Check
+#if (USER_CODES == ENABLE)
+template<typename T>
+bool DRAM<T>::check(typename T::Command cmd, const int* addr, long clk)
+{
+    assert(! nodes.empty()); // only the root checks commands
+    long next_clk = ready[int(cmd) * nodes.size() + get_index(cmd, addr)];
+    return next_clk == -1 || clk >= next_clk;
+}
+#else
 template<typename T>
 bool DRAM<T>::check(typename T::Command cmd, const int* addr, long clk)
 {
@@ -275,6 +383,7 @@ bool DRAM<T>::check(typename T::Command cmd, const int* addr, long clk)
     // recursively check my child
     return children[child_id]->check(cmd, addr, clk);
 }
+#endif // USER_CODES
 
 // SAUGATA: added function to check whether a command is a row hit
 // Check row hits
@@ -310,6 +419,14 @@ bool DRAM<T>::check_row_open(typename T::Command cmd, const int* addr)
     return children[child_id]->check_row_open(cmd, addr);
 }
 
+#if (USER_CODES == ENABLE)
+template<typename T>
+long DRAM<T>::get_next(typename T::Command cmd, const int* addr)
+{
+    assert(! nodes.empty()); // only the root checks commands
+    return max(cur_clk, ready[int(cmd) * nodes.size() + get_index(cmd, addr)]);
+}
+#else
 template<typename T>
 long DRAM<T>::get_next(typename T::Command cmd, const int* addr)
 {
@@ -322,6 +439,7 @@ long DRAM<T>::get_next(typename T::Command cmd, const int* addr)
     }
     return next_clk;
 }
+#endif // USER_CODES
 
 // Update
 template<typename T>
@@ -348,6 +466,68 @@ void DRAM<T>::update_state(typename T::Command cmd, const int* addr)
 }
 
 // Update (Timing)
+#if (USER_CODES == ENABLE)
+template<typename T>
+void DRAM<T>::update_timing(typename T::Command cmd, const int* addr, long clk)
+{
+    assert(! nodes.empty()); // only the root updates the tree
+    // Visit the nodes in the order of the recursion, i.e., the target nodes and all their children
+    for (int i = 0; i < int(nodes.size());)
+    {
+        DRAM<T>* node = nodes[i];
+
+        // The node is not a target node: it is merely one of its siblings
+        if (node->id != addr[int(node->level)])
+        {
+            for (auto& t : node->timing[int(cmd)])
+            {
+                if (! t.sibling)
+                    continue; // not an applicable timing parameter
+
+                assert(t.dist == 1);
+                delay(i, t.cmd, clk + t.val);
+            }
+
+            i = ends[i]; // only target nodes have their children visited
+            continue;
+        }
+
+        // The node is a target node
+        auto& history = node->prev[int(cmd)];
+        if (history.size())
+        {
+            history.pop_back();
+            history.push_front(clk); // update history
+        }
+
+        for (auto& t : node->timing[int(cmd)])
+        {
+            if (t.sibling)
+                continue; // not an applicable timing parameter
+
+            long past = history[t.dist - 1];
+            if (past < 0)
+                continue; // not enough history
+
+            delay(i, t.cmd, past + t.val);
+            // TIANSHI: for refresh statistics
+            if (spec->is_refreshing(cmd) && spec->is_opening(t.cmd))
+            {
+                assert(past == clk);
+                node->begin_of_refreshing = clk;
+                node->end_of_refreshing   = max(node->end_of_refreshing, node->next[int(t.cmd)]);
+                node->refresh_cycles += node->end_of_refreshing - clk;
+                if (node->cur_serving_requests > 0)
+                {
+                    node->refresh_intervals.push_back(make_pair(node->begin_of_refreshing, node->end_of_refreshing));
+                }
+            }
+        }
+
+        i++;
+    }
+}
+#else
 template<typename T>
 void DRAM<T>::update_timing(typename T::Command cmd, const int* addr, long clk)
 {
@@ -409,6 +589,7 @@ void DRAM<T>::update_timing(typename T::Command cmd, const int* addr, long clk)
     for (auto child : children)
         child->update_timing(cmd, addr, clk);
 }
+#endif // USER_CODES
 
 template<typename T>
 void DRAM<T>::update_serving_requests(const int* addr, int delta, long clk)
@@ -7,7 +7,11 @@
 #include "ProjectConfiguration.h" // User file
 
 #if (USER_CODES == ENABLE)
+#include <algorithm>
 #include <array>
+#include <cassert>
+#include <cstdint>
+#include <limits>
 
 #include "ChampSim/champsim_constants.h"
 #include "ChampSim/channel.h"
@@ -16,13 +20,100 @@ using namespace std;
 
 namespace ramulator
 {
+// The address of a request at each level of the memory (e.g., channel, rank, bank, row and column), kept inline instead of on the heap.
+// No standard has more than MAX_LEVELS levels, which each controller checks.
+class AddrVec
+{
+public:
+    static constexpr std::size_t MAX_LEVELS = 8;
+
+    AddrVec() = default;
+    explicit AddrVec(std::size_t size, int value = 0) { resize(size, value); }
+    AddrVec(const int* first, const int* last) : count(last - first)
+    {
+        assert(count <= MAX_LEVELS);
+        std::copy(first, last, values);
+    }
+
+    void resize(std::size_t size, int value = 0)
+    {
+        assert(size <= MAX_LEVELS);
+        std::fill(values + count, values + std::max(size, count), value);
+        count = size;
+    }
+
+    std::size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+
+    int& operator[](std::size_t level) { return values[level]; }
+    const int& operator[](std::size_t level) const { return values[level]; }
+
+    int* data() { return values; }
+    const int* data() const { return values; }
+    int* begin() { return values; }
+    const int* begin() const { return values; }
+    int* end() { return values + count; }
+    const int* end() const { return values + count; }
+
+    bool operator==(const AddrVec& other) const { return std::equal(begin(), end(), other.begin(), other.end()); }
+
+private:
+    int values[MAX_LEVELS] = {};
+    std::size_t count      = 0;
+};
+
+#if (RAMULATOR == ENABLE)
+// ChampSim's packets of the requests in the memories, kept in slots that are reused so that a request carries a handle instead of a copy
+class PacketPool
+{
+public:
+    using packet_type                 = DRAM_CHANNEL::request_type;
+    using handle_type                 = uint32_t;
+    static constexpr handle_type NONE = std::numeric_limits<handle_type>::max();
+
+    // Copy the packet into a free slot. The copy reuses the storage of the packets the slot held before.
+    handle_type acquire(const packet_type& packet)
+    {
+        if (free.empty())
+        {
+            slots.push_back(packet);
+            return handle_type(slots.size() - 1);
+        }
+
+        handle_type handle = free.back();
+        free.pop_back();
+        slots[handle] = packet;
+        return handle;
+    }
+
+    void release(handle_type handle)
+    {
+        assert(handle < slots.size());
+        free.push_back(handle);
+    }
+
+    packet_type& operator[](handle_type handle)
+    {
+        assert(handle < slots.size());
+        return slots[handle];
+    }
+
+    // The packets in the memories
+    std::size_t size() const { return slots.size() - free.size(); }
+
+private:
+    std::vector<packet_type> slots;
+    std::vector<handle_type> free;
+};
+#endif // RAMULATOR
+
 class Request
 {
 public:
     bool is_first_command;
     long addr;
     // long addr_row;
-    vector<int> addr_vec;
+    AddrVec addr_vec;
     // specify which core this request sent from, for virtual address translation
     int coreid;
 
@@ -42,13 +133,23 @@ public:
     function<void(Request&)> callback; // call back with more info
 
 #if (RAMULATOR == ENABLE)
-    // ChampSim's memory controller's packet
-    DRAM_CHANNEL::request_type packet;
+    // ChampSim's memory controller's packet in its PacketPool, for the requests whose data is returned
+    PacketPool::handle_type packet = PacketPool::NONE;
 #endif // RAMULATOR
 
     std::array<uint8_t, BLOCK_SIZE> data = {0}; // a cache line
     uint8_t memory_id                    = NUMBER_OF_MEMORIES;
 
+    // What the scheduler derived from the state of the channel for this request, kept until the controller issues another command
+    struct Schedule
+    {
+        long version   = -1;    // The number of commands the controller had issued when it was derived
+        long ready_clk = 0;     // The earliest clock when the first command of this request can be issued
+        int hits       = 0;     // The hits to the row of this request if it is open
+        bool row_hit   = false; // Whether the row of this request is open
+        bool row_open  = false; // Whether a row of its bank (or subarray) is open
+    } schedule;
+
     /* Member functions */
     Request(long addr, Type type, int coreid = 0)
     : is_first_command(true), addr(addr), coreid(coreid), type(type),
@@ -57,25 +158,25 @@ public:
     }
 
     Request(long addr, Type type, function<void(Request&)> callback, int coreid = 0)
-    : is_first_command(true), addr(addr), coreid(coreid), type(type), callback(callback)
+    : is_first_command(true), addr(addr), coreid(coreid), type(type), callback(std::move(callback))
     {
     }
 
     Request(long addr, Type type, function<void(Request&)> callback, int coreid, uint8_t memory_id)
-    : is_first_command(true), addr(addr), coreid(coreid), type(type), callback(callback), memory_id(memory_id)
+    : is_first_command(true), addr(addr), coreid(coreid), type(type), callback(std::move(callback)), memory_id(memory_id)
     {
     }
 
 #if (RAMULATOR == ENABLE)
     // This instructor is used for ChampSim's memory controller
-    Request(long addr, Type type, function<void(Request&)> callback, DRAM_CHANNEL::request_type packet, int coreid, uint8_t memory_id)
-    : is_first_command(true), addr(addr), coreid(coreid), type(type), callback(callback), packet(packet), memory_id(memory_id)
+    Request(long addr, Type type, function<void(Request&)> callback, PacketPool::handle_type packet, int coreid, uint8_t memory_id)
+    : is_first_command(true), addr(addr), coreid(coreid), type(type), callback(std::move(callback)), packet(packet), memory_id(memory_id)
     {
     }
 #endif // RAMULATOR
 
-    Request(vector<int>& addr_vec, Type type, function<void(Request&)> callback, int coreid = 0)
-    : is_first_command(true), addr_vec(addr_vec), coreid(coreid), type(type), callback(callback)
+    Request(const AddrVec& addr_vec, Type type, function<void(Request&)> callback, int coreid = 0)
+    : is_first_command(true), addr_vec(addr_vec), coreid(coreid), type(type), callback(std::move(callback))
     {
     }
 
@@ -84,6 +185,50 @@ public:
     {
     }
 };
+
+// The reads completed by the controllers of a memory without a callback, kept in a ring until the user of the memory drains them in a batch
+class CompletionQueue
+{
+public:
+    bool empty() const { return count == 0; }
+    std::size_t size() const { return count; }
+
+    void push_back(Request&& req)
+    {
+        if (count == slots.size())
+            grow();
+        slots[(head + count) & (slots.size() - 1)] = std::move(req);
+        count++;
+    }
+
+    Request& front()
+    {
+        assert(count > 0);
+        return slots[head];
+    }
+
+    // The slot keeps the request, whose storage the next push_back reuses
+    void pop_front()
+    {
+        assert(count > 0);
+        head = (head + 1) & (slots.size() - 1);
+        count--;
+    }
+
+private:
+    std::vector<Request> slots; // A power of two of slots
+    std::size_t head  = 0;
+    std::size_t count = 0;
+
+    void grow()
+    {
+        std::vector<Request> larger(std::max<std::size_t>(16, 2 * slots.size()));
+        for (std::size_t i = 0; i < count; i++)
+            larger[i] = std::move(slots[(head + i) & (slots.size() - 1)]);
+        slots.swap(larger);
+        head = 0;
+    }
+};
 } /*namespace ramulator*/
 
 #else
@@ -93,6 +238,8 @@ using namespace std;
 
 namespace ramulator
 {
+using AddrVec = vector<int>;
+
 class Request
 {
 public:
@@ -56,6 +56,10 @@ Current Row Policies:
 #include "Ramulator/DRAM.h"
 #include "Ramulator/Request.h"
 
+#if (USER_CODES == ENABLE)
+#include "ChampSim/profiler.h"
+#endif
+
 using namespace std;
 
 namespace ramulator
@@ -83,6 +87,112 @@ public:
 
     Scheduler(Controller<T>* ctrl): ctrl(ctrl) {}
 
+#if (USER_CODES == ENABLE)
+    list<Request>::iterator get_head(list<Request>& q)
+    {
+        static auto& profiled = champsim::profiler::get("ramulator::Scheduler<" + ctrl->channel->spec->standard_name + ">::get_head");
+        champsim::profiler::scope profile {profiled};
+
+        // Each request is looked at once per call, and what it needs from the channel is cached until the next command is issued
+        auto all   = [](ReqIter req)
+        { return true; };
+        auto ready = [this](ReqIter req)
+        { return look_up(req).ready_clk <= this->ctrl->clk; };
+
+        switch (type)
+        {
+        case Type::FCFS:
+            return get_oldest(q, all, [](ReqIter req) { return false; });
+
+        case Type::FRFCFS:
+            return get_oldest(q, all, ready);
+
+        case Type::FRFCFS_Cap:
+            return get_oldest(q, all, [&](ReqIter req) { return ready(req) && look_up(req).hits <= this->cap; });
+
+        case Type::FRFCFS_PriorHit:
+        {
+            auto head = get_oldest(q, all, [&](ReqIter req) { return ready(req) && look_up(req).row_hit; });
+            if (head == q.end() || (ready(head) && look_up(head).row_hit))
+                return head;
+
+            // Mark the banks (or subarrays) with row hits, whose rows must not be closed by the requests missing them
+            // TODO Here it assumes all DRAM standards use PRE to close a row
+            // It's better to make it more general.
+            int scope = int(ctrl->channel->spec->scope[int(T::Command::PRE)]);
+            if (hit_rowgroups.empty())
+                hit_rowgroups.resize(ctrl->rowtable->table.size(), 0);
+
+            hit_marks++;
+            for (auto itr = q.begin(); itr != q.end(); ++itr)
+            {
+                if (look_up(itr).row_hit)
+                    hit_rowgroups[ctrl->rowtable->get_index(itr->addr_vec, scope)] = hit_marks;
+            }
+
+            // If no request can be scheduled without violating a hit, q.end() is returned so that no command will be scheduled
+            auto keeps_hits = [&](ReqIter req)
+            {
+                auto& schedule = look_up(req);
+                return schedule.row_hit || ! schedule.row_open || hit_rowgroups[ctrl->rowtable->get_index(req->addr_vec, scope)] != hit_marks;
+            };
+            return get_oldest(q, keeps_hits, ready);
+        }
+
+        default:
+            assert(false && "Unimplemented scheduling policy.");
+            return q.end();
+        }
+    }
+
+private:
+    typedef list<Request>::iterator ReqIter;
+
+    // The last get_head call of FRFCFS_PriorHit that found a row hit in each bank (or subarray), indexed like the row table
+    vector<long> hit_rowgroups;
+    long hit_marks = 0;
+
+    // The oldest of the eligible requests that come first, or of all the eligible requests if none comes first. Ties go to the earliest in the
+    // queue, as when the requests are compared in pairs.
+    template<typename Eligible, typename First>
+    ReqIter get_oldest(list<Request>& q, Eligible eligible, First first)
+    {
+        auto head       = q.end();
+        bool head_first = false;
+        for (auto itr = q.begin(); itr != q.end(); ++itr)
+        {
+            if (! eligible(itr))
+                continue;
+
+            bool itr_first = first(itr);
+            if (head == q.end() || (itr_first && ! head_first) || (itr_first == head_first && itr->arrive < head->arrive))
+            {
+                head       = itr;
+                head_first = itr_first;
+            }
+        }
+        return head;
+    }
+
+    // What the scheduling policy needs from the channel for a request, derived again only after the controller has issued a command
+    Request::Schedule& look_up(ReqIter req)
+    {
+        auto& schedule = req->schedule;
+        if (schedule.version == ctrl->issued_commands)
+            return schedule;
+
+        schedule.version   = ctrl->issued_commands;
+        schedule.ready_clk = ctrl->get_ready_clk(req);
+        if (type == Type::FRFCFS_Cap)
+            schedule.hits = ctrl->rowtable->get_hits(req->addr_vec);
+        if (type == Type::FRFCFS_PriorHit)
+        {
+            schedule.row_hit  = ctrl->is_row_hit(req);
+            schedule.row_open = ctrl->is_row_open(req);
+        }
+        return schedule;
+    }
+#else
     list<Request>::iterator get_head(list<Request>& q)
     {
         // TODO make the decision at compile time
@@ -227,6 +337,7 @@ private:
 
             if (req1->arrive <= req2->arrive) return req1;
             return req2; }};
+#endif // USER_CODES
 };
 
 // Row Precharge Policy
@@ -249,6 +360,45 @@ public:
 
     RowPolicy(Controller<T>* ctrl): ctrl(ctrl) {}
 
+#if (USER_CODES == ENABLE)
+    AddrVec get_victim(typename T::Command cmd)
+    {
+        switch (type)
+        {
+        case Type::Closed:
+        case Type::ClosedAP:
+            return get_ready_rowgroup(cmd, 0);
+
+        case Type::Timeout:
+            return get_ready_rowgroup(cmd, timeout);
+
+        default:
+            return AddrVec();
+        }
+    }
+
+private:
+    // The first bank (or subarray) in the order of the addresses whose row has not been accessed for min_idle cycles and can be closed now
+    AddrVec get_ready_rowgroup(typename T::Command cmd, long min_idle)
+    {
+        auto rowtable = ctrl->rowtable;
+        int seen      = 0;
+        for (int i = 0; seen < rowtable->open_rows; i++)
+        {
+            auto& entry = rowtable->table[i];
+            if (entry.row < 0)
+                continue;
+
+            seen++;
+            if (ctrl->clk - entry.timestamp < min_idle)
+                continue;
+            if (! ctrl->is_ready(cmd, rowtable->get_rowgroup(i)))
+                continue;
+            return rowtable->get_rowgroup(i);
+        }
+        return AddrVec();
+    }
+#else
     vector<int> get_victim(typename T::Command cmd)
     {
         return policy[int(type)](cmd);
@@ -292,8 +442,149 @@ private:
                 return kv.first;
             }
             return vector<int>(); }};
+#endif // USER_CODES
 };
 
+#if (USER_CODES == ENABLE)
+template<typename T>
+class RowTable
+{
+public:
+    Controller<T>* ctrl;
+
+    struct Entry
+    {
+        int row        = -1; // -1 if no row is open
+        int hits       = 0;
+        long timestamp = 0;
+    };
+
+    // The open row of each bank (or subarray) of the channel, in the order of their addresses
+    vector<Entry> table;
+    int open_rows = 0;
+
+    RowTable(Controller<T>* ctrl): ctrl(ctrl)
+    {
+        auto& count = ctrl->channel->spec->org_entry.count;
+
+        // entries per index at each level above the rows, e.g., the banks of a rank
+        strides[int(T::Level::Row) - 1] = 1;
+        for (int l = int(T::Level::Row) - 1; l > 0; l--)
+        {
+            assert(count[l] > 0);
+            strides[l - 1] = strides[l] * count[l];
+        }
+
+        table.resize(strides[0]);
+        rowgroups.resize(strides[0], AddrVec(int(T::Level::Row)));
+        for (int i = 0; i < strides[0]; i++)
+        {
+            rowgroups[i][0] = ctrl->channel->id;
+            for (int l = 1; l < int(T::Level::Row); l++)
+                rowgroups[i][l] = i / strides[l] % count[l];
+        }
+    }
+
+    void update(typename T::Command cmd, const AddrVec& addr_vec, long clk)
+    {
+        T* spec = ctrl->channel->spec;
+
+        if (spec->is_opening(cmd))
+        {
+            auto& entry = table[get_index(addr_vec, int(T::Level::Row) - 1)];
+            if (entry.row < 0)
+            {
+                entry = {addr_vec[int(T::Level::Row)], 0, clk};
+                open_rows++;
+            }
+        }
+
+        if (spec->is_accessing(cmd))
+        {
+            // we are accessing a row -- update its entry
+            auto& entry = table[get_index(addr_vec, int(T::Level::Row) - 1)];
+            assert(entry.row >= 0);
+            assert(entry.row == addr_vec[int(T::Level::Row)]);
+            entry.hits++;
+            entry.timestamp = clk;
+        } /* accessing */
+
+        if (spec->is_closing(cmd))
+        {
+            // we are closing one or more rows -- remove their entries, which are next to each other
+            int n_rm = 0;
+            int scope;
+            if (spec->is_accessing(cmd))
+                scope = int(T::Level::Row) - 1; //special condition for RDA and WRA
+            else
+                scope = int(spec->scope[int(cmd)]);
+
+            int first = get_index(addr_vec, scope);
+            for (int i = first; i < first + strides[scope]; i++)
+            {
+                if (table[i].row >= 0)
+                {
+                    n_rm++;
+                    table[i].row = -1;
+                }
+            }
+
+            open_rows -= n_rm;
+            assert(n_rm > 0);
+        } /* closing */
+    }
+
+    int get_hits(const AddrVec& addr_vec, const bool to_opened_row = false)
+    {
+        int index = get_index(addr_vec, int(T::Level::Row) - 1);
+        if (index < 0 || table[index].row < 0)
+            return 0;
+
+        if (! to_opened_row && (table[index].row != addr_vec[int(T::Level::Row)]))
+            return 0;
+
+        return table[index].hits;
+    }
+
+    int get_open_row(const AddrVec& addr_vec)
+    {
+        int index = get_index(addr_vec, int(T::Level::Row) - 1);
+        if (index < 0)
+            return -1;
+
+        return table[index].row;
+    }
+
+    // The first entry of the banks (or subarrays) under the address down to the level, or -1 if the address doesn't go down to it
+    int get_index(const AddrVec& addr_vec, int level)
+    {
+        int index = 0;
+        for (int l = 1; l <= level; l++)
+        {
+            if (addr_vec[l] < 0)
+                return -1;
+            index += addr_vec[l] * strides[l];
+        }
+        return index;
+    }
+
+    // The address of the bank (or subarray) of an entry
+    const AddrVec& get_rowgroup(int index)
+    {
+        return rowgroups[index];
+    }
+
+    template<typename Archive>
+    void checkpoint(Archive& archive)
+    {
+        archive & table & open_rows;
+    }
+
+private:
+    int strides[int(T::Level::Row)];
+    vector<AddrVec> rowgroups;
+};
+#else
 template<typename T>
 class RowTable
 {
@@ -393,6 +684,8 @@ public:
     }
 };
 
+#endif // USER_CODES
+
 } /*namespace ramulator*/
 
 #endif /*__SCHEDULER_H*/
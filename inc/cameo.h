@@ -8,10 +8,12 @@
 #include <vector>
 
 #include "ChampSim/champsim_constants.h"
+#include "ChampSim/checkpoint.h"
 #include "ChampSim/channel.h"
 #include "ChampSim/util/bits.h"
 #include "ProjectConfiguration.h" // User file
 #include "Ramulator/Request.h"
+#include "os_transparent_management.h"
 
 /** @note Abbreviation:
  *  FM -> Fast memory (e.g., HBM, DDR4)
@@ -20,30 +22,30 @@
 
 #if (MEMORY_USE_OS_TRANSPARENT_MANAGEMENT == ENABLE)
 
-#if (IDEAL_LINE_LOCATION_TABLE == ENABLE) || (COLOCATED_LINE_LOCATION_TABLE == ENABLE)
-#define COUNTER_WIDTH                         uint8_t
-#define COUNTER_MAX_VALUE                     (UINT8_MAX)
-#define COUNTER_DEFAULT_VALUE                 (0)
+#define DATA_MANAGEMENT_GRANULARITY        (DATA_GRANULARITY_64B)                       // Default: DATA_GRANULARITY_64B
+#define DATA_MANAGEMENT_OFFSET_BITS        (champsim::lg2(DATA_MANAGEMENT_GRANULARITY)) // Data management granularity means how the hardware cluster the data
+#define DATA_GRANULARITY_IN_CACHE_LINE     (DATA_MANAGEMENT_GRANULARITY / DATA_GRANULARITY_64B)
 
-#define HOTNESS_WIDTH                         bool
-#define HOTNESS_DEFAULT_VALUE                 (false)
+#define COUNTER_WIDTH                      uint8_t
+#define COUNTER_MAX_VALUE                  (UINT8_MAX)
+#define COUNTER_DEFAULT_VALUE              (0)
 
-#define REMAPPING_LOCATION_WIDTH              uint8_t
-#define REMAPPING_LOCATION_WIDTH_BITS         (3) // Default: 3
-#define LOCATION_TABLE_ENTRY_WIDTH            uint16_t
+#define HOTNESS_WIDTH                      bool
+#define HOTNESS_DEFAULT_VALUE              (false)
 
-#define NUMBER_OF_BLOCK                       (5) // Default: 5
+#define REMAPPING_LOCATION_WIDTH           uint8_t
+#define REMAPPING_LOCATION_WIDTH_BITS      (3) // Default: 3
+#define LOCATION_TABLE_ENTRY_WIDTH         uint16_t
+
+#define NUMBER_OF_BLOCK                    (5) // Default: 5
 
 // 0x0538 for the congruence group with 5 members (lines) at most, (000_001_010_011_100_0 = 0x0538)
 // [15:13] bit for member 0, [12:10] bit for member 1, [9:7] bit for member 2, [6:4] bit for member 3, [3:1] bit for member 4.
-#define LOCATION_TABLE_ENTRY_DEFAULT_VALUE    (0x0538)
-#define LOCATION_TABLE_ENTRY_MSB              (UINT16_WIDTH - 1) // MSB -> most significant bit
-
-#define REMAPPING_REQUEST_QUEUE_LENGTH        (64) // 1024/4096
-#define QUEUE_BUSY_DEGREE_THRESHOLD           (0.8f)
+#define LOCATION_TABLE_ENTRY_DEFAULT_VALUE (0x0538)
+#define LOCATION_TABLE_ENTRY_MSB           (UINT16_WIDTH - 1) // MSB -> most significant bit
 
-#define INCOMPLETE_READ_REQUEST_QUEUE_LENGTH  (128)
-#define INCOMPLETE_WRITE_REQUEST_QUEUE_LENGTH (128)
+#define REMAPPING_REQUEST_QUEUE_LENGTH     (64) // 1024/4096
+#define QUEUE_BUSY_DEGREE_THRESHOLD        (0.8f)
 
 #if (BITS_MANIPULATION == DISABLE)
 #undef REMAPPING_LOCATION_WIDTH_BITS
@@ -52,13 +54,14 @@
 #define NUMBER_OF_BLOCK               (35)
 #endif // BITS_MANIPULATION
 
-class OS_TRANSPARENT_MANAGEMENT
+/** @brief
+ *  IDEAL_LINE_LOCATION_TABLE and COLOCATED_LINE_LOCATION_TABLE, which only differ in whether the memory controller reads the
+ *  Location Entry and Data (LEAD) in fast memory before accessing the data.
+ */
+class CAMEO : public OS_TRANSPARENT_MANAGEMENT
 {
-    using channel_type = champsim::channel;
-    using request_type = typename channel_type::request_type;
-
 public:
-    uint64_t cycle                  = 0;
+    bool colocated_line_location_table;
     COUNTER_WIDTH hotness_threshold = 0;
     uint64_t total_capacity;       // Uint is byte
     uint64_t fast_memory_capacity; // Uint is byte
@@ -69,17 +72,6 @@ public:
     std::vector<COUNTER_WIDTH>& counter_table; // A counter for every data block
     std::vector<HOTNESS_WIDTH>& hotness_table; // A hotness bit for every data block, true -> data block is hot, false -> data block is cold.
 
-    /* Remapping request */
-    struct RemappingRequest
-    {
-        uint64_t address_in_fm, address_in_sm; // Hardware address in fast and slow memories
-        REMAPPING_LOCATION_WIDTH fm_location, sm_location;
-        uint8_t size; // Number of cache lines to remap
-    };
-
-    std::deque<RemappingRequest> remapping_request_queue;
-    uint64_t remapping_request_queue_congestion;
-
     // Scoped enumerations
     enum class RemappingLocation : REMAPPING_LOCATION_WIDTH
     {
@@ -113,60 +105,29 @@ public:
     std::vector<LocationTableEntry>& line_location_table; // Paper CAMEO: SRAM-Based LLT / Embed LLT in Stacked DRAM
 #endif // BITS_MANIPULATION
 
-#if (COLOCATED_LINE_LOCATION_TABLE == ENABLE)
-    /** @brief
-     *  If a memory read request is mapped in slow memory, the memory controller needs first access the fast memory
-     *  to get the Location Entry and Data (LEAD), and then access the slow memory based on that LEAD.
-     */
-    struct ReadRequest
-    {
-        request_type packet;
-        bool fm_access_finish = false; // Whether the access in fast memory is completed.
-    };
-
-    std::vector<ReadRequest> incomplete_read_request_queue;
-
-    /** @brief
-     *  If a memory write request is received, the memory controller needs first to figure out where is the right
-     *  place to write. So, the memory controller first access the fast memory to get the Location Entry and Data (LEAD),
-     *  and then write the memory (fast or slow memory).
-     */
-    struct WriteRequest
-    {
-        request_type packet;
-        bool fm_access_finish = false; // Whether the access in fast memory is completed.
-    };
-
-    std::vector<WriteRequest> incomplete_write_request_queue;
-#endif // COLOCATED_LINE_LOCATION_TABLE
-
     /* Member functions */
-    OS_TRANSPARENT_MANAGEMENT(uint64_t max_address, uint64_t fast_memory_max_address);
-    ~OS_TRANSPARENT_MANAGEMENT();
+    CAMEO(uint64_t max_address, uint64_t fast_memory_max_address, bool colocated_line_location_table);
+    ~CAMEO();
 
-    // Address is physical address and at byte granularity
 #if (TRACKING_LOAD_STORE_STATISTICS == ENABLE)
     // Address is physical address and at byte granularity
-    bool memory_activity_tracking(uint64_t address, ramulator::Request::Type type, access_type type_origin, float queue_busy_degree);
+    bool memory_activity_tracking(uint64_t address, ramulator::Request::Type type, access_type type_origin, float queue_busy_degree) override;
 #else
     // Address is physical address and at byte granularity
-    bool memory_activity_tracking(uint64_t address, ramulator::Request::Type type, float queue_busy_degree);
+    bool memory_activity_tracking(uint64_t address, ramulator::Request::Type type, float queue_busy_degree) override;
 #endif // TRACKING_LOAD_STORE_STATISTICS
 
     // Translate the physical address to hardware address
-    void physical_to_hardware_address(request_type& packet);
-    void physical_to_hardware_address(uint64_t& address);
+    void physical_to_hardware_address(request_type& packet) override;
+    void physical_to_hardware_address(uint64_t& address) override;
 
-    bool issue_remapping_request(RemappingRequest& remapping_request);
-    bool finish_remapping_request();
+    bool finish_remapping_request() override;
 
     // Detect cold data block
-    void cold_data_detection();
+    void cold_data_detection() override;
 
-#if (COLOCATED_LINE_LOCATION_TABLE == ENABLE)
-    bool finish_fm_access_in_incomplete_read_request_queue(uint64_t h_address);
-    bool finish_fm_access_in_incomplete_write_request_queue(uint64_t h_address);
-#endif // COLOCATED_LINE_LOCATION_TABLE
+    // Save or restore the counters and the remapping tables, e.g., for checkpoints
+    void checkpoint(champsim::checkpoint_archive& archive) override;
 
 private:
     // Evict cold data block
@@ -176,7 +137,5 @@ private:
     bool enqueue_remapping_request(RemappingRequest& remapping_request);
 };
 
-#endif // IDEAL_LINE_LOCATION_TABLE, COLOCATED_LINE_LOCATION_TABLE
-
 #endif // MEMORY_USE_OS_TRANSPARENT_MANAGEMENT
 #endif // CAMEO_H
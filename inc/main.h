@@ -17,19 +17,26 @@
 #include "ChampSim/defaults.hpp"
 #include "ChampSim/dram_controller.h"
 #include "ChampSim/environment.h"
+#include "ChampSim/inf_stream.h"
+#include "ChampSim/memory_replay.h"
 #include "ChampSim/phase_info.h"
+#include "ChampSim/profiler.h"
+#include "ChampSim/simpoint.h"
 #include "ChampSim/stats_printer.h"
+#include "ChampSim/trace_cache.h"
 #include "ChampSim/tracereader.h"
 #include "ChampSim/vmem.h"
 
 // Includes for Ramulator
 #include <stdlib.h>
 
+#include <cinttypes>
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
 #include <functional>
 #include <map>
+#include <memory>
 
 #include "Ramulator/Config.h"
 #include "Ramulator/Controller.h"
@@ -72,7 +79,6 @@
 
 namespace champsim::configured
 {
-template<typename MEMORY_TYPE, typename MEMORY_TYPE2>
 class generated_environment final : public champsim::environment
 {
 public:
@@ -89,9 +95,23 @@ public:
     champsim::channel cpu0_L1I_to_cpu0_ITLB_queues {16, 16, 16, LOG2_PAGE_SIZE, 1};
     champsim::channel cpu0_L1D_to_cpu0_DTLB_queues {16, 16, 16, LOG2_PAGE_SIZE, 1};
     champsim::channel cpu0_L2C_to_LLC_queues {32, 32, 32, LOG2_BLOCK_SIZE, 0};
+#if (CPU_USE_MULTIPLE_CORES == ENABLE)
+    champsim::channel cpu1_STLB_to_cpu1_PTW_queues {32, 0, 0, LOG2_PAGE_SIZE, 0};
+    champsim::channel cpu1_DTLB_to_cpu1_STLB_queues {32, 32, 32, LOG2_PAGE_SIZE, 0};
+    champsim::channel cpu1_ITLB_to_cpu1_STLB_queues {32, 32, 32, LOG2_PAGE_SIZE, 0};
+    champsim::channel cpu1_L2C_to_cpu1_STLB_queues {32, 32, 32, LOG2_PAGE_SIZE, 0};
+    champsim::channel cpu1_L1D_to_cpu1_L2C_queues {32, 32, 32, LOG2_BLOCK_SIZE, 0};
+    champsim::channel cpu1_L1I_to_cpu1_L2C_queues {32, 32, 32, LOG2_BLOCK_SIZE, 0};
+    champsim::channel cpu1_to_cpu1_L1I_queues {32, 32, 32, LOG2_BLOCK_SIZE, 1};
+    champsim::channel cpu1_PTW_to_cpu1_L1D_queues {32, 32, 32, LOG2_BLOCK_SIZE, 1};
+    champsim::channel cpu1_to_cpu1_L1D_queues {32, 32, 32, LOG2_BLOCK_SIZE, 1};
+    champsim::channel cpu1_L1I_to_cpu1_ITLB_queues {16, 16, 16, LOG2_PAGE_SIZE, 1};
+    champsim::channel cpu1_L1D_to_cpu1_DTLB_queues {16, 16, 16, LOG2_PAGE_SIZE, 1};
+    champsim::channel cpu1_L2C_to_LLC_queues {32, 32, 32, LOG2_BLOCK_SIZE, 0};
+#endif // CPU_USE_MULTIPLE_CORES
 
     // Memory controller
-    MEMORY_CONTROLLER<MEMORY_TYPE, MEMORY_TYPE2> memory_controller;
+    MEMORY_CONTROLLER memory_controller;
 
     // Virtual memory
     VirtualMemory vmem;
@@ -103,10 +123,23 @@ public:
                                   .upper_levels({&cpu0_STLB_to_cpu0_PTW_queues})
                                   .lower_level(&cpu0_PTW_to_cpu0_L1D_queues)};
 
+#if (CPU_USE_MULTIPLE_CORES == ENABLE)
+    PageTableWalker cpu1_PTW {PageTableWalker::Builder {champsim::defaults::default_ptw}
+                                  .name("cpu1_PTW")
+                                  .cpu(CPU_1)
+                                  .virtual_memory(&vmem)
+                                  .upper_levels({&cpu1_STLB_to_cpu1_PTW_queues})
+                                  .lower_level(&cpu1_PTW_to_cpu1_L1D_queues)};
+#endif // CPU_USE_MULTIPLE_CORES
+
     CACHE LLC {CACHE::Builder {champsim::defaults::default_llc}
                    .name("LLC")
                    .frequency(CACHE_CLOCK_SCALE)
+#if (CPU_USE_MULTIPLE_CORES == ENABLE)
+                   .upper_levels({{&cpu0_L2C_to_LLC_queues, &cpu1_L2C_to_LLC_queues}})
+#else
                    .upper_levels({&cpu0_L2C_to_LLC_queues})
+#endif // CPU_USE_MULTIPLE_CORES
                    .lower_level(&LLC_to_MEMORY_CONTROLLER_queues)};
 
     CACHE cpu0_DTLB {CACHE::Builder {champsim::defaults::default_dtlb}
@@ -157,6 +190,56 @@ public:
             .lower_level(&cpu0_STLB_to_cpu0_PTW_queues)
     };
 
+#if (CPU_USE_MULTIPLE_CORES == ENABLE)
+    CACHE cpu1_DTLB {CACHE::Builder {champsim::defaults::default_dtlb}
+                         .name("cpu1_DTLB")
+                         .frequency(CACHE_CLOCK_SCALE)
+                         .upper_levels({&cpu1_L1D_to_cpu1_DTLB_queues})
+                         .lower_level(&cpu1_DTLB_to_cpu1_STLB_queues)};
+
+    CACHE cpu1_ITLB {CACHE::Builder {champsim::defaults::default_itlb}
+                         .name("cpu1_ITLB")
+                         .frequency(CACHE_CLOCK_SCALE)
+                         .upper_levels({&cpu1_L1I_to_cpu1_ITLB_queues})
+                         .lower_level(&cpu1_ITLB_to_cpu1_STLB_queues)};
+
+    CACHE cpu1_L1D {
+        CACHE::Builder {                         champsim::defaults::default_l1d}
+            .name("cpu1_L1D")
+            .frequency(CACHE_CLOCK_SCALE)
+            .upper_levels({{&cpu1_PTW_to_cpu1_L1D_queues, &cpu1_to_cpu1_L1D_queues}}
+         )
+            .lower_level(&cpu1_L1D_to_cpu1_L2C_queues)
+            .lower_translate(&cpu1_L1D_to_cpu1_DTLB_queues)
+    };
+
+    CACHE cpu1_L1I {CACHE::Builder {champsim::defaults::default_l1i}
+                        .name("cpu1_L1I")
+                        .frequency(CACHE_CLOCK_SCALE)
+                        .upper_levels({&cpu1_to_cpu1_L1I_queues})
+                        .lower_level(&cpu1_L1I_to_cpu1_L2C_queues)
+                        .lower_translate(&cpu1_L1I_to_cpu1_ITLB_queues)};
+
+    CACHE cpu1_L2C {
+        CACHE::Builder {                             champsim::defaults::default_l2c}
+            .name("cpu1_L2C")
+            .frequency(CACHE_CLOCK_SCALE)
+            .upper_levels({{&cpu1_L1D_to_cpu1_L2C_queues, &cpu1_L1I_to_cpu1_L2C_queues}}
+         )
+            .lower_level(&cpu1_L2C_to_LLC_queues)
+            .lower_translate(&cpu1_L2C_to_cpu1_STLB_queues)
+    };
+
+    CACHE cpu1_STLB {
+        CACHE::Builder {                                                               champsim::defaults::default_stlb}
+            .name("cpu1_STLB")
+            .frequency(CACHE_CLOCK_SCALE)
+            .upper_levels({{&cpu1_DTLB_to_cpu1_STLB_queues, &cpu1_ITLB_to_cpu1_STLB_queues, &cpu1_L2C_to_cpu1_STLB_queues}}
+         )
+            .lower_level(&cpu1_STLB_to_cpu1_PTW_queues)
+    };
+#endif // CPU_USE_MULTIPLE_CORES
+
     // CPU 0
     O3_CPU cpu0 {O3_CPU::Builder {champsim::defaults::default_core}
                      .index(CPU_0)
@@ -169,8 +252,22 @@ public:
                      .fetch_queues(&cpu0_to_cpu0_L1I_queues)
                      .data_queues(&cpu0_to_cpu0_L1D_queues)};
 
-    generated_environment(ramulator::Memory<MEMORY_TYPE, ramulator::Controller>& memory, ramulator::Memory<MEMORY_TYPE2, ramulator::Controller>& memory2)
-    : memory_controller(MEMORY_CONTROLLER_CLOCK_SCALE, CPU_FREQUENCY / memory.spec->speed_entry.freq, CPU_FREQUENCY / memory2.spec->speed_entry.freq, {&LLC_to_MEMORY_CONTROLLER_queues}, memory, memory2),
+#if (CPU_USE_MULTIPLE_CORES == ENABLE)
+    // CPU 1
+    O3_CPU cpu1 {O3_CPU::Builder {champsim::defaults::default_core}
+                     .index(CPU_1)
+                     .frequency(O3_CPU_CLOCK_SCALE)
+                     .l1i(&cpu1_L1I)
+                     .l1i_bandwidth(cpu1_L1I.MAX_TAG)
+                     .l1d_bandwidth(cpu1_L1D.MAX_TAG)
+                     .branch_predictor<BRANCH_PREDICTOR>()
+                     .btb<BRANCH_TARGET_BUFFER>()
+                     .fetch_queues(&cpu1_to_cpu1_L1I_queues)
+                     .data_queues(&cpu1_to_cpu1_L1D_queues)};
+#endif // CPU_USE_MULTIPLE_CORES
+
+    generated_environment(ramulator::MemoryBase& memory, ramulator::MemoryBase& memory2)
+    : memory_controller(MEMORY_CONTROLLER_CLOCK_SCALE, CPU_FREQUENCY / memory.clk_mhz(), CPU_FREQUENCY / memory2.clk_mhz(), {&LLC_to_MEMORY_CONTROLLER_queues}, memory, memory2),
       vmem(4096, PAGE_TABLE_LEVELS, MINOR_FAULT_PENALTY, memory.max_address + memory2.max_address)
     {
     }
@@ -181,23 +278,54 @@ public:
 
     std::vector<std::reference_wrapper<O3_CPU>> cpu_view() override
     {
+#if (CPU_USE_MULTIPLE_CORES == ENABLE)
+        return {std::ref(cpu0), std::ref(cpu1)};
+#else
         return {std::ref(cpu0)};
+#endif // CPU_USE_MULTIPLE_CORES
     }
 
     std::vector<std::reference_wrapper<CACHE>> cache_view() override
     {
+#if (CPU_USE_MULTIPLE_CORES == ENABLE)
+        return {LLC, cpu0_DTLB, cpu0_ITLB, cpu0_L1D, cpu0_L1I, cpu0_L2C, cpu0_STLB, cpu1_DTLB, cpu1_ITLB, cpu1_L1D, cpu1_L1I, cpu1_L2C, cpu1_STLB};
+#else
         return {LLC, cpu0_DTLB, cpu0_ITLB, cpu0_L1D, cpu0_L1I, cpu0_L2C, cpu0_STLB};
+#endif // CPU_USE_MULTIPLE_CORES
     }
 
     std::vector<std::reference_wrapper<PageTableWalker>> ptw_view() override
     {
+#if (CPU_USE_MULTIPLE_CORES == ENABLE)
+        return {cpu0_PTW, cpu1_PTW};
+#else
         return {cpu0_PTW};
+#endif // CPU_USE_MULTIPLE_CORES
     }
 
     std::vector<std::reference_wrapper<champsim::operable>> operable_view() override
     {
+#if (CPU_USE_MULTIPLE_CORES == ENABLE)
+        return {cpu0, cpu0_PTW, LLC, cpu0_DTLB, cpu0_ITLB, cpu0_L1D, cpu0_L1I, cpu0_L2C, cpu0_STLB, cpu1, cpu1_PTW, cpu1_DTLB, cpu1_ITLB, cpu1_L1D, cpu1_L1I, cpu1_L2C, cpu1_STLB, memory_controller};
+#else
         return {cpu0, cpu0_PTW, LLC, cpu0_DTLB, cpu0_ITLB, cpu0_L1D, cpu0_L1I, cpu0_L2C, cpu0_STLB, memory_controller};
+#endif // CPU_USE_MULTIPLE_CORES
+    }
+
+    std::vector<std::vector<std::reference_wrapper<champsim::operable>>> private_view() override
+    {
+#if (CPU_USE_MULTIPLE_CORES == ENABLE)
+        return {{cpu0, cpu0_DTLB, cpu0_ITLB, cpu0_L1D, cpu0_L1I, cpu0_L2C, cpu0_STLB}, {cpu1, cpu1_DTLB, cpu1_ITLB, cpu1_L1D, cpu1_L1I, cpu1_L2C, cpu1_STLB}};
+#else
+        return {{cpu0, cpu0_DTLB, cpu0_ITLB, cpu0_L1D, cpu0_L1I, cpu0_L2C, cpu0_STLB}};
+#endif // CPU_USE_MULTIPLE_CORES
     }
+
+    champsim::operable& dram_view() override { return memory_controller; }
+
+#if (FUNCTIONAL_WARMUP == ENABLE)
+    void functional_memory_access(const champsim::channel::request_type& packet) override { memory_controller.functional_access(packet); }
+#endif // FUNCTIONAL_WARMUP
 };
 } // namespace champsim::configured
 
@@ -205,7 +333,6 @@ public:
 
 namespace champsim::configured
 {
-template<typename MEMORY_TYPE>
 class generated_environment final : public champsim::environment
 {
 public:
@@ -222,9 +349,23 @@ public:
     champsim::channel cpu0_L1I_to_cpu0_ITLB_queues {16, 16, 16, LOG2_PAGE_SIZE, 1};
     champsim::channel cpu0_L1D_to_cpu0_DTLB_queues {16, 16, 16, LOG2_PAGE_SIZE, 1};
     champsim::channel cpu0_L2C_to_LLC_queues {32, 32, 32, LOG2_BLOCK_SIZE, 0};
+#if (CPU_USE_MULTIPLE_CORES == ENABLE)
+    champsim::channel cpu1_STLB_to_cpu1_PTW_queues {32, 0, 0, LOG2_PAGE_SIZE, 0};
+    champsim::channel cpu1_DTLB_to_cpu1_STLB_queues {32, 32, 32, LOG2_PAGE_SIZE, 0};
+    champsim::channel cpu1_ITLB_to_cpu1_STLB_queues {32, 32, 32, LOG2_PAGE_SIZE, 0};
+    champsim::channel cpu1_L2C_to_cpu1_STLB_queues {32, 32, 32, LOG2_PAGE_SIZE, 0};
+    champsim::channel cpu1_L1D_to_cpu1_L2C_queues {32, 32, 32, LOG2_BLOCK_SIZE, 0};
+    champsim::channel cpu1_L1I_to_cpu1_L2C_queues {32, 32, 32, LOG2_BLOCK_SIZE, 0};
+    champsim::channel cpu1_to_cpu1_L1I_queues {32, 32, 32, LOG2_BLOCK_SIZE, 1};
+    champsim::channel cpu1_PTW_to_cpu1_L1D_queues {32, 32, 32, LOG2_BLOCK_SIZE, 1};
+    champsim::channel cpu1_to_cpu1_L1D_queues {32, 32, 32, LOG2_BLOCK_SIZE, 1};
+    champsim::channel cpu1_L1I_to_cpu1_ITLB_queues {16, 16, 16, LOG2_PAGE_SIZE, 1};
+    champsim::channel cpu1_L1D_to_cpu1_DTLB_queues {16, 16, 16, LOG2_PAGE_SIZE, 1};
+    champsim::channel cpu1_L2C_to_LLC_queues {32, 32, 32, LOG2_BLOCK_SIZE, 0};
+#endif // CPU_USE_MULTIPLE_CORES
 
     // Memory controller
-    MEMORY_CONTROLLER<MEMORY_TYPE> memory_controller;
+    MEMORY_CONTROLLER memory_controller;
 
     // Virtual memory
     VirtualMemory vmem;
@@ -236,10 +377,23 @@ public:
                                   .upper_levels({&cpu0_STLB_to_cpu0_PTW_queues})
                                   .lower_level(&cpu0_PTW_to_cpu0_L1D_queues)};
 
+#if (CPU_USE_MULTIPLE_CORES == ENABLE)
+    PageTableWalker cpu1_PTW {PageTableWalker::Builder {champsim::defaults::default_ptw}
+                                  .name("cpu1_PTW")
+                                  .cpu(CPU_1)
+                                  .virtual_memory(&vmem)
+                                  .upper_levels({&cpu1_STLB_to_cpu1_PTW_queues})
+                                  .lower_level(&cpu1_PTW_to_cpu1_L1D_queues)};
+#endif // CPU_USE_MULTIPLE_CORES
+
     CACHE LLC {CACHE::Builder {champsim::defaults::default_llc}
                    .name("LLC")
                    .frequency(CACHE_CLOCK_SCALE)
+#if (CPU_USE_MULTIPLE_CORES == ENABLE)
+                   .upper_levels({{&cpu0_L2C_to_LLC_queues, &cpu1_L2C_to_LLC_queues}})
+#else
                    .upper_levels({&cpu0_L2C_to_LLC_queues})
+#endif // CPU_USE_MULTIPLE_CORES
                    .lower_level(&LLC_to_MEMORY_CONTROLLER_queues)};
 
     CACHE cpu0_DTLB {CACHE::Builder {champsim::defaults::default_dtlb}
@@ -290,6 +444,56 @@ public:
             .lower_level(&cpu0_STLB_to_cpu0_PTW_queues)
     };
 
+#if (CPU_USE_MULTIPLE_CORES == ENABLE)
+    CACHE cpu1_DTLB {CACHE::Builder {champsim::defaults::default_dtlb}
+                         .name("cpu1_DTLB")
+                         .frequency(CACHE_CLOCK_SCALE)
+                         .upper_levels({&cpu1_L1D_to_cpu1_DTLB_queues})
+                         .lower_level(&cpu1_DTLB_to_cpu1_STLB_queues)};
+
+    CACHE cpu1_ITLB {CACHE::Builder {champsim::defaults::default_itlb}
+                         .name("cpu1_ITLB")
+                         .frequency(CACHE_CLOCK_SCALE)
+                         .upper_levels({&cpu1_L1I_to_cpu1_ITLB_queues})
+                         .lower_level(&cpu1_ITLB_to_cpu1_STLB_queues)};
+
+    CACHE cpu1_L1D {
+        CACHE::Builder {                         champsim::defaults::default_l1d}
+            .name("cpu1_L1D")
+            .frequency(CACHE_CLOCK_SCALE)
+            .upper_levels({{&cpu1_PTW_to_cpu1_L1D_queues, &cpu1_to_cpu1_L1D_queues}}
+         )
+            .lower_level(&cpu1_L1D_to_cpu1_L2C_queues)
+            .lower_translate(&cpu1_L1D_to_cpu1_DTLB_queues)
+    };
+
+    CACHE cpu1_L1I {CACHE::Builder {champsim::defaults::default_l1i}
+                        .name("cpu1_L1I")
+                        .frequency(CACHE_CLOCK_SCALE)
+                        .upper_levels({&cpu1_to_cpu1_L1I_queues})
+                        .lower_level(&cpu1_L1I_to_cpu1_L2C_queues)
+                        .lower_translate(&cpu1_L1I_to_cpu1_ITLB_queues)};
+
+    CACHE cpu1_L2C {
+        CACHE::Builder {                             champsim::defaults::default_l2c}
+            .name("cpu1_L2C")
+            .frequency(CACHE_CLOCK_SCALE)
+            .upper_levels({{&cpu1_L1D_to_cpu1_L2C_queues, &cpu1_L1I_to_cpu1_L2C_queues}}
+         )
+            .lower_level(&cpu1_L2C_to_LLC_queues)
+            .lower_translate(&cpu1_L2C_to_cpu1_STLB_queues)
+    };
+
+    CACHE cpu1_STLB {
+        CACHE::Builder {                                                               champsim::defaults::default_stlb}
+            .name("cpu1_STLB")
+            .frequency(CACHE_CLOCK_SCALE)
+            .upper_levels({{&cpu1_DTLB_to_cpu1_STLB_queues, &cpu1_ITLB_to_cpu1_STLB_queues, &cpu1_L2C_to_cpu1_STLB_queues}}
+         )
+            .lower_level(&cpu1_STLB_to_cpu1_PTW_queues)
+    };
+#endif // CPU_USE_MULTIPLE_CORES
+
     // CPU 0
     O3_CPU cpu0 {O3_CPU::Builder {champsim::defaults::default_core}
                      .index(CPU_0)
@@ -302,8 +506,22 @@ public:
                      .fetch_queues(&cpu0_to_cpu0_L1I_queues)
                      .data_queues(&cpu0_to_cpu0_L1D_queues)};
 
-    generated_environment(ramulator::Memory<MEMORY_TYPE, ramulator::Controller>& memory)
-    : memory_controller(MEMORY_CONTROLLER_CLOCK_SCALE, CPU_FREQUENCY / memory.spec->speed_entry.freq, {&LLC_to_MEMORY_CONTROLLER_queues}, memory),
+#if (CPU_USE_MULTIPLE_CORES == ENABLE)
+    // CPU 1
+    O3_CPU cpu1 {O3_CPU::Builder {champsim::defaults::default_core}
+                     .index(CPU_1)
+                     .frequency(O3_CPU_CLOCK_SCALE)
+                     .l1i(&cpu1_L1I)
+                     .l1i_bandwidth(cpu1_L1I.MAX_TAG)
+                     .l1d_bandwidth(cpu1_L1D.MAX_TAG)
+                     .branch_predictor<BRANCH_PREDICTOR>()
+                     .btb<BRANCH_TARGET_BUFFER>()
+                     .fetch_queues(&cpu1_to_cpu1_L1I_queues)
+                     .data_queues(&cpu1_to_cpu1_L1D_queues)};
+#endif // CPU_USE_MULTIPLE_CORES
+
+    generated_environment(ramulator::MemoryBase& memory)
+    : memory_controller(MEMORY_CONTROLLER_CLOCK_SCALE, CPU_FREQUENCY / memory.clk_mhz(), {&LLC_to_MEMORY_CONTROLLER_queues}, memory),
       vmem(4096, PAGE_TABLE_LEVELS, MINOR_FAULT_PENALTY, memory.max_address)
 
     {
@@ -315,23 +533,54 @@ public:
 
     std::vector<std::reference_wrapper<O3_CPU>> cpu_view() override
     {
+#if (CPU_USE_MULTIPLE_CORES == ENABLE)
+        return {std::ref(cpu0), std::ref(cpu1)};
+#else
         return {std::ref(cpu0)};
+#endif // CPU_USE_MULTIPLE_CORES
     }
 
     std::vector<std::reference_wrapper<CACHE>> cache_view() override
     {
+#if (CPU_USE_MULTIPLE_CORES == ENABLE)
+        return {LLC, cpu0_DTLB, cpu0_ITLB, cpu0_L1D, cpu0_L1I, cpu0_L2C, cpu0_STLB, cpu1_DTLB, cpu1_ITLB, cpu1_L1D, cpu1_L1I, cpu1_L2C, cpu1_STLB};
+#else
         return {LLC, cpu0_DTLB, cpu0_ITLB, cpu0_L1D, cpu0_L1I, cpu0_L2C, cpu0_STLB};
+#endif // CPU_USE_MULTIPLE_CORES
     }
 
     std::vector<std::reference_wrapper<PageTableWalker>> ptw_view() override
     {
+#if (CPU_USE_MULTIPLE_CORES == ENABLE)
+        return {cpu0_PTW, cpu1_PTW};
+#else
         return {cpu0_PTW};
+#endif // CPU_USE_MULTIPLE_CORES
     }
 
     std::vector<std::reference_wrapper<champsim::operable>> operable_view() override
     {
+#if (CPU_USE_MULTIPLE_CORES == ENABLE)
+        return {cpu0, cpu0_PTW, LLC, cpu0_DTLB, cpu0_ITLB, cpu0_L1D, cpu0_L1I, cpu0_L2C, cpu0_STLB, cpu1, cpu1_PTW, cpu1_DTLB, cpu1_ITLB, cpu1_L1D, cpu1_L1I, cpu1_L2C, cpu1_STLB, memory_controller};
+#else
         return {cpu0, cpu0_PTW, LLC, cpu0_DTLB, cpu0_ITLB, cpu0_L1D, cpu0_L1I, cpu0_L2C, cpu0_STLB, memory_controller};
+#endif // CPU_USE_MULTIPLE_CORES
+    }
+
+    std::vector<std::vector<std::reference_wrapper<champsim::operable>>> private_view() override
+    {
+#if (CPU_USE_MULTIPLE_CORES == ENABLE)
+        return {{cpu0, cpu0_DTLB, cpu0_ITLB, cpu0_L1D, cpu0_L1I, cpu0_L2C, cpu0_STLB}, {cpu1, cpu1_DTLB, cpu1_ITLB, cpu1_L1D, cpu1_L1I, cpu1_L2C, cpu1_STLB}};
+#else
+        return {{cpu0, cpu0_DTLB, cpu0_ITLB, cpu0_L1D, cpu0_L1I, cpu0_L2C, cpu0_STLB}};
+#endif // CPU_USE_MULTIPLE_CORES
     }
+
+    champsim::operable& dram_view() override { return memory_controller; }
+
+#if (FUNCTIONAL_WARMUP == ENABLE)
+    void functional_memory_access(const champsim::channel::request_type& packet) override { memory_controller.functional_access(packet); }
+#endif // FUNCTIONAL_WARMUP
 };
 } // namespace champsim::configured
 
@@ -357,6 +606,20 @@ struct generated_environment final : public champsim::environment
     champsim::channel cpu0_L1I_to_cpu0_ITLB_queues {16, 16, 16, LOG2_PAGE_SIZE, 1};
     champsim::channel cpu0_L1D_to_cpu0_DTLB_queues {16, 16, 16, LOG2_PAGE_SIZE, 1};
     champsim::channel cpu0_L2C_to_LLC_queues {32, 32, 32, champsim::lg2(64), 0};
+#if (CPU_USE_MULTIPLE_CORES == ENABLE)
+    champsim::channel cpu1_STLB_to_cpu1_PTW_queues {32, 0, 0, champsim::lg2(PAGE_SIZE), 0};
+    champsim::channel cpu1_DTLB_to_cpu1_STLB_queues {32, 32, 32, LOG2_PAGE_SIZE, 0};
+    champsim::channel cpu1_ITLB_to_cpu1_STLB_queues {32, 32, 32, LOG2_PAGE_SIZE, 0};
+    champsim::channel cpu1_L2C_to_cpu1_STLB_queues {32, 32, 32, LOG2_PAGE_SIZE, 0};
+    champsim::channel cpu1_L1D_to_cpu1_L2C_queues {32, 32, 32, champsim::lg2(64), 0};
+    champsim::channel cpu1_L1I_to_cpu1_L2C_queues {32, 32, 32, champsim::lg2(64), 0};
+    champsim::channel cpu1_to_cpu1_L1I_queues {32, 32, 32, champsim::lg2(64), 1};
+    champsim::channel cpu1_PTW_to_cpu1_L1D_queues {32, 32, 32, champsim::lg2(64), 1};
+    champsim::channel cpu1_to_cpu1_L1D_queues {32, 32, 32, champsim::lg2(64), 1};
+    champsim::channel cpu1_L1I_to_cpu1_ITLB_queues {16, 16, 16, LOG2_PAGE_SIZE, 1};
+    champsim::channel cpu1_L1D_to_cpu1_DTLB_queues {16, 16, 16, LOG2_PAGE_SIZE, 1};
+    champsim::channel cpu1_L2C_to_LLC_queues {32, 32, 32, champsim::lg2(64), 0};
+#endif // CPU_USE_MULTIPLE_CORES
 
     MEMORY_CONTROLLER DRAM {1.25, 3200, 12.5, 12.5, 12.5, 7.5, {&LLC_to_DRAM_queues}};
     VirtualMemory vmem {4096, 5, 200, DRAM};
@@ -368,6 +631,16 @@ struct generated_environment final : public champsim::environment
                                   .upper_levels({&cpu0_STLB_to_cpu0_PTW_queues})
                                   .lower_level(&cpu0_PTW_to_cpu0_L1D_queues)};
 
+#if (CPU_USE_MULTIPLE_CORES == ENABLE)
+    PageTableWalker cpu1_PTW {PageTableWalker::Builder {champsim::defaults::default_ptw}
+                                  .name("cpu1_PTW")
+                                  .cpu(1)
+                                  .virtual_memory(&vmem)
+                                  .mshr_size(5)
+                                  .upper_levels({&cpu1_STLB_to_cpu1_PTW_queues})
+                                  .lower_level(&cpu1_PTW_to_cpu1_L1D_queues)};
+#endif // CPU_USE_MULTIPLE_CORES
+
     CACHE LLC {CACHE::Builder {champsim::defaults::default_llc}
                    .name("LLC")
                    .frequency(1.0)
@@ -379,7 +652,11 @@ struct generated_environment final : public champsim::environment
                    .offset_bits(champsim::lg2(64))
                    .replacement<CACHE::rreplacementDlru>()
                    .prefetcher<CACHE::pprefetcherDno>()
+#if (CPU_USE_MULTIPLE_CORES == ENABLE)
+                   .upper_levels({{&cpu0_L2C_to_LLC_queues, &cpu1_L2C_to_LLC_queues}})
+#else
                    .upper_levels({&cpu0_L2C_to_LLC_queues})
+#endif // CPU_USE_MULTIPLE_CORES
                    .lower_level(&LLC_to_DRAM_queues)};
 
     CACHE cpu0_DTLB {CACHE::Builder {champsim::defaults::default_dtlb}
@@ -478,6 +755,104 @@ struct generated_environment final : public champsim::environment
             .lower_level(&cpu0_STLB_to_cpu0_PTW_queues)
     };
 
+#if (CPU_USE_MULTIPLE_CORES == ENABLE)
+    CACHE cpu1_DTLB {CACHE::Builder {champsim::defaults::default_dtlb}
+                         .name("cpu1_DTLB")
+                         .frequency(1.0)
+                         .sets(16)
+                         .pq_size(16)
+                         .mshr_size(8)
+                         .tag_bandwidth(1)
+                         .fill_bandwidth(1)
+                         .offset_bits(LOG2_PAGE_SIZE)
+                         .replacement<CACHE::rreplacementDlru>()
+                         .prefetcher<CACHE::pprefetcherDno>()
+                         .upper_levels({&cpu1_L1D_to_cpu1_DTLB_queues})
+                         .lower_level(&cpu1_DTLB_to_cpu1_STLB_queues)};
+
+    CACHE cpu1_ITLB {CACHE::Builder {champsim::defaults::default_itlb}
+                         .name("cpu1_ITLB")
+                         .frequency(1.0)
+                         .sets(16)
+                         .pq_size(16)
+                         .mshr_size(8)
+                         .tag_bandwidth(1)
+                         .fill_bandwidth(1)
+                         .offset_bits(LOG2_PAGE_SIZE)
+                         .replacement<CACHE::rreplacementDlru>()
+                         .prefetcher<CACHE::pprefetcherDno>()
+                         .upper_levels({&cpu1_L1I_to_cpu1_ITLB_queues})
+                         .lower_level(&cpu1_ITLB_to_cpu1_STLB_queues)};
+
+    CACHE cpu1_L1D {
+        CACHE::Builder {                         champsim::defaults::default_l1d}
+            .name("cpu1_L1D")
+            .frequency(1.0)
+            .sets(64)
+            .pq_size(32)
+            .mshr_size(32)
+            .tag_bandwidth(1)
+            .fill_bandwidth(1)
+            .offset_bits(champsim::lg2(64))
+            .replacement<CACHE::rreplacementDlru>()
+            .prefetcher<CACHE::pprefetcherDno>()
+            .upper_levels({{&cpu1_PTW_to_cpu1_L1D_queues, &cpu1_to_cpu1_L1D_queues}}
+         )
+            .lower_level(&cpu1_L1D_to_cpu1_L2C_queues)
+            .lower_translate(&cpu1_L1D_to_cpu1_DTLB_queues)
+    };
+
+    CACHE cpu1_L1I {CACHE::Builder {champsim::defaults::default_l1i}
+                        .name("cpu1_L1I")
+                        .frequency(1.0)
+                        .sets(64)
+                        .pq_size(32)
+                        .mshr_size(32)
+                        .tag_bandwidth(1)
+                        .fill_bandwidth(1)
+                        .offset_bits(champsim::lg2(64))
+                        .replacement<CACHE::rreplacementDlru>()
+                        .prefetcher<CACHE::pprefetcherDno_instr>()
+                        .upper_levels({&cpu1_to_cpu1_L1I_queues})
+                        .lower_level(&cpu1_L1I_to_cpu1_L2C_queues)
+                        .lower_translate(&cpu1_L1I_to_cpu1_ITLB_queues)};
+
+    CACHE cpu1_L2C {
+        CACHE::Builder {                             champsim::defaults::default_l2c}
+            .name("cpu1_L2C")
+            .frequency(1.0)
+            .sets(1024)
+            .pq_size(32)
+            .mshr_size(64)
+            .tag_bandwidth(1)
+            .fill_bandwidth(1)
+            .offset_bits(champsim::lg2(64))
+            .replacement<CACHE::rreplacementDlru>()
+            .prefetcher<CACHE::pprefetcherDno>()
+            .upper_levels({{&cpu1_L1D_to_cpu1_L2C_queues, &cpu1_L1I_to_cpu1_L2C_queues}}
+         )
+            .lower_level(&cpu1_L2C_to_LLC_queues)
+            .lower_translate(&cpu1_L2C_to_cpu1_STLB_queues)
+    };
+
+    CACHE cpu1_STLB {
+        CACHE::Builder {                                                               champsim::defaults::default_stlb}
+            .name("cpu1_STLB")
+            .frequency(1.0)
+            .sets(128)
+            .pq_size(32)
+            .mshr_size(16)
+            .tag_bandwidth(1)
+            .fill_bandwidth(1)
+            .offset_bits(LOG2_PAGE_SIZE)
+            .replacement<CACHE::rreplacementDlru>()
+            .prefetcher<CACHE::pprefetcherDno>()
+            .upper_levels({{&cpu1_DTLB_to_cpu1_STLB_queues, &cpu1_ITLB_to_cpu1_STLB_queues, &cpu1_L2C_to_cpu1_STLB_queues}}
+         )
+            .lower_level(&cpu1_STLB_to_cpu1_PTW_queues)
+    };
+#endif // CPU_USE_MULTIPLE_CORES
+
     O3_CPU cpu0 {O3_CPU::Builder {champsim::defaults::default_core}
                      .index(0)
                      .frequency(1.0)
@@ -489,27 +864,69 @@ struct generated_environment final : public champsim::environment
                      .fetch_queues(&cpu0_to_cpu0_L1I_queues)
                      .data_queues(&cpu0_to_cpu0_L1D_queues)};
 
+#if (CPU_USE_MULTIPLE_CORES == ENABLE)
+    O3_CPU cpu1 {O3_CPU::Builder {champsim::defaults::default_core}
+                     .index(1)
+                     .frequency(1.0)
+                     .l1i(&cpu1_L1I)
+                     .l1i_bandwidth(cpu1_L1I.MAX_TAG)
+                     .l1d_bandwidth(cpu1_L1D.MAX_TAG)
+                     .branch_predictor<O3_CPU::bbranchDhashed_perceptron>()
+                     .btb<O3_CPU::tbtbDbasic_btb>()
+                     .fetch_queues(&cpu1_to_cpu1_L1I_queues)
+                     .data_queues(&cpu1_to_cpu1_L1D_queues)};
+#endif // CPU_USE_MULTIPLE_CORES
+
     std::vector<std::reference_wrapper<O3_CPU>> cpu_view() override
     {
+#if (CPU_USE_MULTIPLE_CORES == ENABLE)
+        return {std::ref(cpu0), std::ref(cpu1)};
+#else
         return {std::ref(cpu0)};
+#endif // CPU_USE_MULTIPLE_CORES
     }
 
     std::vector<std::reference_wrapper<CACHE>> cache_view() override
     {
+#if (CPU_USE_MULTIPLE_CORES == ENABLE)
+        return {LLC, cpu0_DTLB, cpu0_ITLB, cpu0_L1D, cpu0_L1I, cpu0_L2C, cpu0_STLB, cpu1_DTLB, cpu1_ITLB, cpu1_L1D, cpu1_L1I, cpu1_L2C, cpu1_STLB};
+#else
         return {LLC, cpu0_DTLB, cpu0_ITLB, cpu0_L1D, cpu0_L1I, cpu0_L2C, cpu0_STLB};
+#endif // CPU_USE_MULTIPLE_CORES
     }
 
     std::vector<std::reference_wrapper<PageTableWalker>> ptw_view() override
     {
+#if (CPU_USE_MULTIPLE_CORES == ENABLE)
+        return {cpu0_PTW, cpu1_PTW};
+#else
         return {cpu0_PTW};
+#endif // CPU_USE_MULTIPLE_CORES
     }
 
     MEMORY_CONTROLLER& dram_view() override { return DRAM; }
 
     std::vector<std::reference_wrapper<champsim::operable>> operable_view() override
     {
+#if (CPU_USE_MULTIPLE_CORES == ENABLE)
+        return {cpu0, cpu0_PTW, LLC, cpu0_DTLB, cpu0_ITLB, cpu0_L1D, cpu0_L1I, cpu0_L2C, cpu0_STLB, cpu1, cpu1_PTW, cpu1_DTLB, cpu1_ITLB, cpu1_L1D, cpu1_L1I, cpu1_L2C, cpu1_STLB, DRAM};
+#else
         return {cpu0, cpu0_PTW, LLC, cpu0_DTLB, cpu0_ITLB, cpu0_L1D, cpu0_L1I, cpu0_L2C, cpu0_STLB, DRAM};
+#endif // CPU_USE_MULTIPLE_CORES
     }
+
+    std::vector<std::vector<std::reference_wrapper<champsim::operable>>> private_view() override
+    {
+#if (CPU_USE_MULTIPLE_CORES == ENABLE)
+        return {{cpu0, cpu0_DTLB, cpu0_ITLB, cpu0_L1D, cpu0_L1I, cpu0_L2C, cpu0_STLB}, {cpu1, cpu1_DTLB, cpu1_ITLB, cpu1_L1D, cpu1_L1I, cpu1_L2C, cpu1_STLB}};
+#else
+        return {{cpu0, cpu0_DTLB, cpu0_ITLB, cpu0_L1D, cpu0_L1I, cpu0_L2C, cpu0_STLB}};
+#endif // CPU_USE_MULTIPLE_CORES
+    }
+
+#if (FUNCTIONAL_WARMUP == ENABLE)
+    void functional_memory_access(const champsim::channel::request_type& packet) override { DRAM.functional_access(packet); }
+#endif // FUNCTIONAL_WARMUP
 };
 } // namespace champsim::configured
 #endif // RAMULATOR
@@ -7,13 +7,11 @@
 #include <vector>
 
 #include "ChampSim/champsim_constants.h"
+#include "ChampSim/channel.h"
+#include "ChampSim/checkpoint.h"
 #include "ChampSim/util/bits.h"
 #include "ProjectConfiguration.h" // User file
-
-/* Includes for research */
-#include "cameo.h"
-#include "ideal_single_mempod.h"
-#include "variable_granularity.h"
+#include "Ramulator/Request.h"
 
 /** @note Abbreviation:
  *  FM -> Fast memory (e.g., HBM, DDR4)
@@ -22,71 +20,104 @@
 
 #if (MEMORY_USE_OS_TRANSPARENT_MANAGEMENT == ENABLE)
 
-#if (NO_METHOD_FOR_RUN_HYBRID_MEMORY == ENABLE)
-#define COUNTER_WIDTH                 uint8_t
-#define COUNTER_MAX_VALUE             (UINT8_MAX)
-#define COUNTER_DEFAULT_VALUE         (0)
-
-#define HOTNESS_WIDTH                 bool
-#define HOTNESS_DEFAULT_VALUE         (false)
-
-#define REMAPPING_LOCATION_WIDTH      uint8_t
-#define REMAPPING_LOCATION_WIDTH_BITS (3)
+#define INCOMPLETE_READ_REQUEST_QUEUE_LENGTH  (128)
+#define INCOMPLETE_WRITE_REQUEST_QUEUE_LENGTH (128)
 
+/** @brief
+ *  The interface of the research proposals, so that one build runs any of them. The memory controller builds the one chosen by
+ *  the project configuration once at startup (make_os_transparent_management()), and each proposal implements it in its own
+ *  source file (e.g., cameo.cc). The headers of the proposals (e.g., cameo.h) are only included by their source files, since
+ *  they give their parameters the same macro names.
+ */
 class OS_TRANSPARENT_MANAGEMENT
 {
+protected:
     using channel_type = champsim::channel;
     using request_type = typename channel_type::request_type;
 
 public:
-    uint64_t cycle                  = 0;
-    COUNTER_WIDTH hotness_threshold = 0;
-    uint64_t total_capacity;       // Uint is byte
-    uint64_t fast_memory_capacity; // Uint is byte
-    uint64_t total_capacity_at_data_block_granularity;
-    uint64_t fast_memory_capacity_at_data_block_granularity;
-    uint8_t fast_memory_offset_bit; // Address format in the data management granularity
-
-    std::vector<COUNTER_WIDTH>& counter_table; // A counter for every data block
-    std::vector<HOTNESS_WIDTH>& hotness_table; // A hotness bit for every data block, true -> data block is hot, false -> data block is cold.
+    uint64_t cycle = 0;
 
     /* Remapping request */
     struct RemappingRequest
     {
-        uint64_t address_in_fm, address_in_sm; // Hardware address in fast and slow memories
-        REMAPPING_LOCATION_WIDTH fm_location, sm_location;
-        uint8_t size; // Number of cache lines to remap
+        uint64_t address_in_fm, address_in_sm;     // Hardware address in fast and slow memories
+        uint64_t p_address_in_fm, p_address_in_sm; // Physical address in fast and slow memories, used by IDEAL_SINGLE_MEMPOD
+        uint8_t fm_location, sm_location;          // Locations in the remapping table entry, unused by IDEAL_SINGLE_MEMPOD
+        uint8_t size;                              // Number of cache lines to remap
     };
 
     std::deque<RemappingRequest> remapping_request_queue;
-    uint64_t remapping_request_queue_congestion;
+    uint64_t remapping_request_queue_congestion = 0;
+
+    /** @brief
+     *  Only used by COLOCATED_LINE_LOCATION_TABLE. If a memory read request is mapped in slow memory, the memory controller needs
+     *  first access the fast memory to get the Location Entry and Data (LEAD), and then access the slow memory based on that LEAD.
+     */
+    struct ReadRequest
+    {
+        request_type packet;
+        bool fm_access_finish = false; // Whether the access in fast memory is completed.
+    };
+
+    std::vector<ReadRequest> incomplete_read_request_queue;
+
+    /** @brief
+     *  Only used by COLOCATED_LINE_LOCATION_TABLE. If a memory write request is received, the memory controller needs first to
+     *  figure out where is the right place to write. So, the memory controller first access the fast memory to get the Location
+     *  Entry and Data (LEAD), and then write the memory (fast or slow memory).
+     */
+    struct WriteRequest
+    {
+        request_type packet;
+        bool fm_access_finish = false; // Whether the access in fast memory is completed.
+    };
+
+    std::vector<WriteRequest> incomplete_write_request_queue;
 
     /* Member functions */
-    OS_TRANSPARENT_MANAGEMENT(uint64_t max_address, uint64_t fast_memory_max_address);
-    ~OS_TRANSPARENT_MANAGEMENT();
+    virtual ~OS_TRANSPARENT_MANAGEMENT() = default;
 
-    // Adress is physical address and at byte granularity
-    bool memory_activity_tracking(uint64_t address, uint8_t type, float queue_busy_degree);
+#if (TRACKING_LOAD_STORE_STATISTICS == ENABLE)
+    // Address is physical address and at byte granularity
+    virtual bool memory_activity_tracking(uint64_t address, ramulator::Request::Type type, access_type type_origin, float queue_busy_degree) = 0;
+#else
+    // Address is physical address and at byte granularity
+    virtual bool memory_activity_tracking(uint64_t address, ramulator::Request::Type type, float queue_busy_degree) = 0;
+#endif // TRACKING_LOAD_STORE_STATISTICS
 
     // Translate the physical address to hardware address
-    void physical_to_hardware_address(request_type& packet);
-    void physical_to_hardware_address(uint64_t& address);
+    virtual void physical_to_hardware_address(request_type& packet) = 0;
+    virtual void physical_to_hardware_address(uint64_t& address)    = 0;
 
     bool issue_remapping_request(RemappingRequest& remapping_request);
-    bool finish_remapping_request();
+    virtual bool finish_remapping_request() = 0;
 
     // Detect cold data block
-    void cold_data_detection();
+    virtual void cold_data_detection() = 0;
 
-private:
-    // Evict cold data block
-    bool cold_data_eviction(uint64_t source_address, float queue_busy_degree);
+    // Swap the hot data found in the last interval, for the proposals that swap at intervals (IDEAL_SINGLE_MEMPOD)
+    virtual void check_interval_swap(uint8_t swapping_states, bool warmup) {}
 
-    // Add new remapping request into the remapping_request_queue
-    bool enqueue_remapping_request(RemappingRequest& remapping_request);
+#if (IDLE_CYCLE_SKIPPING == ENABLE)
+    // The cycles (up to bound) in which the proposal does nothing that the memory controller doesn't see
+    virtual uint64_t idle_cycles(uint64_t bound) const { return bound; }
+#endif // IDLE_CYCLE_SKIPPING
+
+    // Save or restore the counters and the remapping tables, e.g., for checkpoints
+    virtual void checkpoint(champsim::checkpoint_archive& archive) = 0;
+
+    bool finish_fm_access_in_incomplete_read_request_queue(uint64_t h_address);
+    bool finish_fm_access_in_incomplete_write_request_queue(uint64_t h_address);
 };
 
-#endif // NO_METHOD_FOR_RUN_HYBRID_MEMORY
+// Build the research proposal chosen by the project configuration
+OS_TRANSPARENT_MANAGEMENT* make_os_transparent_management(uint64_t max_address, uint64_t fast_memory_max_address);
+
+// The research proposals, each defined in its own source file
+OS_TRANSPARENT_MANAGEMENT* make_cameo(uint64_t max_address, uint64_t fast_memory_max_address, bool colocated_line_location_table);
+OS_TRANSPARENT_MANAGEMENT* make_variable_granularity(uint64_t max_address, uint64_t fast_memory_max_address);
+OS_TRANSPARENT_MANAGEMENT* make_mempod(uint64_t max_address, uint64_t fast_memory_max_address);
 
 #endif // MEMORY_USE_OS_TRANSPARENT_MANAGEMENT
 #endif // OS_TRANSPARENT_MANAGEMENT_H
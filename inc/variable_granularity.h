@@ -8,8 +8,11 @@
 #include <vector>
 
 #include "ChampSim/champsim_constants.h"
+#include "ChampSim/checkpoint.h"
 #include "ChampSim/util/bits.h"
 #include "ProjectConfiguration.h" // User file
+#include "Ramulator/Request.h"
+#include "os_transparent_management.h"
 
 /** @note Abbreviation:
  *  FM -> Fast memory (e.g., HBM, DDR4)
@@ -18,7 +21,11 @@
 
 #if (MEMORY_USE_OS_TRANSPARENT_MANAGEMENT == ENABLE)
 
-#if (IDEAL_VARIABLE_GRANULARITY == ENABLE)
+#define DATA_MANAGEMENT_GRANULARITY      (DATA_GRANULARITY_4096B)
+#define DATA_LINE_OFFSET_BITS            (champsim::lg2(DATA_GRANULARITY_64B))
+#define DATA_MANAGEMENT_OFFSET_BITS      (champsim::lg2(DATA_MANAGEMENT_GRANULARITY)) // Data management granularity means how the hardware cluster the data
+#define DATA_GRANULARITY_IN_CACHE_LINE   (DATA_MANAGEMENT_GRANULARITY / DATA_GRANULARITY_64B)
+
 #define COUNTER_WIDTH                    uint8_t
 #define COUNTER_MAX_VALUE                (UINT8_MAX)
 #define COUNTER_DEFAULT_VALUE            (0)
@@ -43,13 +50,10 @@
 
 #define INTERVAL_FOR_DECREMENT           (1000000) // Default: 1000000
 
-class OS_TRANSPARENT_MANAGEMENT
+// IDEAL_VARIABLE_GRANULARITY
+class VARIABLE_GRANULARITY : public OS_TRANSPARENT_MANAGEMENT
 {
-    using channel_type = champsim::channel;
-    using request_type = typename channel_type::request_type;
-
 public:
-    uint64_t cycle                  = 0;
     COUNTER_WIDTH hotness_threshold = 0;
     uint64_t total_capacity;       // Uint is byte
     uint64_t fast_memory_capacity; // Uint is byte
@@ -60,17 +64,6 @@ public:
     std::vector<COUNTER_WIDTH>& counter_table; // A counter for every data block
     std::vector<HOTNESS_WIDTH>& hotness_table; // A hotness bit for every data block, true -> data block is hot, false -> data block is cold.
 
-    /* Remapping request */
-    struct RemappingRequest
-    {
-        uint64_t address_in_fm, address_in_sm; // Hardware address in fast and slow memories
-        REMAPPING_LOCATION_WIDTH fm_location, sm_location;
-        uint8_t size; // Number of cache lines to remap
-    };
-
-    std::deque<RemappingRequest> remapping_request_queue;
-    uint64_t remapping_request_queue_congestion;
-
     // Scoped enumerations
     /** @brief
      * It is used to store the migrated page's block number, which is to represent the location in a set.
@@ -176,21 +169,33 @@ public:
     uint64_t expected_number_in_congruence_group = 0;
 
     /* Member functions */
-    OS_TRANSPARENT_MANAGEMENT(uint64_t max_address, uint64_t fast_memory_max_address);
-    ~OS_TRANSPARENT_MANAGEMENT();
+    VARIABLE_GRANULARITY(uint64_t max_address, uint64_t fast_memory_max_address);
+    ~VARIABLE_GRANULARITY();
 
+#if (TRACKING_LOAD_STORE_STATISTICS == ENABLE)
+    // Address is physical address and at byte granularity, type_origin is unused
+    bool memory_activity_tracking(uint64_t address, ramulator::Request::Type type, access_type type_origin, float queue_busy_degree) override;
+#else
     // Address is physical address and at byte granularity
-    bool memory_activity_tracking(uint64_t address, ramulator::Request::Type type, float queue_busy_degree);
+    bool memory_activity_tracking(uint64_t address, ramulator::Request::Type type, float queue_busy_degree) override;
+#endif // TRACKING_LOAD_STORE_STATISTICS
 
     // Translate the physical address to hardware address
-    void physical_to_hardware_address(request_type& packet);
-    void physical_to_hardware_address(uint64_t& address);
+    void physical_to_hardware_address(request_type& packet) override;
+    void physical_to_hardware_address(uint64_t& address) override;
 
-    bool issue_remapping_request(RemappingRequest& remapping_request);
-    bool finish_remapping_request();
+    bool finish_remapping_request() override;
 
     // Detect cold data block
-    void cold_data_detection();
+    void cold_data_detection() override;
+
+#if (IDLE_CYCLE_SKIPPING == ENABLE)
+    // The cycles before the counters are decremented
+    uint64_t idle_cycles(uint64_t bound) const override;
+#endif // IDLE_CYCLE_SKIPPING
+
+    // Save or restore the counters and the remapping tables, e.g., for checkpoints
+    void checkpoint(champsim::checkpoint_archive& archive) override;
 
 private:
 #if (COLD_DATA_DETECTION_IN_GROUP == ENABLE)
@@ -214,7 +219,5 @@ private:
     START_ADDRESS_WIDTH round_down_migration_granularity(const START_ADDRESS_WIDTH start_address, const START_ADDRESS_WIDTH end_address, MIGRATION_GRANULARITY_WIDTH& migration_granularity);
 };
 
-#endif // IDEAL_VARIABLE_GRANULARITY
-
 #endif // MEMORY_USE_OS_TRANSPARENT_MANAGEMENT
 #endif // VARIABLE_GRANULARITY_H
@@ -0,0 +1,219 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef BLOCK_TRACE_H
+#define BLOCK_TRACE_H
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <fstream>
+#include <future>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include "ChampSim/block_trace_format.h"
+#include "ChampSim/inf_stream.h"
+#include "ChampSim/instruction.h"
+#include "ChampSim/tracereader.h"
+#include "ProjectConfiguration.h" // User file
+
+#if (USER_CODES == ENABLE)
+
+namespace champsim
+{
+namespace block_trace
+{
+bool is_block_trace(const std::string& file_name);
+
+// Write the records into blocks, and the index when closed
+class writer
+{
+    std::ofstream file;
+    std::string file_name;
+    header head;
+    std::vector<char> pending {};
+    std::vector<index_entry> index {};
+    uint64_t records = 0;
+
+    void write_block();
+
+public:
+    writer(const std::string& file_name, uint32_t record_size, uint32_t records_per_block = DEFAULT_RECORDS_PER_BLOCK);
+    ~writer();
+
+    writer(const writer&)            = delete;
+    writer& operator=(const writer&) = delete;
+
+    // Append bytes of whole records
+    void write(const char* data, std::size_t bytes);
+
+    // Compress the records of a block, which can be done by any thread
+    static std::vector<uint8_t> compress(const char* data, std::size_t bytes);
+
+    // Append a block compressed by compress(), when no records written by write() are pending
+    void write_compressed(const std::vector<uint8_t>& compressed, uint64_t block_records);
+
+    void close();
+};
+
+// Read the index of a block trace, and decompress any of its blocks
+class reader
+{
+    std::ifstream file;
+    std::string file_name;
+    header head;
+    std::vector<index_entry> index {};
+
+public:
+    reader(const std::string& file_name, uint32_t record_size);
+
+    uint64_t records() const { return index.empty() ? 0 : index.back().first_record + index.back().records; }
+
+    std::size_t blocks() const { return std::size(index); }
+
+    // The block holding the record
+    std::size_t block_of(uint64_t record) const;
+
+    const index_entry& entry(std::size_t block) const { return index.at(block); }
+
+    std::vector<char> read_block(std::size_t block) { return decompress(read_compressed(block), block); }
+
+    // Read the block without decompressing it
+    std::vector<uint8_t> read_compressed(std::size_t block);
+
+    // Decompress a block read by read_compressed(), which can be done by any thread
+    std::vector<char> decompress(const std::vector<uint8_t>& compressed, std::size_t block) const;
+};
+} // namespace block_trace
+
+/** @brief
+ *  Read a block trace like bulk_tracereader reads a stream, a block at a time, except that skip() jumps to the block holding the target record
+ *  instead of reading all records before it. With more than one decomp_tags::decoder_threads, that many blocks after the current one are
+ *  decompressed in parallel ahead of time.
+ */
+template<typename T>
+class block_tracereader
+{
+    static_assert(std::is_trivial_v<T>);
+    static_assert(std::is_standard_layout_v<T>);
+
+    uint8_t cpu;
+    block_trace::reader trace_file;
+    std::size_t next_block = 0; // The next block to inflate
+    std::size_t next_issue = 0; // The next block to decompress ahead
+    std::deque<std::future<std::vector<char>>> decompressing {};
+
+    constexpr static std::size_t refresh_thresh = 1;
+    std::deque<ooo_model_instr> instr_buffer {};
+
+    std::vector<char> decompress_next_block()
+    {
+        if (decomp_tags::decoder_threads <= 1)
+            return trace_file.read_block(next_block++);
+
+        // Keep the blocks after the next one decompressing
+        while (std::size(decompressing) < decomp_tags::decoder_threads && next_issue < trace_file.blocks())
+        {
+            decompressing.push_back(std::async(std::launch::async, [&file = trace_file, compressed = trace_file.read_compressed(next_issue), block = next_issue]
+                { return file.decompress(compressed, block); }));
+            next_issue++;
+        }
+
+        auto raw_buf = decompressing.front().get();
+        decompressing.pop_front();
+        next_block++;
+        return raw_buf;
+    }
+
+    void read_next_block()
+    {
+        auto raw_buf = decompress_next_block();
+
+        auto records = std::size(raw_buf) / sizeof(T);
+        for (std::size_t i = 0; i < records; i++)
+        {
+            T t;
+            std::memcpy(&t, std::data(raw_buf) + i * sizeof(T), sizeof(T));
+            instr_buffer.emplace_back(cpu, t);
+        }
+
+        set_branch_targets(std::begin(instr_buffer), std::end(instr_buffer));
+    }
+
+    void refresh()
+    {
+        while (std::size(instr_buffer) <= refresh_thresh && next_block < trace_file.blocks())
+            read_next_block();
+    }
+
+public:
+    using trace_type = T;
+
+    block_tracereader(uint8_t cpu_idx, std::string tf): cpu(cpu_idx), trace_file(tf, sizeof(T)) {}
+
+    ooo_model_instr operator()()
+    {
+        refresh();
+
+        auto retval = instr_buffer.front();
+        instr_buffer.pop_front();
+        return retval;
+    }
+
+    // Skip the next instructions, decompressing only the block of the first instruction after them
+    uint64_t skip(uint64_t count)
+    {
+        if (trace_file.blocks() == 0)
+            return 0; // an empty trace
+
+        // The position of the next instruction in the trace
+        auto position = (next_block < trace_file.blocks() ? trace_file.entry(next_block).first_record : trace_file.records()) - std::size(instr_buffer);
+
+        // The last record of a trace is never read, as with bulk_tracereader
+        auto target = std::min(position + count, trace_file.records() - 1);
+        if (target <= position)
+        {
+            refresh(); // nothing is left to skip, which eof() tells once the last block is read
+            return 0;
+        }
+        if (target - position < std::size(instr_buffer))
+        {
+            instr_buffer.erase(std::begin(instr_buffer), std::next(std::begin(instr_buffer), static_cast<long>(target - position)));
+            return target - position;
+        }
+
+        instr_buffer.clear();
+        decompressing.clear();
+        next_block = next_issue = trace_file.block_of(target);
+        auto first = trace_file.entry(next_block).first_record;
+        read_next_block();
+        instr_buffer.erase(std::begin(instr_buffer), std::next(std::begin(instr_buffer), static_cast<long>(target - first)));
+        refresh();
+        return target - position;
+    }
+
+    bool eof() const { return next_block >= trace_file.blocks() && std::size(instr_buffer) <= refresh_thresh; }
+};
+} // namespace champsim
+
+#endif // USER_CODES
+
+#endif
@@ -25,6 +25,7 @@
 #include <array>
 #include <bitset>
 #include <deque>
+#include <functional>
 #include <memory>
 #include <stdexcept>
 #include <string>
@@ -128,6 +129,10 @@ class CACHE : public champsim::operable
 
     void issue_translation();
 
+#if (FUNCTIONAL_WARMUP == ENABLE)
+    response_type functional_tag_check(tag_lookup_type handle_pkt);
+#endif // FUNCTIONAL_WARMUP
+
     struct BLOCK
     {
         bool valid           = false;
@@ -232,6 +237,35 @@ public:
 
     void print_deadlock() override;
 
+#if (IDLE_CYCLE_SKIPPING == ENABLE)
+    uint64_t idle_cycles(uint64_t bound) override final;
+    void skip_cycles(uint64_t cycles) override final;
+
+    // The entries whose translation could not be issued yet
+    std::size_t pending_translations() const;
+
+    // Whether the tag check misses and cannot allocate an MSHR, so that it fails until a fill
+    bool tag_check_stalled(const tag_lookup_type& handle_pkt) const;
+#endif // IDLE_CYCLE_SKIPPING
+
+#if (USER_CODES == ENABLE)
+    // Save or restore the blocks, the replacement states are kept by the replacement modules
+    void checkpoint(champsim::checkpoint_archive& archive) override final;
+#endif // USER_CODES
+
+#if (FUNCTIONAL_WARMUP == ENABLE)
+    using functional_level_type = std::function<response_type(const request_type&)>;
+
+    // The next levels in functional warmup, they are only set while the functional warmup runs
+    functional_level_type functional_lower_level {}, functional_lower_translate {};
+
+    /** @brief
+     *  Look up a request without timing in functional warmup. The request is translated and its miss is filled from the next level at once, and
+     *  the prefetches it triggers are issued right after, so the tag array, replacement states and prefetchers are trained as in the timing model.
+     */
+    response_type functional_access(const request_type& packet);
+#endif // FUNCTIONAL_WARMUP
+
 #if (USER_CODES == ENABLE)
 
     /* Definition and declaration for data and instruction prefetchers */
@@ -390,6 +424,9 @@ public:
         virtual void impl_prefetcher_cycle_operate()                                                                                                            = 0;
         virtual void impl_prefetcher_final_stats()                                                                                                              = 0;
         virtual void impl_prefetcher_branch_operate(uint64_t ip, uint8_t branch_type, uint64_t branch_target)                                                   = 0;
+#if (IDLE_CYCLE_SKIPPING == ENABLE)
+        virtual bool impl_prefetcher_is_stateless() const                                                                                                      = 0;
+#endif // IDLE_CYCLE_SKIPPING
 
         virtual void impl_initialize_replacement()                                                                                                              = 0;
         virtual uint32_t impl_find_victim(uint32_t triggering_cpu, uint64_t instr_id, uint32_t set, const BLOCK* current_set, uint64_t ip, uint64_t full_addr,
@@ -412,6 +449,10 @@ public:
         void impl_prefetcher_cycle_operate();
         void impl_prefetcher_final_stats();
         void impl_prefetcher_branch_operate(uint64_t ip, uint8_t branch_type, uint64_t branch_target);
+#if (IDLE_CYCLE_SKIPPING == ENABLE)
+        // Whether the prefetchers ignore the accesses, so that retrying a tag check doesn't train them
+        bool impl_prefetcher_is_stateless() const { return (P_FLAG & ~(CACHE::pprefetcherDno | CACHE::pprefetcherDno_instr)) == 0; }
+#endif // IDLE_CYCLE_SKIPPING
 
         void impl_initialize_replacement();
         uint32_t impl_find_victim(uint32_t triggering_cpu, uint64_t instr_id, uint32_t set, const BLOCK* current_set, uint64_t ip, uint64_t full_addr,
@@ -91,10 +91,8 @@ class channel
         /* h_address (hardware address), which is the address used by memory chips */
         uint64_t h_address = 0;
 
-#if (COLOCATED_LINE_LOCATION_TABLE == ENABLE)
-        /* h_address_fm, corresponding hardware address in fast memory */
+        /* h_address_fm, corresponding hardware address in fast memory, only used by COLOCATED_LINE_LOCATION_TABLE */
         uint64_t h_address_fm = 0;
-#endif // COLOCATED_LINE_LOCATION_TABLE
 
 #if (TRACKING_LOAD_STORE_STATISTICS == ENABLE)
         access_type type_origin {access_type::LOAD};
@@ -190,10 +188,8 @@ struct DRAM_CHANNEL
         /* h_address (hardware address), which is the address used by memory chips */
         uint64_t h_address = 0;
 
-#if (COLOCATED_LINE_LOCATION_TABLE == ENABLE)
-        /* h_address_fm, corresponding hardware address in fast memory */
+        /* h_address_fm, corresponding hardware address in fast memory, only used by COLOCATED_LINE_LOCATION_TABLE */
         uint64_t h_address_fm = 0;
-#endif // COLOCATED_LINE_LOCATION_TABLE
 
 #endif // MEMORY_USE_OS_TRANSPARENT_MANAGEMENT
 
@@ -49,13 +49,18 @@
 /* Type */
 
 /* Prototype */
+// Name the checkpoint section of a memory by its standard and organization, so that only a memory of the same organization restores it
+std::string memory_checkpoint_section(uint8_t memory_id, const ramulator::MemoryBase& memory);
+
 #if (MEMORY_USE_HYBRID == ENABLE)
-template<typename T, typename T2>
 class MEMORY_CONTROLLER : public champsim::operable
 {
     double clock_scale  = MEMORY_CONTROLLER_CLOCK_SCALE;
     double clock_scale2 = MEMORY_CONTROLLER_CLOCK_SCALE;
 
+    // Fractional clock counters that decide in which cycles the memories tick
+    double leap_operation_memory = 0, leap_operation_memory2 = 0;
+
     using channel_type  = champsim::channel;
     using request_type  = typename channel_type::request_type;
     using response_type = typename channel_type::response_type;
@@ -65,10 +70,19 @@ class MEMORY_CONTROLLER : public champsim::operable
     bool add_rq(request_type& pkt, champsim::channel* ul);
     bool add_wq(request_type& pkt);
 
+    // The packets of the read requests in the memories, which return their data to the upper levels
+    ramulator::PacketPool packets;
+
+    // Send a read request to the memory, which keeps its packet in packets until the data is returned
+    bool send_read(ramulator::MemoryBase& target, uint64_t address, const DRAM_CHANNEL::request_type& packet, uint32_t cpu, uint8_t target_id);
+
+    // Return the data of the reads the memory completed in its last tick, in the order they completed
+    void drain_completions(ramulator::MemoryBase& target);
+
 public:
     // Note here they are the references to escape memory deallocation here.
-    ramulator::Memory<T, ramulator::Controller>& memory;
-    ramulator::Memory<T2, ramulator::Controller>& memory2;
+    ramulator::MemoryBase& memory;
+    ramulator::MemoryBase& memory2;
 
     const uint8_t memory_id  = MEMORY_NUMBER_ONE;
     const uint8_t memory2_id = MEMORY_NUMBER_TWO;
@@ -90,7 +104,7 @@ public:
         bool dirty[SWAPPING_SEGMENT_NUMBER];                                 // Whether a "new" write request is received
     };
 
-    std::array<BUFFER_ENTRY, SWAPPING_BUFFER_ENTRY_NUMBER> buffer = {};
+    std::vector<BUFFER_ENTRY> buffer; // project_configuration.swapping_buffer_entry_number entries
     uint64_t base_address[SWAPPING_SEGMENT_NUMBER]; // Here base_address[0] for segment 1, base_address[1] for segment 2. Address is hardware address and at cache line granularity.
     uint8_t active_entry_number;
     uint8_t finish_number;
@@ -120,7 +134,7 @@ public:
     uint64_t write_request_in_memory, write_request_in_memory2;
 
     /* Member functions */
-    MEMORY_CONTROLLER(double freq_scale, double clock_scale, double clock_scale2, std::vector<channel_type*>&& ul, ramulator::Memory<T, ramulator::Controller>& memory, ramulator::Memory<T2, ramulator::Controller>& memory2);
+    MEMORY_CONTROLLER(double freq_scale, double clock_scale, double clock_scale2, std::vector<channel_type*>&& ul, ramulator::MemoryBase& memory, ramulator::MemoryBase& memory2);
     ~MEMORY_CONTROLLER();
 
     void initialize() override final;
@@ -129,6 +143,13 @@ public:
     void end_phase(unsigned cpu) override final;
     void print_deadlock() override final;
 
+#if (IDLE_CYCLE_SKIPPING == ENABLE)
+    uint64_t idle_cycles(uint64_t bound) override final;
+    void skip_cycles(uint64_t cycles) override final;
+#endif // IDLE_CYCLE_SKIPPING
+
+    void checkpoint(champsim::checkpoint_archive& archive) override final;
+
     std::size_t size() const;
 
     /** @brief
@@ -145,6 +166,14 @@ public:
 
     void return_data(ramulator::Request& request);
 
+#if (FUNCTIONAL_WARMUP == ENABLE)
+    /** @brief
+     *  Observe a request that misses all caches in functional warmup, so the research proposals are trained without timing.
+     *  The address is physical address.
+     */
+    void functional_access(request_type packet);
+#endif // FUNCTIONAL_WARMUP
+
 #if (MEMORY_USE_SWAPPING_UNIT == ENABLE)
 public:
     // Input address should be hardware address and at byte granularity
@@ -159,7 +188,7 @@ private:
 
     uint8_t operate_swapping();
 
-    // This function is used by memories, like Ramulator.
+    // This function handles the reads of the swapping unit that memories, like Ramulator, completed.
     void return_swapping_data(ramulator::Request& request);
 
     // This function is used by memory controller in add_rq() and add_wq().
@@ -169,1214 +198,15 @@ private:
 #endif // MEMORY_USE_SWAPPING_UNIT
 };
 
-template<typename T, typename T2>
-MEMORY_CONTROLLER<T, T2>::MEMORY_CONTROLLER(double freq_scale, double clock_scale, double clock_scale2, std::vector<channel_type*>&& ul, ramulator::Memory<T, ramulator::Controller>& memory, ramulator::Memory<T2, ramulator::Controller>& memory2)
-#if (MEMORY_USE_OS_TRANSPARENT_MANAGEMENT == ENABLE)
-: champsim::operable(freq_scale), clock_scale(clock_scale), clock_scale2(clock_scale2),
-  queues(std::move(ul)), memory(memory), memory2(memory2),
-  os_transparent_management(*(new OS_TRANSPARENT_MANAGEMENT(memory.max_address + memory2.max_address, memory.max_address)))
-#else
-: champsim::operable(freq_scale), clock_scale(clock_scale), clock_scale2(clock_scale2),
-  queues(std::move(ul)), memory(memory), memory2(memory2)
-#endif // MEMORY_USE_OS_TRANSPARENT_MANAGEMENT
-{
-    std::printf("clock_scale: %f, clock_scale2: %f.\n", clock_scale, clock_scale2);
-
-#if (MEMORY_USE_SWAPPING_UNIT == ENABLE)
-    swapping_count = swapping_traffic_in_bytes = 0;
-#endif // MEMORY_USE_SWAPPING_UNIT
-
-#if (TRACKING_LOAD_STORE_STATISTICS == ENABLE)
-    load_request_in_memory = load_request_in_memory2 = 0;
-    store_request_in_memory = store_request_in_memory2 = 0;
-#endif // TRACKING_LOAD_STORE_STATISTICS
-
-    read_request_in_memory = read_request_in_memory2 = 0;
-    write_request_in_memory = write_request_in_memory2 = 0;
-
-#if (MEMORY_USE_SWAPPING_UNIT == ENABLE)
-    initialize_swapping();
-
-#if (TEST_SWAPPING_UNIT == ENABLE)
-    for (auto i = 0; i < MEMORY_DATA_NUMBER; i++)
-    {
-        memory_data[i][0] = i;
-    }
-#endif // TEST_SWAPPING_UNIT
-#endif // MEMORY_USE_SWAPPING_UNIT
-}
-
-template<typename T, typename T2>
-MEMORY_CONTROLLER<T, T2>::~MEMORY_CONTROLLER()
-{
-// Print information to output_statistics
-#if (MEMORY_USE_SWAPPING_UNIT == ENABLE)
-    output_statistics.swapping_count            = swapping_count;
-    output_statistics.swapping_traffic_in_bytes = swapping_traffic_in_bytes;
-#endif // MEMORY_USE_SWAPPING_UNIT
-
-#if (TRACKING_LOAD_STORE_STATISTICS == ENABLE)
-    output_statistics.load_request_in_memory   = load_request_in_memory;
-    output_statistics.store_request_in_memory  = store_request_in_memory;
-    output_statistics.load_request_in_memory2  = load_request_in_memory2;
-    output_statistics.store_request_in_memory2 = store_request_in_memory2;
-#endif // TRACKING_LOAD_STORE_STATISTICS
-
-    output_statistics.read_request_in_memory   = read_request_in_memory;
-    output_statistics.read_request_in_memory2  = read_request_in_memory2;
-    output_statistics.write_request_in_memory  = write_request_in_memory;
-    output_statistics.write_request_in_memory2 = write_request_in_memory2;
-
-#if (MEMORY_USE_OS_TRANSPARENT_MANAGEMENT == ENABLE)
-    delete &os_transparent_management;
-#endif // MEMORY_USE_OS_TRANSPARENT_MANAGEMENT
-}
-
-template<typename T, typename T2>
-void MEMORY_CONTROLLER<T, T2>::initialize()
-{
-    long long int dram_size = (memory.max_address + memory2.max_address) / MiB; // in MiB
-
-    fmt::print("Memory Subsystem Size: ");
-#if (PRINT_STATISTICS_INTO_FILE == ENABLE)
-    std::fprintf(output_statistics.file_handler, "Memory Subsystem Size: ");
-#endif // PRINT_STATISTICS_INTO_FILE
-
-    if (dram_size > 1024)
-    {
-        fmt::print("{} GiB", dram_size / 1024);
-#if (PRINT_STATISTICS_INTO_FILE == ENABLE)
-        std::fprintf(output_statistics.file_handler, "%lld GiB", dram_size / 1024);
-#endif // PRINT_STATISTICS_INTO_FILE
-    }
-    else
-    {
-        fmt::print("{} MiB", dram_size);
-#if (PRINT_STATISTICS_INTO_FILE == ENABLE)
-        std::fprintf(output_statistics.file_handler, "%lld MiB", dram_size);
-#endif // PRINT_STATISTICS_INTO_FILE
-    }
-
-    fmt::print("\n");
-#if (PRINT_STATISTICS_INTO_FILE == ENABLE)
-    std::fprintf(output_statistics.file_handler, "\n");
-#endif // PRINT_STATISTICS_INTO_FILE
-}
-
-template<typename T, typename T2>
-long MEMORY_CONTROLLER<T, T2>::operate()
-{
-    long progress {0};
-
-    initiate_requests();
-
-    /* Operate research proposals below */
-#if (MEMORY_USE_OS_TRANSPARENT_MANAGEMENT == ENABLE)
-    os_transparent_management.cold_data_detection();
-
-#if (COLOCATED_LINE_LOCATION_TABLE == ENABLE)
-    for (size_t i = 0; i < os_transparent_management.incomplete_read_request_queue.size(); i++)
-    {
-        if (os_transparent_management.incomplete_read_request_queue[i].fm_access_finish) // This read request is ready to access slow memory
-        {
-            request_type packet              = os_transparent_management.incomplete_read_request_queue[i].packet;
-
-            DRAM_CHANNEL::request_type rq_it = DRAM_CHANNEL::request_type {packet};
-            rq_it.forward_checked            = false;
-            rq_it.event_cycle                = current_cycle;
-            if (packet.response_requested)
-                rq_it.to_return = {&(queues.at(packet.cpu)->returned)}; // Store the response queue to communicate with the LLC
-
-            /* Send memory request below */
-            bool stall       = true;
-
-            uint64_t address = packet.h_address;
-            if ((memory.max_address <= address) && (address < memory.max_address + memory2.max_address))
-            {
-                // The memory itself doesn't know other memories' space, so we manage the overall mapping.
-                ramulator::Request request(address - memory.max_address, ramulator::Request::Type::READ, std::bind(&MEMORY_CONTROLLER<T, T2>::return_data, this, placeholders::_1), rq_it, packet.cpu, memory2_id);
-                stall = ! memory2.send(request);
-
-                if (stall == false)
-                {
-                    read_request_in_memory2++;
-                    os_transparent_management.incomplete_read_request_queue.erase(os_transparent_management.incomplete_read_request_queue.begin() + i);
-                }
-            }
-            else
-            {
-                std::printf("%s: Error!\n", __FUNCTION__);
-            }
-        }
-    }
-
-    for (size_t i = 0; i < os_transparent_management.incomplete_write_request_queue.size(); i++)
-    {
-        if (os_transparent_management.incomplete_write_request_queue[i].fm_access_finish) // This write request is ready to write memory (fast or slow)
-        {
-            request_type packet              = os_transparent_management.incomplete_write_request_queue[i].packet;
-
-            DRAM_CHANNEL::request_type wq_it = DRAM_CHANNEL::request_type {packet};
-            wq_it.forward_checked            = false;
-            wq_it.event_cycle                = current_cycle;
-
-            /* Send memory request below */
-            bool stall                       = true;
-
-            uint64_t address                 = packet.h_address;
-
-            // Assign the request to the right memory.
-            if (address < memory.max_address)
-            {
-                ramulator::Request request(address, ramulator::Request::Type::WRITE, std::bind(&MEMORY_CONTROLLER<T, T2>::return_data, this, placeholders::_1), wq_it, packet.cpu, memory_id);
-                stall = ! memory.send(request);
-
-                if (stall == false)
-                {
-                    write_request_in_memory++;
-                    os_transparent_management.incomplete_write_request_queue.erase(os_transparent_management.incomplete_write_request_queue.begin() + i);
-                }
-            }
-            else if (address < memory.max_address + memory2.max_address)
-            {
-                // The memory itself doesn't know other memories' space, so we manage the overall mapping.
-                ramulator::Request request(address - memory.max_address, ramulator::Request::Type::WRITE, std::bind(&MEMORY_CONTROLLER<T, T2>::return_data, this, placeholders::_1), wq_it, packet.cpu, memory2_id);
-                stall = ! memory2.send(request);
-
-                if (stall == false)
-                {
-                    write_request_in_memory2++;
-                    os_transparent_management.incomplete_write_request_queue.erase(os_transparent_management.incomplete_write_request_queue.begin() + i);
-                }
-            }
-            else
-            {
-                std::printf("%s: Error!\n", __FUNCTION__);
-            }
-        }
-    }
-#endif // COLOCATED_LINE_LOCATION_TABLE
-#endif // MEMORY_USE_OS_TRANSPARENT_MANAGEMENT
-
-#if (MEMORY_USE_SWAPPING_UNIT == ENABLE)
-    /* Operate swapping below */
-    uint8_t swapping_states = operate_swapping();
-    switch (swapping_states)
-    {
-    case 0: // The swapping unit is idle
-    {
-#if (MEMORY_USE_OS_TRANSPARENT_MANAGEMENT == ENABLE)
-        OS_TRANSPARENT_MANAGEMENT::RemappingRequest remapping_request;
-        bool issue = os_transparent_management.issue_remapping_request(remapping_request);
-        if (issue == true) // Get a new remapping request.
-        {
-#if (IDEAL_LINE_LOCATION_TABLE == ENABLE) || (COLOCATED_LINE_LOCATION_TABLE == ENABLE) || (IDEAL_VARIABLE_GRANULARITY == ENABLE)
-            start_swapping_segments(remapping_request.address_in_fm, remapping_request.address_in_sm, remapping_request.size);
-#elif (IDEAL_SINGLE_MEMPOD == ENABLE)
-            start_swapping_segments(remapping_request.h_address_in_fm, remapping_request.h_address_in_sm, remapping_request.size);
-#endif // IDEAL_LINE_LOCATION_TABLE, COLOCATED_LINE_LOCATION_TABLE, IDEAL_SINGLE_MEMPOD
-        }
-#endif // MEMORY_USE_OS_TRANSPARENT_MANAGEMENT
-    }
-    break;
-    case 1: // The swapping unit is busy
-    {
-#if (MEMORY_USE_OS_TRANSPARENT_MANAGEMENT == ENABLE)
-        OS_TRANSPARENT_MANAGEMENT::RemappingRequest remapping_request;
-        bool issue = os_transparent_management.issue_remapping_request(remapping_request);
-        if (issue == true) // Get a remapping request.
-        {
-            // In case the swapping segments are updated
-#if (IDEAL_LINE_LOCATION_TABLE == ENABLE) || (COLOCATED_LINE_LOCATION_TABLE == ENABLE) || (IDEAL_VARIABLE_GRANULARITY == ENABLE)
-            update_swapping_segments(remapping_request.address_in_fm, remapping_request.address_in_sm, remapping_request.size);
-#elif (IDEAL_SINGLE_MEMPOD == ENABLE)
-            update_swapping_segments(remapping_request.h_address_in_fm, remapping_request.h_address_in_sm, remapping_request.size);
-#endif // IDEAL_LINE_LOCATION_TABLE, COLOCATED_LINE_LOCATION_TABLE, IDEAL_SINGLE_MEMPOD
-        }
-        else
-        {
-            std::cout << __func__ << ": issue_remapping_request error." << std::endl;
-            assert(false);
-        }
-#endif // MEMORY_USE_OS_TRANSPARENT_MANAGEMENT
-    }
-    break;
-    case 2: // The swapping unit finishes a swapping request
-    {
-#if (MEMORY_USE_OS_TRANSPARENT_MANAGEMENT == ENABLE)
-        bool is_updated = false;
-        OS_TRANSPARENT_MANAGEMENT::RemappingRequest remapping_request;
-        bool issue = os_transparent_management.issue_remapping_request(remapping_request);
-        if (issue == true) // Get a remapping request.
-        {
-            // In case the swapping segments are updated
-#if (IDEAL_LINE_LOCATION_TABLE == ENABLE) || (COLOCATED_LINE_LOCATION_TABLE == ENABLE) || (IDEAL_VARIABLE_GRANULARITY == ENABLE)
-            is_updated = update_swapping_segments(remapping_request.address_in_fm, remapping_request.address_in_sm, remapping_request.size);
-#elif (IDEAL_SINGLE_MEMPOD == ENABLE)
-            is_updated = update_swapping_segments(remapping_request.h_address_in_fm, remapping_request.h_address_in_sm, remapping_request.size);
-#endif // IDEAL_LINE_LOCATION_TABLE, COLOCATED_LINE_LOCATION_TABLE, IDEAL_SINGLE_MEMPOD
-        }
-        else
-        {
-            std::cout << __func__ << ": issue_remapping_request error 2." << std::endl;
-            assert(false);
-        }
-
-        if (is_updated == false)
-        {
-            os_transparent_management.finish_remapping_request();
-            initialize_swapping();
-        }
-#else
-
-        initialize_swapping();
-#endif // MEMORY_USE_OS_TRANSPARENT_MANAGEMENT
-    }
-    break;
-    default:
-        break;
-    }
-#else
-
-#if (MEMORY_USE_OS_TRANSPARENT_MANAGEMENT == ENABLE)
-    // Since we don't consider data swapping overhead here, the data swapping is finished immediately
-    OS_TRANSPARENT_MANAGEMENT::RemappingRequest remapping_request;
-    bool issue = os_transparent_management.issue_remapping_request(remapping_request);
-    if (issue == true) // Get a new remapping request.
-    {
-        os_transparent_management.finish_remapping_request();
-    }
-#endif // MEMORY_USE_OS_TRANSPARENT_MANAGEMENT
-#endif // MEMORY_USE_SWAPPING_UNIT
-
-#if (MEMORY_USE_OS_TRANSPARENT_MANAGEMENT == ENABLE)
-#if (IDEAL_SINGLE_MEMPOD == ENABLE)
-    os_transparent_management.check_interval_swap(swapping_states, warmup);
-#endif // IDEAL_SINGLE_MEMPOD
-#endif // MEMORY_USE_OS_TRANSPARENT_MANAGEMENT
-
-    /* Operate memories below */
-    static double leap_operation = 0, leap_operation2 = 0;
-    // Skip periodically
-    if (leap_operation >= 1)
-    {
-        leap_operation -= 1;
-    }
-    else
-    {
-        memory.tick();
-        leap_operation += clock_scale;
-    }
-
-    if (leap_operation2 >= 1)
-    {
-        leap_operation2 -= 1;
-    }
-    else
-    {
-        memory2.tick();
-        leap_operation2 += clock_scale2;
-    }
-
-    Stats::curTick++; // Processor clock, global, for Statistics
-
-    return ++progress;
-}
-
-template<typename T, typename T2>
-void MEMORY_CONTROLLER<T, T2>::begin_phase()
-{
-    for (auto ul : queues)
-    {
-        channel_type::stats_type ul_new_roi_stats, ul_new_sim_stats;
-        ul->roi_stats = ul_new_roi_stats;
-        ul->sim_stats = ul_new_sim_stats;
-    }
-}
-
-template<typename T, typename T2>
-void MEMORY_CONTROLLER<T, T2>::end_phase(unsigned)
-{
-    /** No code here */
-}
-
-// LCOV_EXCL_START Exclude the following function from LCOV
-template<typename T, typename T2>
-void MEMORY_CONTROLLER<T, T2>::print_deadlock()
-{
-    std::printf("MEMORY_CONTROLLER %s.\n", __func__);
-
-#if (MEMORY_USE_SWAPPING_UNIT == ENABLE)
-    std::printf("base_address[0]: %ld, base_address[1]: %ld.\n", base_address[0], base_address[1]);
-#endif // MEMORY_USE_SWAPPING_UNIT
-}
-
-// LCOV_EXCL_STOP
-
-template<typename T, typename T2>
-std::size_t MEMORY_CONTROLLER<T, T2>::size() const
-{
-    return (memory.max_address + memory2.max_address);
-}
-
-template<typename T, typename T2>
-void MEMORY_CONTROLLER<T, T2>::initiate_requests()
-{
-    // Initiate read requests
-    for (auto ul : queues)
-    {
-        for (auto q : {std::ref(ul->RQ), std::ref(ul->PQ)})
-        {
-            auto [begin, end] = champsim::get_span_p(std::cbegin(q.get()), std::cend(q.get()), [ul, this](const auto& pkt)
-                { 
-                    request_type packet = pkt;
-                    return this->add_rq(packet, ul); }); // Add read requests
-            q.get().erase(begin, end);
-        }
-
-        // Initiate write requests
-        auto [wq_begin, wq_end] = champsim::get_span_p(std::cbegin(ul->WQ), std::cend(ul->WQ), [this](const auto& pkt)
-            { 
-                request_type packet = pkt;
-                return this->add_wq(packet); }); // Add write requests
-        ul->WQ.erase(wq_begin, wq_end);
-    }
-}
-
-template<typename T, typename T2>
-bool MEMORY_CONTROLLER<T, T2>::add_rq(request_type& packet, champsim::channel* ul)
-{
-    const static ramulator::Request::Type type = ramulator::Request::Type::READ; // It means the input request is read request.
-
-#if (TRACKING_LOAD_STORE_STATISTICS == ENABLE)
-    access_type type_origin = packet.type_origin;
-#endif // TRACKING_LOAD_STORE_STATISTICS
-
-    /* Operate research proposals below */
-#if (MEMORY_USE_OS_TRANSPARENT_MANAGEMENT == ENABLE)
-    os_transparent_management.physical_to_hardware_address(packet);
-#if (TRACKING_LOAD_STORE_STATISTICS == ENABLE)
-    os_transparent_management.memory_activity_tracking(packet.address, type, packet.type_origin, float(get_occupancy(type, packet.address)) / get_size(type, packet.address));
-#else
-    os_transparent_management.memory_activity_tracking(packet.address, type, float(get_occupancy(type, packet.address)) / get_size(type, packet.address));
-#endif // TRACKING_LOAD_STORE_STATISTICS
-#endif // MEMORY_USE_OS_TRANSPARENT_MANAGEMENT
-
-#if (MEMORY_USE_SWAPPING_UNIT == ENABLE)
-    /* Check swapping below */
-    uint8_t under_swapping = check_request(packet, type);
-    switch (under_swapping)
-    {
-    case 0: // This address is under swapping.
-    {
-        return false; // Queue is full, note Ramulator doesn't merge requests.
-    }
-    break;
-    case 1: // This address is not under swapping.
-        break;
-    case 2: // Though this address is under swapping, we can service its request because the data is in the swapping buffer.
-    {
-        response_type response {packet.address, packet.v_address, packet.data, packet.pf_metadata, packet.instr_depend_on_me};
-
-        for (auto ret : {&ul->returned})
-        {
-            ret->push_back(response); // Fill the response into the response queue
-        }
-
-        return true; // Fast-forward
-    }
-    break;
-    default:
-        break;
-    }
-#endif // MEMORY_USE_SWAPPING_UNIT
-
-    DRAM_CHANNEL::request_type rq_it = DRAM_CHANNEL::request_type {packet};
-    rq_it.forward_checked            = false;
-    rq_it.event_cycle                = current_cycle;
-    if (packet.response_requested)
-        rq_it.to_return = {&ul->returned}; // Store the response queue to communicate with the LLC
-
-    /* Send memory request below */
-    bool stall = true;
-
-    uint64_t address;
-#if (MEMORY_USE_OS_TRANSPARENT_MANAGEMENT == ENABLE)
-    address = rq_it.h_address = packet.h_address;
-#if (COLOCATED_LINE_LOCATION_TABLE == ENABLE)
-    bool is_sm_request = false; // Whether this request is mapped in slow memory according to the LLT.
-    if (memory.max_address <= address)
-    {
-        is_sm_request = true;
-        address = rq_it.h_address_fm = packet.h_address_fm; // Pretend to access the Location Entry and Data (LEAD) in fast memory
-
-        if (memory.max_address <= address)
-        {
-            std::cout << __func__ << ": co_located LLT error, h_address_fm is uncorrect." << std::endl;
-            abort();
-        }
-
-        // Check incomplete_read_request_queue's size
-        if (os_transparent_management.incomplete_read_request_queue.size() >= INCOMPLETE_READ_REQUEST_QUEUE_LENGTH)
-        {
-            return false;
-        }
-    }
-#endif // COLOCATED_LINE_LOCATION_TABLE
-
-#else
-    address = packet.address;
-#endif // MEMORY_USE_OS_TRANSPARENT_MANAGEMENT
-
-    // Assign the request to the right memory.
-    if (address < memory.max_address)
-    {
-        ramulator::Request request(address, type, std::bind(&MEMORY_CONTROLLER<T, T2>::return_data, this, placeholders::_1), rq_it, packet.cpu, memory_id);
-        stall = ! memory.send(request);
-
-        if (stall == false)
-        {
-            read_request_in_memory++;
-
-#if (TRACKING_LOAD_STORE_STATISTICS == ENABLE)
-            if (warmup == false)
-            {
-                if (type_origin == access_type::LOAD || type_origin == access_type::TRANSLATION)
-                {
-                    load_request_in_memory++;
-                }
-                else if (type_origin == access_type::RFO)
-                {
-                    store_request_in_memory++;
-                }
-            }
-#endif // TRACKING_LOAD_STORE_STATISTICS
-
-#if (COLOCATED_LINE_LOCATION_TABLE == ENABLE)
-            if (is_sm_request)
-            {
-                read_request_in_memory--;
-
-                OS_TRANSPARENT_MANAGEMENT::ReadRequest read_request;
-                // Create new read_request
-                read_request.packet           = packet;
-                read_request.fm_access_finish = false;
-
-                os_transparent_management.incomplete_read_request_queue.push_back(read_request);
-            }
-#endif // COLOCATED_LINE_LOCATION_TABLE
-        }
-    }
-    else if (address < memory.max_address + memory2.max_address)
-    {
-        // The memory itself doesn't know other memories' space, so we manage the overall mapping.
-        ramulator::Request request(address - memory.max_address, type, std::bind(&MEMORY_CONTROLLER<T, T2>::return_data, this, placeholders::_1), rq_it, packet.cpu, memory2_id);
-        stall = ! memory2.send(request);
-
-        if (stall == false)
-        {
-            read_request_in_memory2++;
-        }
-
-#if (TRACKING_LOAD_STORE_STATISTICS == ENABLE)
-        if (type_origin == access_type::LOAD || type_origin == access_type::TRANSLATION)
-        {
-            load_request_in_memory2++;
-        }
-        else if (type_origin == access_type::RFO)
-        {
-            store_request_in_memory2++;
-        }
-        else
-        {
-            std::printf("%s: Error!\n", __FUNCTION__);
-        }
-#endif // TRACKING_LOAD_STORE_STATISTICS
-    }
-    else
-    {
-        std::printf("%s: Error!\n", __FUNCTION__);
-    }
-
-#if (PRINT_MEMORY_TRACE == ENABLE)
-    // Output memory trace
-    output_memorytrace.output_memory_trace_hexadecimal(address, 'R');
-#endif // PRINT_MEMORY_TRACE
-
-    if (stall == true)
-    {
-        return false; // Queue is full, note Ramulator doesn't merge requests.
-    }
-    else
-    {
-        return true;
-    }
-}
-
-template<typename T, typename T2>
-bool MEMORY_CONTROLLER<T, T2>::add_wq(request_type& packet)
-{
-    const static ramulator::Request::Type type = ramulator::Request::Type::WRITE; // It means the input request is write request.
-
-    /* Operate research proposals below */
-#if (MEMORY_USE_OS_TRANSPARENT_MANAGEMENT == ENABLE)
-    os_transparent_management.physical_to_hardware_address(packet);
-#if (TRACKING_LOAD_STORE_STATISTICS == ENABLE)
-    os_transparent_management.memory_activity_tracking(packet.address, type, packet.type_origin, float(get_occupancy(type, packet.address)) / get_size(type, packet.address));
-#else
-    os_transparent_management.memory_activity_tracking(packet.address, type, float(get_occupancy(type, packet.address)) / get_size(type, packet.address));
-#endif // TRACKING_LOAD_STORE_STATISTICS
-#endif // MEMORY_USE_OS_TRANSPARENT_MANAGEMENT
-
-#if (MEMORY_USE_SWAPPING_UNIT == ENABLE)
-    /* Check swapping below */
-    uint8_t under_swapping = check_request(packet, type);
-    switch (under_swapping)
-    {
-    case 0: // This address is under swapping.
-    {
-        return false; // Queue is full, note Ramulator doesn't merge requests.
-    }
-    break;
-    case 1: // This address is not under swapping.
-        break;
-    case 2: // Though this address is under swapping, we can service its request because the data is in the swapping buffer.
-    {
-        return true; // Fast-forward
-    }
-    break;
-    default:
-        break;
-    }
-#endif // MEMORY_USE_SWAPPING_UNIT
-
-    DRAM_CHANNEL::request_type wq_it = DRAM_CHANNEL::request_type {packet};
-    wq_it.forward_checked            = false;
-    wq_it.event_cycle                = current_cycle;
-
-    /* Send memory request below */
-    bool stall                       = true;
-
-    uint64_t address;
-#if (MEMORY_USE_OS_TRANSPARENT_MANAGEMENT == ENABLE)
-    address = wq_it.h_address = packet.h_address;
-#if (COLOCATED_LINE_LOCATION_TABLE == ENABLE)
-    // Check incomplete_write_request_queue's size
-    if (os_transparent_management.incomplete_write_request_queue.size() >= INCOMPLETE_WRITE_REQUEST_QUEUE_LENGTH)
-    {
-        return false;
-    }
-
-    address = wq_it.h_address_fm = packet.h_address_fm; // Pretend to access the Location Entry and Data (LEAD) in fast memory
-    ramulator::Request request(address, ramulator::Request::Type::READ, std::bind(&MEMORY_CONTROLLER<T, T2>::return_data, this, placeholders::_1), wq_it, packet.cpu, memory_id);
-    stall = ! memory.send(request);
-
-    if (stall == false)
-    {
-        OS_TRANSPARENT_MANAGEMENT::WriteRequest write_request;
-        // Create new write_request
-        write_request.packet           = packet;
-        write_request.fm_access_finish = false;
-
-        os_transparent_management.incomplete_write_request_queue.push_back(write_request);
-
-        return true;
-    }
-    else
-    {
-        return false;
-    }
-#endif // COLOCATED_LINE_LOCATION_TABLE
-
-#else
-    address = packet.address;
-#endif // MEMORY_USE_OS_TRANSPARENT_MANAGEMENT
-
-    // Assign the request to the right memory.
-    if (address < memory.max_address)
-    {
-        ramulator::Request request(address, type, std::bind(&MEMORY_CONTROLLER<T, T2>::return_data, this, placeholders::_1), wq_it, packet.cpu, memory_id);
-        stall = ! memory.send(request);
-
-        if (stall == false)
-        {
-            write_request_in_memory++;
-        }
-    }
-    else if (address < memory.max_address + memory2.max_address)
-    {
-        // The memory itself doesn't know other memories' space, so we manage the overall mapping.
-        ramulator::Request request(address - memory.max_address, type, std::bind(&MEMORY_CONTROLLER<T, T2>::return_data, this, placeholders::_1), wq_it, packet.cpu, memory2_id);
-        stall = ! memory2.send(request);
-
-        if (stall == false)
-        {
-            write_request_in_memory2++;
-        }
-    }
-    else
-    {
-        std::printf("%s: Error!\n", __FUNCTION__);
-    }
-
-#if (PRINT_MEMORY_TRACE == ENABLE)
-    // Output memory trace.
-    output_memorytrace.output_memory_trace_hexadecimal(address, 'W');
-#endif // PRINT_MEMORY_TRACE
-
-    if (stall == true)
-    {
-        return false; // Queue is full, note Ramulator doesn't merge requests.
-    }
-    else
-    {
-        return true;
-    }
-}
-
-template<class T, class T2>
-uint32_t MEMORY_CONTROLLER<T, T2>::get_occupancy(ramulator::Request::Type queue_type, uint64_t address)
-{
-#if (MEMORY_USE_OS_TRANSPARENT_MANAGEMENT == ENABLE)
-    os_transparent_management.physical_to_hardware_address(address);
-#endif // MEMORY_USE_OS_TRANSPARENT_MANAGEMENT
-
-    // Assign the request to the right memory.
-    if (address < memory.max_address)
-    {
-        ramulator::Request request(address, queue_type);
-        return memory.get_queue_occupancy(request);
-    }
-    else if (address < memory.max_address + memory2.max_address)
-    {
-        // The memory itself doesn't know other memories' space, so we manage the overall mapping.
-        ramulator::Request request(address - memory.max_address, queue_type);
-        return memory2.get_queue_occupancy(request);
-    }
-    else
-    {
-        std::printf("%s: Error!\n", __FUNCTION__);
-    }
-
-    return 0;
-};
-
-template<class T, class T2>
-uint32_t MEMORY_CONTROLLER<T, T2>::get_size(ramulator::Request::Type queue_type, uint64_t address)
-{
-#if (MEMORY_USE_OS_TRANSPARENT_MANAGEMENT == ENABLE)
-    os_transparent_management.physical_to_hardware_address(address);
-#endif // MEMORY_USE_OS_TRANSPARENT_MANAGEMENT
-
-    // Assign the request to the right memory.
-    if (address < memory.max_address)
-    {
-        ramulator::Request request(address, queue_type);
-        return memory.get_queue_size(request);
-    }
-    else if (address < memory.max_address + memory2.max_address)
-    {
-        // The memory itself doesn't know other memories' space, so we manage the overall mapping.
-        ramulator::Request request(address - memory.max_address, queue_type);
-        return memory2.get_queue_size(request);
-    }
-    else
-    {
-        std::printf("%s: Error!\n", __FUNCTION__);
-    }
-
-    return 0;
-};
-
-template<typename T, typename T2>
-void MEMORY_CONTROLLER<T, T2>::return_data(ramulator::Request& request)
-{
-    // Recover the hardware address to physical address.
-    switch (request.memory_id)
-    {
-    case MEMORY_NUMBER_ONE:
-        // Nothing to do
-        break;
-    case MEMORY_NUMBER_TWO:
-        request.addr += memory.max_address;
-        break;
-    default:
-    {
-        std::cout << __func__ << ": return_data error." << std::endl;
-        assert(false);
-    }
-    break;
-    }
-
-#if (MEMORY_USE_OS_TRANSPARENT_MANAGEMENT == ENABLE) && (COLOCATED_LINE_LOCATION_TABLE == ENABLE)
-    bool finish_return_data = false;
-
-    if (uint64_t(request.addr) < memory.max_address)
-    {
-        // This could be an uncomplete write request
-        bool finish = os_transparent_management.finish_fm_access_in_incomplete_write_request_queue(request.packet.h_address);
-        if (finish)
-        {
-            finish_return_data = true;
-            return;
-        }
-    }
-
-    if ((uint64_t(request.addr) < memory.max_address) && (memory.max_address <= request.packet.h_address))
-    {
-        // This could be an uncomplete read request
-        bool finish = os_transparent_management.finish_fm_access_in_incomplete_read_request_queue(request.packet.h_address);
-
-        if (finish)
-        {
-            finish_return_data = true;
-            return;
-        }
-    }
-
-    if (finish_return_data == false)
-    {
-        // This is a complete read request
-        response_type response {request.packet.address, request.packet.v_address, request.packet.data, request.packet.pf_metadata, request.packet.instr_depend_on_me};
-
-        for (auto ret : request.packet.to_return)
-        {
-            ret->push_back(response); // Fill the response into the response queue
-        }
-    }
-
-#else
-    response_type response {request.packet.address, request.packet.v_address, request.packet.data, request.packet.pf_metadata, request.packet.instr_depend_on_me};
-
-    for (auto ret : request.packet.to_return)
-    {
-        ret->push_back(response); // Fill the response into the response queue
-    }
-#endif // MEMORY_USE_OS_TRANSPARENT_MANAGEMENT && COLOCATED_LINE_LOCATION_TABLE
-};
-
-#if (MEMORY_USE_SWAPPING_UNIT == ENABLE)
-
-// Functions for swapping:
-template<class T, class T2>
-void MEMORY_CONTROLLER<T, T2>::initialize_swapping()
-{
-    swapping_count += active_entry_number * 2;
-    swapping_traffic_in_bytes += active_entry_number * 2 * BLOCK_SIZE;
-
-    states = SwappingState::Idle;
-    for (auto i = 0; i < SWAPPING_BUFFER_ENTRY_NUMBER; i++)
-    {
-        buffer[i].finish = false;
-        for (auto j = 0; j < SWAPPING_SEGMENT_NUMBER; j++)
-        {
-            for (uint64_t z = 0; z < BLOCK_SIZE; z++)
-            {
-                buffer[i].data[j][z] = 0;
-            }
-            buffer[i].read_issue[j] = false;
-            buffer[i].read[j]       = false;
-            buffer[i].write[j]      = false;
-            buffer[i].dirty[j]      = false;
-        }
-    }
-
-    for (auto i = 0; i < SWAPPING_SEGMENT_NUMBER; i++)
-    {
-        base_address[i] = 0;
-    }
-    active_entry_number = finish_number = 0;
-}
-
-// Input address should be hardware address and at byte granularity
-template<class T, class T2>
-bool MEMORY_CONTROLLER<T, T2>::start_swapping_segments(uint64_t address_1, uint64_t address_2, uint8_t size)
-{
-    assert(size <= SWAPPING_BUFFER_ENTRY_NUMBER);
-
-    if (states == SwappingState::Idle)
-    {
-        states              = SwappingState::Swapping;      // Start swapping.
-        base_address[0]     = address_1 >> LOG2_BLOCK_SIZE; // The single swapping is conducted at cache line granularity.
-        base_address[1]     = address_2 >> LOG2_BLOCK_SIZE;
-        active_entry_number = size;
-    }
-    else
-    {
-        return false; // This swapping unit is busy, it cannot issue new swapping request.
-    }
-    return true; // New swapping is issued.
-}
-
-// Input address should be hardware address and at byte granularity
-template<class T, class T2>
-bool MEMORY_CONTROLLER<T, T2>::update_swapping_segments(uint64_t address_1, uint64_t address_2, uint8_t size)
-{
-    assert(size <= SWAPPING_BUFFER_ENTRY_NUMBER);
-
-    uint64_t input_base_address[SWAPPING_SEGMENT_NUMBER];
-
-    input_base_address[0] = address_1 >> LOG2_BLOCK_SIZE;
-    input_base_address[1] = address_2 >> LOG2_BLOCK_SIZE;
-
-    if ((input_base_address[0] == base_address[0]) && (input_base_address[1] == base_address[1]))
-    {
-        // They are same swapping segments
-        if (size > active_entry_number)
-        {
-            // There have new data to swap
-            active_entry_number = size;
-            if (states == SwappingState::Idle)
-            {
-                states = SwappingState::Swapping; // Start swapping.
-            }
-
-            return true; // Update swapping segments
-        }
-    }
-
-    return false;
-}
-
-template<class T, class T2>
-uint8_t MEMORY_CONTROLLER<T, T2>::operate_swapping()
-{
-    const static int coreid = 0;
-
-    switch (states)
-    {
-    case SwappingState::Idle:
-    {
-        return 0; // Idle
-    }
-    break;
-    case SwappingState::Swapping:
-    {
-        // Issue read requests
-        for (auto i = 0; i < active_entry_number; i++) // Go through the active buffer
-        {
-            if (buffer[i].finish == false)
-            {
-                for (auto j = 0; j < SWAPPING_SEGMENT_NUMBER; j++)
-                {
-                    if (buffer[i].read_issue[j] == false)
-                    {
-                        bool stall       = true;
-                        uint64_t address = (base_address[j] + i) << LOG2_BLOCK_SIZE;
-
-                        // Assign the request to the right memory.
-                        if (address < memory.max_address)
-                        {
-                            ramulator::Request request(address, ramulator::Request::Type::READ, std::bind(&MEMORY_CONTROLLER<T, T2>::return_swapping_data, this, placeholders::_1), coreid, memory_id);
-                            stall = ! memory.send(request);
-                        }
-                        else if (address < memory.max_address + memory2.max_address)
-                        {
-                            // The memory itself doesn't know other memories' space, so we manage the overall mapping.
-                            ramulator::Request request(address - memory.max_address, ramulator::Request::Type::READ, std::bind(&MEMORY_CONTROLLER<T, T2>::return_swapping_data, this, placeholders::_1), coreid, memory2_id);
-                            stall = ! memory2.send(request);
-                        }
-                        else
-                        {
-                            std::printf("%s: Error!\n", __FUNCTION__);
-                        }
-
-#if (PRINT_MEMORY_TRACE == ENABLE)
-                        // Output memory trace.
-                        output_memorytrace.output_memory_trace_hexadecimal(address, 'R');
-#endif // PRINT_MEMORY_TRACE
-
-                        if (stall == true)
-                        {
-                            // Queue is full
-                        }
-                        else
-                        {
-                            buffer[i].read_issue[j] = true;
-                        }
-                    }
-                }
-            }
-        }
-
-        // Issue write requests
-        for (auto i = 0; i < active_entry_number; i++) // Go through the active buffer
-        {
-            if (buffer[i].finish == false)
-            {
-                if ((buffer[i].read[0] == true) && (buffer[i].read[1] == true)) // Read requests are finished
-                {
-                    for (auto j = 0; j < SWAPPING_SEGMENT_NUMBER; j++)
-                    {
-                        if ((buffer[i].write[j] == false) || (buffer[i].dirty[j] == true))
-                        {
-                            bool stall       = true;
-                            uint64_t address = (base_address[j] + i) << LOG2_BLOCK_SIZE;
-
-                            // Assign the request to the right memory.
-                            if (address < memory.max_address)
-                            {
-                                ramulator::Request request(address, ramulator::Request::Type::WRITE, NULL, coreid, memory_id);
-                                // Get data from buffer
-                                request.data = buffer[i].data[j];
-                                stall        = ! memory.send(request);
-                            }
-                            else if (address < memory.max_address + memory2.max_address)
-                            {
-                                // The memory itself doesn't know other memories' space, so we manage the overall mapping.
-                                ramulator::Request request(address - memory.max_address, ramulator::Request::Type::WRITE, NULL, coreid, memory2_id);
-                                // Get data from buffer
-                                request.data = buffer[i].data[j];
-                                stall        = ! memory2.send(request);
-                            }
-                            else
-                            {
-                                std::printf("%s: Error!\n", __FUNCTION__);
-                            }
-
-#if (PRINT_MEMORY_TRACE == ENABLE)
-                            // Output memory trace.
-                            output_memorytrace.output_memory_trace_hexadecimal(address, 'W');
-#endif // PRINT_MEMORY_TRACE
-
-                            if (stall == true)
-                            {
-                                // Queue is full
-                            }
-                            else
-                            {
-                                if (buffer[i].write[j] == false)
-                                {
-                                    buffer[i].write[j] = true;
-                                }
-                                if (buffer[i].dirty[j] == true)
-                                {
-                                    buffer[i].dirty[j] = false;
-                                }
-
-#if (TEST_SWAPPING_UNIT == ENABLE)
-                                memory_data[i + j * MEMORY_DATA_NUMBER / 2] = buffer[i].data[j];
-#endif // TEST_SWAPPING_UNIT
-                            }
-                        }
-                    }
-                }
-
-                // Finish swapping
-                if ((buffer[i].write[0] == true) && (buffer[i].write[1] == true))
-                {
-                    buffer[i].finish = true;
-                    finish_number++;
-                }
-            }
-        }
-
-        // Check finish_number
-        if (finish_number == active_entry_number)
-        {
-            states = SwappingState::Idle;
-            return 2; // Finished swapping
-        }
-
-        return 1; // Swapping
-    }
-    break;
-    default:
-        break;
-    }
-
-    return 3; // No meaning, it should never come here.
-}
-
-// This function is used by memories, like Ramulator.
-template<class T, class T2>
-void MEMORY_CONTROLLER<T, T2>::return_swapping_data(ramulator::Request& request)
-{
-    // Sanity check
-    // assert(states == SwappingState::Swapping);
-    if (states == SwappingState::Idle)
-    {
-        std::cout << __func__ << ": data is returned while swapping is already finished." << std::endl;
-        return;
-    }
-
-    // Recover the hardware address to physical address.
-    switch (request.memory_id)
-    {
-    case MEMORY_NUMBER_ONE:
-        // Nothing to do
-        break;
-    case MEMORY_NUMBER_TWO:
-        request.addr += memory.max_address;
-        break;
-    default:
-    {
-        std::cout << __func__ << ": swapping error." << std::endl;
-        assert(false);
-    }
-    break;
-    }
-
-    uint64_t address = request.addr >> LOG2_BLOCK_SIZE;
-    uint8_t segment_index;
-    uint8_t entry_index;
-    // Calculate entry index in the fashion of little-endian.
-    if ((base_address[SWAPPING_SEGMENT_ONE] <= address) && (address < (base_address[SWAPPING_SEGMENT_ONE] + active_entry_number)))
-    {
-        segment_index = SWAPPING_SEGMENT_TWO;
-        entry_index   = static_cast<uint8_t>(address - base_address[SWAPPING_SEGMENT_ONE]);
-
-#if (TEST_SWAPPING_UNIT == ENABLE)
-        request.data = memory_data[entry_index];
-#endif // TEST_SWAPPING_UNIT
-    }
-    else if ((base_address[SWAPPING_SEGMENT_TWO] <= address) && (address < (base_address[SWAPPING_SEGMENT_TWO] + active_entry_number)))
-    {
-        segment_index = SWAPPING_SEGMENT_ONE;
-        entry_index   = static_cast<uint8_t>(address - base_address[SWAPPING_SEGMENT_TWO]);
-
-#if (TEST_SWAPPING_UNIT == ENABLE)
-        request.data = memory_data[entry_index + MEMORY_DATA_NUMBER / 2];
-#endif // TEST_SWAPPING_UNIT
-    }
-    else
-    {
-        std::cout << __func__ << ": swapping error." << std::endl;
-        assert(false);
-    }
-
-    // Read data
-    if ((buffer[entry_index].finish == false) && (buffer[entry_index].write[segment_index] == false) && (buffer[entry_index].dirty[segment_index] == false))
-    {
-        buffer[entry_index].data[segment_index] = request.data;
-        buffer[entry_index].read[segment_index] = true;
-    }
-};
-
-template<class T, class T2>
-uint8_t MEMORY_CONTROLLER<T, T2>::check_request(request_type& packet, ramulator::Request::Type type)
-{
-    uint64_t address;
-#if (MEMORY_USE_OS_TRANSPARENT_MANAGEMENT == ENABLE)
-    address = packet.h_address;
-#else
-    address = packet.address;
-#endif
-
-    address >>= LOG2_BLOCK_SIZE;
-    uint8_t segment_index;
-    uint8_t entry_index;
-    // Calculate entry index in the fashion of little-endian.
-    if ((base_address[SWAPPING_SEGMENT_ONE] <= address) && (address < (base_address[SWAPPING_SEGMENT_ONE] + active_entry_number)))
-    {
-        segment_index = SWAPPING_SEGMENT_ONE;
-        entry_index   = static_cast<uint8_t>(address - base_address[SWAPPING_SEGMENT_ONE]);
-    }
-    else if ((base_address[SWAPPING_SEGMENT_TWO] <= address) && (address < (base_address[SWAPPING_SEGMENT_TWO] + active_entry_number)))
-    {
-        segment_index = SWAPPING_SEGMENT_TWO;
-        entry_index   = static_cast<uint8_t>(address - base_address[SWAPPING_SEGMENT_TWO]);
-    }
-    else
-    {
-        return 1; // This address is not under swapping.
-    }
-
-    if (type == ramulator::Request::Type::READ) // For read request
-    {
-        if ((buffer[entry_index].finish == true) || (buffer[entry_index].read[segment_index] == true) || (buffer[entry_index].write[segment_index] == true) || (buffer[entry_index].dirty[segment_index] == true))
-        {
-            uint64_t& read_data = *((uint64_t*) (&buffer[entry_index].data[segment_index])); // Note the PACKET only has 64 bit data.
-            packet.data         = read_data;
-
-            return 2; // Though this address is under swapping, we can service its request because the data is in the swapping buffer.
-        }
-    }
-    else if (type == ramulator::Request::Type::WRITE) // For write request
-    {
-        if ((buffer[entry_index].read[0] == true) && (buffer[entry_index].read[1] == true))
-        {
-            uint64_t& write_data                     = *((uint64_t*) (&buffer[entry_index].data[segment_index])); // Note the PACKET only has 64 bit data.
-            write_data                               = packet.data;
-            buffer[entry_index].dirty[segment_index] = true;
-
-            if (buffer[entry_index].finish == true)
-            {
-                --finish_number;
-            }
-            buffer[entry_index].finish = false;
-
-            return 2; // Though this address is under swapping, we can service its request because the data is in the swapping buffer.
-        }
-    }
-    else
-    {
-        std::cout << __func__ << ": type input error." << std::endl;
-        assert(false);
-    }
-
-    return 0; // This address is under swapping.
-};
-
-template<class T, class T2>
-uint8_t MEMORY_CONTROLLER<T, T2>::check_address(uint64_t address, uint8_t type)
-{
-#if (MEMORY_USE_OS_TRANSPARENT_MANAGEMENT == ENABLE)
-    os_transparent_management.physical_to_hardware_address(address);
-#else
-#endif // MEMORY_USE_OS_TRANSPARENT_MANAGEMENT
-
-    address >>= LOG2_BLOCK_SIZE;
-    uint8_t segment_index;
-    uint8_t entry_index;
-    // Calculate entry index in the fashion of little-endian.
-    if ((base_address[SWAPPING_SEGMENT_ONE] <= address) && (address < (base_address[SWAPPING_SEGMENT_ONE] + active_entry_number)))
-    {
-        segment_index = SWAPPING_SEGMENT_ONE;
-        entry_index   = static_cast<uint8_t>(address - base_address[SWAPPING_SEGMENT_ONE]);
-    }
-    else if ((base_address[SWAPPING_SEGMENT_TWO] <= address) && (address < (base_address[SWAPPING_SEGMENT_TWO] + active_entry_number)))
-    {
-        segment_index = SWAPPING_SEGMENT_TWO;
-        entry_index   = static_cast<uint8_t>(address - base_address[SWAPPING_SEGMENT_TWO]);
-    }
-    else
-    {
-        return 1; // This address is not under swapping.
-    }
-
-    if (type == 1) // For read request
-    {
-        if ((buffer[entry_index].finish == true) || (buffer[entry_index].read[segment_index] == true) || (buffer[entry_index].write[segment_index] == true) || (buffer[entry_index].dirty[segment_index] == true))
-        {
-            return 2; // Though this address is under swapping, we can service its request because the data is in the swapping buffer.
-        }
-    }
-    else if (type == 2) // For write request
-    {
-        if ((buffer[entry_index].read[0] == true) && (buffer[entry_index].read[1] == true))
-        {
-            return 2; // Though this address is under swapping, we can service its request because the data is in the swapping buffer.
-        }
-    }
-    else
-    {
-        std::cout << __func__ << ": type input error." << std::endl;
-        assert(false);
-    }
-
-    return 0; // This address is under swapping.
-};
-
-#endif // MEMORY_USE_SWAPPING_UNIT
-
 #else
 
-template<typename T>
 class MEMORY_CONTROLLER : public champsim::operable
 {
     double clock_scale  = MEMORY_CONTROLLER_CLOCK_SCALE;
 
+    // Fractional clock counter that decides in which cycles the memory ticks
+    double leap_operation_memory = 0;
+
     using channel_type  = champsim::channel;
     using request_type  = typename channel_type::request_type;
     using response_type = typename channel_type::response_type;
@@ -1386,9 +216,18 @@ class MEMORY_CONTROLLER : public champsim::operable
     bool add_rq(const request_type& pkt, champsim::channel* ul);
     bool add_wq(const request_type& pkt);
 
+    // The packets of the read requests in the memories, which return their data to the upper levels
+    ramulator::PacketPool packets;
+
+    // Send a read request to the memory, which keeps its packet in packets until the data is returned
+    bool send_read(ramulator::MemoryBase& target, uint64_t address, const DRAM_CHANNEL::request_type& packet, uint32_t cpu, uint8_t target_id);
+
+    // Return the data of the reads the memory completed in its last tick, in the order they completed
+    void drain_completions(ramulator::MemoryBase& target);
+
 public:
     // Note here they are the references to escape memory deallocation here.
-    ramulator::Memory<T, ramulator::Controller>& memory;
+    ramulator::MemoryBase& memory;
 
     const uint8_t memory_id = 0;
 
@@ -1396,7 +235,7 @@ public:
     uint64_t write_request_in_memory;
 
     /* Member functions */
-    MEMORY_CONTROLLER(double freq_scale, double clock_scale, std::vector<channel_type*>&& ul, ramulator::Memory<T, ramulator::Controller>& memory);
+    MEMORY_CONTROLLER(double freq_scale, double clock_scale, std::vector<channel_type*>&& ul, ramulator::MemoryBase& memory);
     ~MEMORY_CONTROLLER();
 
     void initialize() override final;
@@ -1405,6 +244,13 @@ public:
     void end_phase(unsigned cpu) override final;
     void print_deadlock() override final;
 
+#if (IDLE_CYCLE_SKIPPING == ENABLE)
+    uint64_t idle_cycles(uint64_t bound) override final;
+    void skip_cycles(uint64_t cycles) override final;
+#endif // IDLE_CYCLE_SKIPPING
+
+    void checkpoint(champsim::checkpoint_archive& archive) override final;
+
     std::size_t size() const;
 
     /** @brief
@@ -1420,270 +266,11 @@ public:
     uint32_t get_size(ramulator::Request::Type queue_type, uint64_t address);
 
     void return_data(ramulator::Request& request);
-};
-
-template<typename T>
-MEMORY_CONTROLLER<T>::MEMORY_CONTROLLER(double freq_scale, double clock_scale, std::vector<channel_type*>&& ul, ramulator::Memory<T, ramulator::Controller>& memory)
-: champsim::operable(freq_scale), clock_scale(clock_scale),
-  queues(std::move(ul)), memory(memory)
-{
-    std::printf("clock_scale: %f.\n", clock_scale);
-
-    read_request_in_memory  = 0;
-    write_request_in_memory = 0;
-}
-
-template<typename T>
-MEMORY_CONTROLLER<T>::~MEMORY_CONTROLLER()
-{
-    // Print information to output_statistics
-    output_statistics.read_request_in_memory  = read_request_in_memory;
-    output_statistics.write_request_in_memory = write_request_in_memory;
-}
-
-template<typename T>
-void MEMORY_CONTROLLER<T>::initialize()
-{
-    long long int dram_size = memory.max_address / MiB; // in MiB
-
-    fmt::print("Memory Subsystem Size: ");
-#if (PRINT_STATISTICS_INTO_FILE == ENABLE)
-    std::fprintf(output_statistics.file_handler, "Memory Subsystem Size: ");
-#endif // PRINT_STATISTICS_INTO_FILE
-
-    if (dram_size > 1024)
-    {
-        fmt::print("{} GiB", dram_size / 1024);
-#if (PRINT_STATISTICS_INTO_FILE == ENABLE)
-        std::fprintf(output_statistics.file_handler, "%lld GiB", dram_size / 1024);
-#endif // PRINT_STATISTICS_INTO_FILE
-    }
-    else
-    {
-        fmt::print("{} MiB", dram_size);
-#if (PRINT_STATISTICS_INTO_FILE == ENABLE)
-        std::fprintf(output_statistics.file_handler, "%lld MiB", dram_size);
-#endif // PRINT_STATISTICS_INTO_FILE
-    }
-
-    fmt::print("\n");
-#if (PRINT_STATISTICS_INTO_FILE == ENABLE)
-    std::fprintf(output_statistics.file_handler, "\n");
-#endif // PRINT_STATISTICS_INTO_FILE
-}
-
-template<typename T>
-long MEMORY_CONTROLLER<T>::operate()
-{
-    long progress {0};
-
-    initiate_requests();
-
-    /* Operate memories below */
-    static double leap_operation = 0;
-    // Skip periodically
-    if (leap_operation >= 1)
-    {
-        leap_operation -= 1;
-    }
-    else
-    {
-        memory.tick();
-        leap_operation += clock_scale;
-    }
-
-    Stats::curTick++; // Processor clock, global, for Statistics
-
-    return ++progress;
-}
-
-template<typename T>
-void MEMORY_CONTROLLER<T>::begin_phase()
-{
-    for (auto ul : queues)
-    {
-        channel_type::stats_type ul_new_roi_stats, ul_new_sim_stats;
-        ul->roi_stats = ul_new_roi_stats;
-        ul->sim_stats = ul_new_sim_stats;
-    }
-}
-
-template<typename T>
-void MEMORY_CONTROLLER<T>::end_phase(unsigned)
-{
-    /** No code here */
-}
-
-// LCOV_EXCL_START Exclude the following function from LCOV
-template<typename T>
-void MEMORY_CONTROLLER<T>::print_deadlock()
-{
-    std::printf("MEMORY_CONTROLLER %s.\n", __func__);
-}
 
-// LCOV_EXCL_STOP
-
-template<typename T>
-std::size_t MEMORY_CONTROLLER<T>::size() const
-{
-    return memory.max_address;
-}
-
-template<typename T>
-void MEMORY_CONTROLLER<T>::initiate_requests()
-{
-    // Initiate read requests
-    for (auto ul : queues)
-    {
-        for (auto q : {std::ref(ul->RQ), std::ref(ul->PQ)})
-        {
-            auto [begin, end] = champsim::get_span_p(std::cbegin(q.get()), std::cend(q.get()), [ul, this](const auto& pkt)
-                { return this->add_rq(pkt, ul); }); // Add read requests
-            q.get().erase(begin, end);
-        }
-
-        // Initiate write requests
-        auto [wq_begin, wq_end] = champsim::get_span_p(std::cbegin(ul->WQ), std::cend(ul->WQ), [this](const auto& pkt)
-            { return this->add_wq(pkt); }); // Add write requests
-        ul->WQ.erase(wq_begin, wq_end);
-    }
-}
-
-template<typename T>
-bool MEMORY_CONTROLLER<T>::add_rq(const request_type& packet, champsim::channel* ul)
-{
-    const static ramulator::Request::Type type = ramulator::Request::Type::READ; // It means the input request is read request.
-
-    DRAM_CHANNEL::request_type rq_it           = DRAM_CHANNEL::request_type {packet};
-    rq_it.forward_checked                      = false;
-    rq_it.event_cycle                          = current_cycle;
-    if (packet.response_requested)
-        rq_it.to_return = {&ul->returned}; // Store the response queue to communicate with the LLC
-
-    /* Send memory request below */
-    bool stall       = true;
-
-    uint64_t address = packet.address;
-
-    // Assign the request to the right memory.
-    if (address < memory.max_address)
-    {
-        ramulator::Request request(address, type, std::bind(&MEMORY_CONTROLLER<T>::return_data, this, placeholders::_1), rq_it, packet.cpu, memory_id);
-        stall = ! memory.send(request);
-
-        if (stall == false)
-        {
-            read_request_in_memory++;
-        }
-    }
-    else
-    {
-        std::printf("%s: Error!\n", __FUNCTION__);
-    }
-
-#if (PRINT_MEMORY_TRACE == ENABLE)
-    // Output memory trace
-    output_memorytrace.output_memory_trace_hexadecimal(address, 'R');
-#endif // PRINT_MEMORY_TRACE
-
-    if (stall == true)
-    {
-        return false; // Queue is full, note Ramulator doesn't merge requests.
-    }
-    else
-    {
-        return true;
-    }
-}
-
-template<typename T>
-bool MEMORY_CONTROLLER<T>::add_wq(const request_type& packet)
-{
-    const static ramulator::Request::Type type = ramulator::Request::Type::WRITE; // It means the input request is write request.
-
-    DRAM_CHANNEL::request_type wq_it           = DRAM_CHANNEL::request_type {packet};
-    wq_it.forward_checked                      = false;
-    wq_it.event_cycle                          = current_cycle;
-
-    /* Send memory request below */
-    bool stall                                 = true;
-
-    uint64_t address                           = packet.address;
-
-    // Assign the request to the right memory.
-    if (address < memory.max_address)
-    {
-        ramulator::Request request(address, type, std::bind(&MEMORY_CONTROLLER<T>::return_data, this, placeholders::_1), wq_it, packet.cpu, memory_id);
-        stall = ! memory.send(request);
-
-        if (stall == false)
-        {
-            write_request_in_memory++;
-        }
-    }
-    else
-    {
-        std::printf("%s: Error!\n", __FUNCTION__);
-    }
-
-#if (PRINT_MEMORY_TRACE == ENABLE)
-    // Output memory trace.
-    output_memorytrace.output_memory_trace_hexadecimal(address, 'W');
-#endif // PRINT_MEMORY_TRACE
-
-    if (stall == true)
-    {
-        return false; // Queue is full, note Ramulator doesn't merge requests.
-    }
-    else
-    {
-        return true;
-    }
-}
-
-template<class T>
-uint32_t MEMORY_CONTROLLER<T>::get_occupancy(ramulator::Request::Type queue_type, uint64_t address)
-{
-    // Assign the request to the right memory.
-    if (address < memory.max_address)
-    {
-        ramulator::Request request(address, queue_type);
-        return memory.get_queue_occupancy(request);
-    }
-    else
-    {
-        std::printf("%s: Error!\n", __FUNCTION__);
-    }
-
-    return 0;
-};
-
-template<class T>
-uint32_t MEMORY_CONTROLLER<T>::get_size(ramulator::Request::Type queue_type, uint64_t address)
-{
-    // Assign the request to the right memory.
-    if (address < memory.max_address)
-    {
-        ramulator::Request request(address, queue_type);
-        return memory.get_queue_size(request);
-    }
-    else
-    {
-        std::printf("%s: Error!\n", __FUNCTION__);
-    }
-
-    return 0;
-};
-
-template<typename T>
-void MEMORY_CONTROLLER<T>::return_data(ramulator::Request& request)
-{
-    response_type response {request.packet.address, request.packet.v_address, request.packet.data, request.packet.pf_metadata, request.packet.instr_depend_on_me};
-
-    for (auto ret : request.packet.to_return)
-    {
-        ret->push_back(response); // Fill the response into the response queue
-    }
+#if (FUNCTIONAL_WARMUP == ENABLE)
+    // A single memory has nothing to train without timing
+    void functional_access(const request_type&) {}
+#endif // FUNCTIONAL_WARMUP
 };
 
 #endif // MEMORY_USE_HYBRID
@@ -1811,6 +398,11 @@ public:
     uint32_t dram_get_bank(uint64_t address);
     uint32_t dram_get_row(uint64_t address);
     uint32_t dram_get_column(uint64_t address);
+
+#if (FUNCTIONAL_WARMUP == ENABLE)
+    // The DRAM model only has timing states
+    void functional_access(const request_type&) {}
+#endif // FUNCTIONAL_WARMUP
 };
 
 #endif // RAMULATOR
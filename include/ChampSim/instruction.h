@@ -25,6 +25,7 @@
 #include <vector>
 
 #include "ChampSim/trace_instruction.h"
+#include "ProjectConfiguration.h" // User file
 
 // branch types
 enum branch_type
@@ -39,6 +40,30 @@ enum branch_type
     BRANCH_OTHER         = 7
 };
 
+#if (USER_CODES == ENABLE)
+/** @brief
+ *  An instruction as the core model reads it, with its branch type and target resolved and its operands in fixed-width slots, so it can be
+ *  stored in a file and read back without decoding the trace again (see trace_cache.h).
+ */
+struct decoded_instr
+{
+    uint64_t ip;
+    uint64_t branch_target;
+    uint64_t destination_memory[NUM_INSTR_DESTINATIONS_SPARC];
+    uint64_t source_memory[NUM_INSTR_SOURCES];
+    uint8_t destination_registers[NUM_INSTR_DESTINATIONS_SPARC];
+    uint8_t source_registers[NUM_INSTR_SOURCES];
+    uint8_t num_destination_registers;
+    uint8_t num_source_registers;
+    uint8_t num_destination_memory;
+    uint8_t num_source_memory;
+    uint8_t is_branch;
+    uint8_t branch_taken;
+    uint8_t branch_type;
+    uint8_t asid[2];
+};
+#endif // USER_CODES
+
 struct ooo_model_instr
 {
     uint64_t instr_id                          = 0;
@@ -151,6 +176,38 @@ public:
 
     ooo_model_instr(uint8_t, cloudsuite_instr instr): ooo_model_instr(instr, {instr.asid[0], instr.asid[1]}) {}
 
+#if (USER_CODES == ENABLE)
+    ooo_model_instr(const decoded_instr& instr, std::array<uint8_t, 2> local_asid)
+        : ip(instr.ip), is_branch(instr.is_branch), branch_taken(instr.branch_taken), asid(local_asid), branch_type(instr.branch_type),
+          branch_target(instr.branch_target), destination_registers(instr.destination_registers, instr.destination_registers + instr.num_destination_registers),
+          source_registers(instr.source_registers, instr.source_registers + instr.num_source_registers),
+          destination_memory(instr.destination_memory, instr.destination_memory + instr.num_destination_memory),
+          source_memory(instr.source_memory, instr.source_memory + instr.num_source_memory)
+    {
+    }
+
+    decoded_instr to_decoded() const
+    {
+        decoded_instr result {};
+        result.ip                        = ip;
+        result.branch_target             = branch_target;
+        result.num_destination_registers = static_cast<uint8_t>(std::size(destination_registers));
+        result.num_source_registers      = static_cast<uint8_t>(std::size(source_registers));
+        result.num_destination_memory    = static_cast<uint8_t>(std::size(destination_memory));
+        result.num_source_memory         = static_cast<uint8_t>(std::size(source_memory));
+        result.is_branch                 = is_branch;
+        result.branch_taken              = branch_taken;
+        result.branch_type               = branch_type;
+        result.asid[0]                   = asid[0];
+        result.asid[1]                   = asid[1];
+        std::copy(std::begin(destination_registers), std::end(destination_registers), result.destination_registers);
+        std::copy(std::begin(source_registers), std::end(source_registers), result.source_registers);
+        std::copy(std::begin(destination_memory), std::end(destination_memory), result.destination_memory);
+        std::copy(std::begin(source_memory), std::end(source_memory), result.source_memory);
+        return result;
+    }
+#endif // USER_CODES
+
     std::size_t num_mem_ops() const { return std::size(destination_memory) + std::size(source_memory); }
 
     static bool program_order(const ooo_model_instr& lhs, const ooo_model_instr& rhs) { return lhs.instr_id < rhs.instr_id; }
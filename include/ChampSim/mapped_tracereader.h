@@ -0,0 +1,113 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MAPPED_TRACEREADER_H
+#define MAPPED_TRACEREADER_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+#include "ChampSim/instruction.h"
+#include "ProjectConfiguration.h" // User file
+
+#if (USER_CODES == ENABLE)
+
+namespace champsim
+{
+// A read-only mapping of a whole file, which the kernel reads ahead sequentially
+class mapped_file
+{
+    const char* base  = nullptr;
+    std::size_t bytes = 0;
+
+public:
+    explicit mapped_file(const std::string& file_name);
+    ~mapped_file();
+
+    mapped_file(mapped_file&& other) noexcept;
+    mapped_file& operator=(mapped_file&& other) noexcept;
+
+    mapped_file(const mapped_file&)            = delete;
+    mapped_file& operator=(const mapped_file&) = delete;
+
+    const char* data() const { return base; }
+
+    std::size_t size() const { return bytes; }
+
+    // Whether the file is a regular file, which can be mapped, rather than, e.g., a pipe or a FIFO
+    static bool can_map(const std::string& file_name);
+};
+
+#if (MEMORY_MAPPED_TRACES == ENABLE)
+/** @brief
+ *  Read an uncompressed trace through a mapped_file. Each instruction is inflated straight from its record in the mapping, and takes its branch
+ *  target from the record after it, so the records are never copied into buffers. As with bulk_tracereader, the last record is never read, since
+ *  its branch target is unknown.
+ */
+template<typename T>
+class mapped_tracereader
+{
+    static_assert(std::is_trivial_v<T>);
+    static_assert(std::is_standard_layout_v<T>);
+
+    uint8_t cpu;
+    mapped_file trace_file;
+    std::size_t records;
+    std::size_t position = 0; // The next record to read
+
+    T record(std::size_t index) const
+    {
+        T t;
+        std::memcpy(&t, trace_file.data() + index * sizeof(T), sizeof(T));
+        return t;
+    }
+
+public:
+    using trace_type = T;
+
+    mapped_tracereader(uint8_t cpu_idx, std::string tf): cpu(cpu_idx), trace_file(tf), records(trace_file.size() / sizeof(T)) {}
+
+    ooo_model_instr operator()()
+    {
+        ooo_model_instr retval {cpu, record(position)};
+        if (retval.is_branch && retval.branch_taken)
+        {
+            uint64_t target_ip;
+            std::memcpy(&target_ip, trace_file.data() + (position + 1) * sizeof(T) + offsetof(T, ip), sizeof(target_ip));
+            retval.branch_target = target_ip;
+        }
+        position++;
+        return retval;
+    }
+
+    uint64_t skip(uint64_t count)
+    {
+        auto skipped = std::min<uint64_t>(count, records - std::min(records, position + 1));
+        position += skipped;
+        return skipped;
+    }
+
+    bool eof() const { return position + 1 >= records; }
+};
+#endif // MEMORY_MAPPED_TRACES
+} // namespace champsim
+
+#endif // USER_CODES
+
+#endif
@@ -0,0 +1,57 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MEMORY_REPLAY_H
+#define MEMORY_REPLAY_H
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "ChampSim/channel.h"
+#include "ChampSim/operable.h"
+#include "ProjectConfiguration.h" // User file
+
+#if (USER_CODES == ENABLE) && (RAMULATOR == ENABLE)
+#include "Ramulator/Memory.h"
+
+namespace champsim
+{
+struct memory_replay_stats
+{
+    uint64_t reads  = 0;
+    uint64_t writes = 0;
+    uint64_t recorded_cycles = 0; // The cycles between the first and last replayed requests when recorded
+    uint64_t cycles          = 0; // The cycles of the memory controller until the memories finished the requests
+};
+
+/** @brief
+ *  Replay a binary memory trace into a memory controller, without the cores and caches (--replay-memory-trace). Each request taken by the
+ *  memories in the recording run is added to the upper channel of the controller at its recorded cycle, relative to the first request, from its
+ *  physical address, so the OS-transparent management and swapping unit of the controller remap and migrate the data by themselves. The
+ *  requests of the swapping unit in the trace are not replayed for the same reason.
+ *
+ *  The replay is open loop: the requests are added when they were recorded whatever the latencies of the replaying memories, since no core
+ *  waits for them, and wait in the channel while the memories are busy.
+ */
+memory_replay_stats replay_memory_trace(operable& controller, channel& upper, const std::vector<std::reference_wrapper<ramulator::MemoryBase>>& memories,
+    const std::string& file_name);
+} // namespace champsim
+
+#endif // USER_CODES, RAMULATOR
+
+#endif
@@ -49,6 +49,13 @@ enum STATUS
 
 class CACHE;
 
+#if (FUNCTIONAL_WARMUP == ENABLE)
+namespace champsim
+{
+class functional_warmup;
+} // namespace champsim
+#endif // FUNCTIONAL_WARMUP
+
 class CacheBus
 {
     using channel_type  = champsim::channel;
@@ -60,6 +67,10 @@ class CacheBus
 
     friend class O3_CPU;
 
+#if (FUNCTIONAL_WARMUP == ENABLE)
+    friend class champsim::functional_warmup;
+#endif // FUNCTIONAL_WARMUP
+
 public:
     CacheBus(uint32_t cpu_idx, champsim::channel* ll): lower_level(ll), cpu(cpu_idx) {}
 
@@ -205,6 +216,15 @@ public:
 
     void print_deadlock() override final;
 
+#if (IDLE_CYCLE_SKIPPING == ENABLE)
+    uint64_t idle_cycles(uint64_t bound) override final;
+#endif // IDLE_CYCLE_SKIPPING
+
+#if (USER_CODES == ENABLE)
+    // Save or restore the retired instructions and the decoded instruction buffer, the predictors are kept by the branch and BTB modules
+    void checkpoint(champsim::checkpoint_archive& archive) override final;
+#endif // USER_CODES
+
 #if (USER_CODES == ENABLE)
     /* Definition and declaration for branch predictors */
     // Branch predictor type selection, i.e., bimodal, gshare, hashed_perceptron, perceptron.
@@ -20,6 +20,8 @@
 #include "ProjectConfiguration.h" // User file
 
 #if (USER_CODES == ENABLE)
+#include "ChampSim/checkpoint.h"
+#include "ChampSim/profiler.h"
 
 namespace champsim
 {
@@ -34,6 +36,8 @@ public:
     uint64_t current_cycle = 0;
     bool warmup            = true;
 
+    profiler::entry* profile_entry = nullptr; // Where --profile counts the time of operate()
+
     explicit operable(double scale): CLOCK_SCALE(scale - 1) {}
 
     long _operate()
@@ -48,6 +52,7 @@ public:
         }
 #endif // RAMULATOR
 
+        profiler::scope profile {profile_entry};
         auto result = operate();
 
 #if (RAMULATOR == ENABLE)
@@ -69,6 +74,20 @@ public:
     virtual void end_phase(unsigned) {} // LCOV_EXCL_LINE
 
     virtual void print_deadlock() {} // LCOV_EXCL_LINE
+
+    // Save or restore the state kept across phases. The derived classes archive their own state after calling this.
+    virtual void checkpoint(checkpoint_archive& archive) { archive & leap_operation & current_cycle; }
+
+#if (IDLE_CYCLE_SKIPPING == ENABLE)
+    /** @brief
+     *  Return how many of the upcoming operate() calls are known to change nothing, checking at most bound of them.
+     *  It is called after every operable finishes the current cycle. Returning 0 keeps the global clock ticking cycle by cycle.
+     */
+    virtual uint64_t idle_cycles(uint64_t bound) { return 0; } // LCOV_EXCL_LINE
+
+    // Advance the clock over cycles that idle_cycles() reported as idle.
+    virtual void skip_cycles(uint64_t cycles) { current_cycle += cycles; }
+#endif // IDLE_CYCLE_SKIPPING
 };
 
 } // namespace champsim
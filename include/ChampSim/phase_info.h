@@ -26,6 +26,8 @@
 #include "ChampSim/cache.h"
 #include "ChampSim/dram_controller.h"
 #include "ChampSim/ooo_cpu.h"
+#include "ChampSim/profiler.h"
+#include "ProjectConfiguration.h" // User file
 
 namespace champsim
 {
@@ -37,6 +39,20 @@ struct phase_info
     uint64_t length;
     std::vector<std::size_t> trace_index;
     std::vector<std::string> trace_names;
+#if (USER_CODES == ENABLE)
+    uint64_t skip_instructions = 0; // The instructions of each trace to fast-forward over before the phase
+    double weight              = 1; // The weight of the region of the trace this phase simulates
+
+    // Sample the simulation phase periodically instead of simulating all of it in detail, unless the period is 0
+    struct sampling_info
+    {
+        uint64_t period = 0; // The instructions from the beginning of a window to the beginning of the next one
+        uint64_t warmup = 0; // The instructions simulated in detail before each window without being measured
+        uint64_t length = 0; // The instructions measured in each window
+    } sampling {};
+
+    bool quiet = false; // Don't print the progress of the phase, e.g., for the windows of a sampled phase
+#endif // USER_CODES
 };
 
 struct phase_stats
@@ -46,6 +62,11 @@ struct phase_stats
     std::vector<O3_CPU::stats_type> roi_cpu_stats, sim_cpu_stats;
     std::vector<CACHE::stats_type> roi_cache_stats, sim_cache_stats;
     std::vector<DRAM_CHANNEL::stats_type> roi_dram_stats, sim_dram_stats;
+#if (USER_CODES == ENABLE)
+    double weight = 1;
+    std::vector<std::vector<double>> sample_cpi {}; // The CPI of each window of each CPU in a sampled phase
+    profiler::report profile {};                    // The host time spent by the components during the phase, with --profile
+#endif // USER_CODES
 };
 
 } // namespace champsim
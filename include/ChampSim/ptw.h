@@ -19,6 +19,7 @@
 
 #include <array>
 #include <deque>
+#include <functional>
 #include <string>
 
 #include "ChampSim/channel.h"
@@ -27,6 +28,13 @@
 
 class VirtualMemory;
 
+#if (FUNCTIONAL_WARMUP == ENABLE)
+namespace champsim
+{
+class functional_warmup;
+} // namespace champsim
+#endif // FUNCTIONAL_WARMUP
+
 class PageTableWalker : public champsim::operable
 {
     struct pscl_entry
@@ -80,6 +88,10 @@ class PageTableWalker : public champsim::operable
 
     void finish_packet(const response_type& packet);
 
+#if (FUNCTIONAL_WARMUP == ENABLE)
+    friend class champsim::functional_warmup;
+#endif // FUNCTIONAL_WARMUP
+
 public:
     const std::string NAME;
     const uint32_t MSHR_SIZE;
@@ -181,6 +193,26 @@ public:
 
     void begin_phase() override final;
     void print_deadlock() override final;
+
+#if (IDLE_CYCLE_SKIPPING == ENABLE)
+    uint64_t idle_cycles(uint64_t bound) override final;
+#endif // IDLE_CYCLE_SKIPPING
+
+#if (USER_CODES == ENABLE)
+    // Save or restore the paging structure caches, the page tables are kept by the virtual memory
+    void checkpoint(champsim::checkpoint_archive& archive) override final;
+#endif // USER_CODES
+
+#if (FUNCTIONAL_WARMUP == ENABLE)
+    // The cache that page table entries are read from in functional warmup, it is only set while the functional warmup runs
+    std::function<response_type(const request_type&)> functional_lower_level {};
+
+    /** @brief
+     *  Walk the page table without timing in functional warmup. The page table entries are read through the caches and the paging structure
+     *  caches are filled as in the timing model. The response carries the physical address.
+     */
+    response_type functional_access(const request_type& packet);
+#endif // FUNCTIONAL_WARMUP
 };
 
 #endif
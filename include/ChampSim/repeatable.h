@@ -23,6 +23,7 @@
 #include <string>
 
 #include "ChampSim/instruction.h"
+#include "ChampSim/tracereader.h"
 
 namespace champsim
 {
@@ -52,6 +53,34 @@ struct repeatable
         return intern_();
     }
 
+#if (USER_CODES == ENABLE)
+    // Skip the next instructions, reopening the trace whenever it ends
+    uint64_t skip(uint64_t count)
+    {
+        uint64_t skipped = 0, reopened_at = 0;
+        bool reopened = false;
+        while (skipped < count)
+        {
+            if (intern_.eof())
+            {
+                // A whole pass over the trace skipped nothing, e.g., it has at most one record, so repeating it never ends
+                if (reopened && skipped == reopened_at)
+                    break;
+                reopened    = true;
+                reopened_at = skipped;
+
+                fmt::print("*** Reached end of trace: {}\n", args_);
+                intern_ = T {std::apply([](auto... x)
+                    { return T {x...}; },
+                    args_)};
+            }
+
+            skipped += skip_instructions(intern_, count - skipped);
+        }
+        return skipped;
+    }
+#endif // USER_CODES
+
     bool eof() const { return false; }
 };
 } // namespace champsim
@@ -0,0 +1,53 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef SAMPLING_H
+#define SAMPLING_H
+
+#include <cstddef>
+#include <vector>
+
+#include "ProjectConfiguration.h" // User file
+
+#if (USER_CODES == ENABLE)
+
+namespace champsim
+{
+
+// The confidence level of the intervals of sampled phases, and its z-score under the normal distribution
+constexpr double SAMPLING_CONFIDENCE = 0.95;
+constexpr double SAMPLING_Z_SCORE    = 1.96;
+
+// The IPC of a CPU estimated from the windows of a sampled phase
+struct sample_estimate
+{
+    std::size_t windows;
+    double ipc;
+    double ipc_low, ipc_high; // The confidence interval of the IPC
+    double relative_error;    // The half width of the confidence interval of the CPI, relative to the mean CPI
+};
+
+/** @brief
+ *  Estimate the IPC from the CPI of each window, as SMARTS does. The mean CPI of the windows is the estimate of the CPI of the whole phase, and its
+ *  confidence interval follows from the central limit theorem. The interval is unbounded with less than two windows.
+ */
+sample_estimate estimate_ipc(const std::vector<double>& cpi);
+
+} // namespace champsim
+
+#endif // USER_CODES
+
+#endif
@@ -0,0 +1,62 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef SIMPOINT_H
+#define SIMPOINT_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "ChampSim/phase_info.h"
+#include "ProjectConfiguration.h" // User file
+
+#if (USER_CODES == ENABLE)
+
+namespace champsim
+{
+
+// A region of the trace to simulate, e.g., a simulation point chosen by SimPoint
+struct simpoint
+{
+    uint64_t start; // The first instruction of the region in the trace
+    double weight;  // The fraction of the whole program this region represents
+};
+
+/** @brief
+ *  Read the regions from a file, one region per line in the form "<start instruction> <weight>". Empty lines and lines starting with # are ignored.
+ *  The weights are normalized to sum to 1, and the regions are sorted by their start.
+ */
+std::vector<simpoint> read_simpoints(const std::string& file_name);
+
+/** @brief
+ *  Make a warmup phase and a simulation phase for each region. Each trace is fast-forwarded from the end of the previous region to the warmup of
+ *  the next one, so all regions are simulated in one pass over the traces. The warmup is shortened when regions are closer than its length.
+ */
+std::vector<phase_info> simpoint_phases(const std::vector<simpoint>& simpoints, uint64_t warmup_instructions, uint64_t simulation_instructions,
+    const std::vector<std::string>& trace_names);
+
+/** @brief
+ *  Combine the statistics of the simulated regions by their weights. The counters of each region are scaled to the same number of instructions
+ *  before being summed, so the combined IPC is the reciprocal of the weighted CPI, and the combined MPKIs are the weighted MPKIs.
+ */
+phase_stats weighted_phase_stats(const std::vector<phase_stats>& regions);
+
+} // namespace champsim
+
+#endif // USER_CODES
+
+#endif
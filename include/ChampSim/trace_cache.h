@@ -0,0 +1,206 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef TRACE_CACHE_H
+#define TRACE_CACHE_H
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <optional>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "ChampSim/instruction.h"
+#include "ChampSim/mapped_tracereader.h"
+#include "ChampSim/tracereader.h"
+#include "ProjectConfiguration.h" // User file
+
+#if (USER_CODES == ENABLE)
+
+namespace champsim
+{
+/** @brief
+ *  A cache of decoded traces (--trace-cache), for running the same trace many times. The first run of a trace records the instructions it reads,
+ *  as decoded_instr, into a file named after a hash of the trace. The later runs map that file and read the instructions from it, without
+ *  decompressing the trace or decoding its instructions again:
+ *
+ *      header | decoded_instr x instructions
+ *
+ *  Only the instructions read by the recording run are cached. A later run that reads beyond them continues from the trace itself, and records
+ *  a longer cache file.
+ */
+namespace trace_cache
+{
+constexpr std::array<char, 8> MAGIC  = {'C', 'H', 'A', 'M', 'P', 'D', 'E', 'C'};
+constexpr uint32_t VERSION           = 1;
+constexpr const char* FILE_EXTENSION = ".cdt";
+
+struct header
+{
+    std::array<char, 8> magic;
+    uint32_t version;
+    uint32_t record_size;
+    uint64_t instructions;
+    uint64_t complete; // Whether the trace ends after the instructions
+};
+
+// Where the decoded traces are kept, empty if --trace-cache is not given
+extern std::string directory;
+
+// The cache file of the trace, named after a hash of its size, inode and modification time, its first and last MiB, and the size of its records
+std::string file_name(const std::string& trace_name, std::size_t record_size);
+
+// The header of the cache file, if it is a complete cache file of this version
+std::optional<header> read_header(const std::string& cache_name);
+
+// Record the instructions into a temporary file, which replaces the cache file when finished unless that caches more instructions
+class recorder
+{
+    std::ofstream file;
+    std::string cache_name;
+    std::string temporary_name;
+    std::vector<decoded_instr> buffer {};
+    uint64_t instructions = 0;
+    bool complete         = false;
+
+    void flush();
+
+public:
+    explicit recorder(const std::string& cache_name);
+    ~recorder();
+
+    recorder(const recorder&)            = delete;
+    recorder& operator=(const recorder&) = delete;
+
+    void record(const ooo_model_instr& instr);
+
+    // Copy instructions recorded before
+    void append(const decoded_instr* instrs, uint64_t count);
+
+    // The trace ended after the recorded instructions
+    void set_complete() { complete = true; }
+};
+} // namespace trace_cache
+
+/** @brief
+ *  Read a trace through the trace cache. If the trace has a cache file, the instructions are read from its mapping, and from the trace itself
+ *  (by the reader R, which skips the cached instructions first) after the cached ones. Otherwise, R reads the trace and the instructions are
+ *  recorded into a new cache file.
+ */
+template<typename R>
+class cached_tracereader
+{
+    using trace_type                 = typename R::trace_type;
+    constexpr static bool keeps_asid = std::is_same_v<trace_type, cloudsuite_instr>; // Other traces take the ASID of the CPU running them
+
+    uint8_t cpu;
+    std::string trace_name;
+    std::string cache_name;
+    std::optional<mapped_file> cache {};
+    uint64_t cached       = 0;
+    bool complete         = false;
+    uint64_t position     = 0; // The next instruction to read
+    mutable std::optional<R> source {};
+    std::unique_ptr<trace_cache::recorder> recorder {};
+
+    R& open_source() const
+    {
+        if (! source.has_value())
+        {
+            source.emplace(cpu, trace_name);
+            skip_instructions(*source, position);
+        }
+        return *source;
+    }
+
+    // Read beyond an incomplete cache file, recording a longer one
+    void extend()
+    {
+        if (position == cached && ! complete && recorder == nullptr)
+        {
+            recorder = std::make_unique<trace_cache::recorder>(cache_name);
+            recorder->append(reinterpret_cast<const decoded_instr*>(cache->data() + sizeof(trace_cache::header)), cached);
+        }
+    }
+
+public:
+    cached_tracereader(uint8_t cpu_idx, std::string tf): cpu(cpu_idx), trace_name(tf), cache_name(trace_cache::file_name(tf, sizeof(trace_type)))
+    {
+        if (auto head = trace_cache::read_header(cache_name); head.has_value())
+        {
+            cache.emplace(cache_name);
+            cached   = head->instructions;
+            complete = (head->complete != 0);
+        }
+        else
+        {
+            recorder = std::make_unique<trace_cache::recorder>(cache_name);
+            open_source();
+        }
+    }
+
+    ooo_model_instr operator()()
+    {
+        if (position < cached)
+        {
+            decoded_instr instr;
+            std::memcpy(&instr, cache->data() + sizeof(trace_cache::header) + position * sizeof(decoded_instr), sizeof(instr));
+            position++;
+            return ooo_model_instr {instr, keeps_asid ? std::array<uint8_t, 2> {instr.asid[0], instr.asid[1]} : std::array<uint8_t, 2> {cpu, cpu}};
+        }
+
+        extend();
+        auto retval = open_source()();
+        if (recorder != nullptr)
+            recorder->record(retval);
+        position++;
+        return retval;
+    }
+
+    uint64_t skip(uint64_t count)
+    {
+        auto in_cache = std::min(count, cached - std::min(position, cached));
+        position += in_cache;
+
+        // The recorded instructions have no gaps, so the others are read
+        uint64_t skipped = in_cache;
+        for (; skipped < count && ! eof(); skipped++)
+            (*this)();
+        return skipped;
+    }
+
+    bool eof() const
+    {
+        if (position < cached)
+            return false;
+        if (complete)
+            return true;
+
+        auto ended = open_source().eof();
+        if (ended && recorder != nullptr)
+            recorder->set_complete();
+        return ended;
+    }
+};
+} // namespace champsim
+
+#endif // USER_CODES
+
+#endif
@@ -25,9 +25,44 @@
 
 #include "ChampSim/instruction.h"
 #include "ChampSim/util/detect.h"
+#include "ProjectConfiguration.h" // User file
 
 namespace champsim
 {
+#if (USER_CODES == ENABLE)
+namespace detail
+{
+template<typename R>
+using has_eof = decltype(std::declval<const R&>().eof());
+
+template<typename R>
+using has_skip = decltype(std::declval<R&>().skip(uint64_t {}));
+} // namespace detail
+
+/** @brief
+ *  Skip the next instructions of a reader, without returning them. Readers that can seek provide skip(), which is used instead of reading the
+ *  instructions one by one. Return the number of instructions skipped, which is less than the count if the reader ends first.
+ */
+template<typename R>
+uint64_t skip_instructions(R& reader, uint64_t count)
+{
+    if constexpr (champsim::is_detected_v<detail::has_skip, R>)
+        return reader.skip(count);
+
+    uint64_t skipped = 0;
+    for (; skipped < count; skipped++)
+    {
+        if constexpr (champsim::is_detected_v<detail::has_eof, R>)
+        {
+            if (reader.eof())
+                break;
+        }
+        reader();
+    }
+    return skipped;
+}
+#endif // USER_CODES
+
 class tracereader
 {
     static uint64_t instr_unique_id;
@@ -37,6 +72,9 @@ class tracereader
         virtual ~reader_concept()            = default;
         virtual ooo_model_instr operator()() = 0;
         virtual bool eof() const             = 0;
+#if (USER_CODES == ENABLE)
+        virtual uint64_t skip(uint64_t count) = 0;
+#endif // USER_CODES
     };
 
     template<typename T>
@@ -57,6 +95,10 @@ class tracereader
                 return intern_.eof();
             return false; // If an eof() member function is not provided, assume the trace never ends.
         }
+
+#if (USER_CODES == ENABLE)
+        uint64_t skip(uint64_t count) override { return skip_instructions(intern_, count); }
+#endif // USER_CODES
     };
 
     std::unique_ptr<reader_concept> pimpl_;
@@ -75,6 +117,16 @@ public:
     }
 
     auto eof() const { return pimpl_->eof(); }
+
+#if (USER_CODES == ENABLE)
+    // Skip the next instructions, which keep their IDs as if they were read
+    uint64_t skip(uint64_t count)
+    {
+        auto skipped = pimpl_->skip(count);
+        instr_unique_id += skipped;
+        return skipped;
+    }
+#endif // USER_CODES
 };
 
 template<typename T, typename F>
@@ -92,6 +144,10 @@ class bulk_tracereader
     std::deque<ooo_model_instr> instr_buffer;
 
 public:
+#if (USER_CODES == ENABLE)
+    using trace_type = T;
+#endif // USER_CODES
+
     ooo_model_instr operator()();
 
     bulk_tracereader(uint8_t cpu_idx, std::string tf): cpu(cpu_idx), trace_file(tf) {}
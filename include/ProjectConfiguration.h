@@ -18,6 +18,13 @@
 #define MEMORY_USE_SWAPPING_UNIT             (ENABLE)  // Whether memory controller uses swapping unit to swap data (data swapping overhead is considered)
 #define MEMORY_USE_OS_TRANSPARENT_MANAGEMENT (ENABLE)  // Whether memory controller uses OS-transparent management designs to simulate the memory system instead of static (no-migration) methods
 #define CPU_USE_MULTIPLE_CORES               (DISABLE) // Whether CPU uses multiple cores to run simulation (go to ./inc/ChampSim/champsim_constants.h to check related parameters)
+#define IDLE_CYCLE_SKIPPING                  (DISABLE) // Whether jump the global clock over cycles in which no component can make progress (only works with ramulator)
+#define PARALLEL_CORE_SIMULATION             (DISABLE) // Whether simulate each core's private caches on its own thread in quanta of cycles, synchronizing at the shared caches and memory controller
+#define FUNCTIONAL_WARMUP                    (DISABLE) // Whether to warm up caches, TLBs, branch predictors and memory management without timing instead of running the out-of-order pipeline
+#define SIMULATION_PROFILER                  (ENABLE)  // Whether --profile can attribute the host time of the simulation to the components that spend it
+#define BACKGROUND_TRACE_DECOMPRESSION       (DISABLE) // Whether decompress and inflate each trace on a thread of its own, overlapping with the simulation
+#define MEMORY_MAPPED_TRACES                 (ENABLE)  // Whether read uncompressed traces through memory mappings instead of file streams
+#define SYNTHETIC_TRACES                     (ENABLE)  // Whether generate the instructions of "synthetic:<pattern>,<key>=<value>,..." given in place of a trace
 
 /** Configuration for hybrid memory systems */
 #if (MEMORY_USE_HYBRID == ENABLE)
@@ -41,6 +48,7 @@
 
 /* Research proposal selection */
 #if (MEMORY_USE_OS_TRANSPARENT_MANAGEMENT == ENABLE)
+// The research proposal run by default, every one is built and another can be chosen at runtime (see PROJECT_CONFIGURATION)
 #define IDEAL_LINE_LOCATION_TABLE      (ENABLE)
 #define COLOCATED_LINE_LOCATION_TABLE  (DISABLE)
 #define IDEAL_VARIABLE_GRANULARITY     (DISABLE)
@@ -48,10 +56,6 @@
 
 #define TRACKING_LOAD_STORE_STATISTICS (DISABLE)
 
-#if (IDEAL_LINE_LOCATION_TABLE == DISABLE) && (COLOCATED_LINE_LOCATION_TABLE == DISABLE) && (IDEAL_VARIABLE_GRANULARITY == DISABLE) && (IDEAL_SINGLE_MEMPOD == DISABLE)
-#define NO_METHOD_FOR_RUN_HYBRID_MEMORY (ENABLE)
-#endif // IDEAL_LINE_LOCATION_TABLE, COLOCATED_LINE_LOCATION_TABLE, IDEAL_VARIABLE_GRANULARITY, IDEAL_SINGLE_MEMPOD
-
 #if (TRACKING_LOAD_STORE_STATISTICS == ENABLE) // Note: it might be better become part of configurations of TRACKING_LOAD_STORE_STATISTICS like IDEAL_SINGLE_MEMPOD in line 71
 /* Option for research */
 #define TRACKING_LOAD_ONLY (ENABLE)
@@ -59,34 +63,50 @@
 #endif // TRACKING_LOAD_STORE_STATISTICS
 
 /** Configuration for each research proposal */
-#if (IDEAL_LINE_LOCATION_TABLE == ENABLE) || (COLOCATED_LINE_LOCATION_TABLE == ENABLE)
-#define HOTNESS_THRESHOLD (1u)
-#define BITS_MANIPULATION (DISABLE)
-#elif (IDEAL_VARIABLE_GRANULARITY == ENABLE)
-#define HOTNESS_THRESHOLD            (1u) // Default: 1/4
+// IDEAL_LINE_LOCATION_TABLE, COLOCATED_LINE_LOCATION_TABLE and IDEAL_VARIABLE_GRANULARITY
+#define HOTNESS_THRESHOLD            (1u) // Default: 1/4 for IDEAL_VARIABLE_GRANULARITY
+
+// IDEAL_LINE_LOCATION_TABLE and COLOCATED_LINE_LOCATION_TABLE
+#define BITS_MANIPULATION            (DISABLE)
+
+// IDEAL_VARIABLE_GRANULARITY
 #define DATA_EVICTION                (ENABLE)
 #define FLEXIBLE_DATA_PLACEMENT      (ENABLE)
 #define STATISTICS_INFORMATION       (ENABLE)
 #define FLEXIBLE_GRANULARITY         (ENABLE)
 #define IMMEDIATE_EVICTION           (DISABLE)
 #define COLD_DATA_DETECTION_IN_GROUP (DISABLE)
-#elif (IDEAL_SINGLE_MEMPOD == ENABLE)
+
+// IDEAL_SINGLE_MEMPOD
 #define PRINT_SWAPS_PER_EPOCH_MEMPOD (DISABLE)
-#else
-#define HOTNESS_THRESHOLD (1u)
-#endif // IDEAL_LINE_LOCATION_TABLE, COLOCATED_LINE_LOCATION_TABLE, IDEAL_VARIABLE_GRANULARITY, IDEAL_SINGLE_MEMPOD
 
 // Check
-#if (NO_METHOD_FOR_RUN_HYBRID_MEMORY == ENABLE)
-#error OS-transparent management designs need to be enabled.
-#endif // IDEAL_LINE_LOCATION_TABLE, COLOCATED_LINE_LOCATION_TABLE
+#if (IDEAL_LINE_LOCATION_TABLE + COLOCATED_LINE_LOCATION_TABLE + IDEAL_VARIABLE_GRANULARITY + IDEAL_SINGLE_MEMPOD != 1)
+#error Exactly one OS-transparent management design needs to be enabled.
+#endif // IDEAL_LINE_LOCATION_TABLE, COLOCATED_LINE_LOCATION_TABLE, IDEAL_VARIABLE_GRANULARITY, IDEAL_SINGLE_MEMPOD
 
 #endif // MEMORY_USE_OS_TRANSPARENT_MANAGEMENT
 
 #if (PRINT_MEMORY_TRACE == ENABLE)
-#define CONTINUOUS_ADDRESS (ENABLE)
+#define CONTINUOUS_ADDRESS  (ENABLE)
+#define BINARY_MEMORY_TRACE (ENABLE) // Whether write the memory trace as compressed binary records (.mtrace.gz) instead of hexadecimal text (.trace)
 #endif // PRINT_MEMORY_TRACE
 
+/** Configuration for parallel core simulation */
+#if (PARALLEL_CORE_SIMULATION == ENABLE)
+#define PARALLEL_QUANTUM_CYCLES (10)// Cycles each core runs ahead before synchronizing, traffic between a core and the shared components is delayed up to this many cycles
+
+// Check
+#if (IDLE_CYCLE_SKIPPING == ENABLE)
+#error Idle cycle skipping and parallel core simulation cannot be enabled together.
+#endif // IDLE_CYCLE_SKIPPING
+#endif // PARALLEL_CORE_SIMULATION
+
+/** Configuration for background trace decompression */
+#if (BACKGROUND_TRACE_DECOMPRESSION == ENABLE)
+#define BACKGROUND_TRACE_BUFFER_ENTRIES (4096u) // Instructions each trace can read ahead of its core, must be a power of two
+#endif // BACKGROUND_TRACE_DECOMPRESSION
+
 // Data block management granularity
 #define DATA_GRANULARITY_64B   (64u)
 #define DATA_GRANULARITY_128B  (128u)
@@ -96,24 +116,15 @@
 #define DATA_GRANULARITY_2048B (2048u)
 #define DATA_GRANULARITY_4096B (4096u)
 
-#if (IDEAL_SINGLE_MEMPOD == DISABLE)
-#if (IDEAL_LINE_LOCATION_TABLE == ENABLE) || (COLOCATED_LINE_LOCATION_TABLE == ENABLE)
-#define DATA_MANAGEMENT_GRANULARITY (DATA_GRANULARITY_64B) // Default: DATA_GRANULARITY_64B
-#elif (IDEAL_VARIABLE_GRANULARITY == ENABLE)
-#define DATA_MANAGEMENT_GRANULARITY (DATA_GRANULARITY_4096B)
-#define DATA_LINE_OFFSET_BITS       (champsim::lg2(DATA_GRANULARITY_64B))
-#else
-#define DATA_MANAGEMENT_GRANULARITY (DATA_GRANULARITY_64B)
-#endif // IDEAL_LINE_LOCATION_TABLE, COLOCATED_LINE_LOCATION_TABLE, IDEAL_VARIABLE_GRANULARITY
-
-#define DATA_MANAGEMENT_OFFSET_BITS    (champsim::lg2(DATA_MANAGEMENT_GRANULARITY)) // Data management granularity means how the hardware cluster the data
-#define DATA_GRANULARITY_IN_CACHE_LINE (DATA_MANAGEMENT_GRANULARITY / DATA_GRANULARITY_64B)
-#endif // IDEAL_SINGLE_MEMPOD
+// Each research proposal defines its DATA_MANAGEMENT_GRANULARITY in its own header (e.g., cameo.h)
 
 #if (USE_OPENMP == ENABLE)
 #define SET_THREADS_NUMBER (6)
 #endif // USE_OPENMP
 
+/** Configuration for trace decompression */
+#define TRACE_DECOMPRESSION_THREADS (1) // Threads decoding each xz or block trace, where more than one decode its blocks in parallel
+
 #define KiB (1024ul) // Unit is byte
 #define MiB (KiB * KiB)
 #define GiB (MiB * KiB)
@@ -128,6 +139,7 @@
 #include <array>
 #include <cassert>
 #include <cstdio>
+#include <memory>
 #include <string>
 
 #if (USE_OPENMP == ENABLE)
@@ -139,6 +151,10 @@
 /* Type */
 
 /* Prototype */
+namespace champsim::memory_trace
+{
+class writer;
+}
 
 // Data output class
 class DATA_OUTPUT
@@ -158,11 +174,18 @@ public:
 // Memory trace output class
 class MEMORY_TRACE : public DATA_OUTPUT
 {
+    std::unique_ptr<champsim::memory_trace::writer> writer; // Used when BINARY_MEMORY_TRACE is enabled
+
 public:
     MEMORY_TRACE(std::string v1, std::string v2);
     MEMORY_TRACE(std::string v1, std::string v2, char** string_array, uint32_t number);
     ~MEMORY_TRACE();
 
+    void output_file_initialization(char** string_array, uint32_t number);
+
+    // Record a request sent to a memory, where the binary trace keeps all the arguments and the text trace only the address and type
+    void output_memory_trace(uint64_t cycle, uint64_t address, uint64_t physical_address, char type, uint32_t cpu, uint8_t memory, uint8_t origin, bool accepted);
+
     void output_memory_trace_hexadecimal(uint64_t address, char type);
 };
 
@@ -188,14 +211,13 @@ public:
 
     uint64_t remapping_request_queue_congestion;
 
-#if (IDEAL_VARIABLE_GRANULARITY == ENABLE)
+    // Only used by IDEAL_VARIABLE_GRANULARITY
     uint64_t no_free_space_for_migration;
     uint64_t no_invalid_group_for_migration;
     uint64_t unexpandable_since_start_address;
     uint64_t unexpandable_since_no_invalid_group;
     uint64_t data_eviction_success, data_eviction_failure;
     uint64_t uncertain_counter;
-#endif // IDEAL_VARIABLE_GRANULARITY
 
     SIMULATOR_STATISTICS(std::string v1, std::string v2);
     SIMULATOR_STATISTICS(std::string v1, std::string v2, char** string_array, uint32_t number);
@@ -205,8 +227,45 @@ private:
     void statistics_initialization();
 };
 
+// The research proposals behind OS_TRANSPARENT_MANAGEMENT, named after their macros above
+enum class ResearchProposal
+{
+    IdealLineLocationTable,
+    ColocatedLineLocationTable,
+    IdealVariableGranularity,
+    IdealSingleMemPod
+};
+
+/** @brief
+ *  The values of the options above that don't change the code being built, so they can be set at runtime by a JSON file
+ *  (--project-configuration <filename>) instead of rebuilding. Each key is the name of its macro, which gives the default value, e.g.,
+ *  {"HOTNESS_THRESHOLD": 2, "SWAPPING_BUFFER_ENTRY_NUMBER": 32, "PRINT_MEMORY_TRACE": false}.
+ *  The research proposals are all built, and the one to run is named by the key OS_TRANSPARENT_MANAGEMENT, e.g.,
+ *  {"OS_TRANSPARENT_MANAGEMENT": "IDEAL_SINGLE_MEMPOD"}. The other switches that select the code (e.g., MEMORY_USE_HYBRID) still need a build
+ *  for each of their values. They can be named too, and are checked against this build, so that one file describes a whole configuration of a sweep.
+ */
+class PROJECT_CONFIGURATION
+{
+public:
+    ResearchProposal research_proposal;    // OS_TRANSPARENT_MANAGEMENT
+    bool print_memory_trace;               // PRINT_MEMORY_TRACE, can only be turned off at runtime
+    bool idle_cycle_skipping;              // IDLE_CYCLE_SKIPPING, can only be turned off at runtime
+    int threads_number;                    // SET_THREADS_NUMBER
+    int parallel_quantum_cycles;           // PARALLEL_QUANTUM_CYCLES
+    int trace_decompression_threads;       // TRACE_DECOMPRESSION_THREADS
+    uint32_t swapping_buffer_entry_number; // SWAPPING_BUFFER_ENTRY_NUMBER
+    uint32_t hotness_threshold;            // HOTNESS_THRESHOLD
+    bool tracking_load_only;               // TRACKING_LOAD_ONLY
+    bool tracking_read_only;               // TRACKING_READ_ONLY
+
+    PROJECT_CONFIGURATION();
+
+    void load(const std::string& file_name);
+};
+
 extern MEMORY_TRACE output_memorytrace;
 extern SIMULATOR_STATISTICS output_statistics;
+extern PROJECT_CONFIGURATION project_configuration;
 
 /* Variable */
 
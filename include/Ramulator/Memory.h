@@ -4,6 +4,7 @@
 #include <cassert>
 #include <cmath>
 #include <functional>
+#include <limits>
 #include <tuple>
 #include <vector>
 
@@ -23,6 +24,8 @@
 
 #if (USER_CODES == ENABLE)
 #include "ChampSim/champsim_constants.h"
+#include "ChampSim/checkpoint.h"
+#include "ChampSim/profiler.h"
 #endif
 
 using namespace std;
@@ -50,6 +53,24 @@ public:
     virtual void record_core(int coreid)                          = 0;
     virtual void set_high_writeq_watermark(const float watermark) = 0;
     virtual void set_low_writeq_watermark(const float watermark)  = 0;
+
+#if (USER_CODES == ENABLE)
+    // What the memory controller of ChampSim needs from a memory, so it is compiled once for all standards
+    uint64_t max_address = 0;
+    CompletionQueue completions; // The reads of all channels that completed without a callback
+
+    virtual double clk_mhz() const                                = 0;
+    virtual const string& standard() const                        = 0;
+    virtual const vector<int>& address_bits() const               = 0;
+    virtual uint32_t get_queue_occupancy(Request& req)            = 0;
+    virtual uint32_t get_queue_size(Request& req)                 = 0;
+    virtual void checkpoint(champsim::checkpoint_archive& archive) = 0;
+
+#if (IDLE_CYCLE_SKIPPING == ENABLE)
+    virtual long idle_ticks()           = 0;
+    virtual void skip_ticks(long ticks) = 0;
+#endif // IDLE_CYCLE_SKIPPING
+#endif // USER_CODES
 };
 
 template<class T, template<typename> class Controller = Controller>
@@ -85,10 +106,6 @@ protected:
     MapScheme mapping_scheme;
 
 public:
-#if (USER_CODES == ENABLE)
-    uint64_t max_address;
-#endif
-
     enum class Type
     {
         ChRaBaRoCo,
@@ -257,6 +274,11 @@ public:
             .name("record_write_requests")
             .desc("record write requests for this core when it reaches request limit or to the end");
 #endif
+
+#if (USER_CODES == ENABLE)
+        for (auto ctrl : ctrls)
+            ctrl->completions = &completions;
+#endif // USER_CODES
     }
 
     ~Memory()
@@ -271,6 +293,23 @@ public:
         return spec->speed_entry.tCK;
     }
 
+#if (USER_CODES == ENABLE)
+    double clk_mhz() const
+    {
+        return spec->speed_entry.freq;
+    }
+
+    const string& standard() const
+    {
+        return spec->standard_name;
+    }
+
+    const vector<int>& address_bits() const
+    {
+        return addr_bits;
+    }
+#endif // USER_CODES
+
     void record_core(int coreid)
     {
 #ifndef INTEGRATED_WITH_GEM5
@@ -285,6 +324,12 @@ public:
 
     void tick()
     {
+#if (USER_CODES == ENABLE)
+        static auto& profiled            = champsim::profiler::get("ramulator::Memory<" + spec->standard_name + ">::tick");
+        static auto& profiled_controller = champsim::profiler::get("ramulator::Controller<" + spec->standard_name + ">::tick");
+        champsim::profiler::scope profile {profiled};
+#endif
+
         ++num_dram_cycles;
         int cur_que_req_num      = 0;
         int cur_que_readreq_num  = 0;
@@ -303,6 +348,9 @@ public:
         for (auto ctrl : ctrls)
         {
             is_active = is_active || ctrl->is_active();
+#if (USER_CODES == ENABLE)
+            champsim::profiler::scope profile_controller {profiled_controller};
+#endif
             ctrl->tick();
         }
         if (is_active)
@@ -311,6 +359,47 @@ public:
         }
     }
 
+#if (IDLE_CYCLE_SKIPPING == ENABLE)
+    // For telling how many upcoming ticks change nothing but the statistics
+    long idle_ticks()
+    {
+        long ticks = std::numeric_limits<long>::max();
+        for (auto ctrl : ctrls)
+            ticks = std::min(ticks, ctrl->idle_ticks());
+
+        return ticks;
+    }
+
+    // Fast-forward over ticks reported by idle_ticks(), same as calling tick() that many times
+    void skip_ticks(long ticks)
+    {
+        num_dram_cycles += ticks;
+        bool is_active = false;
+        for (auto ctrl : ctrls)
+        {
+            in_queue_req_num_sum += ticks * (ctrl->readq.size() + ctrl->writeq.size() + ctrl->pending.size());
+            in_queue_read_req_num_sum += ticks * (ctrl->readq.size() + ctrl->pending.size());
+            in_queue_write_req_num_sum += ticks * ctrl->writeq.size();
+            is_active = is_active || ctrl->is_active();
+            ctrl->skip_ticks(ticks);
+        }
+        if (is_active)
+        {
+            ramulator_active_cycles += ticks;
+        }
+    }
+#endif // IDLE_CYCLE_SKIPPING
+
+#if (USER_CODES == ENABLE)
+    // Save or restore the state of all channels, e.g., for checkpoints
+    void checkpoint(champsim::checkpoint_archive& archive)
+    {
+        archive & free_physical_pages & free_physical_pages_remaining & page_translation;
+        for (auto ctrl : ctrls)
+            ctrl->checkpoint(archive);
+    }
+#endif // USER_CODES
+
     bool send(Request req)
     {
         req.addr_vec.resize(addr_bits.size());
@@ -347,6 +436,27 @@ public:
             }
         }
 
+#if (USER_CODES == ENABLE)
+        // The controller takes the request over, so keep what the statistics need
+        Request::Type req_type = req.type;
+        int channel_id         = req.addr_vec[int(T::Level::Channel)];
+        if (ctrls[req.addr_vec[0]]->enqueue(req))
+        {
+            // tally stats here to avoid double counting for requests that aren't enqueued
+            ++num_incoming_requests;
+            if (req_type == Request::Type::READ)
+            {
+                ++num_read_requests[coreid];
+                ++incoming_read_reqs_per_channel[channel_id];
+            }
+            if (req_type == Request::Type::WRITE)
+            {
+                ++num_write_requests[coreid];
+            }
+            ++incoming_requests_per_channel[channel_id];
+            return true;
+        }
+#else
         if (ctrls[req.addr_vec[0]]->enqueue(req))
         {
             // tally stats here to avoid double counting for requests that aren't enqueued
@@ -363,6 +473,7 @@ public:
             ++incoming_requests_per_channel[req.addr_vec[int(T::Level::Channel)]];
             return true;
         }
+#endif // USER_CODES
 
         return false;
     }
@@ -562,7 +673,7 @@ public:
         }
     }
 
-    void apply_mapping(long addr, std::vector<int>& addr_vec)
+    void apply_mapping(long addr, AddrVec& addr_vec)
     {
         int* sz             = spec->org_entry.count;
         int addr_total_bits = sizeof(addr_vec) * 8;
@@ -159,7 +159,7 @@ public:
         if (clk - refreshed >= refresh_interval)
         {
             auto req_type = Request::Type::REFRESH;
-            vector<int> addr_vec(int(T::Level::MAX), -1);
+            AddrVec addr_vec(int(T::Level::MAX), -1);
             addr_vec[0] = channel->id;
             for (auto child : channel->children)
             {
@@ -9,10 +9,12 @@
 #include <vector>
 
 #include "ChampSim/champsim_constants.h"
+#include "ChampSim/checkpoint.h"
 #include "ChampSim/channel.h"
 #include "ChampSim/util.h"
 #include "ProjectConfiguration.h" // User file
 #include "Ramulator/Request.h"
+#include "os_transparent_management.h"
 
 /** @note Abbreviation:
  *  FM -> Fast memory (e.g., HBM, DDR4)
@@ -26,8 +28,6 @@
 
 #if (MEMORY_USE_OS_TRANSPARENT_MANAGEMENT == ENABLE)
 
-#if (IDEAL_SINGLE_MEMPOD == ENABLE)
-
 /* MemPod Parameter Setting */
 #define TIME_INTERVAL_MEMPOD_us               (50)                                            // [us]
 #define DATA_MANAGEMENT_GRANULARITY           (2048)                                          // [B] default:2048
@@ -51,16 +51,10 @@
 #define QUEUE_BUSY_DEGREE_THRESHOLD_DOWN      (0.8f)
 #define QUEUE_BUSY_DEGREE_THRESHOLD           (0.8f)
 
-#define INCOMPLETE_READ_REQUEST_QUEUE_LENGTH  (128)
-#define INCOMPLETE_WRITE_REQUEST_QUEUE_LENGTH (128)
-
-class OS_TRANSPARENT_MANAGEMENT
+// IDEAL_SINGLE_MEMPOD
+class MEMPOD : public OS_TRANSPARENT_MANAGEMENT
 {
-    using channel_type = champsim::channel;
-    using request_type = typename channel_type::request_type;
-
 public:
-    uint64_t cycle = 0;
     uint64_t total_capacity;       // [B]
     uint64_t fast_memory_capacity; // [B]
     uint64_t total_capacity_at_granularity;
@@ -69,14 +63,6 @@ public:
     uint8_t swap_size                               = SWAP_DATA_CACHE_LINES; // == 32
     REMAPPING_TABLE_ENTRY_WIDTH swap_fm_address_itr = 0;
 
-    /* Remapping request */
-    struct RemappingRequest
-    {
-        uint64_t h_address_in_fm, h_address_in_sm; // Hardware address in fast and slow memories
-        uint64_t p_address_in_fm, p_address_in_sm; // Physical address in fast and slow memories
-        uint8_t size;                              // Number of cache lines to remap == 32 (2048B)
-    };
-
     struct PhysicalHardwareAddressTuple
     {
         uint64_t p_address, h_address;
@@ -91,36 +77,40 @@ public:
     std::unordered_map<REMAPPING_TABLE_ENTRY_WIDTH, REMAPPING_TABLE_ENTRY_WIDTH>& address_remapping_table;
     std::unordered_map<REMAPPING_TABLE_ENTRY_WIDTH, REMAPPING_TABLE_ENTRY_WIDTH>& invert_address_remapping_table;
 
-    std::deque<RemappingRequest> remapping_request_queue;
-    uint64_t remapping_request_queue_congestion;
-
     double interval_cycle;
     double next_interval_cycle;
     uint32_t intervals;
 
     /* Member functions */
-    OS_TRANSPARENT_MANAGEMENT(uint64_t max_address, uint64_t fast_memory_max_address);
-    ~OS_TRANSPARENT_MANAGEMENT();
+    MEMPOD(uint64_t max_address, uint64_t fast_memory_max_address);
+    ~MEMPOD();
 
 #if (TRACKING_LOAD_STORE_STATISTICS == ENABLE)
     // Address is physical address and at byte granularity
-    bool memory_activity_tracking(uint64_t address, ramulator::Request::Type type, ramulator::Request::Type type_origin, float queue_busy_degree);
+    bool memory_activity_tracking(uint64_t address, ramulator::Request::Type type, access_type type_origin, float queue_busy_degree) override;
 #else
     // Address is physical address and at byte granularity
-    bool memory_activity_tracking(uint64_t address, ramulator::Request::Type type, float queue_busy_degree);
+    bool memory_activity_tracking(uint64_t address, ramulator::Request::Type type, float queue_busy_degree) override;
 #endif // TRACKING_LOAD_STORE_STATISTICS
 
     // Translate the physical address to hardware address
-    void physical_to_hardware_address(request_type& packet);
-    void physical_to_hardware_address(uint64_t& address);
+    void physical_to_hardware_address(request_type& packet) override;
+    void physical_to_hardware_address(uint64_t& address) override;
 
     // Detect cold data block and cycle increment
-    void cold_data_detection();
+    void cold_data_detection() override;
+
+#if (IDLE_CYCLE_SKIPPING == ENABLE)
+    // The cycles before the swap pairs of the next interval are decided
+    uint64_t idle_cycles(uint64_t bound) const override;
+#endif // IDLE_CYCLE_SKIPPING
+
+    // Save or restore the counters and the remapping tables, e.g., for checkpoints
+    void checkpoint(champsim::checkpoint_archive& archive) override;
 
     // MemPod interval swap
-    void check_interval_swap(uint8_t swapping_states, bool warmup);
-    bool issue_remapping_request(RemappingRequest& remapping_request);
-    bool finish_remapping_request();
+    void check_interval_swap(uint8_t swapping_states, bool warmup) override;
+    bool finish_remapping_request() override;
 
 private:
     void get_hot_page_from_mea_counter(std::vector<REMAPPING_TABLE_ENTRY_WIDTH>& hot_pages);
@@ -133,7 +123,5 @@ private:
     bool enqueue_remapping_request(RemappingRequest& remapping_request, bool warmup);
 };
 
-#endif // IDEAL_SINGLE_MEMPOD
-
 #endif // MEMORY_USE_OS_TRANSPARENT_MANAGEMENT
-#endif // OS_TRANSPARENT_MANAGEMENT_H
+#endif // IDEAL_SINGLE_MEMPOD_H
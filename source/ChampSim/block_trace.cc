@@ -0,0 +1,187 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ChampSim/block_trace.h"
+
+#include <lzma.h>
+
+#include <cstdio>
+#include <cstdlib>
+
+#if (USER_CODES == ENABLE)
+
+bool champsim::block_trace::is_block_trace(const std::string& file_name)
+{
+    std::string extension {FILE_EXTENSION};
+    return std::size(file_name) >= std::size(extension) && file_name.compare(std::size(file_name) - std::size(extension), std::string::npos, extension) == 0;
+}
+
+champsim::block_trace::writer::writer(const std::string& file_name, uint32_t record_size, uint32_t records_per_block)
+    : file(file_name, std::ios::binary), file_name(file_name), head {MAGIC, VERSION, record_size, records_per_block, 0}
+{
+    if (! file)
+    {
+        std::printf("%s: Cannot write block trace %s.\n", __func__, file_name.c_str());
+        abort();
+    }
+
+    pending.reserve(static_cast<std::size_t>(record_size) * records_per_block);
+    file.write(reinterpret_cast<const char*>(&head), sizeof(head));
+}
+
+champsim::block_trace::writer::~writer()
+{
+    if (file.is_open())
+        close();
+}
+
+std::vector<uint8_t> champsim::block_trace::writer::compress(const char* data, std::size_t bytes)
+{
+    std::vector<uint8_t> compressed(lzma_stream_buffer_bound(bytes));
+    std::size_t compressed_size = 0;
+    auto ret = lzma_easy_buffer_encode(LZMA_PRESET_DEFAULT, LZMA_CHECK_CRC64, nullptr, reinterpret_cast<const uint8_t*>(data), bytes, std::data(compressed),
+        &compressed_size, std::size(compressed));
+    if (ret != LZMA_OK)
+    {
+        std::printf("%s: Cannot compress a block of %zu bytes (lzma error %d).\n", __func__, bytes, static_cast<int>(ret));
+        abort();
+    }
+
+    compressed.resize(compressed_size);
+    return compressed;
+}
+
+void champsim::block_trace::writer::write_compressed(const std::vector<uint8_t>& compressed, uint64_t block_records)
+{
+    index.push_back(index_entry {static_cast<uint64_t>(file.tellp()), std::size(compressed), records, block_records});
+    file.write(reinterpret_cast<const char*>(std::data(compressed)), static_cast<std::streamsize>(std::size(compressed)));
+    records += block_records;
+}
+
+void champsim::block_trace::writer::write_block()
+{
+    write_compressed(compress(std::data(pending), std::size(pending)), std::size(pending) / head.record_size);
+    pending.clear();
+}
+
+void champsim::block_trace::writer::write(const char* data, std::size_t bytes)
+{
+    std::size_t block_bytes = static_cast<std::size_t>(head.record_size) * head.records_per_block;
+    while (bytes > 0)
+    {
+        auto count = std::min(bytes, block_bytes - std::size(pending));
+        pending.insert(std::end(pending), data, data + count);
+        data += count;
+        bytes -= count;
+
+        if (std::size(pending) == block_bytes)
+            write_block();
+    }
+}
+
+void champsim::block_trace::writer::close()
+{
+    // Drop a partial record at the end, as the readers do
+    pending.resize(std::size(pending) - std::size(pending) % head.record_size);
+    if (! std::empty(pending))
+        write_block();
+
+    footer foot {static_cast<uint64_t>(file.tellp()), std::size(index), records, MAGIC};
+    file.write(reinterpret_cast<const char*>(std::data(index)), static_cast<std::streamsize>(std::size(index) * sizeof(index_entry)));
+    file.write(reinterpret_cast<const char*>(&foot), sizeof(foot));
+    file.close();
+
+    if (! file)
+    {
+        std::printf("%s: Cannot write block trace %s.\n", __func__, file_name.c_str());
+        abort();
+    }
+}
+
+champsim::block_trace::reader::reader(const std::string& file_name, uint32_t record_size): file(file_name, std::ios::binary), file_name(file_name)
+{
+    if (! file)
+    {
+        std::printf("%s: Cannot open block trace %s.\n", __func__, file_name.c_str());
+        abort();
+    }
+
+    footer foot;
+    file.read(reinterpret_cast<char*>(&head), sizeof(head));
+    file.seekg(-static_cast<std::streamoff>(sizeof(foot)), std::ios::end);
+    file.read(reinterpret_cast<char*>(&foot), sizeof(foot));
+    if (! file || head.magic != MAGIC || foot.magic != MAGIC || head.version != VERSION)
+    {
+        std::printf("%s: %s is not a block trace of this version.\n", __func__, file_name.c_str());
+        abort();
+    }
+
+    if (head.record_size != record_size)
+    {
+        std::printf("%s: The records of %s have %u bytes instead of %u, check whether it is a cloudsuite trace.\n", __func__, file_name.c_str(), head.record_size,
+            record_size);
+        abort();
+    }
+
+    index.resize(foot.blocks);
+    file.seekg(static_cast<std::streamoff>(foot.index_offset));
+    file.read(reinterpret_cast<char*>(std::data(index)), static_cast<std::streamsize>(std::size(index) * sizeof(index_entry)));
+    if (! file || records() != foot.records)
+    {
+        std::printf("%s: The index of block trace %s is truncated.\n", __func__, file_name.c_str());
+        abort();
+    }
+}
+
+std::size_t champsim::block_trace::reader::block_of(uint64_t record) const
+{
+    auto found = std::upper_bound(std::begin(index), std::end(index), record, [](uint64_t r, const index_entry& e) { return r < e.first_record; });
+    return static_cast<std::size_t>(std::distance(std::begin(index), found)) - 1;
+}
+
+std::vector<uint8_t> champsim::block_trace::reader::read_compressed(std::size_t block)
+{
+    const auto& block_entry = entry(block);
+
+    std::vector<uint8_t> compressed(block_entry.size);
+    file.seekg(static_cast<std::streamoff>(block_entry.offset));
+    file.read(reinterpret_cast<char*>(std::data(compressed)), static_cast<std::streamsize>(std::size(compressed)));
+    if (! file)
+    {
+        std::printf("%s: Block %zu of block trace %s is truncated.\n", __func__, block, file_name.c_str());
+        abort();
+    }
+
+    return compressed;
+}
+
+std::vector<char> champsim::block_trace::reader::decompress(const std::vector<uint8_t>& compressed, std::size_t block) const
+{
+    std::vector<char> raw(entry(block).records * head.record_size);
+    uint64_t memory_limit = UINT64_MAX;
+    std::size_t in_position = 0, out_position = 0;
+    auto ret = lzma_stream_buffer_decode(&memory_limit, 0, nullptr, std::data(compressed), &in_position, std::size(compressed), reinterpret_cast<uint8_t*>(std::data(raw)),
+        &out_position, std::size(raw));
+    if (ret != LZMA_OK || out_position != std::size(raw))
+    {
+        std::printf("%s: Block %zu of block trace %s is corrupted.\n", __func__, block, file_name.c_str());
+        abort();
+    }
+
+    return raw;
+}
+
+#endif // USER_CODES
@@ -27,6 +27,16 @@ std::size_t gs_table_hash(uint64_t ip, std::bitset<GLOBAL_HISTORY_LENGTH> bh_vec
 
     return hash % GS_HISTORY_TABLE_SIZE;
 }
+
+// Keep the history and the counters in checkpoints
+champsim::checkpoint_archive::participant gshare_checkpoint {[](champsim::checkpoint_archive& archive)
+    {
+        for (auto& [cpu, table] : ::gs_history_table)
+        {
+            if (archive.section("cpu" + std::to_string(cpu->cpu) + ".gshare"))
+                archive & ::branch_history_vector[cpu] & table;
+        }
+    }};
 } // namespace
 
 void O3_CPU::bpred_branchDgshare_initialize_branch_predictor()
@@ -36,6 +46,10 @@ void O3_CPU::bpred_branchDgshare_initialize_branch_predictor()
 #else
     std::cout << "CPU " << cpu << " Gshare branch predictor" << std::endl;
 #endif
+
+    // Add the history and the table before the CPUs may predict on several threads
+    ::branch_history_vector[this];
+    ::gs_history_table[this];
 }
 
 uint8_t O3_CPU::bpred_branchDgshare_predict_branch(uint64_t ip)
@@ -109,6 +109,16 @@ int theta[NUM_CPUS],
 
     // perceptron sum
     yout[NUM_CPUS];
+
+// Keep the weights, the histories and the thresholds of all CPUs in checkpoints
+champsim::checkpoint_archive::participant hashed_perceptron_checkpoint {[](champsim::checkpoint_archive& archive)
+    {
+        if (archive.section("hashed_perceptron"))
+        {
+            archive.expect(std::size_t {NUM_CPUS}, "number of CPUs");
+            archive & tables & ghist_words & indices & theta & tc & yout;
+        }
+    }};
 } // namespace
 
 void O3_CPU::bpred_branchDhashed_perceptron_initialize_branch_predictor()
@@ -53,6 +53,16 @@ std::map<O3_CPU*, std::deque<uint64_t>> RAS;
  * find the target for a call's return, since calls may have different sizes.
  */
 std::map<O3_CPU*, std::array<uint64_t, CALL_SIZE_TRACKERS>> CALL_SIZE;
+
+// Keep the target buffers, the return address stack and the call sizes in checkpoints
+champsim::checkpoint_archive::participant basic_btb_checkpoint {[](champsim::checkpoint_archive& archive)
+    {
+        for (auto& [cpu, btb] : ::BTB)
+        {
+            if (archive.section("cpu" + std::to_string(cpu->cpu) + ".basic_btb"))
+                archive & btb & ::INDIRECT_BTB[cpu] & ::CONDITIONAL_HISTORY[cpu] & ::RAS[cpu] & ::CALL_SIZE[cpu];
+        }
+    }};
 } // namespace
 
 void O3_CPU::btb_btbDbasic_btb_initialize_btb()
@@ -69,6 +79,7 @@ void O3_CPU::btb_btbDbasic_btb_initialize_btb()
     std::fill(std::begin(::INDIRECT_BTB[this]), std::end(::INDIRECT_BTB[this]), 0);
     std::fill(std::begin(::CALL_SIZE[this]), std::end(::CALL_SIZE[this]), 4);
     ::CONDITIONAL_HISTORY[this] = 0;
+    ::RAS[this].clear();
 }
 
 std::pair<uint64_t, uint8_t> O3_CPU::btb_btbDbasic_btb_btb_prediction(uint64_t ip)
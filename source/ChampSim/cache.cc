@@ -136,7 +136,14 @@ bool CACHE::handle_fill(const mshr_type& fill_mshr)
                     __func__, writeback_packet.address, writeback_packet.v_address, fill_mshr.pf_metadata);
             }
 
+#if (FUNCTIONAL_WARMUP == ENABLE)
+            if (functional_lower_level)
+                functional_lower_level(writeback_packet); // Functional warmup writes back at once
+            else
+                success = lower_level->add_wq(writeback_packet);
+#else
             success = lower_level->add_wq(writeback_packet);
+#endif // FUNCTIONAL_WARMUP
         }
 
         if (success)
@@ -823,6 +830,202 @@ bool CACHE::should_activate_prefetcher(const T& pkt) const
     return ((1 << champsim::to_underlying(pkt.type)) & pref_activate_mask) && ! pkt.prefetch_from_this;
 }
 
+#if (IDLE_CYCLE_SKIPPING == ENABLE)
+uint64_t CACHE::idle_cycles(uint64_t bound)
+{
+    // Responses waiting in the channels are handled in the next cycle
+    if (! std::empty(lower_level->returned) || (lower_translate != nullptr && ! std::empty(lower_translate->returned)))
+        return 0;
+
+    // Requests are handled in the next cycle, unless the tag checks are full or an untranslated request waits for room in the stash. Both
+    // only change after the events below.
+    auto tag_bw        = std::min<long long>(static_cast<long long>(MAX_TAG), MAX_TAG * HIT_LATENCY - std::size(inflight_tag_check));
+    auto can_translate = [avail = (std::size(translation_stash) < static_cast<std::size_t>(MSHR_SIZE))](const auto& entry)
+    {
+        return avail || entry.is_translated;
+    };
+    auto has_requests = [&can_translate](const auto& queue)
+    {
+        return ! std::empty(queue) && can_translate(queue.front());
+    };
+    if (tag_bw > 0
+        && (std::any_of(std::cbegin(upper_levels), std::cend(upper_levels), [&has_requests](const channel_type* ul)
+                { return has_requests(ul->RQ) || has_requests(ul->WQ) || has_requests(ul->PQ); })
+            || has_requests(internal_PQ)))
+        return 0;
+
+    // New requests are checked for collisions in the next cycle, and they are always at the back of the queues
+    auto unchecked = [](const auto& queue)
+    {
+        return ! std::empty(queue) && ! queue.back().forward_checked;
+    };
+    if (std::any_of(std::cbegin(upper_levels), std::cend(upper_levels), [&unchecked](const channel_type* ul)
+            { return unchecked(ul->RQ) || unchecked(ul->WQ) || unchecked(ul->PQ); }))
+        return 0;
+
+    // Translations that are not issued yet are retried in the next cycle, which fails as long as the lower level has no room for them
+    if (lower_translate != nullptr && std::size(lower_translate->RQ) < lower_translate->rq_size() && pending_translations() > 0)
+        return 0;
+
+    if (! std::empty(translation_stash) && translation_stash.front().is_translated)
+        return 0;
+
+    auto wait_until = [&bound, cycle = current_cycle](uint64_t event_cycle)
+    {
+        bound = std::min(bound, event_cycle > cycle ? event_cycle - cycle : 0);
+    };
+
+    // Untranslated entries move to the stash one cycle after their tag check is due. The tag checks are done in order, so a due one that
+    // stalls holds back the others until a fill, as long as retrying it doesn't train the prefetchers.
+    auto stalled = ! std::empty(inflight_tag_check) && inflight_tag_check.front().is_translated && inflight_tag_check.front().event_cycle <= current_cycle
+                && module_pimpl->impl_prefetcher_is_stateless() && tag_check_stalled(inflight_tag_check.front());
+    for (const auto& entry : inflight_tag_check)
+    {
+        if (! entry.is_translated)
+            wait_until(entry.event_cycle + 1);
+        else if (! stalled)
+            wait_until(entry.event_cycle);
+    }
+
+    for (const auto& entry : MSHR)
+        wait_until(entry.event_cycle);
+
+    for (const auto& entry : inflight_writes)
+        wait_until(entry.event_cycle);
+
+    return bound;
+}
+
+void CACHE::skip_cycles(uint64_t cycles)
+{
+    // Each skipped cycle would have retried the translations that the lower level had no room for
+    if (lower_translate != nullptr)
+    {
+        lower_translate->sim_stats.RQ_ACCESS += cycles * pending_translations();
+        lower_translate->sim_stats.RQ_FULL += cycles * pending_translations();
+    }
+
+    champsim::operable::skip_cycles(cycles);
+}
+
+bool CACHE::tag_check_stalled(const tag_lookup_type& handle_pkt) const
+{
+    // Writebacks are always accepted by handle_write()
+    if (handle_pkt.type == access_type::WRITE && ! match_offset_bits)
+        return false;
+
+    auto match   = [match = handle_pkt.address >> OFFSET_BITS, shamt = OFFSET_BITS](const auto& entry)
+    {
+        return (entry.address >> shamt) == match;
+    };
+    auto set_idx = static_cast<std::vector<BLOCK>::difference_type>(get_set_index(handle_pkt.address));
+    auto set     = std::next(std::cbegin(block), set_idx * NUM_WAY);
+    return std::none_of(set, std::next(set, NUM_WAY), match) && std::none_of(std::cbegin(MSHR), std::cend(MSHR), match) && std::size(MSHR) == MSHR_SIZE;
+}
+
+std::size_t CACHE::pending_translations() const
+{
+    auto needs_translation = [](const tag_lookup_type& entry)
+    {
+        return ! entry.is_translated && ! entry.translate_issued;
+    };
+    return static_cast<std::size_t>(std::count_if(std::cbegin(inflight_tag_check), std::cend(inflight_tag_check), needs_translation)
+                                    + std::count_if(std::cbegin(translation_stash), std::cend(translation_stash), needs_translation));
+}
+#endif // IDLE_CYCLE_SKIPPING
+
+#if (FUNCTIONAL_WARMUP == ENABLE)
+CACHE::response_type CACHE::functional_access(const request_type& packet)
+{
+    auto response = functional_tag_check(tag_lookup_type {packet});
+
+    // Issue the prefetches triggered by this request
+    while (! std::empty(internal_PQ))
+    {
+        auto pf_packet = internal_PQ.front();
+        internal_PQ.pop_front();
+        functional_tag_check(pf_packet);
+    }
+
+    return response;
+}
+
+CACHE::response_type CACHE::functional_tag_check(tag_lookup_type handle_pkt)
+{
+    // Translate the virtual address, like issue_translation() and finish_translation() do
+    if (! handle_pkt.is_translated)
+    {
+        request_type fwd_pkt;
+        fwd_pkt.asid[0]       = handle_pkt.asid[0];
+        fwd_pkt.asid[1]       = handle_pkt.asid[1];
+        fwd_pkt.type          = access_type::LOAD;
+        fwd_pkt.cpu           = handle_pkt.cpu;
+
+        fwd_pkt.address       = handle_pkt.address;
+        fwd_pkt.v_address     = handle_pkt.v_address;
+        fwd_pkt.data          = handle_pkt.data;
+        fwd_pkt.instr_id      = handle_pkt.instr_id;
+        fwd_pkt.ip            = handle_pkt.ip;
+        fwd_pkt.is_translated = true;
+
+        handle_pkt.address       = champsim::splice_bits(functional_lower_translate(fwd_pkt).data, handle_pkt.v_address, LOG2_PAGE_SIZE);
+        handle_pkt.is_translated = true;
+    }
+
+    // The hit or the fill returns the response here
+    std::deque<response_type> returned {};
+    handle_pkt.to_return = {&returned};
+
+    if (try_hit(handle_pkt))
+        return returned.front();
+
+    mshr_type fill_mshr {handle_pkt, current_cycle};
+    if (handle_pkt.type != access_type::WRITE || match_offset_bits)
+    {
+        // Fetch the block from the next level, like handle_miss() does
+        request_type fwd_pkt;
+
+        fwd_pkt.asid[0]            = handle_pkt.asid[0];
+        fwd_pkt.asid[1]            = handle_pkt.asid[1];
+        fwd_pkt.type               = (handle_pkt.type == access_type::WRITE) ? access_type::RFO : handle_pkt.type;
+        fwd_pkt.pf_metadata        = handle_pkt.pf_metadata;
+        fwd_pkt.cpu                = handle_pkt.cpu;
+
+        fwd_pkt.address            = handle_pkt.address;
+        fwd_pkt.v_address          = handle_pkt.v_address;
+        fwd_pkt.data               = handle_pkt.data;
+        fwd_pkt.instr_id           = handle_pkt.instr_id;
+        fwd_pkt.ip                 = handle_pkt.ip;
+
+        fwd_pkt.response_requested = (! handle_pkt.prefetch_from_this || ! handle_pkt.skip_fill);
+
+        auto response = functional_lower_level(fwd_pkt);
+        if (! fwd_pkt.response_requested)
+        {
+            ++sim_stats.misses[champsim::to_underlying(handle_pkt.type)][handle_pkt.cpu];
+            return response;
+        }
+
+        fill_mshr.data        = response.data;
+        fill_mshr.pf_metadata = response.pf_metadata;
+    }
+
+    // Writes (that is, writebacks) are filled directly, like handle_write() does
+    ++sim_stats.misses[champsim::to_underlying(handle_pkt.type)][handle_pkt.cpu];
+    handle_fill(fill_mshr);
+
+    return returned.front();
+}
+#endif // FUNCTIONAL_WARMUP
+
+void CACHE::checkpoint(champsim::checkpoint_archive& archive)
+{
+    champsim::operable::checkpoint(archive);
+
+    archive.expect(std::pair {NUM_SET, NUM_WAY}, NAME + " geometry");
+    archive & block;
+}
+
 // LCOV_EXCL_START Exclude the following function from LCOV
 void CACHE::print_deadlock()
 {
@@ -21,12 +21,21 @@
 
 #include <algorithm>
 #include <chrono>
+#include <deque>
+#include <limits>
 #include <numeric>
 
+#include "ChampSim/clock_schedule.h"
+#include "ChampSim/functional_warmup.h"
 #include "ChampSim/ooo_cpu.h"
 #include "ChampSim/operable.h"
+#include "ChampSim/sampling.h"
+#include "ChampSim/simpoint.h"
 
 constexpr int DEADLOCK_CYCLE {500};
+#if (IDLE_CYCLE_SKIPPING == ENABLE)
+constexpr uint64_t IDLE_CHECK_MAX_BACKOFF {15};
+#endif // IDLE_CYCLE_SKIPPING
 
 auto start_time = std::chrono::steady_clock::now();
 
@@ -34,13 +43,307 @@ std::chrono::seconds elapsed_time() { return std::chrono::duration_cast<std::chr
 
 #if (USER_CODES == ENABLE)
 
+#if (PARALLEL_CORE_SIMULATION == ENABLE)
+namespace
+{
+// Keep enough instructions in the input queues for a whole quantum, since the traces are only read between quanta
+long input_queue_refill_cycles() { return project_configuration.parallel_quantum_cycles; }
+
+/** @brief
+ *  Operate a phase in quanta of PARALLEL_QUANTUM_CYCLES cycles. In every quantum, each CPU's private hierarchy (environment::private_view()) ticks
+ *  on its own thread for the whole quantum, then the shared operables (e.g., PTW, LLC, and memory controller) tick serially for the same cycles.
+ *  The private hierarchies of different CPUs only talk to each other through the shared operables, so the result doesn't depend on the number of
+ *  threads. Traffic crossing the boundary is seen by the other side at the next quantum, so a quantum of one cycle is cycle-by-cycle lockstep.
+ */
+class quantum_engine
+{
+    std::vector<champsim::clock_schedule> private_schedules {};
+    champsim::clock_schedule shared_schedule;
+
+    static std::vector<std::reference_wrapper<champsim::operable>> shared_view(champsim::environment& env)
+    {
+        auto private_operables = env.private_view();
+        auto operables         = env.operable_view();
+        auto is_private        = [&private_operables](const champsim::operable& op)
+        {
+            return std::any_of(std::cbegin(private_operables), std::cend(private_operables), [&op](const auto& view)
+                { return std::any_of(std::cbegin(view), std::cend(view), [&op](const champsim::operable& x)
+                      { return &x == &op; }); });
+        };
+        operables.erase(std::remove_if(std::begin(operables), std::end(operables), is_private), std::end(operables));
+        return operables;
+    }
+
+public:
+    explicit quantum_engine(champsim::environment& env): shared_schedule(shared_view(env))
+    {
+        for (auto& view : env.private_view())
+            private_schedules.emplace_back(view);
+    }
+
+    long operate()
+    {
+        long progress {0};
+        auto domains = static_cast<long>(std::size(private_schedules));
+
+#if (USE_OPENMP == ENABLE)
+#pragma omp parallel for reduction(+ : progress)
+#endif // USE_OPENMP
+        for (long i = 0; i < domains; i++)
+        {
+            auto& schedule = private_schedules[i];
+            for (int cycle = 0; cycle < project_configuration.parallel_quantum_cycles; cycle++)
+            {
+                for (champsim::operable& op : schedule.order())
+                    progress += op._operate();
+                schedule.advance();
+            }
+        }
+
+        for (int cycle = 0; cycle < project_configuration.parallel_quantum_cycles; cycle++)
+        {
+            for (champsim::operable& op : shared_schedule.order())
+                progress += op._operate();
+            shared_schedule.advance();
+        }
+
+        return progress;
+    }
+};
+} // namespace
+
+#else
+namespace
+{
+constexpr long input_queue_refill_cycles() { return 1; }
+} // namespace
+#endif // PARALLEL_CORE_SIMULATION
+
+#if (FUNCTIONAL_WARMUP == ENABLE)
+namespace
+{
+/** @brief
+ *  Perform a warmup phase with the functional warmup instead of the timing model. The CPUs take turns to warm up with one instruction each,
+ *  until all CPUs finish the phase or any trace reaches EOF. The instructions a CPU has read ahead into its input queue come first.
+ */
+void do_functional_phase(const std::string& phase_name, uint64_t length, const std::vector<std::size_t>& trace_index, champsim::environment& env,
+    std::vector<champsim::tracereader>& traces, bool quiet)
+{
+    auto operables = env.operable_view();
+    auto cpus      = env.cpu_view();
+
+    champsim::functional_warmup engine {env};
+
+    std::vector<bool> phase_complete(std::size(cpus), false);
+    while (! std::accumulate(std::begin(phase_complete), std::end(phase_complete), true, std::logical_and {}))
+    {
+        auto next_phase_complete = phase_complete;
+
+        for (O3_CPU& cpu : cpus)
+        {
+            auto& trace = traces.at(trace_index.at(cpu.cpu));
+
+            // A trace can already be at EOF when the phase starts (e.g., after the warmup, without --simulation-instructions to repeat it)
+            if (std::empty(cpu.input_queue) && trace.eof())
+            {
+                std::fill(std::begin(next_phase_complete), std::end(next_phase_complete), true);
+                continue;
+            }
+
+            auto instr  = std::empty(cpu.input_queue) ? trace() : cpu.input_queue.front();
+            if (! std::empty(cpu.input_queue))
+                cpu.input_queue.pop_front();
+            engine.operate(cpu, instr);
+
+            // If any trace reaches EOF, terminate all phases
+            if (trace.eof())
+                std::fill(std::begin(next_phase_complete), std::end(next_phase_complete), true);
+
+            // Phase complete
+            next_phase_complete[cpu.cpu] = next_phase_complete[cpu.cpu] || (cpu.sim_instr() >= length);
+        }
+
+        for (O3_CPU& cpu : cpus)
+        {
+            if (next_phase_complete[cpu.cpu] != phase_complete[cpu.cpu])
+            {
+                for (champsim::operable& op : operables)
+                    op.end_phase(cpu.cpu);
+
+                if (! quiet)
+                    fmt::print("{} finished CPU {} instructions: {} cycles: {} cumulative IPC: {:.4g} (Simulation time: {:%H hr %M min %S sec})\n", phase_name, cpu.cpu,
+                        cpu.sim_instr(), cpu.sim_cycle(), std::ceil(cpu.sim_instr()) / std::ceil(cpu.sim_cycle()), elapsed_time());
+            }
+        }
+
+        phase_complete = next_phase_complete;
+    }
+}
+} // namespace
+#endif // FUNCTIONAL_WARMUP
+
+namespace
+{
+/** @brief
+ *  Fast-forward the trace of each CPU over the instructions between two regions, without simulating them. The instructions a CPU has read
+ *  ahead into its input queue are the first ones skipped, while the instructions already in its pipeline finish in the next phase. Block traces
+ *  (.cbt) jump over the instructions instead of decompressing them.
+ */
+void fast_forward(const std::string& phase_name, uint64_t length, const std::vector<std::size_t>& trace_index, champsim::environment& env,
+    std::vector<champsim::tracereader>& traces)
+{
+    for (O3_CPU& cpu : env.cpu_view())
+    {
+        auto& trace     = traces.at(trace_index.at(cpu.cpu));
+
+        auto read_ahead = std::min<uint64_t>(length, std::size(cpu.input_queue));
+        cpu.input_queue.erase(std::begin(cpu.input_queue), std::next(std::begin(cpu.input_queue), read_ahead));
+
+        uint64_t skipped = read_ahead + trace.skip(length - read_ahead);
+
+        fmt::print("{} skipped CPU {} instructions: {} (Simulation time: {:%H hr %M min %S sec})\n", phase_name, cpu.cpu, skipped, elapsed_time());
+    }
+}
+} // namespace
+
+#if (FUNCTIONAL_WARMUP == ENABLE)
+namespace champsim
+{
+phase_stats do_phase(phase_info phase, environment& env, std::vector<tracereader>& traces);
+} // namespace champsim
+
+namespace
+{
+/** @brief
+ *  Let the CPUs retire the instructions in their pipelines without taking more from their input queues, so the functional warmup that follows
+ *  doesn't fill the caches with the blocks the timing model is still fetching.
+ */
+void drain(champsim::environment& env)
+{
+    auto cpus = env.cpu_view();
+
+    std::vector<std::deque<ooo_model_instr>> held(std::size(cpus));
+    for (std::size_t i = 0; i < std::size(cpus); i++)
+        std::swap(held[i], cpus[i].get().input_queue);
+
+    auto in_flight = [](const O3_CPU& cpu)
+    { return ! std::empty(cpu.IFETCH_BUFFER) || ! std::empty(cpu.DECODE_BUFFER) || ! std::empty(cpu.DISPATCH_BUFFER) || ! std::empty(cpu.ROB); };
+
+    champsim::clock_schedule schedule {env.operable_view()};
+    int stalled_cycle {0};
+    while (std::any_of(std::begin(cpus), std::end(cpus), in_flight))
+    {
+        long progress {0};
+        for (champsim::operable& op : schedule.order())
+            progress += op._operate();
+
+        stalled_cycle = (progress == 0) ? stalled_cycle + 1 : 0;
+        if (stalled_cycle >= DEADLOCK_CYCLE)
+        {
+            std::for_each(std::begin(schedule.order()), std::end(schedule.order()), [](champsim::operable& c)
+                { c.print_deadlock(); });
+            abort();
+        }
+
+        schedule.advance();
+    }
+
+    for (std::size_t i = 0; i < std::size(cpus); i++)
+        std::swap(held[i], cpus[i].get().input_queue);
+}
+
+/** @brief
+ *  Perform a simulation phase by periodic sampling, like SMARTS. In every period, the CPUs are warmed up functionally until the next window, which
+ *  keeps the caches, predictors and memory management warm, then simulated in detail for the warmup of the window to fill the pipelines and the
+ *  memory queues, and for the window itself, which is measured. The statistics of the phase are those of its mean window, and the CPI of each
+ *  window is kept to estimate the confidence of the IPC.
+ */
+champsim::phase_stats do_sampled_phase(const champsim::phase_info& phase, champsim::environment& env, std::vector<champsim::tracereader>& traces)
+{
+    auto operables = env.operable_view();
+    auto cpus      = env.cpu_view();
+
+    std::vector<uint64_t> begin_instrs;
+    std::transform(std::begin(cpus), std::end(cpus), std::back_inserter(begin_instrs), [](const O3_CPU& cpu)
+        { return cpu.num_retired; });
+
+    auto phase_complete = [&]()
+    {
+        auto eof = std::any_of(std::begin(phase.trace_index), std::end(phase.trace_index), [&traces](std::size_t i)
+            { return traces.at(i).eof(); });
+        auto covered = std::all_of(std::begin(cpus), std::end(cpus), [&](const O3_CPU& cpu)
+            { return cpu.num_retired - begin_instrs.at(cpu.cpu) >= phase.length; });
+        return eof || covered;
+    };
+
+    // The windows are phases of their own. Their warmup is timed like them, since a warmup phase doesn't model the latencies.
+    auto window              = phase;
+    window.skip_instructions = 0;
+    window.sampling          = {};
+    window.quiet             = true;
+
+    std::vector<champsim::phase_stats> windows;
+    do
+    {
+        for (champsim::operable& op : operables)
+        {
+            op.warmup = true;
+            op.begin_phase();
+        }
+
+        drain(env);
+        do_functional_phase(phase.name, phase.sampling.period - phase.sampling.warmup - phase.sampling.length, phase.trace_index, env, traces, true);
+
+        window.name   = fmt::format("{} window {}", phase.name, std::size(windows));
+        window.length = phase.sampling.warmup;
+        if (window.length > 0)
+            champsim::do_phase(window, env, traces);
+
+        window.length = phase.sampling.length;
+        windows.push_back(champsim::do_phase(window, env, traces));
+    } while (! phase_complete());
+
+    auto stats   = champsim::weighted_phase_stats(windows);
+    stats.name   = phase.name;
+    stats.weight = phase.weight;
+
+    for (O3_CPU& cpu : cpus)
+    {
+        auto& cpi = stats.sample_cpi.emplace_back();
+        for (const auto& window_stats : windows)
+        {
+            const auto& cpu_stats = window_stats.sim_cpu_stats.at(cpu.cpu);
+            if (cpu_stats.instrs() > 0)
+                cpi.push_back(std::ceil(cpu_stats.cycles()) / std::ceil(cpu_stats.instrs()));
+        }
+
+        auto estimate = champsim::estimate_ipc(cpi);
+        fmt::print("{} complete CPU {} windows: {} sampled IPC: {:.4g} confidence interval: [{:.4g}, {:.4g}] (Simulation time: {:%H hr %M min %S sec})\n",
+            phase.name, cpu.cpu, estimate.windows, estimate.ipc, estimate.ipc_low, estimate.ipc_high, elapsed_time());
+    }
+
+    return stats;
+}
+} // namespace
+#endif // FUNCTIONAL_WARMUP
+
 #if (RAMULATOR == ENABLE)
 namespace champsim
 {
 phase_stats do_phase(phase_info phase, environment& env, std::vector<tracereader>& traces)
 {
-    auto [phase_name, is_warmup, length, trace_index, trace_names] = phase;
-    auto operables                                                 = env.operable_view();
+    auto [phase_name, is_warmup, length, trace_index, trace_names, skip_instructions, weight, sampling, quiet] = phase;
+    auto operables                                                                                             = env.operable_view();
+    auto cpus                                                                                                  = env.cpu_view();
+
+    // Fast-forward to the region of this phase
+    if (skip_instructions > 0)
+        fast_forward(phase_name, skip_instructions, trace_index, env, traces);
+
+#if (FUNCTIONAL_WARMUP == ENABLE)
+    if (! is_warmup && sampling.period > 0)
+        return do_sampled_phase(phase, env, traces);
+#endif // FUNCTIONAL_WARMUP
 
     // Initialize phase
     for (champsim::operable& op : operables)
@@ -49,23 +352,51 @@ phase_stats do_phase(phase_info phase, environment& env, std::vector<tracereader
         op.begin_phase();
     }
 
+    // The tick order of every cycle in this phase
+    clock_schedule schedule {operables};
+#if (PARALLEL_CORE_SIMULATION == ENABLE)
+    quantum_engine engine {env};
+#endif // PARALLEL_CORE_SIMULATION
+
     // Perform phase
     int stalled_cycle {0};
-    std::vector<bool> phase_complete(std::size(env.cpu_view()), false);
+#if (IDLE_CYCLE_SKIPPING == ENABLE)
+    uint64_t skipped_cycles {0};
+    // Each failed check doubles the cycles until the next one, so that busy stretches pay for few checks
+    uint64_t idle_check_delay {0};
+    uint64_t idle_check_backoff {0};
+#endif // IDLE_CYCLE_SKIPPING
+    std::vector<bool> phase_complete(std::size(cpus), false);
+#if (FUNCTIONAL_WARMUP == ENABLE)
+    // Warm up without timing, then the loop below has nothing left to do
+    if (is_warmup)
+    {
+        do_functional_phase(phase_name, length, trace_index, env, traces, quiet);
+        std::fill(std::begin(phase_complete), std::end(phase_complete), true);
+    }
+#endif // FUNCTIONAL_WARMUP
     while (! std::accumulate(std::begin(phase_complete), std::end(phase_complete), true, std::logical_and {}))
     {
         auto next_phase_complete = phase_complete;
 
         // Operate
         long progress {0};
-        for (champsim::operable& op : operables)
+#if (PARALLEL_CORE_SIMULATION == ENABLE)
+        progress = engine.operate();
+#else
+        for (champsim::operable& op : schedule.order())
         {
             progress += op._operate();
         }
+#endif // PARALLEL_CORE_SIMULATION
 
         if (progress == 0)
         {
+#if (PARALLEL_CORE_SIMULATION == ENABLE)
+            stalled_cycle += project_configuration.parallel_quantum_cycles;
+#else
             ++stalled_cycle;
+#endif // PARALLEL_CORE_SIMULATION
         }
         else
         {
@@ -74,20 +405,21 @@ phase_stats do_phase(phase_info phase, environment& env, std::vector<tracereader
 
         if (stalled_cycle >= DEADLOCK_CYCLE)
         {
-            std::for_each(std::begin(operables), std::end(operables), [](champsim::operable& c)
+            std::for_each(std::begin(schedule.order()), std::end(schedule.order()), [](champsim::operable& c)
                 { c.print_deadlock(); });
             abort();
         }
 
-        std::sort(std::begin(operables), std::end(operables),
-            [](const champsim::operable& lhs, const champsim::operable& rhs)
-            { return lhs.leap_operation < rhs.leap_operation; });
+#if (PARALLEL_CORE_SIMULATION == DISABLE)
+        // Operables tick in the order of their fractional clocks in the next cycle
+        schedule.advance();
+#endif // PARALLEL_CORE_SIMULATION
 
         // Read from trace
-        for (O3_CPU& cpu : env.cpu_view())
+        for (O3_CPU& cpu : cpus)
         {
             auto& trace = traces.at(trace_index.at(cpu.cpu));
-            for (auto pkt_count = cpu.IN_QUEUE_SIZE - static_cast<long>(std::size(cpu.input_queue)); ! trace.eof() && pkt_count > 0; --pkt_count)
+            for (auto pkt_count = cpu.IN_QUEUE_SIZE * input_queue_refill_cycles() - static_cast<long>(std::size(cpu.input_queue)); ! trace.eof() && pkt_count > 0; --pkt_count)
                 cpu.input_queue.push_back(trace());
 
             // If any trace reaches EOF, terminate all phases
@@ -96,40 +428,80 @@ phase_stats do_phase(phase_info phase, environment& env, std::vector<tracereader
         }
 
         // Check for phase finish
-        for (O3_CPU& cpu : env.cpu_view())
+        for (O3_CPU& cpu : cpus)
         {
             // Phase complete
             next_phase_complete[cpu.cpu] = next_phase_complete[cpu.cpu] || (cpu.sim_instr() >= length);
         }
 
-        for (O3_CPU& cpu : env.cpu_view())
+        for (O3_CPU& cpu : cpus)
         {
             if (next_phase_complete[cpu.cpu] != phase_complete[cpu.cpu])
             {
-                for (champsim::operable& op : operables)
+                for (champsim::operable& op : schedule.order())
                     op.end_phase(cpu.cpu);
 
-                fmt::print("{} finished CPU {} instructions: {} cycles: {} cumulative IPC: {:.4g} (Simulation time: {:%H hr %M min %S sec})\n", phase_name, cpu.cpu,
-                    cpu.sim_instr(), cpu.sim_cycle(), std::ceil(cpu.sim_instr()) / std::ceil(cpu.sim_cycle()), elapsed_time());
+                if (! quiet)
+                    fmt::print("{} finished CPU {} instructions: {} cycles: {} cumulative IPC: {:.4g} (Simulation time: {:%H hr %M min %S sec})\n", phase_name, cpu.cpu,
+                        cpu.sim_instr(), cpu.sim_cycle(), std::ceil(cpu.sim_instr()) / std::ceil(cpu.sim_cycle()), elapsed_time());
             }
         }
 
         phase_complete = next_phase_complete;
+
+#if (IDLE_CYCLE_SKIPPING == ENABLE)
+        // Jump over the cycles in which no operable can make progress
+        if (idle_check_delay > 0)
+        {
+            --idle_check_delay;
+        }
+        else if (project_configuration.idle_cycle_skipping && ! std::accumulate(std::begin(phase_complete), std::end(phase_complete), true, std::logical_and {}))
+        {
+            // Ask the memory controller first, since it is the cheapest to check and the most often busy
+            uint64_t skip_cycles = std::numeric_limits<uint64_t>::max();
+            for (auto op_it = std::rbegin(schedule.order()); op_it != std::rend(schedule.order()); ++op_it)
+            {
+                skip_cycles = op_it->get().idle_cycles(skip_cycles);
+                if (skip_cycles == 0)
+                    break;
+            }
+
+            if (skip_cycles > 0 && skip_cycles != std::numeric_limits<uint64_t>::max())
+            {
+                for (champsim::operable& op : schedule.order())
+                    op.skip_cycles(skip_cycles);
+                schedule.advance(skip_cycles);
+                skipped_cycles += skip_cycles;
+                idle_check_backoff = 0;
+            }
+            else
+            {
+                idle_check_backoff = std::min<uint64_t>(2 * idle_check_backoff + 1, IDLE_CHECK_MAX_BACKOFF);
+                idle_check_delay   = idle_check_backoff;
+            }
+        }
+#endif // IDLE_CYCLE_SKIPPING
     }
 
-    for (O3_CPU& cpu : env.cpu_view())
+    for (O3_CPU& cpu : cpus)
     {
-        fmt::print("{} complete CPU {} instructions: {} cycles: {} cumulative IPC: {:.4g} (Simulation time: {:%H hr %M min %S sec})\n", phase_name, cpu.cpu,
-            cpu.sim_instr(), cpu.sim_cycle(), std::ceil(cpu.sim_instr()) / std::ceil(cpu.sim_cycle()), elapsed_time());
+        if (! quiet)
+            fmt::print("{} complete CPU {} instructions: {} cycles: {} cumulative IPC: {:.4g} (Simulation time: {:%H hr %M min %S sec})\n", phase_name, cpu.cpu,
+                cpu.sim_instr(), cpu.sim_cycle(), std::ceil(cpu.sim_instr()) / std::ceil(cpu.sim_cycle()), elapsed_time());
     }
+#if (IDLE_CYCLE_SKIPPING == ENABLE)
+    // Tells whether skipping pays off for the workload
+    if (! quiet && project_configuration.idle_cycle_skipping)
+        fmt::print("{} skipped idle cycles: {}\n", phase_name, skipped_cycles);
+#endif // IDLE_CYCLE_SKIPPING
 
     phase_stats stats;
-    stats.name = phase.name;
+    stats.name   = phase.name;
+    stats.weight = weight;
 
     for (std::size_t i = 0; i < std::size(trace_index); ++i)
         stats.trace_names.push_back(trace_names.at(trace_index.at(i)));
 
-    auto cpus = env.cpu_view();
     std::transform(std::begin(cpus), std::end(cpus), std::back_inserter(stats.sim_cpu_stats), [](const O3_CPU& cpu)
         { return cpu.sim_stats; });
     std::transform(std::begin(cpus), std::end(cpus), std::back_inserter(stats.roi_cpu_stats), [](const O3_CPU& cpu)
@@ -145,17 +517,36 @@ phase_stats do_phase(phase_info phase, environment& env, std::vector<tracereader
 }
 
 // simulation entry point
-std::vector<phase_stats> main(environment& env, std::vector<phase_info>& phases, std::vector<tracereader>& traces)
+std::vector<phase_stats> main(environment& env, std::vector<phase_info>& phases, std::vector<tracereader>& traces, const checkpoint_files& checkpoint)
 {
     for (champsim::operable& op : env.operable_view())
         op.initialize();
 
+    if (profiler::enabled)
+        profiler::attach(env);
+
     std::vector<phase_stats> results;
     for (auto phase : phases)
     {
-        auto stats = do_phase(phase, env, traces);
+        if (phase.is_warmup && ! std::empty(checkpoint.restore))
+        {
+            restore_checkpoint(env, checkpoint.restore, phase, traces);
+            fmt::print("{} restored from checkpoint {} (Simulation time: {:%H hr %M min %S sec})\n\n", phase.name, checkpoint.restore, elapsed_time());
+            continue;
+        }
+
+        auto profile_start = profiler::take_snapshot();
+        auto stats         = do_phase(phase, env, traces);
+        if (profiler::enabled)
+            stats.profile = profiler::since(profile_start);
         if (! phase.is_warmup)
             results.push_back(stats);
+
+        if (phase.is_warmup && ! std::empty(checkpoint.save))
+        {
+            save_checkpoint(env, checkpoint.save, phase);
+            fmt::print("{} saved into checkpoint {} (Simulation time: {:%H hr %M min %S sec})\n\n", phase.name, checkpoint.save, elapsed_time());
+        }
     }
 
     return results;
@@ -168,8 +559,18 @@ namespace champsim
 {
 phase_stats do_phase(phase_info phase, environment& env, std::vector<tracereader>& traces)
 {
-    auto [phase_name, is_warmup, length, trace_index, trace_names] = phase;
-    auto operables                                                 = env.operable_view();
+    auto [phase_name, is_warmup, length, trace_index, trace_names, skip_instructions, weight, sampling, quiet] = phase;
+    auto operables                                                                                             = env.operable_view();
+    auto cpus                                                                                                  = env.cpu_view();
+
+    // Fast-forward to the region of this phase
+    if (skip_instructions > 0)
+        fast_forward(phase_name, skip_instructions, trace_index, env, traces);
+
+#if (FUNCTIONAL_WARMUP == ENABLE)
+    if (! is_warmup && sampling.period > 0)
+        return do_sampled_phase(phase, env, traces);
+#endif // FUNCTIONAL_WARMUP
 
     // Initialize phase
     for (champsim::operable& op : operables)
@@ -178,23 +579,45 @@ phase_stats do_phase(phase_info phase, environment& env, std::vector<tracereader
         op.begin_phase();
     }
 
+    // The tick order of every cycle in this phase
+    clock_schedule schedule {operables};
+#if (PARALLEL_CORE_SIMULATION == ENABLE)
+    quantum_engine engine {env};
+#endif // PARALLEL_CORE_SIMULATION
+
     // Perform phase
     int stalled_cycle {0};
-    std::vector<bool> phase_complete(std::size(env.cpu_view()), false);
+    std::vector<bool> phase_complete(std::size(cpus), false);
+#if (FUNCTIONAL_WARMUP == ENABLE)
+    // Warm up without timing, then the loop below has nothing left to do
+    if (is_warmup)
+    {
+        do_functional_phase(phase_name, length, trace_index, env, traces, quiet);
+        std::fill(std::begin(phase_complete), std::end(phase_complete), true);
+    }
+#endif // FUNCTIONAL_WARMUP
     while (! std::accumulate(std::begin(phase_complete), std::end(phase_complete), true, std::logical_and {}))
     {
         auto next_phase_complete = phase_complete;
 
         // Operate
         long progress {0};
-        for (champsim::operable& op : operables)
+#if (PARALLEL_CORE_SIMULATION == ENABLE)
+        progress = engine.operate();
+#else
+        for (champsim::operable& op : schedule.order())
         {
             progress += op._operate();
         }
+#endif // PARALLEL_CORE_SIMULATION
 
         if (progress == 0)
         {
+#if (PARALLEL_CORE_SIMULATION == ENABLE)
+            stalled_cycle += project_configuration.parallel_quantum_cycles;
+#else
             ++stalled_cycle;
+#endif // PARALLEL_CORE_SIMULATION
         }
         else
         {
@@ -203,20 +626,21 @@ phase_stats do_phase(phase_info phase, environment& env, std::vector<tracereader
 
         if (stalled_cycle >= DEADLOCK_CYCLE)
         {
-            std::for_each(std::begin(operables), std::end(operables), [](champsim::operable& c)
+            std::for_each(std::begin(schedule.order()), std::end(schedule.order()), [](champsim::operable& c)
                 { c.print_deadlock(); });
             abort();
         }
 
-        std::sort(std::begin(operables), std::end(operables),
-            [](const champsim::operable& lhs, const champsim::operable& rhs)
-            { return lhs.leap_operation < rhs.leap_operation; });
+#if (PARALLEL_CORE_SIMULATION == DISABLE)
+        // Operables tick in the order of their fractional clocks in the next cycle
+        schedule.advance();
+#endif // PARALLEL_CORE_SIMULATION
 
         // Read from trace
-        for (O3_CPU& cpu : env.cpu_view())
+        for (O3_CPU& cpu : cpus)
         {
             auto& trace = traces.at(trace_index.at(cpu.cpu));
-            for (auto pkt_count = cpu.IN_QUEUE_SIZE - static_cast<long>(std::size(cpu.input_queue)); ! trace.eof() && pkt_count > 0; --pkt_count)
+            for (auto pkt_count = cpu.IN_QUEUE_SIZE * input_queue_refill_cycles() - static_cast<long>(std::size(cpu.input_queue)); ! trace.eof() && pkt_count > 0; --pkt_count)
                 cpu.input_queue.push_back(trace());
 
             // If any trace reaches EOF, terminate all phases
@@ -225,40 +649,42 @@ phase_stats do_phase(phase_info phase, environment& env, std::vector<tracereader
         }
 
         // Check for phase finish
-        for (O3_CPU& cpu : env.cpu_view())
+        for (O3_CPU& cpu : cpus)
         {
             // Phase complete
             next_phase_complete[cpu.cpu] = next_phase_complete[cpu.cpu] || (cpu.sim_instr() >= length);
         }
 
-        for (O3_CPU& cpu : env.cpu_view())
+        for (O3_CPU& cpu : cpus)
         {
             if (next_phase_complete[cpu.cpu] != phase_complete[cpu.cpu])
             {
-                for (champsim::operable& op : operables)
+                for (champsim::operable& op : schedule.order())
                     op.end_phase(cpu.cpu);
 
-                fmt::print("{} finished CPU {} instructions: {} cycles: {} cumulative IPC: {:.4g} (Simulation time: {:%H hr %M min %S sec})\n", phase_name, cpu.cpu,
-                    cpu.sim_instr(), cpu.sim_cycle(), std::ceil(cpu.sim_instr()) / std::ceil(cpu.sim_cycle()), elapsed_time());
+                if (! quiet)
+                    fmt::print("{} finished CPU {} instructions: {} cycles: {} cumulative IPC: {:.4g} (Simulation time: {:%H hr %M min %S sec})\n", phase_name, cpu.cpu,
+                        cpu.sim_instr(), cpu.sim_cycle(), std::ceil(cpu.sim_instr()) / std::ceil(cpu.sim_cycle()), elapsed_time());
             }
         }
 
         phase_complete = next_phase_complete;
     }
 
-    for (O3_CPU& cpu : env.cpu_view())
+    for (O3_CPU& cpu : cpus)
     {
-        fmt::print("{} complete CPU {} instructions: {} cycles: {} cumulative IPC: {:.4g} (Simulation time: {:%H hr %M min %S sec})\n", phase_name, cpu.cpu,
-            cpu.sim_instr(), cpu.sim_cycle(), std::ceil(cpu.sim_instr()) / std::ceil(cpu.sim_cycle()), elapsed_time());
+        if (! quiet)
+            fmt::print("{} complete CPU {} instructions: {} cycles: {} cumulative IPC: {:.4g} (Simulation time: {:%H hr %M min %S sec})\n", phase_name, cpu.cpu,
+                cpu.sim_instr(), cpu.sim_cycle(), std::ceil(cpu.sim_instr()) / std::ceil(cpu.sim_cycle()), elapsed_time());
     }
 
     phase_stats stats;
-    stats.name = phase.name;
+    stats.name   = phase.name;
+    stats.weight = weight;
 
     for (std::size_t i = 0; i < std::size(trace_index); ++i)
         stats.trace_names.push_back(trace_names.at(trace_index.at(i)));
 
-    auto cpus = env.cpu_view();
     std::transform(std::begin(cpus), std::end(cpus), std::back_inserter(stats.sim_cpu_stats), [](const O3_CPU& cpu)
         { return cpu.sim_stats; });
     std::transform(std::begin(cpus), std::end(cpus), std::back_inserter(stats.roi_cpu_stats), [](const O3_CPU& cpu)
@@ -282,17 +708,36 @@ phase_stats do_phase(phase_info phase, environment& env, std::vector<tracereader
 }
 
 // simulation entry point
-std::vector<phase_stats> main(environment& env, std::vector<phase_info>& phases, std::vector<tracereader>& traces)
+std::vector<phase_stats> main(environment& env, std::vector<phase_info>& phases, std::vector<tracereader>& traces, const checkpoint_files& checkpoint)
 {
     for (champsim::operable& op : env.operable_view())
         op.initialize();
 
+    if (profiler::enabled)
+        profiler::attach(env);
+
     std::vector<phase_stats> results;
     for (auto phase : phases)
     {
-        auto stats = do_phase(phase, env, traces);
+        if (phase.is_warmup && ! std::empty(checkpoint.restore))
+        {
+            restore_checkpoint(env, checkpoint.restore, phase, traces);
+            fmt::print("{} restored from checkpoint {} (Simulation time: {:%H hr %M min %S sec})\n\n", phase.name, checkpoint.restore, elapsed_time());
+            continue;
+        }
+
+        auto profile_start = profiler::take_snapshot();
+        auto stats         = do_phase(phase, env, traces);
+        if (profiler::enabled)
+            stats.profile = profiler::since(profile_start);
         if (! phase.is_warmup)
             results.push_back(stats);
+
+        if (phase.is_warmup && ! std::empty(checkpoint.save))
+        {
+            save_checkpoint(env, checkpoint.save, phase);
+            fmt::print("{} saved into checkpoint {} (Simulation time: {:%H hr %M min %S sec})\n\n", phase.name, checkpoint.save, elapsed_time());
+        }
     }
 
     return results;
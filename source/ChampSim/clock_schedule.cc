@@ -0,0 +1,97 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ChampSim/clock_schedule.h"
+
+#include <algorithm>
+#include <map>
+#include <numeric>
+#include <utility>
+
+#if (USER_CODES == ENABLE)
+
+namespace
+{
+// Advance a fractional clock by one cycle, the same way as champsim::operable::_operate() does
+void leap(double& leap_operation, double clock_scale)
+{
+#if (RAMULATOR == ENABLE)
+    // Every operable ticks every cycle, the memories keep their own fractional clocks
+#else
+    if (leap_operation >= 1)
+        leap_operation -= 1;
+    else
+        leap_operation += clock_scale;
+#endif // RAMULATOR
+}
+} // namespace
+
+champsim::clock_schedule::clock_schedule(order_type operables)
+{
+    // Replay the fractional clocks on indices of the operables until a state (order and clocks) repeats
+    std::vector<double> leaps {};
+    std::transform(std::cbegin(operables), std::cend(operables), std::back_inserter(leaps), [](const operable& op)
+        { return op.leap_operation; });
+    std::vector<std::size_t> indices(std::size(operables));
+    std::iota(std::begin(indices), std::end(indices), 0);
+
+    std::map<std::pair<std::vector<std::size_t>, std::vector<double>>, std::size_t> seen {};
+    std::vector<std::vector<std::size_t>> orders {};
+    while (std::size(orders) < MAX_LENGTH)
+    {
+        auto [state, inserted] = seen.try_emplace({indices, leaps}, std::size(orders));
+        if (! inserted)
+        {
+            repeat_begin = state->second;
+            std::transform(std::cbegin(orders), std::cend(orders), std::back_inserter(calendar), [&operables](const auto& order)
+                {
+                order_type result {};
+                std::transform(std::cbegin(order), std::cend(order), std::back_inserter(result), [&operables](std::size_t i)
+                    { return operables[i]; });
+                return result; });
+            return;
+        }
+
+        orders.push_back(indices);
+        for (std::size_t i = 0; i < std::size(operables); i++)
+            leap(leaps[i], operables[i].get().CLOCK_SCALE);
+
+        // Same comparisons as sorting the operables themselves, so ties are ordered the same way
+        std::sort(std::begin(indices), std::end(indices), [&leaps](std::size_t lhs, std::size_t rhs)
+            { return leaps[lhs] < leaps[rhs]; });
+    }
+
+    sorting = true;
+    calendar.push_back(std::move(operables));
+}
+
+void champsim::clock_schedule::advance(uint64_t cycles)
+{
+    if (sorting)
+    {
+        std::sort(std::begin(calendar[0]), std::end(calendar[0]), [](const operable& lhs, const operable& rhs)
+            { return lhs.leap_operation < rhs.leap_operation; });
+        return;
+    }
+
+    for (; cycles > 0; cycles--)
+    {
+        if (++slot == std::size(calendar))
+            slot = repeat_begin;
+    }
+}
+
+#endif // USER_CODES
@@ -0,0 +1,164 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ChampSim/functional_warmup.h"
+
+#if (USER_CODES == ENABLE)
+#if (FUNCTIONAL_WARMUP == ENABLE)
+
+champsim::functional_warmup::functional_warmup(environment& env): env(env)
+{
+    // Find the component that handles the requests of each channel
+    std::map<const channel*, level_type> levels {};
+    for (CACHE& cache : env.cache_view())
+    {
+        clocked.push_back(cache);
+        for (auto ul : cache.upper_levels)
+            levels[ul] = [&cache](const channel::request_type& packet)
+            { return cache.functional_access(packet); };
+    }
+
+    for (PageTableWalker& ptw : env.ptw_view())
+    {
+        clocked.push_back(ptw);
+        for (auto ul : ptw.upper_levels)
+            levels[ul] = [&ptw](const channel::request_type& packet)
+            { return ptw.functional_access(packet); };
+    }
+
+    // The channels that no cache or page table walker handles lead to the memory controller
+    auto lower = [&levels, this](const channel* ll) -> level_type
+    {
+        if (auto found = levels.find(ll); found != std::end(levels))
+            return found->second;
+
+        return [this](const channel::request_type& packet)
+        {
+            this->env.functional_memory_access(packet);
+            return channel::response_type {packet.address, packet.v_address, packet.data, packet.pf_metadata, {}};
+        };
+    };
+
+    for (CACHE& cache : env.cache_view())
+    {
+        cache.functional_lower_level = lower(cache.lower_level);
+        if (cache.lower_translate != nullptr)
+            cache.functional_lower_translate = lower(cache.lower_translate);
+    }
+
+    for (PageTableWalker& ptw : env.ptw_view())
+        ptw.functional_lower_level = lower(ptw.lower_level);
+
+    for (O3_CPU& cpu : env.cpu_view())
+    {
+        clocked.push_back(cpu);
+        first_levels[cpu.cpu] = {lower(cpu.L1I_bus.lower_level), lower(cpu.L1D_bus.lower_level)};
+    }
+}
+
+champsim::functional_warmup::~functional_warmup()
+{
+    // Go back to the timing model
+    for (CACHE& cache : env.cache_view())
+    {
+        cache.functional_lower_level     = nullptr;
+        cache.functional_lower_translate = nullptr;
+    }
+
+    for (PageTableWalker& ptw : env.ptw_view())
+        ptw.functional_lower_level = nullptr;
+}
+
+void champsim::functional_warmup::operate(O3_CPU& cpu, ooo_model_instr& instr)
+{
+    auto& [l1i, l1d] = first_levels.at(cpu.cpu);
+
+    // Advance the clocks by one cycle per instruction, since replacement policies order the accesses by them
+    for (operable& op : clocked)
+        ++op.current_cycle;
+
+    // Predict the branch, like initialize_instruction() does
+    cpu.do_init_instruction(instr);
+
+    // Fetch the instruction unless the decoded instruction buffer has it, like check_dib() and fetch_instruction() do
+    if (! cpu.DIB.check_hit(instr.ip).has_value())
+    {
+        channel::request_type fetch_packet;
+        fetch_packet.v_address = instr.ip;
+        fetch_packet.instr_id  = instr.instr_id;
+        fetch_packet.ip        = instr.ip;
+
+        // Same as CacheBus::issue_read()
+        fetch_packet.address       = fetch_packet.v_address;
+        fetch_packet.is_translated = false;
+        fetch_packet.cpu           = cpu.cpu;
+        fetch_packet.type          = access_type::LOAD;
+
+#if (TRACKING_LOAD_STORE_STATISTICS == ENABLE)
+        fetch_packet.type_origin = access_type::LOAD;
+#endif // TRACKING_LOAD_STORE_STATISTICS
+
+        l1i(fetch_packet);
+    }
+    cpu.do_dib_update(instr);
+
+    // Access the data, like execute_load() and do_complete_store() do
+    for (auto smem : instr.source_memory)
+    {
+        channel::request_type data_packet;
+        data_packet.v_address = smem;
+        data_packet.instr_id  = instr.instr_id;
+        data_packet.ip        = instr.ip;
+
+        // Same as CacheBus::issue_read()
+        data_packet.address       = data_packet.v_address;
+        data_packet.is_translated = false;
+        data_packet.cpu           = cpu.cpu;
+        data_packet.type          = access_type::LOAD;
+
+#if (TRACKING_LOAD_STORE_STATISTICS == ENABLE)
+        data_packet.type_origin = access_type::LOAD;
+#endif // TRACKING_LOAD_STORE_STATISTICS
+
+        l1d(data_packet);
+    }
+
+    for (auto dmem : instr.destination_memory)
+    {
+        channel::request_type data_packet;
+        data_packet.v_address          = dmem;
+        data_packet.instr_id           = instr.instr_id;
+        data_packet.ip                 = instr.ip;
+
+        // Same as CacheBus::issue_write()
+        data_packet.address            = data_packet.v_address;
+        data_packet.is_translated      = false;
+        data_packet.cpu                = cpu.cpu;
+        data_packet.type               = access_type::WRITE;
+        data_packet.response_requested = false;
+
+#if (TRACKING_LOAD_STORE_STATISTICS == ENABLE)
+        data_packet.type_origin = access_type::WRITE;
+#endif // TRACKING_LOAD_STORE_STATISTICS
+
+        l1d(data_packet);
+    }
+
+    ++cpu.num_retired;
+}
+
+#endif // FUNCTIONAL_WARMUP
+#endif // USER_CODES
@@ -19,6 +19,7 @@
 #include <utility>
 
 #include "ChampSim/phase_info.h"
+#include "ChampSim/sampling.h"
 #include "ChampSim/stats_printer.h"
 
 void to_json(nlohmann::json& j, const O3_CPU::stats_type stats)
@@ -103,6 +104,41 @@ void to_json(nlohmann::json& j, const champsim::phase_stats stats)
     };
     statsmap.emplace("roi", roi_stats);
     statsmap.emplace("sim", sim_stats);
+
+#if (USER_CODES == ENABLE)
+    // The confidence of the IPC of a sampled phase
+    if (! std::empty(stats.sample_cpi))
+    {
+        std::vector<nlohmann::json> sampling;
+        for (const auto& cpi : stats.sample_cpi)
+        {
+            auto estimate = champsim::estimate_ipc(cpi);
+            sampling.push_back(nlohmann::json {
+                {                    "windows",                      estimate.windows},
+                {                        "IPC",                          estimate.ipc},
+                {"IPC confidence interval", {estimate.ipc_low, estimate.ipc_high}},
+                {             "relative error",               estimate.relative_error}
+            });
+        }
+        statsmap.emplace("sampling", sampling);
+    }
+
+    // The host time spent by the components, with --profile
+    if (! std::empty(stats.profile.records))
+    {
+        std::vector<nlohmann::json> records;
+        for (const auto& record : stats.profile.records)
+        {
+            records.push_back(nlohmann::json {
+                {   "name",    record.name},
+                {  "calls",   record.calls},
+                {"seconds", record.seconds}
+            });
+        }
+        statsmap.emplace("profile", nlohmann::json {{"seconds", stats.profile.seconds}, {"entries", records}});
+    }
+#endif // USER_CODES
+
     j = statsmap;
 }
 } // namespace champsim
@@ -0,0 +1,81 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ChampSim/mapped_tracereader.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <utility>
+
+#if (USER_CODES == ENABLE)
+
+champsim::mapped_file::mapped_file(const std::string& file_name)
+{
+    int fd = open(file_name.c_str(), O_RDONLY);
+    struct stat status;
+    if (fd < 0 || fstat(fd, &status) != 0)
+    {
+        std::printf("%s: Cannot open trace %s.\n", __func__, file_name.c_str());
+        abort();
+    }
+
+    bytes = static_cast<std::size_t>(status.st_size);
+    if (bytes > 0)
+    {
+        void* mapping = mmap(nullptr, bytes, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapping == MAP_FAILED)
+        {
+            std::printf("%s: Cannot map trace %s.\n", __func__, file_name.c_str());
+            abort();
+        }
+
+        // The trace is read from the beginning to the end, so the kernel can read ahead aggressively and drop the pages behind
+        madvise(mapping, bytes, MADV_SEQUENTIAL);
+        base = static_cast<const char*>(mapping);
+    }
+
+    // The mapping stays valid after the file is closed
+    close(fd);
+}
+
+bool champsim::mapped_file::can_map(const std::string& file_name)
+{
+    // Only look at the file, since opening a FIFO would wait for its writer
+    struct stat status;
+    return stat(file_name.c_str(), &status) == 0 && S_ISREG(status.st_mode);
+}
+
+champsim::mapped_file::~mapped_file()
+{
+    if (base != nullptr)
+        munmap(const_cast<char*>(base), bytes);
+}
+
+champsim::mapped_file::mapped_file(mapped_file&& other) noexcept: base(std::exchange(other.base, nullptr)), bytes(std::exchange(other.bytes, 0)) {}
+
+champsim::mapped_file& champsim::mapped_file::operator=(mapped_file&& other) noexcept
+{
+    std::swap(base, other.base);
+    std::swap(bytes, other.bytes);
+    return *this;
+}
+
+#endif // USER_CODES
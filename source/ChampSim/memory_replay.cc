@@ -0,0 +1,115 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ChampSim/memory_replay.h"
+
+#include <algorithm>
+#include <optional>
+
+#include "ChampSim/memory_trace.h"
+
+#if (USER_CODES == ENABLE) && (RAMULATOR == ENABLE)
+
+namespace
+{
+// The next request that the recording run sent to the memories by itself
+std::optional<champsim::memory_trace::record> next_replayed(champsim::memory_trace::reader& trace)
+{
+    auto r = trace.next();
+    while (r.has_value() && (! r->accepted || r->origin == champsim::memory_trace::ORIGIN_SWAPPING))
+        r = trace.next();
+    return r;
+}
+
+champsim::channel::request_type make_packet(const champsim::memory_trace::record& r)
+{
+    champsim::channel::request_type packet;
+    packet.address            = r.physical_address;
+    packet.v_address          = r.physical_address;
+    packet.cpu                = r.cpu;
+    packet.response_requested = false; // No cache waits for the data
+
+    auto origin = static_cast<access_type>(r.origin);
+    if (r.type == 'W')
+        packet.type = access_type::WRITE;
+    else if (r.origin < static_cast<uint8_t>(access_type::NUM_TYPES) && origin != access_type::WRITE)
+        packet.type = origin;
+    else
+        packet.type = access_type::LOAD;
+
+#if (MEMORY_USE_OS_TRANSPARENT_MANAGEMENT == ENABLE) && (TRACKING_LOAD_STORE_STATISTICS == ENABLE)
+    packet.type_origin = origin;
+#endif // MEMORY_USE_OS_TRANSPARENT_MANAGEMENT, TRACKING_LOAD_STORE_STATISTICS
+
+    return packet;
+}
+} // namespace
+
+champsim::memory_replay_stats champsim::replay_memory_trace(operable& controller, channel& upper,
+    const std::vector<std::reference_wrapper<ramulator::MemoryBase>>& memories, const std::string& file_name)
+{
+    memory_trace::reader trace {file_name};
+    memory_replay_stats stats;
+
+    controller.warmup = false;
+    controller.begin_phase();
+
+    auto next                 = next_replayed(trace);
+    const uint64_t first      = next.has_value() ? next->cycle : 0;
+    const uint64_t start      = controller.current_cycle;
+    auto memories_are_pending = [&memories]
+    { return std::any_of(std::begin(memories), std::end(memories), [](ramulator::MemoryBase& memory) { return memory.pending_requests() > 0; }); };
+
+    while (next.has_value() || ! std::empty(upper.RQ) || ! std::empty(upper.WQ) || memories_are_pending())
+    {
+        // Add the requests recorded up to this cycle
+        while (next.has_value() && next->cycle - first <= controller.current_cycle - start)
+        {
+            if (next->type == 'W')
+            {
+                upper.add_wq(make_packet(*next));
+                stats.writes++;
+            }
+            else
+            {
+                upper.add_rq(make_packet(*next));
+                stats.reads++;
+            }
+
+            stats.recorded_cycles = next->cycle - first;
+            next                  = next_replayed(trace);
+        }
+
+        controller._operate();
+        upper.returned.clear(); // The swapping unit returns the data it buffers whether requested or not
+
+#if (IDLE_CYCLE_SKIPPING == ENABLE)
+        // Jump over the cycles before the next request in which the memories have nothing to do
+        if (project_configuration.idle_cycle_skipping && next.has_value() && next->cycle - first > controller.current_cycle - start)
+        {
+            auto idle = controller.idle_cycles(next->cycle - first - (controller.current_cycle - start));
+            if (idle > 0)
+                controller.skip_cycles(idle);
+        }
+#endif // IDLE_CYCLE_SKIPPING
+    }
+
+    controller.end_phase(0);
+    stats.cycles = controller.current_cycle - start;
+    return stats;
+}
+
+#endif // USER_CODES, RAMULATOR
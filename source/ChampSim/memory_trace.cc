@@ -0,0 +1,135 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ChampSim/memory_trace.h"
+
+#include <zlib.h>
+
+#include <cstdlib>
+#include <cstring>
+
+#if (USER_CODES == ENABLE)
+
+champsim::memory_trace::writer::writer(std::FILE* file, const std::string& file_name): file(file), file_name(file_name)
+{
+    if (file == nullptr)
+    {
+        std::printf("%s: Cannot write memory trace %s.\n", __func__, file_name.c_str());
+        abort();
+    }
+
+    filling.reserve(BUFFER_RECORDS);
+    compressor = std::thread {&writer::compress, this};
+}
+
+champsim::memory_trace::writer::~writer()
+{
+    submit();
+    {
+        std::lock_guard lock {mutex};
+        closing = true;
+    }
+    changed.notify_all();
+    compressor.join();
+    std::fflush(file);
+}
+
+void champsim::memory_trace::writer::submit()
+{
+    std::unique_lock lock {mutex};
+    changed.wait(lock, [this] { return std::size(pending) < PENDING_BUFFERS; });
+    pending.push_back(std::move(filling));
+    lock.unlock();
+    changed.notify_all();
+
+    filling = std::vector<record> {};
+    filling.reserve(BUFFER_RECORDS);
+}
+
+void champsim::memory_trace::writer::compress()
+{
+    z_stream strm {};
+    // Fast compression keeps up with the simulator, and the records are regular enough to compress well anyway
+    if (deflateInit2(&strm, Z_BEST_SPEED, Z_DEFLATED, 15 + 16, 8, Z_DEFAULT_STRATEGY) != Z_OK)
+    {
+        std::printf("%s: Cannot compress memory trace %s.\n", __func__, file_name.c_str());
+        abort();
+    }
+
+    std::vector<uint8_t> out(1u << 20);
+    auto deflate_into_file = [&](const void* data, std::size_t bytes, int flush)
+    {
+        strm.next_in  = reinterpret_cast<Bytef*>(const_cast<void*>(data));
+        strm.avail_in = static_cast<uInt>(bytes);
+        do
+        {
+            strm.next_out  = std::data(out);
+            strm.avail_out = static_cast<uInt>(std::size(out));
+            deflate(&strm, flush);
+            std::fwrite(std::data(out), 1, std::size(out) - strm.avail_out, file);
+        } while (strm.avail_out == 0);
+    };
+
+    header head {MAGIC, VERSION, sizeof(record)};
+    deflate_into_file(&head, sizeof(head), Z_NO_FLUSH);
+
+    while (true)
+    {
+        std::unique_lock lock {mutex};
+        changed.wait(lock, [this] { return ! std::empty(pending) || closing; });
+        if (std::empty(pending))
+            break;
+
+        auto records = std::move(pending.front());
+        pending.pop_front();
+        lock.unlock();
+        changed.notify_all();
+
+        deflate_into_file(std::data(records), std::size(records) * sizeof(record), Z_NO_FLUSH);
+    }
+
+    deflate_into_file(nullptr, 0, Z_FINISH);
+    deflateEnd(&strm);
+}
+
+champsim::memory_trace::reader::reader(const std::string& file_name): stream(file_name), file_name(file_name)
+{
+    header head;
+    stream.read(reinterpret_cast<char*>(&head), sizeof(head));
+    if (stream.gcount() != sizeof(head) || head.magic != MAGIC || head.version != VERSION || head.record_size != sizeof(record))
+    {
+        std::printf("%s: %s is not a memory trace of this version.\n", __func__, file_name.c_str());
+        abort();
+    }
+}
+
+std::optional<champsim::memory_trace::record> champsim::memory_trace::reader::next()
+{
+    if (position == std::size(buffer))
+    {
+        buffer.resize(BUFFER_RECORDS);
+        stream.read(reinterpret_cast<char*>(std::data(buffer)), static_cast<std::streamsize>(std::size(buffer) * sizeof(record)));
+        buffer.resize(static_cast<std::size_t>(stream.gcount()) / sizeof(record));
+        position = 0;
+
+        if (std::empty(buffer))
+            return std::nullopt;
+    }
+
+    return buffer[position++];
+}
+
+#endif // USER_CODES
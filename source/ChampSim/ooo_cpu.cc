@@ -695,6 +695,91 @@ long O3_CPU::retire_rob()
     return retire_count;
 }
 
+#if (IDLE_CYCLE_SKIPPING == ENABLE)
+uint64_t O3_CPU::idle_cycles(uint64_t bound)
+{
+    // Memory returns are handled in the next cycle
+    if (! std::empty(L1I_bus.lower_level->returned) || ! std::empty(L1D_bus.lower_level->returned))
+        return 0;
+
+    // Instructions that are not checked against the DIB or not fetched yet are handled in the next cycle
+    if (std::any_of(std::cbegin(IFETCH_BUFFER), std::cend(IFETCH_BUFFER), [](const ooo_model_instr& x)
+            { return ! x.dib_checked || ! x.fetched; }))
+        return 0;
+
+    // Instructions that are not scheduled yet are handled in the next cycle
+    auto search_bw = SCHEDULER_SIZE;
+    for (auto rob_it = std::cbegin(ROB); rob_it != std::cend(ROB) && search_bw > 0; ++rob_it)
+    {
+        if (rob_it->scheduled == 0)
+            return 0;
+
+        if (rob_it->executed == 0)
+            --search_bw;
+    }
+
+    if (! std::empty(ROB) && ROB.front().executed == COMPLETED)
+        return 0;
+
+    auto wait_until = [&bound, cycle = current_cycle](uint64_t event_cycle)
+    {
+        bound = std::min(bound, event_cycle > cycle ? event_cycle - cycle : 0);
+    };
+
+    // Each stage waits for the head of its buffer, as long as the next stage has room for it
+    if (! std::empty(input_queue) && std::size(IFETCH_BUFFER) < IFETCH_BUFFER_SIZE)
+        wait_until(fetch_resume_cycle);
+
+    if (! std::empty(IFETCH_BUFFER) && IFETCH_BUFFER.front().fetched == COMPLETED && std::size(DECODE_BUFFER) < DECODE_BUFFER_SIZE)
+        wait_until(IFETCH_BUFFER.front().event_cycle);
+
+    if (! std::empty(DECODE_BUFFER) && std::size(DISPATCH_BUFFER) < DISPATCH_BUFFER_SIZE)
+        wait_until(DECODE_BUFFER.front().event_cycle);
+
+    if (! std::empty(DISPATCH_BUFFER) && std::size(ROB) != ROB_SIZE)
+    {
+        const auto& db_entry = DISPATCH_BUFFER.front();
+        auto free_lq         = static_cast<std::size_t>(std::count_if(std::begin(LQ), std::end(LQ), [](const auto& lq_entry)
+                    { return ! lq_entry.has_value(); }));
+        if (free_lq >= std::size(db_entry.source_memory) && (std::size(db_entry.destination_memory) + std::size(SQ)) <= SQ_SIZE)
+            wait_until(db_entry.event_cycle + 1); // Dispatch requires the latency to have fully elapsed
+    }
+
+    for (const auto& rob_entry : ROB)
+    {
+        if (rob_entry.scheduled == COMPLETED && rob_entry.executed == 0 && rob_entry.num_reg_dependent == 0)
+            wait_until(rob_entry.event_cycle); // Ready to execute
+        else if (rob_entry.executed == INFLIGHT && rob_entry.completed_mem_ops == rob_entry.num_mem_ops())
+            wait_until(rob_entry.event_cycle); // Ready to complete
+    }
+
+    // Stores waiting to finish, and the oldest store waiting to be written into the L1D
+    auto unfetched_sq = std::partition_point(std::cbegin(SQ), std::cend(SQ), [](const auto& x)
+        { return x.fetch_issued; });
+    if (unfetched_sq != std::cend(SQ))
+        wait_until(unfetched_sq->event_cycle);
+
+    if (! std::empty(SQ) && (std::empty(ROB) || SQ.front().instr_id < ROB.front().instr_id))
+        wait_until(SQ.front().event_cycle);
+
+    for (const auto& lq_entry : LQ)
+    {
+        if (lq_entry.has_value() && lq_entry->producer_id == std::numeric_limits<uint64_t>::max() && ! lq_entry->fetch_issued)
+            wait_until(lq_entry->event_cycle + 1); // Loads require the latency to have fully elapsed
+    }
+
+    return bound;
+}
+#endif // IDLE_CYCLE_SKIPPING
+
+#if (USER_CODES == ENABLE)
+void O3_CPU::checkpoint(champsim::checkpoint_archive& archive)
+{
+    champsim::operable::checkpoint(archive);
+    archive & num_retired & DIB;
+}
+#endif // USER_CODES
+
 // LCOV_EXCL_START Exclude the following function from LCOV
 void O3_CPU::print_deadlock()
 {
@@ -106,6 +106,9 @@ void CACHE::pref_prefetcherDip_stride_prefetcher_initialize()
 #else
     std::cout << NAME << " IP-based stride prefetcher" << std::endl;
 #endif
+
+    // Add the tracker before the caches may operate on several threads (PARALLEL_CORE_SIMULATION)
+    ::trackers[this];
 }
 
 void CACHE::pref_prefetcherDip_stride_prefetcher_cycle_operate()
@@ -35,6 +35,20 @@ std::map<CACHE*, std::vector<int>> rrpv_values;
 
 // prediction table structure
 std::map<std::pair<CACHE*, std::size_t>, std::array<unsigned, SHCT_SIZE>> SHCT;
+
+// Keep the sampler, the RRPVs and the signature history counters in checkpoints
+champsim::checkpoint_archive::participant ship_checkpoint {[](champsim::checkpoint_archive& archive)
+    {
+        for (auto& [cache, values] : ::rrpv_values)
+        {
+            if (! archive.section(cache->NAME + ".ship"))
+                continue;
+
+            archive & ::rand_sets[cache] & ::sampler[cache] & values;
+            for (std::size_t cpu = 0; cpu < NUM_CPUS; cpu++)
+                archive & ::SHCT[std::make_pair(cache, cpu)];
+        }
+    }};
 } // namespace
 
 // initialize replacement state
@@ -61,6 +75,10 @@ void CACHE::repl_replacementDship_initialize_replacement()
     sampler.emplace(this, ::SAMPLER_SET * NUM_WAY);
 
     ::rrpv_values[this] = std::vector<int>(NUM_SET * NUM_WAY, ::maxRRPV);
+
+    // Add the counter tables of the CPUs before the caches may operate on several threads
+    for (std::size_t cpu = 0; cpu < NUM_CPUS; cpu++)
+        ::SHCT[std::make_pair(this, cpu)];
 }
 
 // find replacement victim
@@ -0,0 +1,48 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ChampSim/sampling.h"
+
+#include <cmath>
+#include <limits>
+#include <numeric>
+
+#if (USER_CODES == ENABLE)
+
+champsim::sample_estimate champsim::estimate_ipc(const std::vector<double>& cpi)
+{
+    sample_estimate estimate {std::size(cpi), 0, 0, std::numeric_limits<double>::infinity(), std::numeric_limits<double>::infinity()};
+    if (std::empty(cpi))
+        return estimate;
+
+    auto windows = static_cast<double>(std::size(cpi));
+    auto mean    = std::accumulate(std::begin(cpi), std::end(cpi), 0.0) / windows;
+    estimate.ipc = 1 / mean;
+    if (std::size(cpi) < 2)
+        return estimate;
+
+    auto variance = std::accumulate(std::begin(cpi), std::end(cpi), 0.0, [mean](double sum, double x)
+                        { return sum + (x - mean) * (x - mean); })
+                  / (windows - 1);
+    auto half_width         = SAMPLING_Z_SCORE * std::sqrt(variance / windows);
+
+    estimate.ipc_low        = 1 / (mean + half_width);
+    estimate.ipc_high       = half_width < mean ? 1 / (mean - half_width) : std::numeric_limits<double>::infinity();
+    estimate.relative_error = half_width / mean;
+    return estimate;
+}
+
+#endif // USER_CODES
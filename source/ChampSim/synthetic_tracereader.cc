@@ -0,0 +1,299 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ChampSim/synthetic_tracereader.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <sstream>
+#include <string_view>
+
+#include "ChampSim/champsim_constants.h"
+
+#if (USER_CODES == ENABLE) && (SYNTHETIC_TRACES == ENABLE)
+
+namespace
+{
+constexpr std::string_view SCHEME = "synthetic:";
+constexpr uint64_t CODE_BASE      = 0x400000;
+constexpr uint64_t WORD_SIZE      = 8;
+
+// Registers, away from the stack pointer, flags and instruction pointer
+constexpr unsigned char REG_CHASE   = 1;  // The pointer chased from load to load
+constexpr unsigned char REG_BASE    = 2;  // The base of the footprint, never written
+constexpr unsigned char REG_DATA    = 3;  // The data stored
+constexpr unsigned char REG_LOADED  = 8;  // The first of the 8 registers loaded into in turn
+constexpr unsigned char REG_ALU_IN  = 16; // The first of the 4 registers read by the other instructions
+constexpr unsigned char REG_ALU_OUT = 20; // The first of the 4 registers written by the other instructions
+
+[[noreturn]] void invalid(const std::string& name, const std::string& reason)
+{
+    std::printf("parse_synthetic_trace: Invalid synthetic trace %s: %s.\n", name.c_str(), reason.c_str());
+    abort();
+}
+
+uint64_t parse_size(const std::string& name, const std::string& value)
+{
+    std::size_t end = 0;
+    uint64_t size   = 0;
+    try
+    {
+        size = std::stoull(value, &end, 0);
+    }
+    catch (const std::exception&)
+    {
+        invalid(name, "\"" + value + "\" is not a size");
+    }
+
+    auto suffix = value.substr(end);
+    if (suffix == "K" || suffix == "KiB")
+        return size << 10;
+    if (suffix == "M" || suffix == "MiB")
+        return size << 20;
+    if (suffix == "G" || suffix == "GiB")
+        return size << 30;
+    if (! std::empty(suffix))
+        invalid(name, "\"" + value + "\" has an unknown suffix");
+    return size;
+}
+
+double parse_fraction(const std::string& name, const std::string& value)
+{
+    try
+    {
+        return std::stod(value);
+    }
+    catch (const std::exception&)
+    {
+        invalid(name, "\"" + value + "\" is not a number");
+    }
+}
+
+// The sum of 1 / i^theta for i from 1 to n, with the tail after the first million terms approximated by an integral
+double zeta(uint64_t n, double theta)
+{
+    constexpr uint64_t EXACT_TERMS = 1u << 20;
+
+    double sum = 0;
+    for (uint64_t i = 1; i <= std::min(n, EXACT_TERMS); i++)
+        sum += 1.0 / std::pow(static_cast<double>(i), theta);
+
+    if (n > EXACT_TERMS)
+    {
+        auto from = static_cast<double>(EXACT_TERMS) + 0.5;
+        auto to   = static_cast<double>(n) + 0.5;
+        sum += (std::pow(to, 1 - theta) - std::pow(from, 1 - theta)) / (1 - theta);
+    }
+    return sum;
+}
+} // namespace
+
+bool champsim::is_synthetic_trace(const std::string& name) { return name.compare(0, std::size(SCHEME), SCHEME) == 0; }
+
+champsim::synthetic_trace_parameters champsim::parse_synthetic_trace(const std::string& name)
+{
+    synthetic_trace_parameters parameters;
+
+    std::istringstream fields {name.substr(std::size(SCHEME))};
+    std::string pattern;
+    std::getline(fields, pattern, ',');
+    if (pattern == "stream")
+        parameters.pattern = synthetic_pattern::STREAM;
+    else if (pattern == "stride")
+        parameters.pattern = synthetic_pattern::STRIDE;
+    else if (pattern == "random")
+        parameters.pattern = synthetic_pattern::RANDOM;
+    else if (pattern == "zipfian")
+        parameters.pattern = synthetic_pattern::ZIPFIAN;
+    else if (pattern == "chase")
+        parameters.pattern = synthetic_pattern::CHASE;
+    else
+        invalid(name, "the pattern is not stream, stride, random, zipfian or chase");
+
+    for (std::string field; std::getline(fields, field, ',');)
+    {
+        auto equal = field.find('=');
+        if (equal == std::string::npos)
+            invalid(name, "\"" + field + "\" is not <key>=<value>");
+
+        auto key   = field.substr(0, equal);
+        auto value = field.substr(equal + 1);
+        if (key == "footprint")
+            parameters.footprint = parse_size(name, value);
+        else if (key == "stride")
+            parameters.stride = parse_size(name, value);
+        else if (key == "writes")
+            parameters.writes = parse_fraction(name, value);
+        else if (key == "skew")
+            parameters.skew = parse_fraction(name, value);
+        else if (key == "gap")
+            parameters.gap = static_cast<uint32_t>(parse_size(name, value));
+        else if (key == "loop")
+            parameters.loop = static_cast<uint32_t>(parse_size(name, value));
+        else if (key == "length")
+            parameters.length = parse_size(name, value);
+        else if (key == "seed")
+            parameters.seed = parse_size(name, value);
+        else if (key == "base")
+            parameters.base = parse_size(name, value);
+        else
+            invalid(name, "\"" + key + "\" is not a parameter");
+    }
+
+    if (parameters.footprint < BLOCK_SIZE)
+        invalid(name, "the footprint is smaller than a cache line");
+    if (parameters.pattern == synthetic_pattern::ZIPFIAN && parameters.footprint < 2 * BLOCK_SIZE)
+        invalid(name, "the footprint of zipfian is smaller than two cache lines");
+    if (parameters.stride == 0)
+        invalid(name, "the stride is 0");
+    if (parameters.writes < 0 || parameters.writes > 1)
+        invalid(name, "the fraction of writes is not in [0, 1]");
+    if (parameters.skew <= 0 || parameters.skew >= 1)
+        invalid(name, "the skew is not in (0, 1)");
+    if (parameters.loop < 2)
+        invalid(name, "the loop has fewer than 2 instructions");
+    if (parameters.base == 0)
+        invalid(name, "the base address is 0");
+
+    return parameters;
+}
+
+champsim::synthetic_tracereader::synthetic_tracereader(uint8_t cpu_idx, std::string name)
+    : cpu(cpu_idx), parameters(parse_synthetic_trace(name)), generator(parameters.seed + cpu_idx), lines(parameters.footprint / BLOCK_SIZE)
+{
+    // The full-period generator of chase visits a power of two of lines
+    if (parameters.pattern == synthetic_pattern::CHASE)
+        lines = uint64_t {1} << (63 - __builtin_clzll(lines));
+
+    if (parameters.pattern == synthetic_pattern::ZIPFIAN)
+    {
+        auto theta = parameters.skew;
+        auto n     = static_cast<double>(lines);
+        zeta_n     = zeta(lines, theta);
+        zeta_2     = zeta(2, theta);
+        alpha      = 1.0 / (1.0 - theta);
+        eta        = (1.0 - std::pow(2.0 / n, 1.0 - theta)) / (1.0 - zeta_2 / zeta_n);
+    }
+}
+
+uint64_t champsim::synthetic_tracereader::next_address()
+{
+    uint64_t offset = 0;
+    switch (parameters.pattern)
+    {
+    case synthetic_pattern::STREAM:
+        offset = (cursor++ * WORD_SIZE) % parameters.footprint;
+        break;
+    case synthetic_pattern::STRIDE:
+        offset = (cursor++ * parameters.stride) % parameters.footprint;
+        break;
+    case synthetic_pattern::RANDOM:
+        offset = std::uniform_int_distribution<uint64_t> {0, lines - 1}(generator)*BLOCK_SIZE;
+        break;
+    case synthetic_pattern::ZIPFIAN:
+    {
+        auto u     = uniform(generator);
+        auto uz    = u * zeta_n;
+        uint64_t rank;
+        if (uz < 1.0)
+            rank = 0;
+        else if (uz < 1.0 + std::pow(0.5, parameters.skew))
+            rank = 1;
+        else
+            rank = std::min(lines - 1, static_cast<uint64_t>(static_cast<double>(lines) * std::pow(eta * u - eta + 1.0, alpha)));
+
+        // Scatter the hot lines over the footprint instead of keeping them together at its beginning
+        offset = ((rank * 0x9e3779b97f4a7c15ull) % lines) * BLOCK_SIZE;
+        break;
+    }
+    case synthetic_pattern::CHASE:
+        // A linear congruential generator modulo a power of two with an odd increment and a multiplier of 1 modulo 4 visits every line
+        cursor = (cursor * 6364136223846793005ull + 1442695040888963407ull) & (lines - 1);
+        offset = cursor * BLOCK_SIZE;
+        break;
+    }
+
+    accesses++;
+    return parameters.base + offset;
+}
+
+input_instr champsim::synthetic_tracereader::next_record()
+{
+    input_instr record {};
+    auto slot = position % parameters.loop;
+    record.ip = CODE_BASE + slot * 4;
+
+    if (slot == parameters.loop - 1)
+    {
+        // The conditional branch closing the loop, which is always taken
+        record.is_branch                = 1;
+        record.branch_taken             = 1;
+        record.destination_registers[0] = champsim::REG_INSTRUCTION_POINTER;
+        record.source_registers[0]      = champsim::REG_INSTRUCTION_POINTER;
+        record.source_registers[1]      = champsim::REG_FLAGS;
+    }
+    else if (slot % (parameters.gap + 1) == 0)
+    {
+        auto address = next_address();
+        bool write   = parameters.writes > 0 && uniform(generator) < parameters.writes;
+        if (write)
+        {
+            record.destination_memory[0] = address;
+            record.source_registers[0]   = (parameters.pattern == synthetic_pattern::CHASE) ? REG_CHASE : REG_BASE;
+            record.source_registers[1]   = REG_DATA;
+        }
+        else if (parameters.pattern == synthetic_pattern::CHASE)
+        {
+            record.source_memory[0]         = address;
+            record.source_registers[0]      = REG_CHASE;
+            record.destination_registers[0] = REG_CHASE;
+        }
+        else
+        {
+            record.source_memory[0]         = address;
+            record.source_registers[0]      = REG_BASE;
+            record.destination_registers[0] = static_cast<unsigned char>(REG_LOADED + accesses % 8);
+        }
+    }
+    else
+    {
+        record.source_registers[0]      = static_cast<unsigned char>(REG_ALU_IN + slot % 4);
+        record.destination_registers[0] = static_cast<unsigned char>(REG_ALU_OUT + slot % 4);
+    }
+
+    position++;
+    return record;
+}
+
+ooo_model_instr champsim::synthetic_tracereader::operator()()
+{
+    ooo_model_instr retval {cpu, next_record()};
+    if (retval.is_branch)
+        retval.branch_target = CODE_BASE;
+    return retval;
+}
+
+uint64_t champsim::synthetic_tracereader::skip(uint64_t count)
+{
+    uint64_t skipped = 0;
+    for (; skipped < count && ! eof(); skipped++)
+        next_record();
+    return skipped;
+}
+
+#endif // USER_CODES, SYNTHETIC_TRACES
@@ -0,0 +1,154 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ChampSim/trace_cache.h"
+
+#include <fmt/core.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+
+#if (USER_CODES == ENABLE)
+
+std::string champsim::trace_cache::directory {};
+
+namespace
+{
+constexpr std::size_t RECORDER_BUFFER_ENTRIES = 1u << 14;
+constexpr std::streamoff HASHED_BYTES         = 1 << 20;
+
+// FNV-1a
+uint64_t hash_bytes(uint64_t hash, const char* data, std::size_t size)
+{
+    for (std::size_t i = 0; i < size; i++)
+    {
+        hash ^= static_cast<uint8_t>(data[i]);
+        hash *= 0x100000001b3ull;
+    }
+    return hash;
+}
+} // namespace
+
+std::string champsim::trace_cache::file_name(const std::string& trace_name, std::size_t record_size)
+{
+    std::ifstream trace {trace_name, std::ios::binary};
+    struct stat status;
+    if (! trace || stat(trace_name.c_str(), &status) != 0)
+    {
+        std::printf("%s: Cannot open trace %s.\n", __func__, trace_name.c_str());
+        abort();
+    }
+
+    // The inode and the modification time tell an edited trace from the one cached, even if its size and both ends are the same
+    std::streamoff size = status.st_size;
+    uint64_t inode      = status.st_ino;
+    int64_t mtime[2]    = {status.st_mtim.tv_sec, status.st_mtim.tv_nsec};
+    uint64_t hash       = 0xcbf29ce484222325ull;
+    hash                = hash_bytes(hash, reinterpret_cast<const char*>(&size), sizeof(size));
+    hash                = hash_bytes(hash, reinterpret_cast<const char*>(&inode), sizeof(inode));
+    hash                = hash_bytes(hash, reinterpret_cast<const char*>(mtime), sizeof(mtime));
+    hash                = hash_bytes(hash, reinterpret_cast<const char*>(&record_size), sizeof(record_size));
+
+    // The first and last MiB tell the traces apart without reading all of them
+    std::vector<char> bytes(static_cast<std::size_t>(std::min(size, HASHED_BYTES)));
+    for (std::streamoff offset : {std::streamoff {0}, size - static_cast<std::streamoff>(std::size(bytes))})
+    {
+        trace.seekg(offset);
+        trace.read(std::data(bytes), static_cast<std::streamsize>(std::size(bytes)));
+        hash = hash_bytes(hash, std::data(bytes), std::size(bytes));
+    }
+
+    auto base_name = trace_name.substr(trace_name.find_last_of('/') + 1);
+    return fmt::format("{}/{}.{:016x}{}", directory, base_name, hash, FILE_EXTENSION);
+}
+
+std::optional<champsim::trace_cache::header> champsim::trace_cache::read_header(const std::string& cache_name)
+{
+    std::ifstream file {cache_name, std::ios::binary | std::ios::ate};
+    if (! file)
+        return std::nullopt;
+
+    auto size = static_cast<uint64_t>(file.tellg());
+    header head;
+    file.seekg(0);
+    file.read(reinterpret_cast<char*>(&head), sizeof(head));
+    if (! file || head.magic != MAGIC || head.version != VERSION || head.record_size != sizeof(decoded_instr)
+        || size != sizeof(head) + head.instructions * sizeof(decoded_instr))
+        return std::nullopt;
+
+    return head;
+}
+
+champsim::trace_cache::recorder::recorder(const std::string& cache_name): cache_name(cache_name)
+{
+    // Runs recording the same trace at the same time write different files
+    static std::atomic<unsigned> recorders {0};
+    temporary_name = fmt::format("{}.{}.{}.tmp", cache_name, getpid(), recorders++);
+
+    file.open(temporary_name, std::ios::binary);
+    if (! file)
+    {
+        std::printf("%s: Cannot write trace cache %s.\n", __func__, temporary_name.c_str());
+        abort();
+    }
+
+    // The header is written when finished
+    header head {};
+    file.write(reinterpret_cast<const char*>(&head), sizeof(head));
+    buffer.reserve(RECORDER_BUFFER_ENTRIES);
+}
+
+void champsim::trace_cache::recorder::flush()
+{
+    file.write(reinterpret_cast<const char*>(std::data(buffer)), static_cast<std::streamsize>(std::size(buffer) * sizeof(decoded_instr)));
+    buffer.clear();
+}
+
+void champsim::trace_cache::recorder::record(const ooo_model_instr& instr)
+{
+    buffer.push_back(instr.to_decoded());
+    instructions++;
+    if (std::size(buffer) == RECORDER_BUFFER_ENTRIES)
+        flush();
+}
+
+void champsim::trace_cache::recorder::append(const decoded_instr* instrs, uint64_t count)
+{
+    flush();
+    file.write(reinterpret_cast<const char*>(instrs), static_cast<std::streamsize>(count * sizeof(decoded_instr)));
+    instructions += count;
+}
+
+champsim::trace_cache::recorder::~recorder()
+{
+    flush();
+
+    header head {MAGIC, VERSION, sizeof(decoded_instr), instructions, complete};
+    file.seekp(0);
+    file.write(reinterpret_cast<const char*>(&head), sizeof(head));
+    file.close();
+
+    // Keep the cache file if it caches at least as many instructions
+    auto existing = read_header(cache_name);
+    bool replace  = file && instructions > 0 && (! existing.has_value() || (! existing->complete && existing->instructions < instructions));
+    if (! replace || std::rename(temporary_name.c_str(), cache_name.c_str()) != 0)
+        std::remove(temporary_name.c_str());
+}
+
+#endif // USER_CODES
@@ -19,8 +19,13 @@
 #include <fstream>
 #include <string>
 
+#include "ChampSim/background_tracereader.h"
+#include "ChampSim/block_trace.h"
 #include "ChampSim/inf_stream.h"
+#include "ChampSim/mapped_tracereader.h"
 #include "ChampSim/repeatable.h"
+#include "ChampSim/synthetic_tracereader.h"
+#include "ChampSim/trace_cache.h"
 
 namespace champsim
 {
@@ -32,6 +37,21 @@ ooo_model_instr apply_branch_target(ooo_model_instr branch, const ooo_model_inst
     return branch;
 }
 
+#if (BACKGROUND_TRACE_DECOMPRESSION == ENABLE)
+// Read the trace on a thread of its own
+template<typename R>
+champsim::tracereader make_tracereader(R&& reader)
+{
+    return champsim::tracereader {champsim::background_tracereader<R> {std::move(reader)}};
+}
+#else
+template<typename R>
+champsim::tracereader make_tracereader(R&& reader)
+{
+    return champsim::tracereader {std::move(reader)};
+}
+#endif // BACKGROUND_TRACE_DECOMPRESSION
+
 template<template<class, class> typename R, typename T>
 champsim::tracereader get_tracereader_for_type(std::string fname, uint8_t cpu)
 {
@@ -40,21 +60,126 @@ champsim::tracereader get_tracereader_for_type(std::string fname, uint8_t cpu)
     bool is_bzip2_compressed = (fname.substr(std::size(fname) - 3) == "bz2");
 
     if (is_gzip_compressed)
-        return champsim::tracereader {R<T, champsim::inf_istream<champsim::decomp_tags::gzip_tag_t<>>>(cpu, fname)};
+        return make_tracereader(R<T, champsim::inf_istream<champsim::decomp_tags::gzip_tag_t<>>>(cpu, fname));
     else if (is_lzma_compressed)
-        return champsim::tracereader {R<T, champsim::inf_istream<champsim::decomp_tags::lzma_tag_t<>>>(cpu, fname)};
+#if (USER_CODES == ENABLE)
+        // The PIN tracer compresses its buffers in parallel into xz streams one after another
+        return make_tracereader(R<T, champsim::inf_istream<champsim::decomp_tags::lzma_tag_t<LZMA_CONCATENATED>>>(cpu, fname));
+#else
+        return make_tracereader(R<T, champsim::inf_istream<champsim::decomp_tags::lzma_tag_t<>>>(cpu, fname));
+#endif // USER_CODES
     else if (is_bzip2_compressed)
-        return champsim::tracereader {R<T, champsim::inf_istream<champsim::decomp_tags::bzip2_tag_t>>(cpu, fname)};
+        return make_tracereader(R<T, champsim::inf_istream<champsim::decomp_tags::bzip2_tag_t>>(cpu, fname));
+    else
+        return make_tracereader(R<T, std::ifstream>(cpu, fname));
+}
+
+#if (USER_CODES == ENABLE)
+// A trace read by a reader of its own format (e.g., a block trace), which can skip instructions without reading them
+template<template<class> typename R, typename T>
+champsim::tracereader get_seekable_tracereader(std::string fname, uint8_t cpu, bool repeat)
+{
+    if (! std::empty(champsim::trace_cache::directory))
+    {
+        if (repeat)
+            return make_tracereader(champsim::repeatable<champsim::cached_tracereader<R<T>>, uint8_t, std::string>(cpu, fname));
+        else
+            return make_tracereader(champsim::cached_tracereader<R<T>>(cpu, fname));
+    }
+
+    if (repeat)
+        return make_tracereader(champsim::repeatable<R<T>, uint8_t, std::string>(cpu, fname));
+    else
+        return make_tracereader(R<T>(cpu, fname));
+}
+
+#if (MEMORY_MAPPED_TRACES == ENABLE)
+// An uncompressed trace, which is read from its mapping without a thread of its own
+template<typename T>
+champsim::tracereader get_mapped_tracereader(std::string fname, uint8_t cpu, bool repeat)
+{
+    if (! std::empty(champsim::trace_cache::directory))
+    {
+        if (repeat)
+            return champsim::tracereader {champsim::repeatable<champsim::cached_tracereader<champsim::mapped_tracereader<T>>, uint8_t, std::string>(cpu, fname)};
+        else
+            return champsim::tracereader {champsim::cached_tracereader<champsim::mapped_tracereader<T>>(cpu, fname)};
+    }
+
+    if (repeat)
+        return champsim::tracereader {champsim::repeatable<champsim::mapped_tracereader<T>, uint8_t, std::string>(cpu, fname)};
     else
-        return champsim::tracereader {R<T, std::ifstream>(cpu, fname)};
+        return champsim::tracereader {champsim::mapped_tracereader<T>(cpu, fname)};
 }
+#endif // MEMORY_MAPPED_TRACES
+#endif // USER_CODES
 } // namespace champsim
 
 template<typename T, typename S>
 using repeatable_reader_t = champsim::repeatable<champsim::bulk_tracereader<T, S>, uint8_t, std::string>;
 
+#if (USER_CODES == ENABLE)
+template<typename T, typename S>
+using cached_reader_t = champsim::cached_tracereader<champsim::bulk_tracereader<T, S>>;
+
+template<typename T, typename S>
+using repeatable_cached_reader_t = champsim::repeatable<cached_reader_t<T, S>, uint8_t, std::string>;
+#endif // USER_CODES
+
 champsim::tracereader get_tracereader(std::string fname, uint8_t cpu, bool is_cloudsuite, bool repeat)
 {
+#if (USER_CODES == ENABLE)
+#if (SYNTHETIC_TRACES == ENABLE)
+    // Generated without a file, so there is nothing to cache or map
+    if (champsim::is_synthetic_trace(fname))
+    {
+        if (repeat)
+            return champsim::tracereader {champsim::repeatable<champsim::synthetic_tracereader, uint8_t, std::string>(cpu, fname)};
+        else
+            return champsim::tracereader {champsim::synthetic_tracereader(cpu, fname)};
+    }
+#endif // SYNTHETIC_TRACES
+
+    if (champsim::block_trace::is_block_trace(fname))
+    {
+        if (is_cloudsuite)
+            return champsim::get_seekable_tracereader<champsim::block_tracereader, cloudsuite_instr>(fname, cpu, repeat);
+        else
+            return champsim::get_seekable_tracereader<champsim::block_tracereader, input_instr>(fname, cpu, repeat);
+    }
+
+#if (MEMORY_MAPPED_TRACES == ENABLE)
+    bool is_compressed = (fname.substr(std::size(fname) - 2) == "gz") || (fname.substr(std::size(fname) - 2) == "xz") || (fname.substr(std::size(fname) - 3) == "bz2");
+    // Anything but a regular file (e.g., a pipe, a FIFO or /dev/stdin) is read as a stream as before
+    if (! is_compressed && champsim::mapped_file::can_map(fname))
+    {
+        if (is_cloudsuite)
+            return champsim::get_mapped_tracereader<cloudsuite_instr>(fname, cpu, repeat);
+        else
+            return champsim::get_mapped_tracereader<input_instr>(fname, cpu, repeat);
+    }
+#endif // MEMORY_MAPPED_TRACES
+
+    // Only a regular file can be told apart from an edited one, so a pipe or a FIFO is never cached
+    if (! std::empty(champsim::trace_cache::directory) && champsim::mapped_file::can_map(fname))
+    {
+        if (is_cloudsuite)
+        {
+            if (repeat)
+                return champsim::get_tracereader_for_type<repeatable_cached_reader_t, cloudsuite_instr>(fname, cpu);
+            else
+                return champsim::get_tracereader_for_type<cached_reader_t, cloudsuite_instr>(fname, cpu);
+        }
+        else
+        {
+            if (repeat)
+                return champsim::get_tracereader_for_type<repeatable_cached_reader_t, input_instr>(fname, cpu);
+            else
+                return champsim::get_tracereader_for_type<cached_reader_t, input_instr>(fname, cpu);
+        }
+    }
+#endif // USER_CODES
+
     if (is_cloudsuite)
     {
         if (repeat)
@@ -1,7 +1,20 @@
 #include "ProjectConfiguration.h"
 
+#include <nlohmann/json.hpp>
+
+#include <climits>
+#include <fstream>
+#include <map>
+
+#include "ChampSim/memory_trace.h"
+
+#if (BINARY_MEMORY_TRACE == ENABLE)
+MEMORY_TRACE output_memorytrace("memory trace", champsim::memory_trace::FILE_EXTENSION);
+#else
 MEMORY_TRACE output_memorytrace("memory trace", ".trace");
+#endif // BINARY_MEMORY_TRACE
 SIMULATOR_STATISTICS output_statistics("ChampSim statistics", ".statistics");
+PROJECT_CONFIGURATION project_configuration;
 
 DATA_OUTPUT::DATA_OUTPUT(std::string v1, std::string v2)
 : data_name(v1), file_extension(v2)
@@ -72,13 +85,41 @@ MEMORY_TRACE::MEMORY_TRACE(std::string v1, std::string v2, char** string_array,
 
 MEMORY_TRACE::~MEMORY_TRACE()
 {
-    if (file_handler) // check the validity of this file handler
+    // Finish writing the records before the file is closed
+    writer.reset();
+}
+
+void MEMORY_TRACE::output_file_initialization(char** string_array, uint32_t number)
+{
+    DATA_OUTPUT::output_file_initialization(string_array, number);
+
+#if (BINARY_MEMORY_TRACE == ENABLE)
+    writer = std::make_unique<champsim::memory_trace::writer>(file_handler, file_name);
+#endif // BINARY_MEMORY_TRACE
+}
+
+void MEMORY_TRACE::output_memory_trace(uint64_t cycle, uint64_t address, uint64_t physical_address, char type, uint32_t cpu, uint8_t memory, uint8_t origin, bool accepted)
+{
+    if (project_configuration.print_memory_trace == false)
     {
+        return;
     }
+
+#if (BINARY_MEMORY_TRACE == ENABLE)
+    assert(writer);
+    writer->write(champsim::memory_trace::record {cycle, address, physical_address, cpu, memory, type, origin, accepted});
+#else
+    output_memory_trace_hexadecimal(address, type);
+#endif // BINARY_MEMORY_TRACE
 }
 
 void MEMORY_TRACE::output_memory_trace_hexadecimal(uint64_t address, char type)
 {
+    if (project_configuration.print_memory_trace == false)
+    {
+        return;
+    }
+
     assert(file_handler);
     fprintf(file_handler, "0x%lx %c\n", address, type);
 }
@@ -122,15 +163,18 @@ SIMULATOR_STATISTICS::~SIMULATOR_STATISTICS()
 
         fprintf(file_handler, "remapping_request_queue_congestion: %ld.\n", remapping_request_queue_congestion);
 
-#if (IDEAL_VARIABLE_GRANULARITY == ENABLE)
-        fprintf(file_handler, "no_free_space_for_migration: %ld (%f).\n", no_free_space_for_migration, no_free_space_for_migration / float(total_access_request_in_memory));
-        fprintf(file_handler, "no_invalid_group_for_migration: %ld (%f).\n", no_invalid_group_for_migration, no_invalid_group_for_migration / float(total_access_request_in_memory));
-        fprintf(file_handler, "unexpandable_since_start_address: %ld (%f).\n", unexpandable_since_start_address, unexpandable_since_start_address / float(total_access_request_in_memory));
-        fprintf(file_handler, "unexpandable_since_no_invalid_group: %ld (%f).\n", unexpandable_since_no_invalid_group, unexpandable_since_no_invalid_group / float(total_access_request_in_memory));
-        fprintf(file_handler, "data_eviction_success: %ld (%f).\n", data_eviction_success, data_eviction_success / float(total_access_request_in_memory));
-        fprintf(file_handler, "data_eviction_failure: %ld (%f).\n", data_eviction_failure, data_eviction_failure / float(total_access_request_in_memory));
-        fprintf(file_handler, "uncertain_counter: %ld (%f).\n", uncertain_counter, uncertain_counter / float(total_access_request_in_memory));
-#endif // IDEAL_VARIABLE_GRANULARITY
+#if (MEMORY_USE_OS_TRANSPARENT_MANAGEMENT == ENABLE)
+        if (project_configuration.research_proposal == ResearchProposal::IdealVariableGranularity)
+        {
+            fprintf(file_handler, "no_free_space_for_migration: %ld (%f).\n", no_free_space_for_migration, no_free_space_for_migration / float(total_access_request_in_memory));
+            fprintf(file_handler, "no_invalid_group_for_migration: %ld (%f).\n", no_invalid_group_for_migration, no_invalid_group_for_migration / float(total_access_request_in_memory));
+            fprintf(file_handler, "unexpandable_since_start_address: %ld (%f).\n", unexpandable_since_start_address, unexpandable_since_start_address / float(total_access_request_in_memory));
+            fprintf(file_handler, "unexpandable_since_no_invalid_group: %ld (%f).\n", unexpandable_since_no_invalid_group, unexpandable_since_no_invalid_group / float(total_access_request_in_memory));
+            fprintf(file_handler, "data_eviction_success: %ld (%f).\n", data_eviction_success, data_eviction_success / float(total_access_request_in_memory));
+            fprintf(file_handler, "data_eviction_failure: %ld (%f).\n", data_eviction_failure, data_eviction_failure / float(total_access_request_in_memory));
+            fprintf(file_handler, "uncertain_counter: %ld (%f).\n", uncertain_counter, uncertain_counter / float(total_access_request_in_memory));
+        }
+#endif // MEMORY_USE_OS_TRANSPARENT_MANAGEMENT
     }
 }
 
@@ -160,12 +204,238 @@ void SIMULATOR_STATISTICS::statistics_initialization()
 
     remapping_request_queue_congestion = 0;
 
-#if (IDEAL_VARIABLE_GRANULARITY == ENABLE)
     no_free_space_for_migration         = 0;
     no_invalid_group_for_migration      = 0;
     unexpandable_since_start_address    = 0;
     unexpandable_since_no_invalid_group = 0;
     data_eviction_success = data_eviction_failure = 0;
     uncertain_counter                             = 0;
-#endif // IDEAL_VARIABLE_GRANULARITY
+}
+
+namespace
+{
+// Whether the features with runtime options are built. These switches are only defined along with the features they belong to.
+#if (MEMORY_USE_OS_TRANSPARENT_MANAGEMENT == ENABLE)
+constexpr bool OS_TRANSPARENT_MANAGEMENT_BUILT = true;
+#else
+constexpr bool OS_TRANSPARENT_MANAGEMENT_BUILT = false;
+#endif // MEMORY_USE_OS_TRANSPARENT_MANAGEMENT
+
+#if (TRACKING_LOAD_STORE_STATISTICS == ENABLE)
+constexpr bool TRACKING_BUILT = true;
+#else
+constexpr bool TRACKING_BUILT = false;
+#endif // TRACKING_LOAD_STORE_STATISTICS
+
+bool read_switch(const std::string& key, const nlohmann::json& value)
+{
+    if (! value.is_boolean())
+    {
+        std::printf("%s: %s should be true or false.\n", __func__, key.c_str());
+        abort();
+    }
+    return value.get<bool>();
+}
+
+uint64_t read_parameter(const std::string& key, const nlohmann::json& value, uint64_t min, uint64_t max)
+{
+    if (! value.is_number_unsigned() || value.get<uint64_t>() < min || value.get<uint64_t>() > max)
+    {
+        std::printf("%s: %s should be an integer from %lu to %lu.\n", __func__, key.c_str(), min, max);
+        abort();
+    }
+    return value.get<uint64_t>();
+}
+
+// The options of a feature can only be set when the feature is built
+void check_build(const std::string& key, bool built, const char* switch_name)
+{
+    if (! built)
+    {
+        std::printf("%s: %s needs a build with %s (ENABLE).\n", __func__, key.c_str(), switch_name);
+        abort();
+    }
+}
+} // namespace
+
+PROJECT_CONFIGURATION::PROJECT_CONFIGURATION()
+{
+#if (MEMORY_USE_OS_TRANSPARENT_MANAGEMENT == ENABLE)
+#if (IDEAL_LINE_LOCATION_TABLE == ENABLE)
+    research_proposal = ResearchProposal::IdealLineLocationTable;
+#elif (COLOCATED_LINE_LOCATION_TABLE == ENABLE)
+    research_proposal = ResearchProposal::ColocatedLineLocationTable;
+#elif (IDEAL_VARIABLE_GRANULARITY == ENABLE)
+    research_proposal = ResearchProposal::IdealVariableGranularity;
+#else
+    research_proposal = ResearchProposal::IdealSingleMemPod;
+#endif // IDEAL_LINE_LOCATION_TABLE, COLOCATED_LINE_LOCATION_TABLE, IDEAL_VARIABLE_GRANULARITY, IDEAL_SINGLE_MEMPOD
+#else
+    research_proposal = ResearchProposal::IdealLineLocationTable;
+#endif // MEMORY_USE_OS_TRANSPARENT_MANAGEMENT
+
+    print_memory_trace  = (PRINT_MEMORY_TRACE == ENABLE);
+    idle_cycle_skipping = (IDLE_CYCLE_SKIPPING == ENABLE);
+
+#if (USE_OPENMP == ENABLE)
+    threads_number = SET_THREADS_NUMBER;
+#else
+    threads_number = 1;
+#endif // USE_OPENMP
+
+#if (PARALLEL_CORE_SIMULATION == ENABLE)
+    parallel_quantum_cycles = PARALLEL_QUANTUM_CYCLES;
+#else
+    parallel_quantum_cycles = 1;
+#endif // PARALLEL_CORE_SIMULATION
+
+    trace_decompression_threads = TRACE_DECOMPRESSION_THREADS;
+
+#if (MEMORY_USE_SWAPPING_UNIT == ENABLE)
+    swapping_buffer_entry_number = SWAPPING_BUFFER_ENTRY_NUMBER;
+#else
+    swapping_buffer_entry_number = 0;
+#endif // MEMORY_USE_SWAPPING_UNIT
+
+#if (MEMORY_USE_OS_TRANSPARENT_MANAGEMENT == ENABLE)
+    hotness_threshold = HOTNESS_THRESHOLD;
+#else
+    hotness_threshold = 0;
+#endif // MEMORY_USE_OS_TRANSPARENT_MANAGEMENT
+
+#if (TRACKING_LOAD_STORE_STATISTICS == ENABLE)
+    tracking_load_only = (TRACKING_LOAD_ONLY == ENABLE);
+    tracking_read_only = (TRACKING_READ_ONLY == ENABLE);
+#else
+    tracking_load_only = tracking_read_only = false;
+#endif // TRACKING_LOAD_STORE_STATISTICS
+}
+
+void PROJECT_CONFIGURATION::load(const std::string& file_name)
+{
+    // The research proposals, each built behind OS_TRANSPARENT_MANAGEMENT
+    const std::map<std::string, ResearchProposal> research_proposals {
+        {"IDEAL_LINE_LOCATION_TABLE",     ResearchProposal::IdealLineLocationTable    },
+        {"COLOCATED_LINE_LOCATION_TABLE", ResearchProposal::ColocatedLineLocationTable},
+        {"IDEAL_VARIABLE_GRANULARITY",    ResearchProposal::IdealVariableGranularity  },
+        {"IDEAL_SINGLE_MEMPOD",           ResearchProposal::IdealSingleMemPod         },
+    };
+
+    // The switches that select the code being built
+    const std::map<std::string, bool> built_switches {
+        {"USE_OPENMP",                           USE_OPENMP == ENABLE                          },
+        {"RAMULATOR",                            RAMULATOR == ENABLE                           },
+        {"MEMORY_USE_HYBRID",                    MEMORY_USE_HYBRID == ENABLE                   },
+        {"PRINT_STATISTICS_INTO_FILE",           PRINT_STATISTICS_INTO_FILE == ENABLE          },
+        {"MEMORY_USE_SWAPPING_UNIT",             MEMORY_USE_SWAPPING_UNIT == ENABLE            },
+        {"MEMORY_USE_OS_TRANSPARENT_MANAGEMENT", MEMORY_USE_OS_TRANSPARENT_MANAGEMENT == ENABLE},
+        {"CPU_USE_MULTIPLE_CORES",               CPU_USE_MULTIPLE_CORES == ENABLE              },
+        {"PARALLEL_CORE_SIMULATION",             PARALLEL_CORE_SIMULATION == ENABLE            },
+        {"FUNCTIONAL_WARMUP",                    FUNCTIONAL_WARMUP == ENABLE                   },
+        {"SIMULATION_PROFILER",                  SIMULATION_PROFILER == ENABLE                 },
+        {"BACKGROUND_TRACE_DECOMPRESSION",       BACKGROUND_TRACE_DECOMPRESSION == ENABLE      },
+        {"MEMORY_MAPPED_TRACES",                 MEMORY_MAPPED_TRACES == ENABLE                },
+#if (MEMORY_USE_OS_TRANSPARENT_MANAGEMENT == ENABLE)
+        {"TRACKING_LOAD_STORE_STATISTICS",       TRACKING_LOAD_STORE_STATISTICS == ENABLE      },
+#else
+        {"TRACKING_LOAD_STORE_STATISTICS",       false                                         },
+#endif // MEMORY_USE_OS_TRANSPARENT_MANAGEMENT
+    };
+
+    std::ifstream file {file_name};
+    if (! file)
+    {
+        std::printf("%s: Cannot open project configuration %s.\n", __func__, file_name.c_str());
+        abort();
+    }
+
+    auto configuration = nlohmann::json::parse(file, nullptr, false);
+    if (configuration.is_discarded() || ! configuration.is_object())
+    {
+        std::printf("%s: %s is not a JSON object.\n", __func__, file_name.c_str());
+        abort();
+    }
+
+    for (auto& [key, value] : configuration.items())
+    {
+        if (auto found = built_switches.find(key); found != std::end(built_switches))
+        {
+            if (read_switch(key, value) != found->second)
+            {
+                std::printf("%s: %s needs a build with %s (%s), since it selects the code being built.\n", __func__, file_name.c_str(), key.c_str(), found->second ? "DISABLE" : "ENABLE");
+                abort();
+            }
+        }
+        else if (key == "OS_TRANSPARENT_MANAGEMENT")
+        {
+            check_build(key, OS_TRANSPARENT_MANAGEMENT_BUILT, "MEMORY_USE_OS_TRANSPARENT_MANAGEMENT");
+            auto found = value.is_string() ? research_proposals.find(value.get<std::string>()) : std::end(research_proposals);
+            if (found == std::end(research_proposals))
+            {
+                std::printf("%s: %s should be IDEAL_LINE_LOCATION_TABLE, COLOCATED_LINE_LOCATION_TABLE, IDEAL_VARIABLE_GRANULARITY or IDEAL_SINGLE_MEMPOD.\n", __func__, key.c_str());
+                abort();
+            }
+            research_proposal = found->second;
+        }
+        else if (key == "PRINT_MEMORY_TRACE")
+        {
+            print_memory_trace = read_switch(key, value);
+            if (print_memory_trace)
+                check_build(key, PRINT_MEMORY_TRACE == ENABLE, "PRINT_MEMORY_TRACE");
+        }
+        else if (key == "IDLE_CYCLE_SKIPPING")
+        {
+            idle_cycle_skipping = read_switch(key, value);
+            if (idle_cycle_skipping)
+                check_build(key, IDLE_CYCLE_SKIPPING == ENABLE, "IDLE_CYCLE_SKIPPING");
+        }
+        else if (key == "SET_THREADS_NUMBER")
+        {
+            check_build(key, USE_OPENMP == ENABLE, "USE_OPENMP");
+            threads_number = read_parameter(key, value, 1, INT_MAX);
+        }
+        else if (key == "PARALLEL_QUANTUM_CYCLES")
+        {
+            check_build(key, PARALLEL_CORE_SIMULATION == ENABLE, "PARALLEL_CORE_SIMULATION");
+            parallel_quantum_cycles = read_parameter(key, value, 1, INT_MAX);
+        }
+        else if (key == "TRACE_DECOMPRESSION_THREADS")
+        {
+            trace_decompression_threads = read_parameter(key, value, 1, INT_MAX);
+        }
+        else if (key == "SWAPPING_BUFFER_ENTRY_NUMBER")
+        {
+            // The swapping unit counts its entries in uint8_t
+            check_build(key, MEMORY_USE_SWAPPING_UNIT == ENABLE, "MEMORY_USE_SWAPPING_UNIT");
+            swapping_buffer_entry_number = read_parameter(key, value, 1, UINT8_MAX);
+        }
+        else if (key == "HOTNESS_THRESHOLD")
+        {
+            // The counters of the data blocks are uint8_t
+            check_build(key, OS_TRANSPARENT_MANAGEMENT_BUILT, "MEMORY_USE_OS_TRANSPARENT_MANAGEMENT");
+            hotness_threshold = read_parameter(key, value, 0, UINT8_MAX);
+        }
+        else if (key == "TRACKING_LOAD_ONLY")
+        {
+            check_build(key, TRACKING_BUILT, "TRACKING_LOAD_STORE_STATISTICS");
+            tracking_load_only = read_switch(key, value);
+        }
+        else if (key == "TRACKING_READ_ONLY")
+        {
+            check_build(key, TRACKING_BUILT, "TRACKING_LOAD_STORE_STATISTICS");
+            tracking_read_only = read_switch(key, value);
+        }
+        else
+        {
+            std::printf("%s: Unknown option %s in %s.\n", __func__, key.c_str(), file_name.c_str());
+            abort();
+        }
+    }
+
+    // IDEAL_SINGLE_MEMPOD finds its hot data with MEA counters instead of a hotness threshold
+    if (configuration.contains("HOTNESS_THRESHOLD") && research_proposal == ResearchProposal::IdealSingleMemPod)
+    {
+        std::printf("%s: HOTNESS_THRESHOLD is not used by IDEAL_SINGLE_MEMPOD.\n", __func__);
+        abort();
+    }
 }
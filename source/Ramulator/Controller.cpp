@@ -9,7 +9,7 @@ using namespace ramulator;
 namespace ramulator
 {
 
-static vector<int> get_offending_subarray(DRAM<SALP>* channel, vector<int>& addr_vec)
+static AddrVec get_offending_subarray(DRAM<SALP>* channel, AddrVec& addr_vec)
 {
     int sa_id = 0;
     auto rank = channel->children[addr_vec[int(SALP::Level::Rank)]];
@@ -21,14 +21,14 @@ static vector<int> get_offending_subarray(DRAM<SALP>* channel, vector<int>& addr
             sa_id = sa_other->id;
             break;
         }
-    vector<int> offending                 = addr_vec;
+    AddrVec offending                     = addr_vec;
     offending[int(SALP::Level::SubArray)] = sa_id;
     offending[int(SALP::Level::Row)]      = -1;
     return offending;
 }
 
 template<>
-vector<int> Controller<SALP>::get_addr_vec(SALP::Command cmd, list<Request>::iterator req)
+AddrVec Controller<SALP>::get_addr_vec(SALP::Command cmd, list<Request>::iterator req)
 {
     if (cmd == SALP::Command::PRE_OTHER)
         return get_offending_subarray(channel, req->addr_vec);
@@ -42,12 +42,26 @@ bool Controller<SALP>::is_ready(list<Request>::iterator req)
     SALP::Command cmd = get_first_cmd(req);
     if (cmd == SALP::Command::PRE_OTHER)
     {
-        vector<int> addr_vec = get_offending_subarray(channel, req->addr_vec);
+        AddrVec addr_vec = get_offending_subarray(channel, req->addr_vec);
         return channel->check(cmd, addr_vec.data(), clk);
     }
     else return channel->check(cmd, req->addr_vec.data(), clk);
 }
 
+#if (USER_CODES == ENABLE)
+template<>
+long Controller<SALP>::get_ready_clk(list<Request>::iterator req)
+{
+    SALP::Command cmd = get_first_cmd(req);
+    if (cmd == SALP::Command::PRE_OTHER)
+    {
+        AddrVec addr_vec = get_offending_subarray(channel, req->addr_vec);
+        return channel->get_next(cmd, addr_vec.data());
+    }
+    else return channel->get_next(cmd, req->addr_vec.data());
+}
+#endif // USER_CODES
+
 template<>
 void Controller<ALDRAM>::update_temp(ALDRAM::Temp current_temperature)
 {
@@ -74,7 +88,17 @@ void Controller<TLDRAM>::tick()
                 channel->update_serving_requests(
                     req.addr_vec.data(), -1, clk);
             }
+#if (USER_CODES == ENABLE)
+            if (req.callback)
+                req.callback(req);
+            else
+            {
+                assert(completions);
+                completions->push_back(std::move(req));
+            }
+#else
             req.callback(req);
+#endif // USER_CODES
             pending.pop_front();
         }
     }
@@ -105,8 +129,8 @@ void Controller<TLDRAM>::tick()
     if (req == queue->q.end() || ! is_ready(req))
     {
         // we couldn't find a command to schedule -- let's try to be speculative
-        auto cmd           = TLDRAM::Command::PRE;
-        vector<int> victim = rowpolicy->get_victim(cmd);
+        auto cmd       = TLDRAM::Command::PRE;
+        AddrVec victim = rowpolicy->get_victim(cmd);
         if (! victim.empty())
         {
             issue_cmd(cmd, victim);
@@ -181,7 +205,11 @@ void Controller<TLDRAM>::tick()
     if (req->type == Request::Type::READ || req->type == Request::Type::EXTENSION)
     {
         req->depart = clk + channel->spec->read_latency;
+#if (USER_CODES == ENABLE)
+        pending.push_back(std::move(*req)); // the request is removed from the queue below
+#else
         pending.push_back(*req);
+#endif // USER_CODES
     }
     if (req->type == Request::Type::WRITE)
     {
@@ -194,10 +222,20 @@ void Controller<TLDRAM>::tick()
 
 template<>
 void Controller<TLDRAM>::cmd_issue_autoprecharge(typename TLDRAM::Command& cmd,
-    const vector<int>& addr_vec)
+    const AddrVec& addr_vec)
 {
     //TLDRAM currently does not have autoprecharge commands
     return;
 }
 
+#if (IDLE_CYCLE_SKIPPING == ENABLE)
+// The refresh of DSARP runs on the per-bank interval and may inject refreshes early or on entering write mode at any tick, so no tick is
+// known to be idle ahead of time
+template<>
+long Controller<DSARP>::idle_ticks()
+{
+    return 0;
+}
+#endif // IDLE_CYCLE_SKIPPING
+
 } /* namespace ramulator */
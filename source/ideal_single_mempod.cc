@@ -1,12 +1,17 @@
 #include "ideal_single_mempod.h"
 
 #include <algorithm>
+#include <cmath>
 
 #if (MEMORY_USE_OS_TRANSPARENT_MANAGEMENT == ENABLE)
-#if (IDEAL_SINGLE_MEMPOD == ENABLE)
+
+OS_TRANSPARENT_MANAGEMENT* make_mempod(uint64_t max_address, uint64_t fast_memory_max_address)
+{
+    return new MEMPOD(max_address, fast_memory_max_address);
+}
 
 // Complete
-OS_TRANSPARENT_MANAGEMENT::OS_TRANSPARENT_MANAGEMENT(uint64_t max_address, uint64_t fast_memory_max_address)
+MEMPOD::MEMPOD(uint64_t max_address, uint64_t fast_memory_max_address)
 : total_capacity(max_address), fast_memory_capacity(fast_memory_max_address),
   total_capacity_at_granularity(max_address >> DATA_MANAGEMENT_OFFSET_BITS),
   fast_memory_capacity_at_granularity(fast_memory_max_address >> DATA_MANAGEMENT_OFFSET_BITS),
@@ -15,11 +20,10 @@ OS_TRANSPARENT_MANAGEMENT::OS_TRANSPARENT_MANAGEMENT(uint64_t max_address, uint6
   address_remapping_table(*(new std::unordered_map<REMAPPING_TABLE_ENTRY_WIDTH, REMAPPING_TABLE_ENTRY_WIDTH>())),
   invert_address_remapping_table(*(new std::unordered_map<REMAPPING_TABLE_ENTRY_WIDTH, REMAPPING_TABLE_ENTRY_WIDTH>()))
 {
-    remapping_request_queue_congestion = 0;
-    intervals                          = 1;
+    intervals           = 1;
 
-    interval_cycle                     = CPU_FREQUENCY * (double) TIME_INTERVAL_MEMPOD_us / MEMORY_CONTROLLER_CLOCK_SCALE;
-    next_interval_cycle                = interval_cycle;
+    interval_cycle      = CPU_FREQUENCY * (double) TIME_INTERVAL_MEMPOD_us / MEMORY_CONTROLLER_CLOCK_SCALE;
+    next_interval_cycle = interval_cycle;
 
     /* Initializing address_remapping_table and invert_address_remapping_table */
     // TODO: I think there is faster way to construct mapping.
@@ -38,7 +42,7 @@ OS_TRANSPARENT_MANAGEMENT::OS_TRANSPARENT_MANAGEMENT(uint64_t max_address, uint6
 };
 
 // Complete
-OS_TRANSPARENT_MANAGEMENT::~OS_TRANSPARENT_MANAGEMENT()
+MEMPOD::~MEMPOD()
 {
     output_statistics.remapping_request_queue_congestion = remapping_request_queue_congestion;
 
@@ -49,21 +53,17 @@ OS_TRANSPARENT_MANAGEMENT::~OS_TRANSPARENT_MANAGEMENT()
 
 #if (TRACKING_LOAD_STORE_STATISTICS == ENABLE)
 // Complete
-bool OS_TRANSPARENT_MANAGEMENT::memory_activity_tracking(uint64_t address, uint8_t type, uint8_t type_origin, float queue_busy_degree)
+bool MEMPOD::memory_activity_tracking(uint64_t address, ramulator::Request::Type type, access_type type_origin, float queue_busy_degree)
 {
-#if (TRACKING_LOAD_ONLY)
-    if (type_origin == RFO || type_origin == WRITEBACK) // CPU Store Instruction and LLC Writeback is ignored
+    if (project_configuration.tracking_load_only && (type_origin == access_type::RFO || type_origin == access_type::WRITE)) // CPU Store Instruction and LLC Writeback is ignored
     {
         return true;
     }
-#endif // TRACKING_LOAD_ONLY
 
-#if (TRACKING_READ_ONLY)
-    if (type == 2) // Memory Write is ignored
+    if (project_configuration.tracking_read_only && (type == ramulator::Request::Type::WRITE)) // Memory Write is ignored
     {
         return true;
     }
-#endif // TRACKING_READ_ONLY
 
     if (address >= total_capacity)
     {
@@ -76,7 +76,7 @@ bool OS_TRANSPARENT_MANAGEMENT::memory_activity_tracking(uint64_t address, uint8
     return true;
 };
 #else
-bool OS_TRANSPARENT_MANAGEMENT::memory_activity_tracking(uint64_t address, ramulator::Request::Type type, float queue_busy_degree)
+bool MEMPOD::memory_activity_tracking(uint64_t address, ramulator::Request::Type type, float queue_busy_degree)
 {
     if (address >= total_capacity)
     {
@@ -88,10 +88,10 @@ bool OS_TRANSPARENT_MANAGEMENT::memory_activity_tracking(uint64_t address, ramul
     update_mea_counter(data_segment_address);
     return true;
 };
-#endif
+#endif // TRACKING_LOAD_STORE_STATISTICS
 
 // Debugged
-void OS_TRANSPARENT_MANAGEMENT::update_mea_counter(uint64_t segment_address)
+void MEMPOD::update_mea_counter(uint64_t segment_address)
 {
     std::deque<REMAPPING_TABLE_ENTRY_WIDTH> data_to_delete;
 
@@ -133,7 +133,7 @@ void OS_TRANSPARENT_MANAGEMENT::update_mea_counter(uint64_t segment_address)
 };
 
 // Complete
-void OS_TRANSPARENT_MANAGEMENT::physical_to_hardware_address(request_type& packet)
+void MEMPOD::physical_to_hardware_address(request_type& packet)
 {
     uint64_t data_segment_address = packet.address >> DATA_MANAGEMENT_OFFSET_BITS;
     uint64_t data_segment_offset  = packet.address - (data_segment_address << DATA_MANAGEMENT_OFFSET_BITS);
@@ -144,7 +144,7 @@ void OS_TRANSPARENT_MANAGEMENT::physical_to_hardware_address(request_type& packe
 };
 
 // Complete
-void OS_TRANSPARENT_MANAGEMENT::physical_to_hardware_address(uint64_t& address)
+void MEMPOD::physical_to_hardware_address(uint64_t& address)
 {
     uint64_t data_segment_address = address >> DATA_MANAGEMENT_OFFSET_BITS;
     uint64_t data_segment_offset  = address - (data_segment_address << DATA_MANAGEMENT_OFFSET_BITS);
@@ -155,19 +155,7 @@ void OS_TRANSPARENT_MANAGEMENT::physical_to_hardware_address(uint64_t& address)
 };
 
 // Complete
-bool OS_TRANSPARENT_MANAGEMENT::issue_remapping_request(RemappingRequest& remapping_request)
-{
-    if (remapping_request_queue.empty() == false)
-    {
-        remapping_request = remapping_request_queue.front();
-        return true;
-    }
-
-    return false;
-};
-
-// Complete
-bool OS_TRANSPARENT_MANAGEMENT::finish_remapping_request()
+bool MEMPOD::finish_remapping_request()
 {
     if (remapping_request_queue.empty() == false)
     {
@@ -178,8 +166,8 @@ bool OS_TRANSPARENT_MANAGEMENT::finish_remapping_request()
         uint64_t data_segment_p_address_fm = remapping_request.p_address_in_fm >> DATA_MANAGEMENT_OFFSET_BITS;
         uint64_t data_segment_p_address_sm = remapping_request.p_address_in_sm >> DATA_MANAGEMENT_OFFSET_BITS;
 
-        uint64_t data_segment_h_address_fm = remapping_request.h_address_in_fm >> DATA_MANAGEMENT_OFFSET_BITS;
-        uint64_t data_segment_h_address_sm = remapping_request.h_address_in_sm >> DATA_MANAGEMENT_OFFSET_BITS;
+        uint64_t data_segment_h_address_fm = remapping_request.address_in_fm >> DATA_MANAGEMENT_OFFSET_BITS;
+        uint64_t data_segment_h_address_sm = remapping_request.address_in_sm >> DATA_MANAGEMENT_OFFSET_BITS;
 
         // Sanity check
         if (data_segment_h_address_fm == data_segment_h_address_sm)
@@ -204,13 +192,28 @@ bool OS_TRANSPARENT_MANAGEMENT::finish_remapping_request()
 };
 
 // Complete
-void OS_TRANSPARENT_MANAGEMENT::cold_data_detection()
+void MEMPOD::cold_data_detection()
 {
     cycle++;
 };
 
+#if (IDLE_CYCLE_SKIPPING == ENABLE)
+uint64_t MEMPOD::idle_cycles(uint64_t bound) const
+{
+    // The swap pairs are decided when the cycle reaches the next interval
+    uint64_t next_interval = static_cast<uint64_t>(std::ceil(next_interval_cycle));
+    return std::min<uint64_t>(bound, next_interval > cycle + 1 ? next_interval - cycle - 1 : 0);
+}
+#endif // IDLE_CYCLE_SKIPPING
+
+void MEMPOD::checkpoint(champsim::checkpoint_archive& archive)
+{
+    archive & cycle & swap_fm_address_itr & mea_counter_table & address_remapping_table & invert_address_remapping_table & remapping_request_queue;
+    archive & interval_cycle & next_interval_cycle & intervals;
+}
+
 // Complete
-void OS_TRANSPARENT_MANAGEMENT::check_interval_swap(uint8_t swapping_states, bool warmup)
+void MEMPOD::check_interval_swap(uint8_t swapping_states, bool warmup)
 {
     if (cycle >= next_interval_cycle)
     {
@@ -237,10 +240,10 @@ void OS_TRANSPARENT_MANAGEMENT::check_interval_swap(uint8_t swapping_states, boo
 };
 
 // Complete
-bool OS_TRANSPARENT_MANAGEMENT::enqueue_remapping_request(RemappingRequest& remapping_request, bool warmup)
+bool MEMPOD::enqueue_remapping_request(RemappingRequest& remapping_request, bool warmup)
 {
     /*
-        uint64_t data_segment_address = remapping_request.h_address_in_sm >> DATA_MANAGEMENT_OFFSET_BITS;
+        uint64_t data_segment_address = remapping_request.address_in_sm >> DATA_MANAGEMENT_OFFSET_BITS;
 
         // check duplicated remapping request in remapping_request_queue
         // if duplicated remapping requests exist, we won't add this new remapping request into the remapping_request_queue.
@@ -284,7 +287,7 @@ bool OS_TRANSPARENT_MANAGEMENT::enqueue_remapping_request(RemappingRequest& rema
     */
     if (remapping_request_queue.size() < REMAPPING_REQUEST_QUEUE_LENGTH)
     {
-        if (remapping_request.h_address_in_fm == remapping_request.h_address_in_sm) // Check
+        if (remapping_request.address_in_fm == remapping_request.address_in_sm) // Check
         {
             std::cout << __func__ << ": add new remapping request error 2." << std::endl;
             abort();
@@ -305,7 +308,7 @@ bool OS_TRANSPARENT_MANAGEMENT::enqueue_remapping_request(RemappingRequest& rema
 }
 
 // Debugged
-void OS_TRANSPARENT_MANAGEMENT::get_hot_page_from_mea_counter(std::vector<REMAPPING_TABLE_ENTRY_WIDTH>& hot_pages)
+void MEMPOD::get_hot_page_from_mea_counter(std::vector<REMAPPING_TABLE_ENTRY_WIDTH>& hot_pages)
 {
     int hot_page_itr = 0;
     for (auto mea_itr = mea_counter_table.begin(); mea_itr != mea_counter_table.end(); ++mea_itr)
@@ -317,13 +320,13 @@ void OS_TRANSPARENT_MANAGEMENT::get_hot_page_from_mea_counter(std::vector<REMAPP
 };
 
 // Complete
-void OS_TRANSPARENT_MANAGEMENT::reset_mea_counter()
+void MEMPOD::reset_mea_counter()
 {
     mea_counter_table.clear();
 };
 
 // Debugged
-void OS_TRANSPARENT_MANAGEMENT::determine_swap_pair(std::vector<REMAPPING_TABLE_ENTRY_WIDTH>& hot_pages, bool warmup)
+void MEMPOD::determine_swap_pair(std::vector<REMAPPING_TABLE_ENTRY_WIDTH>& hot_pages, bool warmup)
 {
 #if (PRINT_SWAPS_PER_EPOCH_MEMPOD == ENABLE)
     uint32_t swaps_per_epoch = 0;
@@ -369,8 +372,8 @@ void OS_TRANSPARENT_MANAGEMENT::determine_swap_pair(std::vector<REMAPPING_TABLE_
         RemappingRequest remapping_request;
         remapping_request.p_address_in_fm = invert_address_remapping_table[swap_fm_address_itr] << DATA_MANAGEMENT_OFFSET_BITS;
         remapping_request.p_address_in_sm = hot_page_in_sm[hot_page_in_sm_itr].p_address << DATA_MANAGEMENT_OFFSET_BITS;
-        remapping_request.h_address_in_fm = swap_fm_address_itr << DATA_MANAGEMENT_OFFSET_BITS;
-        remapping_request.h_address_in_sm = hot_page_in_sm[hot_page_in_sm_itr].h_address << DATA_MANAGEMENT_OFFSET_BITS;
+        remapping_request.address_in_fm   = swap_fm_address_itr << DATA_MANAGEMENT_OFFSET_BITS;
+        remapping_request.address_in_sm   = hot_page_in_sm[hot_page_in_sm_itr].h_address << DATA_MANAGEMENT_OFFSET_BITS;
         remapping_request.size            = SWAP_DATA_CACHE_LINES;
         enqueue_remapping_request(remapping_request, warmup);
 
@@ -393,7 +396,7 @@ void OS_TRANSPARENT_MANAGEMENT::determine_swap_pair(std::vector<REMAPPING_TABLE_
 };
 
 // Complete
-void OS_TRANSPARENT_MANAGEMENT::cancel_not_started_remapping_request(uint8_t swapping_states)
+void MEMPOD::cancel_not_started_remapping_request(uint8_t swapping_states)
 {
     switch (swapping_states)
     {
@@ -419,5 +422,4 @@ void OS_TRANSPARENT_MANAGEMENT::cancel_not_started_remapping_request(uint8_t swa
     }
 };
 
-#endif // IDEAL_SINGLE_MEMPOD
 #endif // MEMORY_USE_OS_TRANSPARENT_MANAGEMENT
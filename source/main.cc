@@ -35,6 +35,18 @@ struct simulator_input_parameter
     std::string json_file_name;
     std::vector<std::string> trace_names;
 
+    // Save the state after the warmup phase into a checkpoint, or skip the warmup phase by restoring it
+    champsim::checkpoint_files checkpoint;
+
+    // Simulate the regions listed in this file instead of the beginning of the traces
+    std::string simpoints_file_name;
+
+    // Sample the simulation phases periodically instead of simulating them in detail
+    champsim::phase_info::sampling_info sampling;
+
+    // Replay the requests of this memory trace into the memory controller instead of simulating the traces
+    std::string replay_file_name;
+
     std::vector<champsim::phase_info> phases;
     std::vector<champsim::tracereader> traces;
 };
@@ -43,28 +55,22 @@ struct simulator_input_parameter
 
 #if (RAMULATOR == ENABLE)
 
-#if (MEMORY_USE_HYBRID == ENABLE)
+template<typename T>
+std::unique_ptr<ramulator::MemoryBase> make_memory(const ramulator::Config& configs, T* spec);
 
-void configure_fast_memory_to_run_simulation(const std::string& standard, ramulator::Config& configs, const std::string& standard2, ramulator::Config& configs2, simulator_input_parameter& input_parameter);
+std::unique_ptr<ramulator::MemoryBase> configure_memory(const std::string& standard, ramulator::Config& configs);
 
-template<typename T>
-void next_configure_slow_memory_to_run_simulation(const std::string& standard2, ramulator::Config& configs2, ramulator::Config& configs, T* spec, simulator_input_parameter& input_parameter);
+#if (MEMORY_USE_HYBRID == ENABLE)
 
-template<typename T, typename T2>
-void start_run_simulation(const ramulator::Config& configs, T* spec, const ramulator::Config& configs2, T2* spec2, simulator_input_parameter& input_parameter);
+void simulation_run(const ramulator::Config& configs, ramulator::MemoryBase& memory, const ramulator::Config& configs2, ramulator::MemoryBase& memory2, simulator_input_parameter& input_parameter);
 
-template<typename T, typename T2>
-void simulation_run(const ramulator::Config& configs, ramulator::Memory<T, ramulator::Controller>& memory, const ramulator::Config& configs2, ramulator::Memory<T2, ramulator::Controller>& memory2, simulator_input_parameter& input_parameter);
+void replay_run(ramulator::MemoryBase& memory, ramulator::MemoryBase& memory2, simulator_input_parameter& input_parameter);
 
 #else
 
-void configure_memory_to_run_simulation(const std::string& standard, ramulator::Config& configs, simulator_input_parameter& input_parameter);
-
-template<typename T>
-void start_run_simulation(const ramulator::Config& configs, T* spec, simulator_input_parameter& input_parameter);
+void simulation_run(const ramulator::Config& configs, ramulator::MemoryBase& memory, simulator_input_parameter& input_parameter);
 
-template<typename T>
-void simulation_run(const ramulator::Config& configs, ramulator::Memory<T, ramulator::Controller>& memory, simulator_input_parameter& input_parameter);
+void replay_run(ramulator::MemoryBase& memory, simulator_input_parameter& input_parameter);
 
 #endif // MEMORY_USE_HYBRID
 
@@ -83,7 +89,7 @@ int main(int argc, char** argv)
 {
     /** @note Test the OpenMP functionality */
 #if (USE_OPENMP == ENABLE)
-    omp_set_num_threads(SET_THREADS_NUMBER);
+    omp_set_num_threads(project_configuration.threads_number);
 #pragma omp parallel
     {
         // Show how many cores your computer have
@@ -101,18 +107,20 @@ int main(int argc, char** argv)
 #if (RAMULATOR == ENABLE)
 #if (MEMORY_USE_HYBRID == ENABLE)
         std::printf(
-            "Usage: %s --warmup-instructions <warmup-instructions> --simulation-instructions <simulation-instructions> [--stats <filename>] <configs-file> <configs-file2> <trace-filename1>\n"
-            "Example: %s --warmup-instructions 1000000 --simulation-instructions 2000000 ramulator-configs1.cfg ramulator-configs2.cfg cpu_trace.xz\n",
-            argv[0], argv[0]);
+            "Usage: %s --warmup-instructions <warmup-instructions> --simulation-instructions <simulation-instructions> [--stats <filename>] [--save-checkpoint <filename>] [--restore-checkpoint <filename>] [--simpoints <filename>] [--sampling <period>:<warmup>:<length>] [--project-configuration <filename>] [--profile] [--trace-cache <directory>] <configs-file> <configs-file2> <trace-filename1>\n"
+            "Example: %s --warmup-instructions 1000000 --simulation-instructions 2000000 ramulator-configs1.cfg ramulator-configs2.cfg cpu_trace.xz\n"
+            "Usage: %s [--project-configuration <filename>] --replay-memory-trace <memory-trace-filename> <configs-file> <configs-file2>\n",
+            argv[0], argv[0], argv[0]);
 #else
         std::printf(
-            "Usage: %s --warmup-instructions <warmup-instructions> --simulation-instructions <simulation-instructions> [--stats <filename>] <configs-file> <trace-filename1>\n"
-            "Example: %s --warmup-instructions 1000000 --simulation-instructions 2000000 ramulator-configs1.cfg cpu_trace.xz\n",
-            argv[0], argv[0]);
+            "Usage: %s --warmup-instructions <warmup-instructions> --simulation-instructions <simulation-instructions> [--stats <filename>] [--save-checkpoint <filename>] [--restore-checkpoint <filename>] [--simpoints <filename>] [--sampling <period>:<warmup>:<length>] [--project-configuration <filename>] [--profile] [--trace-cache <directory>] <configs-file> <trace-filename1>\n"
+            "Example: %s --warmup-instructions 1000000 --simulation-instructions 2000000 ramulator-configs1.cfg cpu_trace.xz\n"
+            "Usage: %s [--project-configuration <filename>] --replay-memory-trace <memory-trace-filename> <configs-file>\n",
+            argv[0], argv[0], argv[0]);
 #endif // MEMORY_USE_HYBRID
 #else
         std::printf(
-            "Usage: %s --warmup-instructions <warmup-instructions> --simulation-instructions <simulation-instructions> <trace-filename1>\n"
+            "Usage: %s --warmup-instructions <warmup-instructions> --simulation-instructions <simulation-instructions> [--project-configuration <filename>] [--profile] [--trace-cache <directory>] <trace-filename1>\n"
             "Example: %s --warmup-instructions 1000000 --simulation-instructions 2000000 cpu_trace.xz\n",
             argv[0], argv[0]);
 #endif // RAMULATOR
@@ -132,6 +140,7 @@ int main(int argc, char** argv)
     bool mapping_flag {false};
     argc_type start_position_of_stats   = 0;
     argc_type start_position_of_mapping = 0;
+    argc_type position_of_replay        = 0;
 #endif // RAMULATOR
     for (auto i = 1; i < argc; i++)
     {
@@ -224,6 +233,162 @@ int main(int argc, char** argv)
             }
         }
 
+        /** The name of the file to save the state after the warmup phase into */
+        if (strcmp(argv[i], "--save-checkpoint") == 0)
+        {
+            if (i + 1 < argc)
+            {
+                input_parameter.checkpoint.save = argv[++i];
+
+#if (RAMULATOR == ENABLE)
+                start_position_of_configs = i + 1;
+                start_position_of_traces  = start_position_of_configs + NUMBER_OF_MEMORIES;
+#else
+                start_position_of_traces = i + 1;
+#endif // RAMULATOR
+                continue;
+            }
+            else
+            {
+                std::cout << __func__ << ": Need parameter behind --save-checkpoint." << std::endl;
+                abort_flag++;
+            }
+        }
+
+        /** The name of the checkpoint to restore instead of running the warmup phase */
+        if (strcmp(argv[i], "--restore-checkpoint") == 0)
+        {
+            if (i + 1 < argc)
+            {
+                input_parameter.checkpoint.restore = argv[++i];
+
+#if (RAMULATOR == ENABLE)
+                start_position_of_configs = i + 1;
+                start_position_of_traces  = start_position_of_configs + NUMBER_OF_MEMORIES;
+#else
+                start_position_of_traces = i + 1;
+#endif // RAMULATOR
+                continue;
+            }
+            else
+            {
+                std::cout << __func__ << ": Need parameter behind --restore-checkpoint." << std::endl;
+                abort_flag++;
+            }
+        }
+
+        /** The file of the regions to simulate, with one "<start instruction> <weight>" per line */
+        if (strcmp(argv[i], "--simpoints") == 0)
+        {
+            if (i + 1 < argc)
+            {
+                input_parameter.simpoints_file_name = argv[++i];
+
+#if (RAMULATOR == ENABLE)
+                start_position_of_configs = i + 1;
+                start_position_of_traces  = start_position_of_configs + NUMBER_OF_MEMORIES;
+#else
+                start_position_of_traces = i + 1;
+#endif // RAMULATOR
+                continue;
+            }
+            else
+            {
+                std::cout << __func__ << ": Need parameter behind --simpoints." << std::endl;
+                abort_flag++;
+            }
+        }
+
+#if (FUNCTIONAL_WARMUP == ENABLE)
+        /** Simulate a window of <length> instructions after <warmup> instructions in detail every <period> instructions, and warm up the rest functionally */
+        if (strcmp(argv[i], "--sampling") == 0)
+        {
+            auto& sampling = input_parameter.sampling;
+            if (i + 1 < argc && std::sscanf(argv[i + 1], "%" SCNu64 ":%" SCNu64 ":%" SCNu64, &sampling.period, &sampling.warmup, &sampling.length) == 3)
+            {
+                if (sampling.length == 0 || sampling.period < sampling.warmup + sampling.length)
+                {
+                    std::printf("%s: --sampling needs a window within its period.\n", __func__);
+                    abort();
+                }
+                i++;
+
+#if (RAMULATOR == ENABLE)
+                start_position_of_configs = i + 1;
+                start_position_of_traces  = start_position_of_configs + NUMBER_OF_MEMORIES;
+#else
+                start_position_of_traces = i + 1;
+#endif // RAMULATOR
+                continue;
+            }
+            else
+            {
+                std::cout << __func__ << ": Need parameter <period>:<warmup>:<length> behind --sampling." << std::endl;
+                abort_flag++;
+            }
+        }
+#endif // FUNCTIONAL_WARMUP
+
+#if (SIMULATION_PROFILER == ENABLE)
+        /** Report the host time spent by each component of the simulator */
+        if (strcmp(argv[i], "--profile") == 0)
+        {
+            champsim::profiler::enabled = true;
+
+#if (RAMULATOR == ENABLE)
+            start_position_of_configs = i + 1;
+            start_position_of_traces  = start_position_of_configs + NUMBER_OF_MEMORIES;
+#else
+            start_position_of_traces = i + 1;
+#endif // RAMULATOR
+            continue;
+        }
+#endif // SIMULATION_PROFILER
+
+        /** The directory keeping the decoded traces for later runs */
+        if (strcmp(argv[i], "--trace-cache") == 0)
+        {
+            if (i + 1 < argc)
+            {
+                champsim::trace_cache::directory = argv[++i];
+
+#if (RAMULATOR == ENABLE)
+                start_position_of_configs = i + 1;
+                start_position_of_traces  = start_position_of_configs + NUMBER_OF_MEMORIES;
+#else
+                start_position_of_traces = i + 1;
+#endif // RAMULATOR
+                continue;
+            }
+            else
+            {
+                std::cout << __func__ << ": Need parameter behind --trace-cache." << std::endl;
+                abort_flag++;
+            }
+        }
+
+        /** The JSON file overriding the options of ProjectConfiguration.h that don't need a rebuild */
+        if (strcmp(argv[i], "--project-configuration") == 0)
+        {
+            if (i + 1 < argc)
+            {
+                project_configuration.load(argv[++i]);
+
+#if (RAMULATOR == ENABLE)
+                start_position_of_configs = i + 1;
+                start_position_of_traces  = start_position_of_configs + NUMBER_OF_MEMORIES;
+#else
+                start_position_of_traces = i + 1;
+#endif // RAMULATOR
+                continue;
+            }
+            else
+            {
+                std::cout << __func__ << ": Need parameter behind --project-configuration." << std::endl;
+                abort_flag++;
+            }
+        }
+
 #if (RAMULATOR == ENABLE)
         if (strcmp(argv[i], "--stats") == 0)
         {
@@ -243,6 +408,25 @@ int main(int argc, char** argv)
             }
         }
 
+        /** The memory trace to replay into the memory controller, without the cores and caches */
+        if (strcmp(argv[i], "--replay-memory-trace") == 0)
+        {
+            if (i + 1 < argc)
+            {
+                position_of_replay               = ++i;
+                input_parameter.replay_file_name = argv[i];
+
+                start_position_of_configs        = i + 1;
+                start_position_of_traces         = start_position_of_configs + NUMBER_OF_MEMORIES;
+                continue;
+            }
+            else
+            {
+                std::cout << __func__ << ": Need parameter behind --replay-memory-trace." << std::endl;
+                abort_flag++;
+            }
+        }
+
         if (strcmp(argv[i], "--mapping") == 0)
         {
             if (i + 1 < argc)
@@ -282,30 +466,73 @@ int main(int argc, char** argv)
         assert(false);
     }
 
+    // The output files are named after the traces, or the memory trace replayed instead of them
+    char** output_names          = &(argv[start_position_of_traces]);
+    uint32_t output_names_number = argc - start_position_of_traces;
+#if (RAMULATOR == ENABLE)
+    if (! std::empty(input_parameter.replay_file_name))
+    {
+        if (! std::empty(input_parameter.trace_names))
+        {
+            std::printf("%s: --replay-memory-trace replaces the traces, so no trace can be given with it.\n", __func__);
+            abort();
+        }
+
+        output_names        = &(argv[position_of_replay]);
+        output_names_number = 1;
+    }
+#endif // RAMULATOR
+
+#if (USE_OPENMP == ENABLE)
+    omp_set_num_threads(project_configuration.threads_number);
+#endif // USE_OPENMP
+
 #if (PRINT_MEMORY_TRACE == ENABLE)
     // Prepare file for recording memory traces.
-    output_memorytrace.output_file_initialization(&(argv[start_position_of_traces]), argc - start_position_of_traces);
+    if (project_configuration.print_memory_trace)
+    {
+        output_memorytrace.output_file_initialization(output_names, output_names_number);
+    }
 #endif // PRINT_MEMORY_TRACE
 
 #if (PRINT_STATISTICS_INTO_FILE == ENABLE)
     // Prepare file for recording statistics.
-    output_statistics.output_file_initialization(&(argv[start_position_of_traces]), argc - start_position_of_traces);
+    output_statistics.output_file_initialization(output_names, output_names_number);
 #endif // PRINT_STATISTICS_INTO_FILE
 
     /** @note Prepare the ChampSim framework */
     if (input_parameter.simulation_given && ! input_parameter.warmup_given)
         input_parameter.warmup_instructions = input_parameter.simulation_instructions * 2 / 10;
 
+    champsim::decomp_tags::decoder_threads = project_configuration.trace_decompression_threads;
     std::transform(std::begin(input_parameter.trace_names), std::end(input_parameter.trace_names), std::back_inserter(input_parameter.traces),
         [knob_cloudsuite = input_parameter.knob_cloudsuite, repeat = input_parameter.simulation_given, i = uint8_t(0)](auto name) mutable
         { return get_tracereader(name, i++, knob_cloudsuite, repeat); });
 
-    input_parameter.phases.push_back(champsim::phase_info {"Warmup", true, input_parameter.warmup_instructions, std::vector<std::size_t>(std::size(input_parameter.trace_names), 0), input_parameter.trace_names});          // Push back warmup phase
-    input_parameter.phases.push_back(champsim::phase_info {"Simulation", false, input_parameter.simulation_instructions, std::vector<std::size_t>(std::size(input_parameter.trace_names), 0), input_parameter.trace_names}); // Push back simulation phase
+    if (! std::empty(input_parameter.simpoints_file_name))
+    {
+        // The checkpoint is of the only warmup phase
+        if (! std::empty(input_parameter.checkpoint.save) || ! std::empty(input_parameter.checkpoint.restore))
+        {
+            std::printf("%s: --simpoints cannot be used with checkpoints.\n", __func__);
+            abort();
+        }
+
+        // Push back a warmup phase and a simulation phase for each region
+        input_parameter.phases = champsim::simpoint_phases(champsim::read_simpoints(input_parameter.simpoints_file_name), input_parameter.warmup_instructions, input_parameter.simulation_instructions, input_parameter.trace_names);
+    }
+    else
+    {
+        input_parameter.phases.push_back(champsim::phase_info {"Warmup", true, input_parameter.warmup_instructions, std::vector<std::size_t>(std::size(input_parameter.trace_names), 0), input_parameter.trace_names});          // Push back warmup phase
+        input_parameter.phases.push_back(champsim::phase_info {"Simulation", false, input_parameter.simulation_instructions, std::vector<std::size_t>(std::size(input_parameter.trace_names), 0), input_parameter.trace_names}); // Push back simulation phase
+    }
 
     for (auto& p : input_parameter.phases)
     {
         std::iota(std::begin(p.trace_index), std::end(p.trace_index), 0);
+
+        if (! p.is_warmup)
+            p.sampling = input_parameter.sampling;
     }
 
     /** @note Prepare the Ramulator framework */
@@ -389,9 +616,37 @@ int main(int argc, char** argv)
 
 #if (RAMULATOR == ENABLE)
 #if (MEMORY_USE_HYBRID == ENABLE)
-    configure_fast_memory_to_run_simulation(standard, configs, standard2, configs2, input_parameter);
+    // The fast memory is built first, so its statistics come first in the .stats file
+    auto memory  = configure_memory(standard, configs);
+    auto memory2 = configure_memory(standard2, configs2);
+
+    if (! std::empty(input_parameter.replay_file_name))
+    {
+        replay_run(*memory, *memory2, input_parameter);
+    }
+    else if ((configs["trace_type"] == "DRAM") && (configs2["trace_type"] == "DRAM"))
+    {
+        simulation_run(configs, *memory, configs2, *memory2, input_parameter);
+    }
+    else
+    {
+        std::printf("%s: Error!\n", __FUNCTION__);
+    }
 #else
-    configure_memory_to_run_simulation(standard, configs, input_parameter);
+    auto memory = configure_memory(standard, configs);
+
+    if (! std::empty(input_parameter.replay_file_name))
+    {
+        replay_run(*memory, input_parameter);
+    }
+    else if (configs["trace_type"] == "DRAM")
+    {
+        simulation_run(configs, *memory, input_parameter);
+    }
+    else
+    {
+        std::printf("%s: Error!\n", __FUNCTION__);
+    }
 #endif // MEMORY_USE_HYBRID
 
     std::printf("Simulation done. Statistics written to %s\n", stats_out.c_str());
@@ -404,217 +659,120 @@ int main(int argc, char** argv)
 }
 
 #if (RAMULATOR == ENABLE)
-#if (MEMORY_USE_HYBRID == ENABLE)
 
-void configure_fast_memory_to_run_simulation(const std::string& standard, ramulator::Config& configs, const std::string& standard2, ramulator::Config& configs2, simulator_input_parameter& input_parameter)
+template<typename T>
+std::unique_ptr<ramulator::MemoryBase> make_memory(const ramulator::Config& configs, T* spec)
 {
+    // Initiate controller and memory
+    int C = configs.get_channels(), R = configs.get_ranks();
+    // Check and Set channel, rank number
+    spec->set_channel_number(C);
+    spec->set_rank_number(R);
+    std::vector<ramulator::Controller<T>*> ctrls;
+    for (int c = 0; c < C; c++)
+    {
+        ramulator::DRAM<T>* channel = new ramulator::DRAM<T>(spec, T::Level::Channel);
+        channel->id                 = c;
+        channel->regStats("");
+        ramulator::Controller<T>* ctrl = new ramulator::Controller<T>(configs, channel);
+        ctrls.push_back(ctrl);
+    }
+    return std::make_unique<ramulator::Memory<T, ramulator::Controller>>(configs, ctrls);
+}
+
+/** @brief
+ *  Pick the DRAM standard at runtime. Only the memory is built per standard, while the memory controller of ChampSim and the rest of the
+ *  simulator use it through ramulator::MemoryBase, so they are compiled once instead of once per standard (or per pair of standards).
+ */
+std::unique_ptr<ramulator::MemoryBase> configure_memory(const std::string& standard, ramulator::Config& configs)
+{
+    /** @todo When to delete the memory? */
     if (standard == "DDR3")
     {
         ramulator::DDR3* ddr3 = new ramulator::DDR3(configs["org"], configs["speed"]);
-        next_configure_slow_memory_to_run_simulation(standard2, configs2, configs, ddr3, input_parameter);
+        return make_memory(configs, ddr3);
     }
     else if (standard == "DDR4")
     {
         ramulator::DDR4* ddr4 = new ramulator::DDR4(configs["org"], configs["speed"]);
-        next_configure_slow_memory_to_run_simulation(standard2, configs2, configs, ddr4, input_parameter);
+        return make_memory(configs, ddr4);
     }
     else if (standard == "SALP-MASA")
     {
         ramulator::SALP* salp8 = new ramulator::SALP(configs["org"], configs["speed"], "SALP-MASA", configs.get_subarrays());
-        next_configure_slow_memory_to_run_simulation(standard2, configs2, configs, salp8, input_parameter);
+        return make_memory(configs, salp8);
     }
     else if (standard == "LPDDR3")
     {
         ramulator::LPDDR3* lpddr3 = new ramulator::LPDDR3(configs["org"], configs["speed"]);
-        next_configure_slow_memory_to_run_simulation(standard2, configs2, configs, lpddr3, input_parameter);
+        return make_memory(configs, lpddr3);
     }
     else if (standard == "LPDDR4")
     {
         // total cap: 2GB, 1/2 of others
         ramulator::LPDDR4* lpddr4 = new ramulator::LPDDR4(configs["org"], configs["speed"]);
-        next_configure_slow_memory_to_run_simulation(standard2, configs2, configs, lpddr4, input_parameter);
+        return make_memory(configs, lpddr4);
     }
     else if (standard == "GDDR5")
     {
         ramulator::GDDR5* gddr5 = new ramulator::GDDR5(configs["org"], configs["speed"]);
-        next_configure_slow_memory_to_run_simulation(standard2, configs2, configs, gddr5, input_parameter);
+        return make_memory(configs, gddr5);
     }
     else if (standard == "HBM")
     {
         ramulator::HBM* hbm = new ramulator::HBM(configs["org"], configs["speed"]);
-        next_configure_slow_memory_to_run_simulation(standard2, configs2, configs, hbm, input_parameter);
+        return make_memory(configs, hbm);
     }
     else if (standard == "WideIO")
     {
         // total cap: 1GB, 1/4 of others
         ramulator::WideIO* wio = new ramulator::WideIO(configs["org"], configs["speed"]);
-        next_configure_slow_memory_to_run_simulation(standard2, configs2, configs, wio, input_parameter);
+        return make_memory(configs, wio);
     }
     else if (standard == "WideIO2")
     {
         // total cap: 2GB, 1/2 of others
         ramulator::WideIO2* wio2 = new ramulator::WideIO2(configs["org"], configs["speed"], configs.get_channels());
         wio2->channel_width *= 2;
-        next_configure_slow_memory_to_run_simulation(standard2, configs2, configs, wio2, input_parameter);
+        return make_memory(configs, wio2);
     }
     else if (standard == "STTMRAM")
     {
         ramulator::STTMRAM* sttmram = new ramulator::STTMRAM(configs["org"], configs["speed"]);
-        next_configure_slow_memory_to_run_simulation(standard2, configs2, configs, sttmram, input_parameter);
+        return make_memory(configs, sttmram);
     }
     else if (standard == "PCM")
     {
         ramulator::PCM* pcm = new ramulator::PCM(configs["org"], configs["speed"]);
-        next_configure_slow_memory_to_run_simulation(standard2, configs2, configs, pcm, input_parameter);
+        return make_memory(configs, pcm);
     }
     // Various refresh mechanisms
     else if (standard == "DSARP")
     {
         ramulator::DSARP* dsddr3_dsarp = new ramulator::DSARP(configs["org"], configs["speed"], ramulator::DSARP::Type::DSARP, configs.get_subarrays());
-        next_configure_slow_memory_to_run_simulation(standard2, configs2, configs, dsddr3_dsarp, input_parameter);
+        return make_memory(configs, dsddr3_dsarp);
     }
     else if (standard == "ALDRAM")
     {
         ramulator::ALDRAM* aldram = new ramulator::ALDRAM(configs["org"], configs["speed"]);
-        next_configure_slow_memory_to_run_simulation(standard2, configs2, configs, aldram, input_parameter);
+        return make_memory(configs, aldram);
     }
     else if (standard == "TLDRAM")
     {
         ramulator::TLDRAM* tldram = new ramulator::TLDRAM(configs["org"], configs["speed"], configs.get_subarrays());
-        next_configure_slow_memory_to_run_simulation(standard2, configs2, configs, tldram, input_parameter);
+        return make_memory(configs, tldram);
     }
-}
 
-template<typename T>
-void next_configure_slow_memory_to_run_simulation(const std::string& standard2, ramulator::Config& configs2, ramulator::Config& configs, T* spec, simulator_input_parameter& input_parameter)
-{
-    if (standard2 == "DDR3")
-    {
-        ramulator::DDR3* ddr3 = new ramulator::DDR3(configs2["org"], configs2["speed"]);
-        start_run_simulation(configs, spec, configs2, ddr3, input_parameter);
-    }
-    else if (standard2 == "DDR4")
-    {
-        ramulator::DDR4* ddr4 = new ramulator::DDR4(configs2["org"], configs2["speed"]);
-        start_run_simulation(configs, spec, configs2, ddr4, input_parameter);
-    }
-    else if (standard2 == "SALP-MASA")
-    {
-        ramulator::SALP* salp8 = new ramulator::SALP(configs2["org"], configs2["speed"], "SALP-MASA", configs2.get_subarrays());
-        start_run_simulation(configs, spec, configs2, salp8, input_parameter);
-    }
-    else if (standard2 == "LPDDR3")
-    {
-        ramulator::LPDDR3* lpddr3 = new ramulator::LPDDR3(configs2["org"], configs2["speed"]);
-        start_run_simulation(configs, spec, configs2, lpddr3, input_parameter);
-    }
-    else if (standard2 == "LPDDR4")
-    {
-        // total cap: 2GB, 1/2 of others
-        ramulator::LPDDR4* lpddr4 = new ramulator::LPDDR4(configs2["org"], configs2["speed"]);
-        start_run_simulation(configs, spec, configs2, lpddr4, input_parameter);
-    }
-    else if (standard2 == "GDDR5")
-    {
-        ramulator::GDDR5* gddr5 = new ramulator::GDDR5(configs2["org"], configs2["speed"]);
-        start_run_simulation(configs, spec, configs2, gddr5, input_parameter);
-    }
-    else if (standard2 == "HBM")
-    {
-        ramulator::HBM* hbm = new ramulator::HBM(configs2["org"], configs2["speed"]);
-        start_run_simulation(configs, spec, configs2, hbm, input_parameter);
-    }
-    else if (standard2 == "WideIO")
-    {
-        // total cap: 1GB, 1/4 of others
-        ramulator::WideIO* wio = new ramulator::WideIO(configs2["org"], configs2["speed"]);
-        start_run_simulation(configs, spec, configs2, wio, input_parameter);
-    }
-    else if (standard2 == "WideIO2")
-    {
-        // total cap: 2GB, 1/2 of others
-        ramulator::WideIO2* wio2 = new ramulator::WideIO2(configs2["org"], configs2["speed"], configs2.get_channels());
-        wio2->channel_width *= 2;
-        start_run_simulation(configs, spec, configs2, wio2, input_parameter);
-    }
-    else if (standard2 == "STTMRAM")
-    {
-        ramulator::STTMRAM* sttmram = new ramulator::STTMRAM(configs2["org"], configs2["speed"]);
-        start_run_simulation(configs, spec, configs2, sttmram, input_parameter);
-    }
-    else if (standard2 == "PCM")
-    {
-        ramulator::PCM* pcm = new ramulator::PCM(configs2["org"], configs2["speed"]);
-        start_run_simulation(configs, spec, configs2, pcm, input_parameter);
-    }
-    // Various refresh mechanisms
-    else if (standard2 == "DSARP")
-    {
-        ramulator::DSARP* dsddr3_dsarp = new ramulator::DSARP(configs2["org"], configs2["speed"], ramulator::DSARP::Type::DSARP, configs2.get_subarrays());
-        start_run_simulation(configs, spec, configs2, dsddr3_dsarp, input_parameter);
-    }
-    else if (standard2 == "ALDRAM")
-    {
-        ramulator::ALDRAM* aldram = new ramulator::ALDRAM(configs2["org"], configs2["speed"]);
-        start_run_simulation(configs, spec, configs2, aldram, input_parameter);
-    }
-    else if (standard2 == "TLDRAM")
-    {
-        ramulator::TLDRAM* tldram = new ramulator::TLDRAM(configs2["org"], configs2["speed"], configs2.get_subarrays());
-        start_run_simulation(configs, spec, configs2, tldram, input_parameter);
-    }
+    std::printf("%s: Unknown DRAM standard %s.\n", __func__, standard.c_str());
+    abort();
 }
 
-template<typename T, typename T2>
-void start_run_simulation(const ramulator::Config& configs, T* spec, const ramulator::Config& configs2, T2* spec2, simulator_input_parameter& input_parameter)
-{
-    // Initiate controller and memory for fast memory
-    int C = configs.get_channels(), R = configs.get_ranks();
-    // Check and Set channel, rank number for fast memory
-    spec->set_channel_number(C);
-    spec->set_rank_number(R);
-    std::vector<ramulator::Controller<T>*> ctrls;
-    for (int c = 0; c < C; c++)
-    {
-        ramulator::DRAM<T>* channel = new ramulator::DRAM<T>(spec, T::Level::Channel);
-        channel->id                 = c;
-        channel->regStats("");
-        ramulator::Controller<T>* ctrl = new ramulator::Controller<T>(configs, channel);
-        ctrls.push_back(ctrl);
-    }
-    ramulator::Memory<T, ramulator::Controller> memory(configs, ctrls);
-
-    // Initiate controller and memory for slow memory
-    C = configs2.get_channels(), R = configs2.get_ranks();
-    // Check and Set channel, rank number for slow memory
-    spec2->set_channel_number(C);
-    spec2->set_rank_number(R);
-    std::vector<ramulator::Controller<T2>*> ctrls2;
-    for (int c = 0; c < C; c++)
-    {
-        ramulator::DRAM<T2>* channel = new ramulator::DRAM<T2>(spec2, T2::Level::Channel);
-        channel->id                  = c;
-        channel->regStats("");
-        ramulator::Controller<T2>* ctrl = new ramulator::Controller<T2>(configs2, channel);
-        ctrls2.push_back(ctrl);
-    }
-    ramulator::Memory<T2, ramulator::Controller> memory2(configs2, ctrls2);
-
-    if ((configs["trace_type"] == "DRAM") && (configs2["trace_type"] == "DRAM"))
-    {
-        simulation_run(configs, memory, configs2, memory2, input_parameter);
-    }
-    else
-    {
-        std::printf("%s: Error!\n", __FUNCTION__);
-    }
-}
+#if (MEMORY_USE_HYBRID == ENABLE)
 
-template<typename T, typename T2>
-void simulation_run(const ramulator::Config& configs, ramulator::Memory<T, ramulator::Controller>& memory, const ramulator::Config& configs2, ramulator::Memory<T2, ramulator::Controller>& memory2, simulator_input_parameter& input_parameter)
+void simulation_run(const ramulator::Config& configs, ramulator::MemoryBase& memory, const ramulator::Config& configs2, ramulator::MemoryBase& memory2, simulator_input_parameter& input_parameter)
 {
     /** @note Prepare the hardware modules */
-    champsim::configured::generated_environment<T, T2> gen_environment(memory, memory2);
+    champsim::configured::generated_environment gen_environment(memory, memory2);
 
     if (input_parameter.hide_given)
     {
@@ -700,7 +858,11 @@ void simulation_run(const ramulator::Config& configs, ramulator::Memory<T, ramul
     }
 #endif // MEMORY_USE_SWAPPING_UNIT && TEST_SWAPPING_UNIT
 
-    auto phase_stats = champsim::main(gen_environment, input_parameter.phases, input_parameter.traces);
+    auto phase_stats = champsim::main(gen_environment, input_parameter.phases, input_parameter.traces, input_parameter.checkpoint);
+
+    // Combine the regions by their weights
+    if (! std::empty(input_parameter.simpoints_file_name) && ! std::empty(phase_stats))
+        phase_stats.push_back(champsim::weighted_phase_stats(phase_stats));
 
     fmt::print("\nChampSim completed all CPUs\n\n");
 #if (PRINT_STATISTICS_INTO_FILE == ENABLE)
@@ -732,122 +894,37 @@ void simulation_run(const ramulator::Config& configs, ramulator::Memory<T, ramul
     }
 }
 
-#else
-
-void configure_memory_to_run_simulation(const std::string& standard, ramulator::Config& configs, simulator_input_parameter& input_parameter)
+void replay_run(ramulator::MemoryBase& memory, ramulator::MemoryBase& memory2, simulator_input_parameter& input_parameter)
 {
-    /** @todo When to delete the memory? */
-    if (standard == "DDR3")
-    {
-        ramulator::DDR3* ddr3 = new ramulator::DDR3(configs["org"], configs["speed"]);
-        start_run_simulation(configs, ddr3, input_parameter);
-    }
-    else if (standard == "DDR4")
-    {
-        ramulator::DDR4* ddr4 = new ramulator::DDR4(configs["org"], configs["speed"]);
-        start_run_simulation(configs, ddr4, input_parameter);
-    }
-    else if (standard == "SALP-MASA")
-    {
-        ramulator::SALP* salp8 = new ramulator::SALP(configs["org"], configs["speed"], "SALP-MASA", configs.get_subarrays());
-        start_run_simulation(configs, salp8, input_parameter);
-    }
-    else if (standard == "LPDDR3")
-    {
-        ramulator::LPDDR3* lpddr3 = new ramulator::LPDDR3(configs["org"], configs["speed"]);
-        start_run_simulation(configs, lpddr3, input_parameter);
-    }
-    else if (standard == "LPDDR4")
-    {
-        // total cap: 2GB, 1/2 of others
-        ramulator::LPDDR4* lpddr4 = new ramulator::LPDDR4(configs["org"], configs["speed"]);
-        start_run_simulation(configs, lpddr4, input_parameter);
-    }
-    else if (standard == "GDDR5")
-    {
-        ramulator::GDDR5* gddr5 = new ramulator::GDDR5(configs["org"], configs["speed"]);
-        start_run_simulation(configs, gddr5, input_parameter);
-    }
-    else if (standard == "HBM")
-    {
-        ramulator::HBM* hbm = new ramulator::HBM(configs["org"], configs["speed"]);
-        start_run_simulation(configs, hbm, input_parameter);
-    }
-    else if (standard == "WideIO")
-    {
-        // total cap: 1GB, 1/4 of others
-        ramulator::WideIO* wio = new ramulator::WideIO(configs["org"], configs["speed"]);
-        start_run_simulation(configs, wio, input_parameter);
-    }
-    else if (standard == "WideIO2")
-    {
-        // total cap: 2GB, 1/2 of others
-        ramulator::WideIO2* wio2 = new ramulator::WideIO2(configs["org"], configs["speed"], configs.get_channels());
-        wio2->channel_width *= 2;
-        start_run_simulation(configs, wio2, input_parameter);
-    }
-    else if (standard == "STTMRAM")
-    {
-        ramulator::STTMRAM* sttmram = new ramulator::STTMRAM(configs["org"], configs["speed"]);
-        start_run_simulation(configs, sttmram, input_parameter);
-    }
-    else if (standard == "PCM")
-    {
-        ramulator::PCM* pcm = new ramulator::PCM(configs["org"], configs["speed"]);
-        start_run_simulation(configs, pcm, input_parameter);
-    }
-    // Various refresh mechanisms
-    else if (standard == "DSARP")
-    {
-        ramulator::DSARP* dsddr3_dsarp = new ramulator::DSARP(configs["org"], configs["speed"], ramulator::DSARP::Type::DSARP, configs.get_subarrays());
-        start_run_simulation(configs, dsddr3_dsarp, input_parameter);
-    }
-    else if (standard == "ALDRAM")
-    {
-        ramulator::ALDRAM* aldram = new ramulator::ALDRAM(configs["org"], configs["speed"]);
-        start_run_simulation(configs, aldram, input_parameter);
-    }
-    else if (standard == "TLDRAM")
-    {
-        ramulator::TLDRAM* tldram = new ramulator::TLDRAM(configs["org"], configs["speed"], configs.get_subarrays());
-        start_run_simulation(configs, tldram, input_parameter);
-    }
-}
+    /** @note Prepare the memory controller alone, which receives the requests from the channel of the LLC */
+    champsim::channel LLC_to_MEMORY_CONTROLLER_queues {std::numeric_limits<std::size_t>::max(), std::numeric_limits<std::size_t>::max(), std::numeric_limits<std::size_t>::max(), LOG2_BLOCK_SIZE, 0};
+    MEMORY_CONTROLLER memory_controller(MEMORY_CONTROLLER_CLOCK_SCALE, CPU_FREQUENCY / memory.clk_mhz(), CPU_FREQUENCY / memory2.clk_mhz(), {&LLC_to_MEMORY_CONTROLLER_queues}, memory, memory2);
+    memory_controller.initialize();
 
-template<typename T>
-void start_run_simulation(const ramulator::Config& configs, T* spec, simulator_input_parameter& input_parameter)
-{
-    // Initiate controller and memory for fast memory
-    int C = configs.get_channels(), R = configs.get_ranks();
-    // Check and Set channel, rank number for fast memory
-    spec->set_channel_number(C);
-    spec->set_rank_number(R);
-    std::vector<ramulator::Controller<T>*> ctrls;
-    for (int c = 0; c < C; c++)
-    {
-        ramulator::DRAM<T>* channel = new ramulator::DRAM<T>(spec, T::Level::Channel);
-        channel->id = c;
-        channel->regStats("");
-        ramulator::Controller<T>* ctrl = new ramulator::Controller<T>(configs, channel);
-        ctrls.push_back(ctrl);
-    }
-    ramulator::Memory<T, ramulator::Controller> memory(configs, ctrls);
+    fmt::print("\n*** ChampSim Memory Trace Replay ***\nMemory Trace: {}\n\n", input_parameter.replay_file_name);
+#if (PRINT_STATISTICS_INTO_FILE == ENABLE)
+    std::fprintf(output_statistics.file_handler, "\n*** ChampSim Memory Trace Replay ***\nMemory Trace: %s\n\n", input_parameter.replay_file_name.c_str());
+#endif // PRINT_STATISTICS_INTO_FILE
 
-    if (configs["trace_type"] == "DRAM")
-    {
-        simulation_run(configs, memory, input_parameter);
-    }
-    else
-    {
-        std::printf("%s: Error!\n", __FUNCTION__);
-    }
+    auto stats = champsim::replay_memory_trace(memory_controller, LLC_to_MEMORY_CONTROLLER_queues, {memory, memory2}, input_parameter.replay_file_name);
+
+    fmt::print("Replayed {} reads and {} writes recorded in {} cycles, which took {} cycles\n", stats.reads, stats.writes, stats.recorded_cycles, stats.cycles);
+#if (PRINT_STATISTICS_INTO_FILE == ENABLE)
+    std::fprintf(output_statistics.file_handler, "Replayed %lu reads and %lu writes recorded in %lu cycles, which took %lu cycles\n", stats.reads, stats.writes, stats.recorded_cycles, stats.cycles);
+#endif // PRINT_STATISTICS_INTO_FILE
+
+    // This a workaround for statistics set only initially lost in the end
+    memory.finish();
+    memory2.finish();
+    Stats::statlist.printall();
 }
 
-template<typename T>
-void simulation_run(const ramulator::Config& configs, ramulator::Memory<T, ramulator::Controller>& memory, simulator_input_parameter& input_parameter)
+#else
+
+void simulation_run(const ramulator::Config& configs, ramulator::MemoryBase& memory, simulator_input_parameter& input_parameter)
 {
     /** @note Prepare the hardware modules */
-    champsim::configured::generated_environment<T> gen_environment(memory);
+    champsim::configured::generated_environment gen_environment(memory);
 
     if (input_parameter.hide_given)
     {
@@ -860,7 +937,11 @@ void simulation_run(const ramulator::Config& configs, ramulator::Memory<T, ramul
     std::fprintf(output_statistics.file_handler, "\n*** ChampSim Multicore Out-of-Order Simulator ***\nWarmup Instructions: %ld\nSimulation Instructions: %ld\nNumber of CPUs: %ld\nPage size: %d\n\n", input_parameter.phases.at(0).length, input_parameter.phases.at(1).length, std::size(gen_environment.cpu_view()), PAGE_SIZE);
 #endif // PRINT_STATISTICS_INTO_FILE
 
-    auto phase_stats = champsim::main(gen_environment, input_parameter.phases, input_parameter.traces);
+    auto phase_stats = champsim::main(gen_environment, input_parameter.phases, input_parameter.traces, input_parameter.checkpoint);
+
+    // Combine the regions by their weights
+    if (! std::empty(input_parameter.simpoints_file_name) && ! std::empty(phase_stats))
+        phase_stats.push_back(champsim::weighted_phase_stats(phase_stats));
 
     fmt::print("\nChampSim completed all CPUs\n\n");
 #if (PRINT_STATISTICS_INTO_FILE == ENABLE)
@@ -890,6 +971,30 @@ void simulation_run(const ramulator::Config& configs, ramulator::Memory<T, ramul
         champsim::json_printer {json_file}.print(phase_stats);
     }
 }
+
+void replay_run(ramulator::MemoryBase& memory, simulator_input_parameter& input_parameter)
+{
+    /** @note Prepare the memory controller alone, which receives the requests from the channel of the LLC */
+    champsim::channel LLC_to_MEMORY_CONTROLLER_queues {std::numeric_limits<std::size_t>::max(), std::numeric_limits<std::size_t>::max(), std::numeric_limits<std::size_t>::max(), LOG2_BLOCK_SIZE, 0};
+    MEMORY_CONTROLLER memory_controller(MEMORY_CONTROLLER_CLOCK_SCALE, CPU_FREQUENCY / memory.clk_mhz(), {&LLC_to_MEMORY_CONTROLLER_queues}, memory);
+    memory_controller.initialize();
+
+    fmt::print("\n*** ChampSim Memory Trace Replay ***\nMemory Trace: {}\n\n", input_parameter.replay_file_name);
+#if (PRINT_STATISTICS_INTO_FILE == ENABLE)
+    std::fprintf(output_statistics.file_handler, "\n*** ChampSim Memory Trace Replay ***\nMemory Trace: %s\n\n", input_parameter.replay_file_name.c_str());
+#endif // PRINT_STATISTICS_INTO_FILE
+
+    auto stats = champsim::replay_memory_trace(memory_controller, LLC_to_MEMORY_CONTROLLER_queues, {memory}, input_parameter.replay_file_name);
+
+    fmt::print("Replayed {} reads and {} writes recorded in {} cycles, which took {} cycles\n", stats.reads, stats.writes, stats.recorded_cycles, stats.cycles);
+#if (PRINT_STATISTICS_INTO_FILE == ENABLE)
+    std::fprintf(output_statistics.file_handler, "Replayed %lu reads and %lu writes recorded in %lu cycles, which took %lu cycles\n", stats.reads, stats.writes, stats.recorded_cycles, stats.cycles);
+#endif // PRINT_STATISTICS_INTO_FILE
+
+    // This a workaround for statistics set only initially lost in the end
+    memory.finish();
+    Stats::statlist.printall();
+}
 #endif // MEMORY_USE_HYBRID
 
 #else
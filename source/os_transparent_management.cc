@@ -2,43 +2,23 @@
 
 #if (MEMORY_USE_OS_TRANSPARENT_MANAGEMENT == ENABLE)
 
-#if (NO_METHOD_FOR_RUN_HYBRID_MEMORY == ENABLE)
-
-OS_TRANSPARENT_MANAGEMENT::OS_TRANSPARENT_MANAGEMENT(uint64_t max_address, uint64_t fast_memory_max_address)
-: total_capacity(max_address), fast_memory_capacity(fast_memory_max_address),
-  fast_memory_capacity_at_data_block_granularity(fast_memory_max_address >> DATA_MANAGEMENT_OFFSET_BITS),
-  fast_memory_offset_bit(champsim::lg2(fast_memory_max_address)), // Note here only support integers of 2's power.
-  counter_table(*(new std::vector<COUNTER_WIDTH>(max_address >> DATA_MANAGEMENT_OFFSET_BITS, COUNTER_DEFAULT_VALUE))),
-  hotness_table(*(new std::vector<HOTNESS_WIDTH>(max_address >> DATA_MANAGEMENT_OFFSET_BITS, HOTNESS_DEFAULT_VALUE)))
-{
-    hotness_threshold = HOTNESS_THRESHOLD;
-};
-
-OS_TRANSPARENT_MANAGEMENT::~OS_TRANSPARENT_MANAGEMENT()
-{
-    output_statistics.remapping_request_queue_congestion = remapping_request_queue_congestion;
-    delete &counter_table;
-    delete &hotness_table;
-};
-
-bool OS_TRANSPARENT_MANAGEMENT::memory_activity_tracking(uint64_t address, uint8_t type, float queue_busy_degree)
+OS_TRANSPARENT_MANAGEMENT* make_os_transparent_management(uint64_t max_address, uint64_t fast_memory_max_address)
 {
-    if (address >= total_capacity)
+    switch (project_configuration.research_proposal)
     {
-        std::cout << __func__ << ": address input error." << std::endl;
-        return false;
+    case ResearchProposal::IdealLineLocationTable:
+        return make_cameo(max_address, fast_memory_max_address, false);
+    case ResearchProposal::ColocatedLineLocationTable:
+        return make_cameo(max_address, fast_memory_max_address, true);
+    case ResearchProposal::IdealVariableGranularity:
+        return make_variable_granularity(max_address, fast_memory_max_address);
+    case ResearchProposal::IdealSingleMemPod:
+        return make_mempod(max_address, fast_memory_max_address);
+    default:
+        std::cout << __func__ << ": research proposal error." << std::endl;
+        abort();
     }
-
-    return true;
-};
-
-void OS_TRANSPARENT_MANAGEMENT::physical_to_hardware_address(request_type& packet) {
-
-};
-
-void OS_TRANSPARENT_MANAGEMENT::physical_to_hardware_address(uint64_t& address) {
-
-};
+}
 
 bool OS_TRANSPARENT_MANAGEMENT::issue_remapping_request(RemappingRequest& remapping_request)
 {
@@ -51,37 +31,46 @@ bool OS_TRANSPARENT_MANAGEMENT::issue_remapping_request(RemappingRequest& remapp
     return false;
 };
 
-bool OS_TRANSPARENT_MANAGEMENT::finish_remapping_request()
+bool OS_TRANSPARENT_MANAGEMENT::finish_fm_access_in_incomplete_read_request_queue(uint64_t h_address)
 {
-    if (remapping_request_queue.empty() == false)
+    for (size_t i = 0; i < incomplete_read_request_queue.size(); i++)
     {
-        RemappingRequest remapping_request = remapping_request_queue.front();
-        remapping_request_queue.pop_front();
+        if (incomplete_read_request_queue[i].packet.h_address == h_address)
+        {
+            if (incomplete_read_request_queue[i].fm_access_finish == false)
+            {
+                incomplete_read_request_queue[i].fm_access_finish = true;
+                return true;
+            }
+            else
+            {
+                continue;
+            }
+        }
     }
-    else
-    {
-        std::cout << __func__ << ": remapping error." << std::endl;
-        assert(false);
-        return false; // Error
-    }
-
-    return true;
-};
 
-void OS_TRANSPARENT_MANAGEMENT::cold_data_detection()
-{
-    cycle++;
-}
-
-bool OS_TRANSPARENT_MANAGEMENT::cold_data_eviction(uint64_t source_address, float queue_busy_degree)
-{
     return false;
 }
 
-bool OS_TRANSPARENT_MANAGEMENT::enqueue_remapping_request(RemappingRequest& remapping_request)
+bool OS_TRANSPARENT_MANAGEMENT::finish_fm_access_in_incomplete_write_request_queue(uint64_t h_address)
 {
+    for (size_t i = 0; i < incomplete_write_request_queue.size(); i++)
+    {
+        if (incomplete_write_request_queue[i].packet.h_address == h_address)
+        {
+            if (incomplete_write_request_queue[i].fm_access_finish == false)
+            {
+                incomplete_write_request_queue[i].fm_access_finish = true;
+                return true;
+            }
+            else
+            {
+                continue;
+            }
+        }
+    }
+
     return false;
 }
 
-#endif // NO_METHOD_FOR_RUN_HYBRID_MEMORY
 #endif // MEMORY_USE_OS_TRANSPARENT_MANAGEMENT
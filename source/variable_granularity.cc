@@ -1,9 +1,13 @@
-#include "os_transparent_management.h"
+#include "variable_granularity.h"
 
 #if (MEMORY_USE_OS_TRANSPARENT_MANAGEMENT == ENABLE)
 
-#if (IDEAL_VARIABLE_GRANULARITY == ENABLE)
-OS_TRANSPARENT_MANAGEMENT::OS_TRANSPARENT_MANAGEMENT(uint64_t max_address, uint64_t fast_memory_max_address)
+OS_TRANSPARENT_MANAGEMENT* make_variable_granularity(uint64_t max_address, uint64_t fast_memory_max_address)
+{
+    return new VARIABLE_GRANULARITY(max_address, fast_memory_max_address);
+}
+
+VARIABLE_GRANULARITY::VARIABLE_GRANULARITY(uint64_t max_address, uint64_t fast_memory_max_address)
 : total_capacity(max_address), fast_memory_capacity(fast_memory_max_address),
   total_capacity_at_data_block_granularity(max_address >> DATA_MANAGEMENT_OFFSET_BITS),
   fast_memory_capacity_at_data_block_granularity(fast_memory_max_address >> DATA_MANAGEMENT_OFFSET_BITS),
@@ -14,14 +18,13 @@ OS_TRANSPARENT_MANAGEMENT::OS_TRANSPARENT_MANAGEMENT(uint64_t max_address, uint6
   access_table(*(new std::vector<AccessDistribution>(max_address >> DATA_MANAGEMENT_OFFSET_BITS))),
   placement_table(*(new std::vector<PlacementEntry>(fast_memory_max_address >> DATA_MANAGEMENT_OFFSET_BITS)))
 {
-    hotness_threshold                   = HOTNESS_THRESHOLD;
-    remapping_request_queue_congestion  = 0;
+    hotness_threshold                   = project_configuration.hotness_threshold;
 
     expected_number_in_congruence_group = total_capacity / fast_memory_capacity;
     std::printf("Number in Congruence group: %ld.\n", expected_number_in_congruence_group);
 };
 
-OS_TRANSPARENT_MANAGEMENT::~OS_TRANSPARENT_MANAGEMENT()
+VARIABLE_GRANULARITY::~VARIABLE_GRANULARITY()
 {
     output_statistics.remapping_request_queue_congestion = remapping_request_queue_congestion;
 
@@ -105,7 +108,11 @@ OS_TRANSPARENT_MANAGEMENT::~OS_TRANSPARENT_MANAGEMENT()
     delete &placement_table;
 };
 
-bool OS_TRANSPARENT_MANAGEMENT::memory_activity_tracking(uint64_t address, ramulator::Request::Type type, float queue_busy_degree)
+#if (TRACKING_LOAD_STORE_STATISTICS == ENABLE)
+bool VARIABLE_GRANULARITY::memory_activity_tracking(uint64_t address, ramulator::Request::Type type, access_type type_origin, float queue_busy_degree)
+#else
+bool VARIABLE_GRANULARITY::memory_activity_tracking(uint64_t address, ramulator::Request::Type type, float queue_busy_degree)
+#endif // TRACKING_LOAD_STORE_STATISTICS
 {
     if (address >= total_capacity)
     {
@@ -570,7 +577,7 @@ bool OS_TRANSPARENT_MANAGEMENT::memory_activity_tracking(uint64_t address, ramul
     return true;
 };
 
-void OS_TRANSPARENT_MANAGEMENT::physical_to_hardware_address(request_type& packet)
+void VARIABLE_GRANULARITY::physical_to_hardware_address(request_type& packet)
 {
     uint64_t data_block_address           = packet.address >> DATA_MANAGEMENT_OFFSET_BITS;
     uint64_t placement_table_index        = data_block_address % fast_memory_capacity_at_data_block_granularity;
@@ -674,7 +681,7 @@ void OS_TRANSPARENT_MANAGEMENT::physical_to_hardware_address(request_type& packe
     }
 };
 
-void OS_TRANSPARENT_MANAGEMENT::physical_to_hardware_address(uint64_t& address)
+void VARIABLE_GRANULARITY::physical_to_hardware_address(uint64_t& address)
 {
     uint64_t data_block_address           = address >> DATA_MANAGEMENT_OFFSET_BITS;
     uint64_t placement_table_index        = data_block_address % fast_memory_capacity_at_data_block_granularity;
@@ -778,18 +785,7 @@ void OS_TRANSPARENT_MANAGEMENT::physical_to_hardware_address(uint64_t& address)
     }
 };
 
-bool OS_TRANSPARENT_MANAGEMENT::issue_remapping_request(RemappingRequest& remapping_request)
-{
-    if (remapping_request_queue.empty() == false)
-    {
-        remapping_request = remapping_request_queue.front();
-        return true;
-    }
-
-    return false;
-};
-
-bool OS_TRANSPARENT_MANAGEMENT::finish_remapping_request()
+bool VARIABLE_GRANULARITY::finish_remapping_request()
 {
     if (remapping_request_queue.empty() == false)
     {
@@ -1062,7 +1058,7 @@ bool OS_TRANSPARENT_MANAGEMENT::finish_remapping_request()
     return true;
 };
 
-void OS_TRANSPARENT_MANAGEMENT::cold_data_detection()
+void VARIABLE_GRANULARITY::cold_data_detection()
 {
     if ((cycle % INTERVAL_FOR_DECREMENT) == 0)
     {
@@ -1115,8 +1111,28 @@ void OS_TRANSPARENT_MANAGEMENT::cold_data_detection()
     cycle++;
 }
 
+#if (IDLE_CYCLE_SKIPPING == ENABLE)
+uint64_t VARIABLE_GRANULARITY::idle_cycles(uint64_t bound) const
+{
+    // The counters are halved when the cycle reaches a multiple of INTERVAL_FOR_DECREMENT
+    return std::min<uint64_t>(bound, (INTERVAL_FOR_DECREMENT - cycle % INTERVAL_FOR_DECREMENT) % INTERVAL_FOR_DECREMENT);
+}
+#endif // IDLE_CYCLE_SKIPPING
+
+void VARIABLE_GRANULARITY::checkpoint(champsim::checkpoint_archive& archive)
+{
+    archive & cycle;
+    // The tables of a warmed checkpoint keep serving a sweep of HOTNESS_THRESHOLD, under the threshold configured for this run
+    COUNTER_WIDTH archived_hotness_threshold = hotness_threshold;
+    archive & archived_hotness_threshold;
+    if (archived_hotness_threshold != hotness_threshold)
+        std::printf("%s: The checkpoint was taken with hotness threshold %u, this run continues with %u.\n", __func__, unsigned(archived_hotness_threshold), unsigned(hotness_threshold));
+    archive & counter_table & hotness_table & remapping_request_queue;
+    archive & access_table & placement_table & expected_number_in_congruence_group;
+}
+
 #if (COLD_DATA_DETECTION_IN_GROUP == ENABLE)
-void OS_TRANSPARENT_MANAGEMENT::cold_data_detection_in_group(uint64_t source_address)
+void VARIABLE_GRANULARITY::cold_data_detection_in_group(uint64_t source_address)
 {
     uint64_t data_block_address     = source_address >> DATA_MANAGEMENT_OFFSET_BITS;                       // Calculate the data block address
     uint64_t placement_table_index  = data_block_address % fast_memory_capacity_at_data_block_granularity; // Calculate the index in placement table
@@ -1146,7 +1162,7 @@ void OS_TRANSPARENT_MANAGEMENT::cold_data_detection_in_group(uint64_t source_add
 }
 #endif // COLD_DATA_DETECTION_IN_GROUP
 
-bool OS_TRANSPARENT_MANAGEMENT::cold_data_eviction(uint64_t source_address, float queue_busy_degree)
+bool VARIABLE_GRANULARITY::cold_data_eviction(uint64_t source_address, float queue_busy_degree)
 {
 #if (DATA_EVICTION == ENABLE)
     uint64_t data_block_address                    = source_address >> DATA_MANAGEMENT_OFFSET_BITS;                       // Calculate the data block address
@@ -1261,7 +1277,7 @@ bool OS_TRANSPARENT_MANAGEMENT::cold_data_eviction(uint64_t source_address, floa
     return true;
 }
 
-bool OS_TRANSPARENT_MANAGEMENT::enqueue_remapping_request(RemappingRequest& remapping_request)
+bool VARIABLE_GRANULARITY::enqueue_remapping_request(RemappingRequest& remapping_request)
 {
     uint64_t data_block_address       = remapping_request.address_in_fm >> DATA_MANAGEMENT_OFFSET_BITS;
     uint64_t placement_table_index    = data_block_address % fast_memory_capacity_at_data_block_granularity;
@@ -1344,7 +1360,7 @@ bool OS_TRANSPARENT_MANAGEMENT::enqueue_remapping_request(RemappingRequest& rema
     return true;
 }
 
-MIGRATION_GRANULARITY_WIDTH OS_TRANSPARENT_MANAGEMENT::calculate_migration_granularity(const START_ADDRESS_WIDTH start_address, const START_ADDRESS_WIDTH end_address)
+MIGRATION_GRANULARITY_WIDTH VARIABLE_GRANULARITY::calculate_migration_granularity(const START_ADDRESS_WIDTH start_address, const START_ADDRESS_WIDTH end_address)
 {
     // Check
     if (start_address > end_address)
@@ -1393,7 +1409,7 @@ MIGRATION_GRANULARITY_WIDTH OS_TRANSPARENT_MANAGEMENT::calculate_migration_granu
     return migration_granularity;
 }
 
-START_ADDRESS_WIDTH OS_TRANSPARENT_MANAGEMENT::adjust_migration_granularity(const START_ADDRESS_WIDTH start_address, const START_ADDRESS_WIDTH end_address, MIGRATION_GRANULARITY_WIDTH& migration_granularity)
+START_ADDRESS_WIDTH VARIABLE_GRANULARITY::adjust_migration_granularity(const START_ADDRESS_WIDTH start_address, const START_ADDRESS_WIDTH end_address, MIGRATION_GRANULARITY_WIDTH& migration_granularity)
 {
     START_ADDRESS_WIDTH updated_end_address = end_address;
 
@@ -1447,7 +1463,7 @@ START_ADDRESS_WIDTH OS_TRANSPARENT_MANAGEMENT::adjust_migration_granularity(cons
     return updated_end_address;
 }
 
-START_ADDRESS_WIDTH OS_TRANSPARENT_MANAGEMENT::round_down_migration_granularity(const START_ADDRESS_WIDTH start_address, const START_ADDRESS_WIDTH end_address, MIGRATION_GRANULARITY_WIDTH& migration_granularity)
+START_ADDRESS_WIDTH VARIABLE_GRANULARITY::round_down_migration_granularity(const START_ADDRESS_WIDTH start_address, const START_ADDRESS_WIDTH end_address, MIGRATION_GRANULARITY_WIDTH& migration_granularity)
 {
     START_ADDRESS_WIDTH updated_end_address = end_address;
 
@@ -1501,5 +1517,4 @@ START_ADDRESS_WIDTH OS_TRANSPARENT_MANAGEMENT::round_down_migration_granularity(
     return updated_end_address;
 }
 
-#endif // IDEAL_VARIABLE_GRANULARITY
 #endif // MEMORY_USE_OS_TRANSPARENT_MANAGEMENT
@@ -13,6 +13,16 @@ constexpr std::size_t BIMODAL_PRIME      = 16381;
 constexpr std::size_t COUNTER_BITS       = 2;
 
 std::map<O3_CPU*, std::array<champsim::msl::fwcounter<COUNTER_BITS>, BIMODAL_TABLE_SIZE>> bimodal_table;
+
+// Keep the counters in checkpoints
+champsim::checkpoint_archive::participant bimodal_checkpoint {[](champsim::checkpoint_archive& archive)
+    {
+        for (auto& [cpu, table] : ::bimodal_table)
+        {
+            if (archive.section("cpu" + std::to_string(cpu->cpu) + ".bimodal"))
+                archive & table;
+        }
+    }};
 } // namespace
 
 void O3_CPU::bpred_branchDbimodal_initialize_branch_predictor()
@@ -22,6 +32,9 @@ void O3_CPU::bpred_branchDbimodal_initialize_branch_predictor()
 #else
     std::cout << "CPU " << cpu << " Bimodal branch predictor" << std::endl;
 #endif
+
+    // Add the table before the CPUs may predict on several threads
+    ::bimodal_table[this];
 }
 
 uint8_t O3_CPU::bpred_branchDbimodal_predict_branch(uint64_t ip)
@@ -114,6 +114,16 @@ std::map<O3_CPU*, std::deque<perceptron_state>> perceptron_state_buf;   // state
 std::map<O3_CPU*, std::bitset<PERCEPTRON_HISTORY>> spec_global_history; // speculative global history - updated by predictor
 std::map<O3_CPU*, std::bitset<PERCEPTRON_HISTORY>> global_history;      // real global history - updated when the predictor is
                                                                         // updated
+
+// Keep the perceptrons, the histories and the pending updates in checkpoints
+champsim::checkpoint_archive::participant perceptron_checkpoint {[](champsim::checkpoint_archive& archive)
+    {
+        for (auto& [cpu, table] : ::perceptrons)
+        {
+            if (archive.section("cpu" + std::to_string(cpu->cpu) + ".perceptron"))
+                archive & table & ::perceptron_state_buf[cpu] & ::spec_global_history[cpu] & ::global_history[cpu];
+        }
+    }};
 } // namespace
 
 void O3_CPU::bpred_branchDperceptron_initialize_branch_predictor()
@@ -123,6 +133,12 @@ void O3_CPU::bpred_branchDperceptron_initialize_branch_predictor()
 #else
     std::cout << "CPU " << cpu << " Perceptron branch predictor" << std::endl;
 #endif
+
+    // Add the perceptrons and the histories before the CPUs may predict on several threads
+    ::perceptrons[this];
+    ::perceptron_state_buf[this];
+    ::spec_global_history[this];
+    ::global_history[this];
 }
 
 uint8_t O3_CPU::bpred_branchDperceptron_predict_branch(uint64_t ip)
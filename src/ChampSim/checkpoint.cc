@@ -0,0 +1,276 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ChampSim/checkpoint.h"
+
+#include <fmt/core.h>
+#include <sys/stat.h>
+
+#include <cassert>
+#include <cstring>
+#include <fstream>
+
+#include "ChampSim/champsim.h"
+#include "ChampSim/vmem.h"
+
+#if (USER_CODES == ENABLE)
+
+namespace
+{
+// The first bytes of a checkpoint file, bumped whenever the layout of the archived state changes
+constexpr char CHECKPOINT_MAGIC[] = "ChampSim checkpoint 2";
+
+template<typename T>
+void write_value(std::ofstream& file, const T& value)
+{
+    file.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template<typename T>
+void read_value(std::ifstream& file, T& value)
+{
+    file.read(reinterpret_cast<char*>(&value), sizeof(T));
+}
+
+// Archive the state of every component of the environment
+void checkpoint_environment(champsim::environment& env, champsim::checkpoint_archive& archive)
+{
+    for (O3_CPU& cpu : env.cpu_view())
+    {
+        if (archive.section(fmt::format("cpu{}", cpu.cpu)))
+            archive & cpu;
+    }
+
+    for (CACHE& cache : env.cache_view())
+    {
+        if (archive.section(cache.NAME))
+            archive & cache;
+    }
+
+    for (PageTableWalker& ptw : env.ptw_view())
+    {
+        if (archive.section(ptw.NAME))
+            archive & ptw;
+    }
+
+    // The page table walkers share the virtual memory
+    if (auto ptws = env.ptw_view(); ! std::empty(ptws) && archive.section("vmem"))
+        archive & *ptws.front().get().vmem;
+
+    if (archive.section("memory_controller"))
+        archive & env.dram_view();
+
+    archive.checkpoint_participants();
+}
+
+// Save the name (without its directory) and the size of the trace of each CPU, or check that they are the same when restoring, since the
+// restored state is only meaningful with the traces it was simulated from
+void checkpoint_traces(champsim::environment& env, champsim::checkpoint_archive& archive, const champsim::phase_info& phase)
+{
+    if (! archive.is_saving() && ! archive.has_section("traces"))
+    {
+        std::printf("%s: The checkpoint has no traces to check.\n", __func__);
+        abort();
+    }
+
+    archive.section("traces");
+    for (O3_CPU& cpu : env.cpu_view())
+    {
+        auto trace_name = phase.trace_names.at(phase.trace_index.at(cpu.cpu));
+        auto base_name  = trace_name.substr(trace_name.find_last_of('/') + 1);
+
+        // A synthetic trace, a pipe or a FIFO has no size
+        struct stat status;
+        uint64_t size = (stat(trace_name.c_str(), &status) == 0 && S_ISREG(status.st_mode)) ? static_cast<uint64_t>(status.st_size) : 0;
+
+        auto saved_name = base_name;
+        auto saved_size = size;
+        archive & saved_name & saved_size;
+        if (saved_name != base_name || saved_size != size)
+        {
+            std::printf("%s: The checkpoint was taken with trace %s (%lu bytes) on CPU %u, not %s (%lu bytes).\n", __func__, saved_name.c_str(), saved_size,
+                cpu.cpu, base_name.c_str(), size);
+            abort();
+        }
+    }
+}
+} // namespace
+
+champsim::checkpoint_archive::checkpoint_archive(const std::string& file_name): saving(false)
+{
+    std::ifstream file {file_name, std::ios::binary};
+    if (! file)
+    {
+        std::printf("%s: Cannot open checkpoint %s.\n", __func__, file_name.c_str());
+        abort();
+    }
+
+    char magic[sizeof(CHECKPOINT_MAGIC)] = {};
+    file.read(magic, sizeof(magic));
+    if (std::memcmp(magic, CHECKPOINT_MAGIC, sizeof(magic)) != 0)
+    {
+        std::printf("%s: %s is not a checkpoint of this version.\n", __func__, file_name.c_str());
+        abort();
+    }
+
+    uint64_t number_of_sections = 0;
+    read_value(file, number_of_sections);
+    for (uint64_t i = 0; i < number_of_sections; i++)
+    {
+        uint64_t name_size = 0, data_size = 0;
+        read_value(file, name_size);
+        std::string name(name_size, '\0');
+        file.read(std::data(name), name_size);
+
+        read_value(file, data_size);
+        auto& data = sections[name];
+        data.resize(data_size);
+        file.read(std::data(data), data_size);
+    }
+
+    if (! file)
+    {
+        std::printf("%s: Checkpoint %s is truncated.\n", __func__, file_name.c_str());
+        abort();
+    }
+}
+
+void champsim::checkpoint_archive::write(const std::string& file_name) const
+{
+    std::ofstream file {file_name, std::ios::binary};
+    file.write(CHECKPOINT_MAGIC, sizeof(CHECKPOINT_MAGIC));
+
+    write_value(file, uint64_t {std::size(sections)});
+    for (auto& [name, data] : sections)
+    {
+        write_value(file, uint64_t {std::size(name)});
+        file.write(std::data(name), std::size(name));
+        write_value(file, uint64_t {std::size(data)});
+        file.write(std::data(data), std::size(data));
+    }
+
+    if (! file)
+    {
+        std::printf("%s: Cannot write checkpoint %s.\n", __func__, file_name.c_str());
+        abort();
+    }
+}
+
+bool champsim::checkpoint_archive::section(const std::string& name)
+{
+    close_section();
+    current_name = name;
+
+    if (saving)
+    {
+        current = &sections[name];
+        assert(std::empty(*current)); // Each section is saved once
+    }
+    else
+    {
+        auto found = sections.find(name);
+        if (found == std::end(sections))
+        {
+            fmt::print("Checkpoint has no state of {}, which starts from its initial state.\n", name);
+            current = nullptr;
+            return false;
+        }
+        current = &found->second;
+    }
+
+    position = 0;
+    return true;
+}
+
+void champsim::checkpoint_archive::close_section()
+{
+    if (! saving && current != nullptr && position != std::size(*current))
+    {
+        std::printf("%s: The section %s of the checkpoint has %zu bytes left over, so it is out of date.\n", __func__, current_name.c_str(),
+            std::size(*current) - position);
+        abort();
+    }
+
+    current = nullptr;
+}
+
+void champsim::checkpoint_archive::bytes(void* data, std::size_t size)
+{
+    if (current == nullptr)
+    {
+        std::printf("%s: The state is checkpointed outside a section.\n", __func__);
+        abort();
+    }
+
+    if (saving)
+    {
+        auto begin = static_cast<const char*>(data);
+        current->insert(std::end(*current), begin, begin + size);
+    }
+    else
+    {
+        if (position + size > std::size(*current))
+        {
+            std::printf("%s: The section %s of the checkpoint is truncated or out of date.\n", __func__, current_name.c_str());
+            abort();
+        }
+        std::memcpy(data, std::data(*current) + position, size);
+        position += size;
+    }
+}
+
+void champsim::checkpoint_archive::checkpoint_participants()
+{
+    for (auto& participant : participants())
+        participant(*this);
+}
+
+std::vector<champsim::checkpoint_archive::participant_type>& champsim::checkpoint_archive::participants()
+{
+    static std::vector<participant_type> registered {};
+    return registered;
+}
+
+void champsim::checkpoint_archive::mismatch(const std::string& what) const
+{
+    std::printf("%s: The checkpoint has a different %s from this configuration.\n", __func__, what.c_str());
+    abort();
+}
+
+void champsim::save_checkpoint(environment& env, const std::string& file_name, const phase_info& phase)
+{
+    checkpoint_archive archive {};
+    checkpoint_traces(env, archive, phase);
+    checkpoint_environment(env, archive);
+    archive.close_section();
+    archive.write(file_name);
+}
+
+void champsim::restore_checkpoint(environment& env, const std::string& file_name, const phase_info& phase, std::vector<tracereader>& traces)
+{
+    checkpoint_archive archive {file_name};
+    checkpoint_traces(env, archive, phase);
+    checkpoint_environment(env, archive);
+    archive.close_section();
+
+    // Resume each trace after the instructions retired before the checkpoint. The instructions still in flight then are read again.
+    for (O3_CPU& cpu : env.cpu_view())
+    {
+        traces.at(phase.trace_index.at(cpu.cpu)).skip(cpu.num_retired);
+    }
+}
+
+#endif // USER_CODES
@@ -25,12 +25,1747 @@
 #include "ChampSim/champsim_constants.h"
 #include "ChampSim/deadlock.h"
 #include "ChampSim/instruction.h"
+#include "ChampSim/memory_trace.h"
+#include "ChampSim/profiler.h"
 #include "ChampSim/util/span.h"
 #include "ProjectConfiguration.h" // User file
 
 #if (USER_CODES == ENABLE)
 
 #if (RAMULATOR == ENABLE)
+#if (PRINT_MEMORY_TRACE == ENABLE)
+// The access type of the load or store causing the request, as the OS-transparent management tracks it when it can
+static uint8_t memory_trace_origin(const champsim::channel::request_type& packet)
+{
+#if (MEMORY_USE_OS_TRANSPARENT_MANAGEMENT == ENABLE) && (TRACKING_LOAD_STORE_STATISTICS == ENABLE)
+    return static_cast<uint8_t>(packet.type_origin);
+#else
+    return static_cast<uint8_t>(packet.type);
+#endif // MEMORY_USE_OS_TRANSPARENT_MANAGEMENT, TRACKING_LOAD_STORE_STATISTICS
+}
+#endif // PRINT_MEMORY_TRACE
+
+std::string memory_checkpoint_section(uint8_t memory_id, const ramulator::MemoryBase& memory)
+{
+    std::string name = fmt::format("memory_controller.memory{}.{}", memory_id, memory.standard());
+    for (auto bits : memory.address_bits())
+        name += fmt::format(".{}", bits);
+    return name;
+}
+
+#if (MEMORY_USE_OS_TRANSPARENT_MANAGEMENT == ENABLE)
+// Where --profile counts the time of the hooks of the OS-transparent management
+static champsim::profiler::entry& profiled_cold_data_detection      = champsim::profiler::get("OS_TRANSPARENT_MANAGEMENT::cold_data_detection");
+static champsim::profiler::entry& profiled_memory_activity_tracking = champsim::profiler::get("OS_TRANSPARENT_MANAGEMENT::memory_activity_tracking");
+
+// Whether the memory controller reads the Location Entry and Data (LEAD) in fast memory before the data, as COLOCATED_LINE_LOCATION_TABLE does
+static bool colocated_line_location_table()
+{
+    return project_configuration.research_proposal == ResearchProposal::ColocatedLineLocationTable;
+}
+
+// The research proposal keeps its own section, so that a checkpoint of another research proposal leaves it cold
+static std::string os_transparent_management_checkpoint_section(uint64_t max_address, uint64_t fast_memory_max_address)
+{
+    const char* name = "";
+    switch (project_configuration.research_proposal)
+    {
+    case ResearchProposal::IdealLineLocationTable:
+        name = "ideal_line_location_table";
+        break;
+    case ResearchProposal::ColocatedLineLocationTable:
+        name = "colocated_line_location_table";
+        break;
+    case ResearchProposal::IdealVariableGranularity:
+        name = "ideal_variable_granularity";
+        break;
+    case ResearchProposal::IdealSingleMemPod:
+        name = "ideal_single_mempod";
+        break;
+    }
+    return fmt::format("memory_controller.os_transparent_management.{}.{}.{}", name, max_address, fast_memory_max_address);
+}
+#endif // MEMORY_USE_OS_TRANSPARENT_MANAGEMENT
+
+#if (MEMORY_USE_HYBRID == ENABLE)
+MEMORY_CONTROLLER::MEMORY_CONTROLLER(double freq_scale, double clock_scale, double clock_scale2, std::vector<channel_type*>&& ul, ramulator::MemoryBase& memory, ramulator::MemoryBase& memory2)
+#if (MEMORY_USE_OS_TRANSPARENT_MANAGEMENT == ENABLE)
+: champsim::operable(freq_scale), clock_scale(clock_scale), clock_scale2(clock_scale2),
+  queues(std::move(ul)), memory(memory), memory2(memory2),
+  os_transparent_management(*make_os_transparent_management(memory.max_address + memory2.max_address, memory.max_address))
+#else
+: champsim::operable(freq_scale), clock_scale(clock_scale), clock_scale2(clock_scale2),
+  queues(std::move(ul)), memory(memory), memory2(memory2)
+#endif // MEMORY_USE_OS_TRANSPARENT_MANAGEMENT
+{
+    std::printf("clock_scale: %f, clock_scale2: %f.\n", clock_scale, clock_scale2);
+
+#if (MEMORY_USE_SWAPPING_UNIT == ENABLE)
+    swapping_count = swapping_traffic_in_bytes = 0;
+#endif // MEMORY_USE_SWAPPING_UNIT
+
+#if (TRACKING_LOAD_STORE_STATISTICS == ENABLE)
+    load_request_in_memory = load_request_in_memory2 = 0;
+    store_request_in_memory = store_request_in_memory2 = 0;
+#endif // TRACKING_LOAD_STORE_STATISTICS
+
+    read_request_in_memory = read_request_in_memory2 = 0;
+    write_request_in_memory = write_request_in_memory2 = 0;
+
+#if (MEMORY_USE_SWAPPING_UNIT == ENABLE)
+    buffer.resize(project_configuration.swapping_buffer_entry_number);
+    initialize_swapping();
+
+#if (TEST_SWAPPING_UNIT == ENABLE)
+    for (auto i = 0; i < MEMORY_DATA_NUMBER; i++)
+    {
+        memory_data[i][0] = i;
+    }
+#endif // TEST_SWAPPING_UNIT
+#endif // MEMORY_USE_SWAPPING_UNIT
+}
+
+MEMORY_CONTROLLER::~MEMORY_CONTROLLER()
+{
+// Print information to output_statistics
+#if (MEMORY_USE_SWAPPING_UNIT == ENABLE)
+    output_statistics.swapping_count            = swapping_count;
+    output_statistics.swapping_traffic_in_bytes = swapping_traffic_in_bytes;
+#endif // MEMORY_USE_SWAPPING_UNIT
+
+#if (TRACKING_LOAD_STORE_STATISTICS == ENABLE)
+    output_statistics.load_request_in_memory   = load_request_in_memory;
+    output_statistics.store_request_in_memory  = store_request_in_memory;
+    output_statistics.load_request_in_memory2  = load_request_in_memory2;
+    output_statistics.store_request_in_memory2 = store_request_in_memory2;
+#endif // TRACKING_LOAD_STORE_STATISTICS
+
+    output_statistics.read_request_in_memory   = read_request_in_memory;
+    output_statistics.read_request_in_memory2  = read_request_in_memory2;
+    output_statistics.write_request_in_memory  = write_request_in_memory;
+    output_statistics.write_request_in_memory2 = write_request_in_memory2;
+
+#if (MEMORY_USE_OS_TRANSPARENT_MANAGEMENT == ENABLE)
+    delete &os_transparent_management;
+#endif // MEMORY_USE_OS_TRANSPARENT_MANAGEMENT
+}
+
+void MEMORY_CONTROLLER::initialize()
+{
+    long long int dram_size = (memory.max_address + memory2.max_address) / MiB; // in MiB
+
+    fmt::print("Memory Subsystem Size: ");
+#if (PRINT_STATISTICS_INTO_FILE == ENABLE)
+    std::fprintf(output_statistics.file_handler, "Memory Subsystem Size: ");
+#endif // PRINT_STATISTICS_INTO_FILE
+
+    if (dram_size > 1024)
+    {
+        fmt::print("{} GiB", dram_size / 1024);
+#if (PRINT_STATISTICS_INTO_FILE == ENABLE)
+        std::fprintf(output_statistics.file_handler, "%lld GiB", dram_size / 1024);
+#endif // PRINT_STATISTICS_INTO_FILE
+    }
+    else
+    {
+        fmt::print("{} MiB", dram_size);
+#if (PRINT_STATISTICS_INTO_FILE == ENABLE)
+        std::fprintf(output_statistics.file_handler, "%lld MiB", dram_size);
+#endif // PRINT_STATISTICS_INTO_FILE
+    }
+
+    fmt::print("\n");
+#if (PRINT_STATISTICS_INTO_FILE == ENABLE)
+    std::fprintf(output_statistics.file_handler, "\n");
+#endif // PRINT_STATISTICS_INTO_FILE
+}
+
+long MEMORY_CONTROLLER::operate()
+{
+    long progress {0};
+
+    initiate_requests();
+
+    /* Operate research proposals below */
+#if (MEMORY_USE_OS_TRANSPARENT_MANAGEMENT == ENABLE)
+    {
+        champsim::profiler::scope profile {profiled_cold_data_detection};
+        os_transparent_management.cold_data_detection();
+    }
+
+    // The incomplete requests are only queued by COLOCATED_LINE_LOCATION_TABLE
+    for (size_t i = 0; i < os_transparent_management.incomplete_read_request_queue.size(); i++)
+    {
+        if (os_transparent_management.incomplete_read_request_queue[i].fm_access_finish) // This read request is ready to access slow memory
+        {
+            request_type packet              = os_transparent_management.incomplete_read_request_queue[i].packet;
+
+            DRAM_CHANNEL::request_type rq_it = DRAM_CHANNEL::request_type {packet};
+            rq_it.forward_checked            = false;
+            rq_it.event_cycle                = current_cycle;
+            if (packet.response_requested)
+                rq_it.to_return = {&(queues.at(packet.cpu)->returned)}; // Store the response queue to communicate with the LLC
+
+            /* Send memory request below */
+            bool stall       = true;
+
+            uint64_t address = packet.h_address;
+            if ((memory.max_address <= address) && (address < memory.max_address + memory2.max_address))
+            {
+                // The memory itself doesn't know other memories' space, so we manage the overall mapping.
+                stall = ! send_read(memory2, address - memory.max_address, rq_it, packet.cpu, memory2_id);
+
+                if (stall == false)
+                {
+                    read_request_in_memory2++;
+                    os_transparent_management.incomplete_read_request_queue.erase(os_transparent_management.incomplete_read_request_queue.begin() + i);
+                }
+            }
+            else
+            {
+                std::printf("%s: Error!\n", __FUNCTION__);
+            }
+        }
+    }
+
+    for (size_t i = 0; i < os_transparent_management.incomplete_write_request_queue.size(); i++)
+    {
+        if (os_transparent_management.incomplete_write_request_queue[i].fm_access_finish) // This write request is ready to write memory (fast or slow)
+        {
+            request_type packet              = os_transparent_management.incomplete_write_request_queue[i].packet;
+
+            DRAM_CHANNEL::request_type wq_it = DRAM_CHANNEL::request_type {packet};
+            wq_it.forward_checked            = false;
+            wq_it.event_cycle                = current_cycle;
+
+            /* Send memory request below */
+            bool stall                       = true;
+
+            uint64_t address                 = packet.h_address;
+
+            // Assign the request to the right memory.
+            if (address < memory.max_address)
+            {
+                ramulator::Request request(address, ramulator::Request::Type::WRITE, NULL, packet.cpu, memory_id);
+                stall = ! memory.send(std::move(request));
+
+                if (stall == false)
+                {
+                    write_request_in_memory++;
+                    os_transparent_management.incomplete_write_request_queue.erase(os_transparent_management.incomplete_write_request_queue.begin() + i);
+                }
+            }
+            else if (address < memory.max_address + memory2.max_address)
+            {
+                // The memory itself doesn't know other memories' space, so we manage the overall mapping.
+                ramulator::Request request(address - memory.max_address, ramulator::Request::Type::WRITE, NULL, packet.cpu, memory2_id);
+                stall = ! memory2.send(std::move(request));
+
+                if (stall == false)
+                {
+                    write_request_in_memory2++;
+                    os_transparent_management.incomplete_write_request_queue.erase(os_transparent_management.incomplete_write_request_queue.begin() + i);
+                }
+            }
+            else
+            {
+                std::printf("%s: Error!\n", __FUNCTION__);
+            }
+        }
+    }
+#endif // MEMORY_USE_OS_TRANSPARENT_MANAGEMENT
+
+#if (MEMORY_USE_SWAPPING_UNIT == ENABLE)
+    /* Operate swapping below */
+    uint8_t swapping_states = operate_swapping();
+    switch (swapping_states)
+    {
+    case 0: // The swapping unit is idle
+    {
+#if (MEMORY_USE_OS_TRANSPARENT_MANAGEMENT == ENABLE)
+        OS_TRANSPARENT_MANAGEMENT::RemappingRequest remapping_request;
+        bool issue = os_transparent_management.issue_remapping_request(remapping_request);
+        if (issue == true) // Get a new remapping request.
+        {
+            start_swapping_segments(remapping_request.address_in_fm, remapping_request.address_in_sm, remapping_request.size);
+        }
+#endif // MEMORY_USE_OS_TRANSPARENT_MANAGEMENT
+    }
+    break;
+    case 1: // The swapping unit is busy
+    {
+#if (MEMORY_USE_OS_TRANSPARENT_MANAGEMENT == ENABLE)
+        OS_TRANSPARENT_MANAGEMENT::RemappingRequest remapping_request;
+        bool issue = os_transparent_management.issue_remapping_request(remapping_request);
+        if (issue == true) // Get a remapping request.
+        {
+            // In case the swapping segments are updated
+            update_swapping_segments(remapping_request.address_in_fm, remapping_request.address_in_sm, remapping_request.size);
+        }
+        else
+        {
+            std::cout << __func__ << ": issue_remapping_request error." << std::endl;
+            assert(false);
+        }
+#endif // MEMORY_USE_OS_TRANSPARENT_MANAGEMENT
+    }
+    break;
+    case 2: // The swapping unit finishes a swapping request
+    {
+#if (MEMORY_USE_OS_TRANSPARENT_MANAGEMENT == ENABLE)
+        bool is_updated = false;
+        OS_TRANSPARENT_MANAGEMENT::RemappingRequest remapping_request;
+        bool issue = os_transparent_management.issue_remapping_request(remapping_request);
+        if (issue == true) // Get a remapping request.
+        {
+            // In case the swapping segments are updated
+            is_updated = update_swapping_segments(remapping_request.address_in_fm, remapping_request.address_in_sm, remapping_request.size);
+        }
+        else
+        {
+            std::cout << __func__ << ": issue_remapping_request error 2." << std::endl;
+            assert(false);
+        }
+
+        if (is_updated == false)
+        {
+            os_transparent_management.finish_remapping_request();
+            initialize_swapping();
+        }
+#else
+
+        initialize_swapping();
+#endif // MEMORY_USE_OS_TRANSPARENT_MANAGEMENT
+    }
+    break;
+    default:
+        break;
+    }
+#else
+
+#if (MEMORY_USE_OS_TRANSPARENT_MANAGEMENT == ENABLE)
+    // Since we don't consider data swapping overhead here, the data swapping is finished immediately
+    OS_TRANSPARENT_MANAGEMENT::RemappingRequest remapping_request;
+    bool issue = os_transparent_management.issue_remapping_request(remapping_request);
+    if (issue == true) // Get a new remapping request.
+    {
+        os_transparent_management.finish_remapping_request();
+    }
+#endif // MEMORY_USE_OS_TRANSPARENT_MANAGEMENT
+#endif // MEMORY_USE_SWAPPING_UNIT
+
+#if (MEMORY_USE_OS_TRANSPARENT_MANAGEMENT == ENABLE) && (MEMORY_USE_SWAPPING_UNIT == ENABLE)
+    os_transparent_management.check_interval_swap(swapping_states, warmup);
+#endif // MEMORY_USE_OS_TRANSPARENT_MANAGEMENT, MEMORY_USE_SWAPPING_UNIT
+
+    /* Operate memories below */
+    // Skip periodically
+    if (leap_operation_memory >= 1)
+    {
+        leap_operation_memory -= 1;
+    }
+    else
+    {
+        memory.tick();
+        drain_completions(memory);
+        leap_operation_memory += clock_scale;
+    }
+
+    if (leap_operation_memory2 >= 1)
+    {
+        leap_operation_memory2 -= 1;
+    }
+    else
+    {
+        memory2.tick();
+        drain_completions(memory2);
+        leap_operation_memory2 += clock_scale2;
+    }
+
+    Stats::curTick++; // Processor clock, global, for Statistics
+
+    return ++progress;
+}
+
+void MEMORY_CONTROLLER::begin_phase()
+{
+    for (auto ul : queues)
+    {
+        channel_type::stats_type ul_new_roi_stats, ul_new_sim_stats;
+        ul->roi_stats = ul_new_roi_stats;
+        ul->sim_stats = ul_new_sim_stats;
+    }
+}
+
+void MEMORY_CONTROLLER::end_phase(unsigned)
+{
+    /** No code here */
+}
+
+#if (IDLE_CYCLE_SKIPPING == ENABLE)
+uint64_t MEMORY_CONTROLLER::idle_cycles(uint64_t bound)
+{
+    // Requests waiting in the channels are handled in the next cycle
+    for (auto ul : queues)
+    {
+        if (! std::empty(ul->RQ) || ! std::empty(ul->WQ) || ! std::empty(ul->PQ))
+            return 0;
+    }
+
+#if (MEMORY_USE_SWAPPING_UNIT == ENABLE)
+    if (states != SwappingState::Idle)
+        return 0;
+#endif // MEMORY_USE_SWAPPING_UNIT
+
+    /* Check research proposals below */
+#if (MEMORY_USE_OS_TRANSPARENT_MANAGEMENT == ENABLE)
+    if (! os_transparent_management.remapping_request_queue.empty())
+        return 0;
+
+    if (! os_transparent_management.incomplete_read_request_queue.empty() || ! os_transparent_management.incomplete_write_request_queue.empty())
+        return 0;
+
+    bound = os_transparent_management.idle_cycles(bound);
+#endif // MEMORY_USE_OS_TRANSPARENT_MANAGEMENT
+
+    /* Check memories below */
+    // Replay the fractional clocks until one memory would tick with something to do
+    long idle_ticks = memory.idle_ticks(), idle_ticks2 = memory2.idle_ticks();
+    double leap = leap_operation_memory, leap2 = leap_operation_memory2;
+
+    auto idle_tick  = [](double& fraction, long& ticks, double scale)
+    {
+        if (fraction >= 1)
+        {
+            fraction -= 1;
+            return true;
+        }
+
+        fraction += scale;
+        return ticks-- > 0;
+    };
+
+    uint64_t cycles = 0;
+    while (cycles < bound && idle_tick(leap, idle_ticks, clock_scale) && idle_tick(leap2, idle_ticks2, clock_scale2))
+        cycles++;
+
+    return cycles;
+}
+
+void MEMORY_CONTROLLER::skip_cycles(uint64_t cycles)
+{
+    long ticks = 0, ticks2 = 0;
+    for (uint64_t i = 0; i < cycles; i++)
+    {
+        if (leap_operation_memory >= 1)
+        {
+            leap_operation_memory -= 1;
+        }
+        else
+        {
+            ticks++;
+            leap_operation_memory += clock_scale;
+        }
+
+        if (leap_operation_memory2 >= 1)
+        {
+            leap_operation_memory2 -= 1;
+        }
+        else
+        {
+            ticks2++;
+            leap_operation_memory2 += clock_scale2;
+        }
+    }
+
+    memory.skip_ticks(ticks);
+    memory2.skip_ticks(ticks2);
+
+#if (MEMORY_USE_OS_TRANSPARENT_MANAGEMENT == ENABLE)
+    os_transparent_management.cycle += cycles;
+#endif // MEMORY_USE_OS_TRANSPARENT_MANAGEMENT
+
+    Stats::curTick += cycles;
+    current_cycle += cycles;
+}
+#endif // IDLE_CYCLE_SKIPPING
+
+void MEMORY_CONTROLLER::checkpoint(champsim::checkpoint_archive& archive)
+{
+    champsim::operable::checkpoint(archive);
+    archive & leap_operation_memory & leap_operation_memory2;
+
+    // The memories keep their own sections, so that a checkpoint of other memories (e.g., in a sweep of the memory configurations) leaves them cold
+    if (archive.section(memory_checkpoint_section(memory_id, memory)))
+        archive & memory;
+    if (archive.section(memory_checkpoint_section(memory2_id, memory2)))
+        archive & memory2;
+
+#if (MEMORY_USE_OS_TRANSPARENT_MANAGEMENT == ENABLE)
+    if (archive.section(os_transparent_management_checkpoint_section(memory.max_address + memory2.max_address, memory.max_address)))
+        archive & os_transparent_management;
+#endif // MEMORY_USE_OS_TRANSPARENT_MANAGEMENT
+}
+
+// LCOV_EXCL_START Exclude the following function from LCOV
+void MEMORY_CONTROLLER::print_deadlock()
+{
+    std::printf("MEMORY_CONTROLLER %s.\n", __func__);
+
+#if (MEMORY_USE_SWAPPING_UNIT == ENABLE)
+    std::printf("base_address[0]: %ld, base_address[1]: %ld.\n", base_address[0], base_address[1]);
+#endif // MEMORY_USE_SWAPPING_UNIT
+}
+
+// LCOV_EXCL_STOP
+
+std::size_t MEMORY_CONTROLLER::size() const
+{
+    return (memory.max_address + memory2.max_address);
+}
+
+void MEMORY_CONTROLLER::initiate_requests()
+{
+    // Initiate read requests
+    for (auto ul : queues)
+    {
+        for (auto q : {std::ref(ul->RQ), std::ref(ul->PQ)})
+        {
+            auto [begin, end] = champsim::get_span_p(std::cbegin(q.get()), std::cend(q.get()), [ul, this](const auto& pkt)
+                { 
+                    request_type packet = pkt;
+                    return this->add_rq(packet, ul); }); // Add read requests
+            q.get().erase(begin, end);
+        }
+
+        // Initiate write requests
+        auto [wq_begin, wq_end] = champsim::get_span_p(std::cbegin(ul->WQ), std::cend(ul->WQ), [this](const auto& pkt)
+            { 
+                request_type packet = pkt;
+                return this->add_wq(packet); }); // Add write requests
+        ul->WQ.erase(wq_begin, wq_end);
+    }
+}
+
+bool MEMORY_CONTROLLER::add_rq(request_type& packet, champsim::channel* ul)
+{
+    const static ramulator::Request::Type type = ramulator::Request::Type::READ; // It means the input request is read request.
+
+#if (TRACKING_LOAD_STORE_STATISTICS == ENABLE)
+    access_type type_origin = packet.type_origin;
+#endif // TRACKING_LOAD_STORE_STATISTICS
+
+    /* Operate research proposals below */
+#if (MEMORY_USE_OS_TRANSPARENT_MANAGEMENT == ENABLE)
+    os_transparent_management.physical_to_hardware_address(packet);
+    {
+        champsim::profiler::scope profile {profiled_memory_activity_tracking};
+#if (TRACKING_LOAD_STORE_STATISTICS == ENABLE)
+        os_transparent_management.memory_activity_tracking(packet.address, type, packet.type_origin, float(get_occupancy(type, packet.address)) / get_size(type, packet.address));
+#else
+        os_transparent_management.memory_activity_tracking(packet.address, type, float(get_occupancy(type, packet.address)) / get_size(type, packet.address));
+#endif // TRACKING_LOAD_STORE_STATISTICS
+    }
+#endif // MEMORY_USE_OS_TRANSPARENT_MANAGEMENT
+
+#if (MEMORY_USE_SWAPPING_UNIT == ENABLE)
+    /* Check swapping below */
+    uint8_t under_swapping = check_request(packet, type);
+    switch (under_swapping)
+    {
+    case 0: // This address is under swapping.
+    {
+        return false; // Queue is full, note Ramulator doesn't merge requests.
+    }
+    break;
+    case 1: // This address is not under swapping.
+        break;
+    case 2: // Though this address is under swapping, we can service its request because the data is in the swapping buffer.
+    {
+        response_type response {packet.address, packet.v_address, packet.data, packet.pf_metadata, packet.instr_depend_on_me};
+
+        for (auto ret : {&ul->returned})
+        {
+            ret->push_back(response); // Fill the response into the response queue
+        }
+
+        return true; // Fast-forward
+    }
+    break;
+    default:
+        break;
+    }
+#endif // MEMORY_USE_SWAPPING_UNIT
+
+    DRAM_CHANNEL::request_type rq_it = DRAM_CHANNEL::request_type {packet};
+    rq_it.forward_checked            = false;
+    rq_it.event_cycle                = current_cycle;
+    if (packet.response_requested)
+        rq_it.to_return = {&ul->returned}; // Store the response queue to communicate with the LLC
+
+    /* Send memory request below */
+    bool stall = true;
+
+    uint64_t address;
+#if (MEMORY_USE_OS_TRANSPARENT_MANAGEMENT == ENABLE)
+    address = rq_it.h_address = packet.h_address;
+    bool is_sm_request = false; // Whether this request is mapped in slow memory according to the LLT.
+    if (colocated_line_location_table() && (memory.max_address <= address))
+    {
+        is_sm_request = true;
+        address = rq_it.h_address_fm = packet.h_address_fm; // Pretend to access the Location Entry and Data (LEAD) in fast memory
+
+        if (memory.max_address <= address)
+        {
+            std::cout << __func__ << ": co_located LLT error, h_address_fm is uncorrect." << std::endl;
+            abort();
+        }
+
+        // Check incomplete_read_request_queue's size
+        if (os_transparent_management.incomplete_read_request_queue.size() >= INCOMPLETE_READ_REQUEST_QUEUE_LENGTH)
+        {
+            return false;
+        }
+    }
+
+#else
+    address = packet.address;
+#endif // MEMORY_USE_OS_TRANSPARENT_MANAGEMENT
+
+    // Assign the request to the right memory.
+    if (address < memory.max_address)
+    {
+        stall = ! send_read(memory, address, rq_it, packet.cpu, memory_id);
+
+        if (stall == false)
+        {
+            read_request_in_memory++;
+
+#if (TRACKING_LOAD_STORE_STATISTICS == ENABLE)
+            if (warmup == false)
+            {
+                if (type_origin == access_type::LOAD || type_origin == access_type::TRANSLATION)
+                {
+                    load_request_in_memory++;
+                }
+                else if (type_origin == access_type::RFO)
+                {
+                    store_request_in_memory++;
+                }
+            }
+#endif // TRACKING_LOAD_STORE_STATISTICS
+
+#if (MEMORY_USE_OS_TRANSPARENT_MANAGEMENT == ENABLE)
+            if (is_sm_request)
+            {
+                read_request_in_memory--;
+
+                OS_TRANSPARENT_MANAGEMENT::ReadRequest read_request;
+                // Create new read_request
+                read_request.packet           = packet;
+                read_request.fm_access_finish = false;
+
+                os_transparent_management.incomplete_read_request_queue.push_back(read_request);
+            }
+#endif // MEMORY_USE_OS_TRANSPARENT_MANAGEMENT
+        }
+    }
+    else if (address < memory.max_address + memory2.max_address)
+    {
+        // The memory itself doesn't know other memories' space, so we manage the overall mapping.
+        stall = ! send_read(memory2, address - memory.max_address, rq_it, packet.cpu, memory2_id);
+
+        if (stall == false)
+        {
+            read_request_in_memory2++;
+        }
+
+#if (TRACKING_LOAD_STORE_STATISTICS == ENABLE)
+        if (type_origin == access_type::LOAD || type_origin == access_type::TRANSLATION)
+        {
+            load_request_in_memory2++;
+        }
+        else if (type_origin == access_type::RFO)
+        {
+            store_request_in_memory2++;
+        }
+        else
+        {
+            std::printf("%s: Error!\n", __FUNCTION__);
+        }
+#endif // TRACKING_LOAD_STORE_STATISTICS
+    }
+    else
+    {
+        std::printf("%s: Error!\n", __FUNCTION__);
+    }
+
+#if (PRINT_MEMORY_TRACE == ENABLE)
+    // Output memory trace
+    output_memorytrace.output_memory_trace(current_cycle, address, packet.address, 'R', packet.cpu, address < memory.max_address ? memory_id : memory2_id, memory_trace_origin(packet), ! stall);
+#endif // PRINT_MEMORY_TRACE
+
+    if (stall == true)
+    {
+        return false; // Queue is full, note Ramulator doesn't merge requests.
+    }
+    else
+    {
+        return true;
+    }
+}
+
+bool MEMORY_CONTROLLER::add_wq(request_type& packet)
+{
+    const static ramulator::Request::Type type = ramulator::Request::Type::WRITE; // It means the input request is write request.
+
+    /* Operate research proposals below */
+#if (MEMORY_USE_OS_TRANSPARENT_MANAGEMENT == ENABLE)
+    os_transparent_management.physical_to_hardware_address(packet);
+    {
+        champsim::profiler::scope profile {profiled_memory_activity_tracking};
+#if (TRACKING_LOAD_STORE_STATISTICS == ENABLE)
+        os_transparent_management.memory_activity_tracking(packet.address, type, packet.type_origin, float(get_occupancy(type, packet.address)) / get_size(type, packet.address));
+#else
+        os_transparent_management.memory_activity_tracking(packet.address, type, float(get_occupancy(type, packet.address)) / get_size(type, packet.address));
+#endif // TRACKING_LOAD_STORE_STATISTICS
+    }
+#endif // MEMORY_USE_OS_TRANSPARENT_MANAGEMENT
+
+#if (MEMORY_USE_SWAPPING_UNIT == ENABLE)
+    /* Check swapping below */
+    uint8_t under_swapping = check_request(packet, type);
+    switch (under_swapping)
+    {
+    case 0: // This address is under swapping.
+    {
+        return false; // Queue is full, note Ramulator doesn't merge requests.
+    }
+    break;
+    case 1: // This address is not under swapping.
+        break;
+    case 2: // Though this address is under swapping, we can service its request because the data is in the swapping buffer.
+    {
+        return true; // Fast-forward
+    }
+    break;
+    default:
+        break;
+    }
+#endif // MEMORY_USE_SWAPPING_UNIT
+
+    DRAM_CHANNEL::request_type wq_it = DRAM_CHANNEL::request_type {packet};
+    wq_it.forward_checked            = false;
+    wq_it.event_cycle                = current_cycle;
+
+    /* Send memory request below */
+    bool stall                       = true;
+
+    uint64_t address;
+#if (MEMORY_USE_OS_TRANSPARENT_MANAGEMENT == ENABLE)
+    address = wq_it.h_address = packet.h_address;
+    if (colocated_line_location_table())
+    {
+        // Check incomplete_write_request_queue's size
+        if (os_transparent_management.incomplete_write_request_queue.size() >= INCOMPLETE_WRITE_REQUEST_QUEUE_LENGTH)
+        {
+            return false;
+        }
+
+        address = wq_it.h_address_fm = packet.h_address_fm; // Pretend to access the Location Entry and Data (LEAD) in fast memory
+        stall = ! send_read(memory, address, wq_it, packet.cpu, memory_id);
+
+        if (stall == false)
+        {
+            OS_TRANSPARENT_MANAGEMENT::WriteRequest write_request;
+            // Create new write_request
+            write_request.packet           = packet;
+            write_request.fm_access_finish = false;
+
+            os_transparent_management.incomplete_write_request_queue.push_back(write_request);
+
+            return true;
+        }
+        else
+        {
+            return false;
+        }
+    }
+
+#else
+    address = packet.address;
+#endif // MEMORY_USE_OS_TRANSPARENT_MANAGEMENT
+
+    // Assign the request to the right memory.
+    if (address < memory.max_address)
+    {
+        ramulator::Request request(address, type, NULL, packet.cpu, memory_id);
+        stall = ! memory.send(std::move(request));
+
+        if (stall == false)
+        {
+            write_request_in_memory++;
+        }
+    }
+    else if (address < memory.max_address + memory2.max_address)
+    {
+        // The memory itself doesn't know other memories' space, so we manage the overall mapping.
+        ramulator::Request request(address - memory.max_address, type, NULL, packet.cpu, memory2_id);
+        stall = ! memory2.send(std::move(request));
+
+        if (stall == false)
+        {
+            write_request_in_memory2++;
+        }
+    }
+    else
+    {
+        std::printf("%s: Error!\n", __FUNCTION__);
+    }
+
+#if (PRINT_MEMORY_TRACE == ENABLE)
+    // Output memory trace.
+    output_memorytrace.output_memory_trace(current_cycle, address, packet.address, 'W', packet.cpu, address < memory.max_address ? memory_id : memory2_id, memory_trace_origin(packet), ! stall);
+#endif // PRINT_MEMORY_TRACE
+
+    if (stall == true)
+    {
+        return false; // Queue is full, note Ramulator doesn't merge requests.
+    }
+    else
+    {
+        return true;
+    }
+}
+
+#if (FUNCTIONAL_WARMUP == ENABLE)
+void MEMORY_CONTROLLER::functional_access(request_type packet)
+{
+    const ramulator::Request::Type type = (packet.type == access_type::WRITE) ? ramulator::Request::Type::WRITE : ramulator::Request::Type::READ;
+
+    /* Operate research proposals below */
+#if (MEMORY_USE_OS_TRANSPARENT_MANAGEMENT == ENABLE)
+    // The queues are always empty without timing
+    os_transparent_management.physical_to_hardware_address(packet);
+#if (TRACKING_LOAD_STORE_STATISTICS == ENABLE)
+    os_transparent_management.memory_activity_tracking(packet.address, type, packet.type_origin, 0);
+#else
+    os_transparent_management.memory_activity_tracking(packet.address, type, 0);
+#endif // TRACKING_LOAD_STORE_STATISTICS
+
+    // Since no data is moved without timing, the data swapping is finished immediately
+    OS_TRANSPARENT_MANAGEMENT::RemappingRequest remapping_request;
+    while (os_transparent_management.issue_remapping_request(remapping_request))
+    {
+        os_transparent_management.finish_remapping_request();
+    }
+#else
+    (void) type;
+#endif // MEMORY_USE_OS_TRANSPARENT_MANAGEMENT
+}
+#endif // FUNCTIONAL_WARMUP
+
+bool MEMORY_CONTROLLER::send_read(ramulator::MemoryBase& target, uint64_t address, const DRAM_CHANNEL::request_type& packet, uint32_t cpu, uint8_t target_id)
+{
+    ramulator::PacketPool::handle_type handle = packets.acquire(packet);
+    ramulator::Request request(address, ramulator::Request::Type::READ, NULL, handle, cpu, target_id); // The data is returned through the completions of the memory
+    if (target.send(std::move(request)))
+        return true;
+
+    packets.release(handle); // The memory is full, and the packet is sent again later.
+    return false;
+}
+
+void MEMORY_CONTROLLER::drain_completions(ramulator::MemoryBase& target)
+{
+    for (; ! target.completions.empty(); target.completions.pop_front())
+    {
+        ramulator::Request& request = target.completions.front();
+#if (MEMORY_USE_SWAPPING_UNIT == ENABLE)
+        if (request.packet == ramulator::PacketPool::NONE) // Only the reads of the swapping unit have no packet
+        {
+            return_swapping_data(request);
+            continue;
+        }
+#endif // MEMORY_USE_SWAPPING_UNIT
+        return_data(request);
+    }
+}
+
+uint32_t MEMORY_CONTROLLER::get_occupancy(ramulator::Request::Type queue_type, uint64_t address)
+{
+#if (MEMORY_USE_OS_TRANSPARENT_MANAGEMENT == ENABLE)
+    os_transparent_management.physical_to_hardware_address(address);
+#endif // MEMORY_USE_OS_TRANSPARENT_MANAGEMENT
+
+    // Assign the request to the right memory.
+    if (address < memory.max_address)
+    {
+        ramulator::Request request(address, queue_type);
+        return memory.get_queue_occupancy(request);
+    }
+    else if (address < memory.max_address + memory2.max_address)
+    {
+        // The memory itself doesn't know other memories' space, so we manage the overall mapping.
+        ramulator::Request request(address - memory.max_address, queue_type);
+        return memory2.get_queue_occupancy(request);
+    }
+    else
+    {
+        std::printf("%s: Error!\n", __FUNCTION__);
+    }
+
+    return 0;
+};
+
+uint32_t MEMORY_CONTROLLER::get_size(ramulator::Request::Type queue_type, uint64_t address)
+{
+#if (MEMORY_USE_OS_TRANSPARENT_MANAGEMENT == ENABLE)
+    os_transparent_management.physical_to_hardware_address(address);
+#endif // MEMORY_USE_OS_TRANSPARENT_MANAGEMENT
+
+    // Assign the request to the right memory.
+    if (address < memory.max_address)
+    {
+        ramulator::Request request(address, queue_type);
+        return memory.get_queue_size(request);
+    }
+    else if (address < memory.max_address + memory2.max_address)
+    {
+        // The memory itself doesn't know other memories' space, so we manage the overall mapping.
+        ramulator::Request request(address - memory.max_address, queue_type);
+        return memory2.get_queue_size(request);
+    }
+    else
+    {
+        std::printf("%s: Error!\n", __FUNCTION__);
+    }
+
+    return 0;
+};
+
+void MEMORY_CONTROLLER::return_data(ramulator::Request& request)
+{
+    assert(request.packet != ramulator::PacketPool::NONE);
+    const DRAM_CHANNEL::request_type& packet = packets[request.packet];
+
+    // Recover the hardware address to physical address.
+    switch (request.memory_id)
+    {
+    case MEMORY_NUMBER_ONE:
+        // Nothing to do
+        break;
+    case MEMORY_NUMBER_TWO:
+        request.addr += memory.max_address;
+        break;
+    default:
+    {
+        std::cout << __func__ << ": return_data error." << std::endl;
+        assert(false);
+    }
+    break;
+    }
+
+#if (MEMORY_USE_OS_TRANSPARENT_MANAGEMENT == ENABLE)
+    bool finish_return_data = false;
+
+    if (colocated_line_location_table() && (uint64_t(request.addr) < memory.max_address))
+    {
+        // This could be an uncomplete write request
+        bool finish = os_transparent_management.finish_fm_access_in_incomplete_write_request_queue(packet.h_address);
+        if (finish)
+        {
+            finish_return_data = true;
+            packets.release(request.packet);
+            return;
+        }
+    }
+
+    if (colocated_line_location_table() && (uint64_t(request.addr) < memory.max_address) && (memory.max_address <= packet.h_address))
+    {
+        // This could be an uncomplete read request
+        bool finish = os_transparent_management.finish_fm_access_in_incomplete_read_request_queue(packet.h_address);
+
+        if (finish)
+        {
+            finish_return_data = true;
+            packets.release(request.packet);
+            return;
+        }
+    }
+
+    if (finish_return_data == false)
+    {
+        // This is a complete read request
+        response_type response {packet.address, packet.v_address, packet.data, packet.pf_metadata, packet.instr_depend_on_me};
+
+        for (auto ret : packet.to_return)
+        {
+            ret->push_back(response); // Fill the response into the response queue
+        }
+    }
+
+#else
+    response_type response {packet.address, packet.v_address, packet.data, packet.pf_metadata, packet.instr_depend_on_me};
+
+    for (auto ret : packet.to_return)
+    {
+        ret->push_back(response); // Fill the response into the response queue
+    }
+#endif // MEMORY_USE_OS_TRANSPARENT_MANAGEMENT
+
+    packets.release(request.packet);
+};
+
+#if (MEMORY_USE_SWAPPING_UNIT == ENABLE)
+
+// Functions for swapping:
+void MEMORY_CONTROLLER::initialize_swapping()
+{
+    swapping_count += active_entry_number * 2;
+    swapping_traffic_in_bytes += active_entry_number * 2 * BLOCK_SIZE;
+
+    states = SwappingState::Idle;
+    for (std::size_t i = 0; i < std::size(buffer); i++)
+    {
+        buffer[i].finish = false;
+        for (auto j = 0; j < SWAPPING_SEGMENT_NUMBER; j++)
+        {
+            for (uint64_t z = 0; z < BLOCK_SIZE; z++)
+            {
+                buffer[i].data[j][z] = 0;
+            }
+            buffer[i].read_issue[j] = false;
+            buffer[i].read[j]       = false;
+            buffer[i].write[j]      = false;
+            buffer[i].dirty[j]      = false;
+        }
+    }
+
+    for (auto i = 0; i < SWAPPING_SEGMENT_NUMBER; i++)
+    {
+        base_address[i] = 0;
+    }
+    active_entry_number = finish_number = 0;
+}
+
+// Input address should be hardware address and at byte granularity
+bool MEMORY_CONTROLLER::start_swapping_segments(uint64_t address_1, uint64_t address_2, uint8_t size)
+{
+    assert(size <= std::size(buffer));
+
+    if (states == SwappingState::Idle)
+    {
+        states              = SwappingState::Swapping;      // Start swapping.
+        base_address[0]     = address_1 >> LOG2_BLOCK_SIZE; // The single swapping is conducted at cache line granularity.
+        base_address[1]     = address_2 >> LOG2_BLOCK_SIZE;
+        active_entry_number = size;
+    }
+    else
+    {
+        return false; // This swapping unit is busy, it cannot issue new swapping request.
+    }
+    return true; // New swapping is issued.
+}
+
+// Input address should be hardware address and at byte granularity
+bool MEMORY_CONTROLLER::update_swapping_segments(uint64_t address_1, uint64_t address_2, uint8_t size)
+{
+    assert(size <= std::size(buffer));
+
+    uint64_t input_base_address[SWAPPING_SEGMENT_NUMBER];
+
+    input_base_address[0] = address_1 >> LOG2_BLOCK_SIZE;
+    input_base_address[1] = address_2 >> LOG2_BLOCK_SIZE;
+
+    if ((input_base_address[0] == base_address[0]) && (input_base_address[1] == base_address[1]))
+    {
+        // They are same swapping segments
+        if (size > active_entry_number)
+        {
+            // There have new data to swap
+            active_entry_number = size;
+            if (states == SwappingState::Idle)
+            {
+                states = SwappingState::Swapping; // Start swapping.
+            }
+
+            return true; // Update swapping segments
+        }
+    }
+
+    return false;
+}
+
+uint8_t MEMORY_CONTROLLER::operate_swapping()
+{
+    const static int coreid = 0;
+
+    switch (states)
+    {
+    case SwappingState::Idle:
+    {
+        return 0; // Idle
+    }
+    break;
+    case SwappingState::Swapping:
+    {
+        // Issue read requests
+        for (auto i = 0; i < active_entry_number; i++) // Go through the active buffer
+        {
+            if (buffer[i].finish == false)
+            {
+                for (auto j = 0; j < SWAPPING_SEGMENT_NUMBER; j++)
+                {
+                    if (buffer[i].read_issue[j] == false)
+                    {
+                        bool stall       = true;
+                        uint64_t address = (base_address[j] + i) << LOG2_BLOCK_SIZE;
+
+                        // Assign the request to the right memory.
+                        if (address < memory.max_address)
+                        {
+                            ramulator::Request request(address, ramulator::Request::Type::READ, NULL, coreid, memory_id);
+                            stall = ! memory.send(std::move(request));
+                        }
+                        else if (address < memory.max_address + memory2.max_address)
+                        {
+                            // The memory itself doesn't know other memories' space, so we manage the overall mapping.
+                            ramulator::Request request(address - memory.max_address, ramulator::Request::Type::READ, NULL, coreid, memory2_id);
+                            stall = ! memory2.send(std::move(request));
+                        }
+                        else
+                        {
+                            std::printf("%s: Error!\n", __FUNCTION__);
+                        }
+
+#if (PRINT_MEMORY_TRACE == ENABLE)
+                        // Output memory trace.
+                        output_memorytrace.output_memory_trace(current_cycle, address, address, 'R', champsim::memory_trace::NO_CPU, address < memory.max_address ? memory_id : memory2_id,
+                            champsim::memory_trace::ORIGIN_SWAPPING, ! stall);
+#endif // PRINT_MEMORY_TRACE
+
+                        if (stall == true)
+                        {
+                            // Queue is full
+                        }
+                        else
+                        {
+                            buffer[i].read_issue[j] = true;
+                        }
+                    }
+                }
+            }
+        }
+
+        // Issue write requests
+        for (auto i = 0; i < active_entry_number; i++) // Go through the active buffer
+        {
+            if (buffer[i].finish == false)
+            {
+                if ((buffer[i].read[0] == true) && (buffer[i].read[1] == true)) // Read requests are finished
+                {
+                    for (auto j = 0; j < SWAPPING_SEGMENT_NUMBER; j++)
+                    {
+                        if ((buffer[i].write[j] == false) || (buffer[i].dirty[j] == true))
+                        {
+                            bool stall       = true;
+                            uint64_t address = (base_address[j] + i) << LOG2_BLOCK_SIZE;
+
+                            // Assign the request to the right memory.
+                            if (address < memory.max_address)
+                            {
+                                ramulator::Request request(address, ramulator::Request::Type::WRITE, NULL, coreid, memory_id);
+                                // Get data from buffer
+                                request.data = buffer[i].data[j];
+                                stall        = ! memory.send(std::move(request));
+                            }
+                            else if (address < memory.max_address + memory2.max_address)
+                            {
+                                // The memory itself doesn't know other memories' space, so we manage the overall mapping.
+                                ramulator::Request request(address - memory.max_address, ramulator::Request::Type::WRITE, NULL, coreid, memory2_id);
+                                // Get data from buffer
+                                request.data = buffer[i].data[j];
+                                stall        = ! memory2.send(std::move(request));
+                            }
+                            else
+                            {
+                                std::printf("%s: Error!\n", __FUNCTION__);
+                            }
+
+#if (PRINT_MEMORY_TRACE == ENABLE)
+                            // Output memory trace.
+                            output_memorytrace.output_memory_trace(current_cycle, address, address, 'W', champsim::memory_trace::NO_CPU, address < memory.max_address ? memory_id : memory2_id,
+                                champsim::memory_trace::ORIGIN_SWAPPING, ! stall);
+#endif // PRINT_MEMORY_TRACE
+
+                            if (stall == true)
+                            {
+                                // Queue is full
+                            }
+                            else
+                            {
+                                if (buffer[i].write[j] == false)
+                                {
+                                    buffer[i].write[j] = true;
+                                }
+                                if (buffer[i].dirty[j] == true)
+                                {
+                                    buffer[i].dirty[j] = false;
+                                }
+
+#if (TEST_SWAPPING_UNIT == ENABLE)
+                                memory_data[i + j * MEMORY_DATA_NUMBER / 2] = buffer[i].data[j];
+#endif // TEST_SWAPPING_UNIT
+                            }
+                        }
+                    }
+                }
+
+                // Finish swapping
+                if ((buffer[i].write[0] == true) && (buffer[i].write[1] == true))
+                {
+                    buffer[i].finish = true;
+                    finish_number++;
+                }
+            }
+        }
+
+        // Check finish_number
+        if (finish_number == active_entry_number)
+        {
+            states = SwappingState::Idle;
+            return 2; // Finished swapping
+        }
+
+        return 1; // Swapping
+    }
+    break;
+    default:
+        break;
+    }
+
+    return 3; // No meaning, it should never come here.
+}
+
+// This function handles the reads of the swapping unit that memories, like Ramulator, completed.
+void MEMORY_CONTROLLER::return_swapping_data(ramulator::Request& request)
+{
+    // Sanity check
+    // assert(states == SwappingState::Swapping);
+    if (states == SwappingState::Idle)
+    {
+        std::cout << __func__ << ": data is returned while swapping is already finished." << std::endl;
+        return;
+    }
+
+    // Recover the hardware address to physical address.
+    switch (request.memory_id)
+    {
+    case MEMORY_NUMBER_ONE:
+        // Nothing to do
+        break;
+    case MEMORY_NUMBER_TWO:
+        request.addr += memory.max_address;
+        break;
+    default:
+    {
+        std::cout << __func__ << ": swapping error." << std::endl;
+        assert(false);
+    }
+    break;
+    }
+
+    uint64_t address = request.addr >> LOG2_BLOCK_SIZE;
+    uint8_t segment_index;
+    uint8_t entry_index;
+    // Calculate entry index in the fashion of little-endian.
+    if ((base_address[SWAPPING_SEGMENT_ONE] <= address) && (address < (base_address[SWAPPING_SEGMENT_ONE] + active_entry_number)))
+    {
+        segment_index = SWAPPING_SEGMENT_TWO;
+        entry_index   = static_cast<uint8_t>(address - base_address[SWAPPING_SEGMENT_ONE]);
+
+#if (TEST_SWAPPING_UNIT == ENABLE)
+        request.data = memory_data[entry_index];
+#endif // TEST_SWAPPING_UNIT
+    }
+    else if ((base_address[SWAPPING_SEGMENT_TWO] <= address) && (address < (base_address[SWAPPING_SEGMENT_TWO] + active_entry_number)))
+    {
+        segment_index = SWAPPING_SEGMENT_ONE;
+        entry_index   = static_cast<uint8_t>(address - base_address[SWAPPING_SEGMENT_TWO]);
+
+#if (TEST_SWAPPING_UNIT == ENABLE)
+        request.data = memory_data[entry_index + MEMORY_DATA_NUMBER / 2];
+#endif // TEST_SWAPPING_UNIT
+    }
+    else
+    {
+        std::cout << __func__ << ": swapping error." << std::endl;
+        assert(false);
+    }
+
+    // Read data
+    if ((buffer[entry_index].finish == false) && (buffer[entry_index].write[segment_index] == false) && (buffer[entry_index].dirty[segment_index] == false))
+    {
+        buffer[entry_index].data[segment_index] = request.data;
+        buffer[entry_index].read[segment_index] = true;
+    }
+};
+
+uint8_t MEMORY_CONTROLLER::check_request(request_type& packet, ramulator::Request::Type type)
+{
+    uint64_t address;
+#if (MEMORY_USE_OS_TRANSPARENT_MANAGEMENT == ENABLE)
+    address = packet.h_address;
+#else
+    address = packet.address;
+#endif
+
+    address >>= LOG2_BLOCK_SIZE;
+    uint8_t segment_index;
+    uint8_t entry_index;
+    // Calculate entry index in the fashion of little-endian.
+    if ((base_address[SWAPPING_SEGMENT_ONE] <= address) && (address < (base_address[SWAPPING_SEGMENT_ONE] + active_entry_number)))
+    {
+        segment_index = SWAPPING_SEGMENT_ONE;
+        entry_index   = static_cast<uint8_t>(address - base_address[SWAPPING_SEGMENT_ONE]);
+    }
+    else if ((base_address[SWAPPING_SEGMENT_TWO] <= address) && (address < (base_address[SWAPPING_SEGMENT_TWO] + active_entry_number)))
+    {
+        segment_index = SWAPPING_SEGMENT_TWO;
+        entry_index   = static_cast<uint8_t>(address - base_address[SWAPPING_SEGMENT_TWO]);
+    }
+    else
+    {
+        return 1; // This address is not under swapping.
+    }
+
+    if (type == ramulator::Request::Type::READ) // For read request
+    {
+        if ((buffer[entry_index].finish == true) || (buffer[entry_index].read[segment_index] == true) || (buffer[entry_index].write[segment_index] == true) || (buffer[entry_index].dirty[segment_index] == true))
+        {
+            uint64_t& read_data = *((uint64_t*) (&buffer[entry_index].data[segment_index])); // Note the PACKET only has 64 bit data.
+            packet.data         = read_data;
+
+            return 2; // Though this address is under swapping, we can service its request because the data is in the swapping buffer.
+        }
+    }
+    else if (type == ramulator::Request::Type::WRITE) // For write request
+    {
+        if ((buffer[entry_index].read[0] == true) && (buffer[entry_index].read[1] == true))
+        {
+            uint64_t& write_data                     = *((uint64_t*) (&buffer[entry_index].data[segment_index])); // Note the PACKET only has 64 bit data.
+            write_data                               = packet.data;
+            buffer[entry_index].dirty[segment_index] = true;
+
+            if (buffer[entry_index].finish == true)
+            {
+                --finish_number;
+            }
+            buffer[entry_index].finish = false;
+
+            return 2; // Though this address is under swapping, we can service its request because the data is in the swapping buffer.
+        }
+    }
+    else
+    {
+        std::cout << __func__ << ": type input error." << std::endl;
+        assert(false);
+    }
+
+    return 0; // This address is under swapping.
+};
+
+uint8_t MEMORY_CONTROLLER::check_address(uint64_t address, uint8_t type)
+{
+#if (MEMORY_USE_OS_TRANSPARENT_MANAGEMENT == ENABLE)
+    os_transparent_management.physical_to_hardware_address(address);
+#else
+#endif // MEMORY_USE_OS_TRANSPARENT_MANAGEMENT
+
+    address >>= LOG2_BLOCK_SIZE;
+    uint8_t segment_index;
+    uint8_t entry_index;
+    // Calculate entry index in the fashion of little-endian.
+    if ((base_address[SWAPPING_SEGMENT_ONE] <= address) && (address < (base_address[SWAPPING_SEGMENT_ONE] + active_entry_number)))
+    {
+        segment_index = SWAPPING_SEGMENT_ONE;
+        entry_index   = static_cast<uint8_t>(address - base_address[SWAPPING_SEGMENT_ONE]);
+    }
+    else if ((base_address[SWAPPING_SEGMENT_TWO] <= address) && (address < (base_address[SWAPPING_SEGMENT_TWO] + active_entry_number)))
+    {
+        segment_index = SWAPPING_SEGMENT_TWO;
+        entry_index   = static_cast<uint8_t>(address - base_address[SWAPPING_SEGMENT_TWO]);
+    }
+    else
+    {
+        return 1; // This address is not under swapping.
+    }
+
+    if (type == 1) // For read request
+    {
+        if ((buffer[entry_index].finish == true) || (buffer[entry_index].read[segment_index] == true) || (buffer[entry_index].write[segment_index] == true) || (buffer[entry_index].dirty[segment_index] == true))
+        {
+            return 2; // Though this address is under swapping, we can service its request because the data is in the swapping buffer.
+        }
+    }
+    else if (type == 2) // For write request
+    {
+        if ((buffer[entry_index].read[0] == true) && (buffer[entry_index].read[1] == true))
+        {
+            return 2; // Though this address is under swapping, we can service its request because the data is in the swapping buffer.
+        }
+    }
+    else
+    {
+        std::cout << __func__ << ": type input error." << std::endl;
+        assert(false);
+    }
+
+    return 0; // This address is under swapping.
+};
+
+#endif // MEMORY_USE_SWAPPING_UNIT
+
+#else
+
+MEMORY_CONTROLLER::MEMORY_CONTROLLER(double freq_scale, double clock_scale, std::vector<channel_type*>&& ul, ramulator::MemoryBase& memory)
+: champsim::operable(freq_scale), clock_scale(clock_scale),
+  queues(std::move(ul)), memory(memory)
+{
+    std::printf("clock_scale: %f.\n", clock_scale);
+
+    read_request_in_memory  = 0;
+    write_request_in_memory = 0;
+}
+
+MEMORY_CONTROLLER::~MEMORY_CONTROLLER()
+{
+    // Print information to output_statistics
+    output_statistics.read_request_in_memory  = read_request_in_memory;
+    output_statistics.write_request_in_memory = write_request_in_memory;
+}
+
+void MEMORY_CONTROLLER::initialize()
+{
+    long long int dram_size = memory.max_address / MiB; // in MiB
+
+    fmt::print("Memory Subsystem Size: ");
+#if (PRINT_STATISTICS_INTO_FILE == ENABLE)
+    std::fprintf(output_statistics.file_handler, "Memory Subsystem Size: ");
+#endif // PRINT_STATISTICS_INTO_FILE
+
+    if (dram_size > 1024)
+    {
+        fmt::print("{} GiB", dram_size / 1024);
+#if (PRINT_STATISTICS_INTO_FILE == ENABLE)
+        std::fprintf(output_statistics.file_handler, "%lld GiB", dram_size / 1024);
+#endif // PRINT_STATISTICS_INTO_FILE
+    }
+    else
+    {
+        fmt::print("{} MiB", dram_size);
+#if (PRINT_STATISTICS_INTO_FILE == ENABLE)
+        std::fprintf(output_statistics.file_handler, "%lld MiB", dram_size);
+#endif // PRINT_STATISTICS_INTO_FILE
+    }
+
+    fmt::print("\n");
+#if (PRINT_STATISTICS_INTO_FILE == ENABLE)
+    std::fprintf(output_statistics.file_handler, "\n");
+#endif // PRINT_STATISTICS_INTO_FILE
+}
+
+long MEMORY_CONTROLLER::operate()
+{
+    long progress {0};
+
+    initiate_requests();
+
+    /* Operate memories below */
+    // Skip periodically
+    if (leap_operation_memory >= 1)
+    {
+        leap_operation_memory -= 1;
+    }
+    else
+    {
+        memory.tick();
+        drain_completions(memory);
+        leap_operation_memory += clock_scale;
+    }
+
+    Stats::curTick++; // Processor clock, global, for Statistics
+
+    return ++progress;
+}
+
+void MEMORY_CONTROLLER::begin_phase()
+{
+    for (auto ul : queues)
+    {
+        channel_type::stats_type ul_new_roi_stats, ul_new_sim_stats;
+        ul->roi_stats = ul_new_roi_stats;
+        ul->sim_stats = ul_new_sim_stats;
+    }
+}
+
+void MEMORY_CONTROLLER::end_phase(unsigned)
+{
+    /** No code here */
+}
+
+#if (IDLE_CYCLE_SKIPPING == ENABLE)
+uint64_t MEMORY_CONTROLLER::idle_cycles(uint64_t bound)
+{
+    // Requests waiting in the channels are handled in the next cycle
+    for (auto ul : queues)
+    {
+        if (! std::empty(ul->RQ) || ! std::empty(ul->WQ) || ! std::empty(ul->PQ))
+            return 0;
+    }
+
+    // Replay the fractional clock until the memory would tick with something to do
+    long idle_ticks = memory.idle_ticks();
+    double leap     = leap_operation_memory;
+
+    uint64_t cycles = 0;
+    for (; cycles < bound; cycles++)
+    {
+        if (leap >= 1)
+        {
+            leap -= 1;
+        }
+        else
+        {
+            if (idle_ticks-- <= 0)
+                break;
+            leap += clock_scale;
+        }
+    }
+
+    return cycles;
+}
+
+void MEMORY_CONTROLLER::skip_cycles(uint64_t cycles)
+{
+    long ticks = 0;
+    for (uint64_t i = 0; i < cycles; i++)
+    {
+        if (leap_operation_memory >= 1)
+        {
+            leap_operation_memory -= 1;
+        }
+        else
+        {
+            ticks++;
+            leap_operation_memory += clock_scale;
+        }
+    }
+
+    memory.skip_ticks(ticks);
+
+    Stats::curTick += cycles;
+    current_cycle += cycles;
+}
+#endif // IDLE_CYCLE_SKIPPING
+
+void MEMORY_CONTROLLER::checkpoint(champsim::checkpoint_archive& archive)
+{
+    champsim::operable::checkpoint(archive);
+    archive & leap_operation_memory;
+
+    // The memory keeps its own section, so that a checkpoint of another memory (e.g., in a sweep of the memory configurations) leaves it cold
+    if (archive.section(memory_checkpoint_section(memory_id, memory)))
+        archive & memory;
+}
+
+// LCOV_EXCL_START Exclude the following function from LCOV
+void MEMORY_CONTROLLER::print_deadlock()
+{
+    std::printf("MEMORY_CONTROLLER %s.\n", __func__);
+}
+
+// LCOV_EXCL_STOP
+
+std::size_t MEMORY_CONTROLLER::size() const
+{
+    return memory.max_address;
+}
+
+void MEMORY_CONTROLLER::initiate_requests()
+{
+    // Initiate read requests
+    for (auto ul : queues)
+    {
+        for (auto q : {std::ref(ul->RQ), std::ref(ul->PQ)})
+        {
+            auto [begin, end] = champsim::get_span_p(std::cbegin(q.get()), std::cend(q.get()), [ul, this](const auto& pkt)
+                { return this->add_rq(pkt, ul); }); // Add read requests
+            q.get().erase(begin, end);
+        }
+
+        // Initiate write requests
+        auto [wq_begin, wq_end] = champsim::get_span_p(std::cbegin(ul->WQ), std::cend(ul->WQ), [this](const auto& pkt)
+            { return this->add_wq(pkt); }); // Add write requests
+        ul->WQ.erase(wq_begin, wq_end);
+    }
+}
+
+bool MEMORY_CONTROLLER::add_rq(const request_type& packet, champsim::channel* ul)
+{
+    const static ramulator::Request::Type type = ramulator::Request::Type::READ; // It means the input request is read request.
+
+    DRAM_CHANNEL::request_type rq_it           = DRAM_CHANNEL::request_type {packet};
+    rq_it.forward_checked                      = false;
+    rq_it.event_cycle                          = current_cycle;
+    if (packet.response_requested)
+        rq_it.to_return = {&ul->returned}; // Store the response queue to communicate with the LLC
+
+    /* Send memory request below */
+    bool stall       = true;
+
+    uint64_t address = packet.address;
+
+    // Assign the request to the right memory.
+    if (address < memory.max_address)
+    {
+        stall = ! send_read(memory, address, rq_it, packet.cpu, memory_id);
+
+        if (stall == false)
+        {
+            read_request_in_memory++;
+        }
+    }
+    else
+    {
+        std::printf("%s: Error!\n", __FUNCTION__);
+    }
+
+#if (PRINT_MEMORY_TRACE == ENABLE)
+    // Output memory trace
+    output_memorytrace.output_memory_trace(current_cycle, address, packet.address, 'R', packet.cpu, memory_id, memory_trace_origin(packet), ! stall);
+#endif // PRINT_MEMORY_TRACE
+
+    if (stall == true)
+    {
+        return false; // Queue is full, note Ramulator doesn't merge requests.
+    }
+    else
+    {
+        return true;
+    }
+}
+
+bool MEMORY_CONTROLLER::add_wq(const request_type& packet)
+{
+    const static ramulator::Request::Type type = ramulator::Request::Type::WRITE; // It means the input request is write request.
+
+    DRAM_CHANNEL::request_type wq_it           = DRAM_CHANNEL::request_type {packet};
+    wq_it.forward_checked                      = false;
+    wq_it.event_cycle                          = current_cycle;
+
+    /* Send memory request below */
+    bool stall                                 = true;
+
+    uint64_t address                           = packet.address;
+
+    // Assign the request to the right memory.
+    if (address < memory.max_address)
+    {
+        ramulator::Request request(address, type, NULL, packet.cpu, memory_id);
+        stall = ! memory.send(std::move(request));
+
+        if (stall == false)
+        {
+            write_request_in_memory++;
+        }
+    }
+    else
+    {
+        std::printf("%s: Error!\n", __FUNCTION__);
+    }
+
+#if (PRINT_MEMORY_TRACE == ENABLE)
+    // Output memory trace.
+    output_memorytrace.output_memory_trace(current_cycle, address, packet.address, 'W', packet.cpu, memory_id, memory_trace_origin(packet), ! stall);
+#endif // PRINT_MEMORY_TRACE
+
+    if (stall == true)
+    {
+        return false; // Queue is full, note Ramulator doesn't merge requests.
+    }
+    else
+    {
+        return true;
+    }
+}
+
+bool MEMORY_CONTROLLER::send_read(ramulator::MemoryBase& target, uint64_t address, const DRAM_CHANNEL::request_type& packet, uint32_t cpu, uint8_t target_id)
+{
+    ramulator::PacketPool::handle_type handle = packets.acquire(packet);
+    ramulator::Request request(address, ramulator::Request::Type::READ, NULL, handle, cpu, target_id); // The data is returned through the completions of the memory
+    if (target.send(std::move(request)))
+        return true;
+
+    packets.release(handle); // The memory is full, and the packet is sent again later.
+    return false;
+}
+
+void MEMORY_CONTROLLER::drain_completions(ramulator::MemoryBase& target)
+{
+    for (; ! target.completions.empty(); target.completions.pop_front())
+        return_data(target.completions.front());
+}
+
+uint32_t MEMORY_CONTROLLER::get_occupancy(ramulator::Request::Type queue_type, uint64_t address)
+{
+    // Assign the request to the right memory.
+    if (address < memory.max_address)
+    {
+        ramulator::Request request(address, queue_type);
+        return memory.get_queue_occupancy(request);
+    }
+    else
+    {
+        std::printf("%s: Error!\n", __FUNCTION__);
+    }
+
+    return 0;
+};
+
+uint32_t MEMORY_CONTROLLER::get_size(ramulator::Request::Type queue_type, uint64_t address)
+{
+    // Assign the request to the right memory.
+    if (address < memory.max_address)
+    {
+        ramulator::Request request(address, queue_type);
+        return memory.get_queue_size(request);
+    }
+    else
+    {
+        std::printf("%s: Error!\n", __FUNCTION__);
+    }
+
+    return 0;
+};
+
+void MEMORY_CONTROLLER::return_data(ramulator::Request& request)
+{
+    assert(request.packet != ramulator::PacketPool::NONE);
+    const DRAM_CHANNEL::request_type& packet = packets[request.packet];
+
+    response_type response {packet.address, packet.v_address, packet.data, packet.pf_metadata, packet.instr_depend_on_me};
+
+    for (auto ret : packet.to_return)
+    {
+        ret->push_back(response); // Fill the response into the response queue
+    }
+
+    packets.release(request.packet);
+};
+
+#endif // MEMORY_USE_HYBRID
 
 #else
 uint64_t cycles(double time, int io_freq)
@@ -22,6 +22,7 @@
 #include <utility>
 #include <vector>
 
+#include "ChampSim/sampling.h"
 #include "ChampSim/stats_printer.h"
 #include "ProjectConfiguration.h" // User file
 
@@ -187,6 +188,18 @@ void champsim::plain_printer::print(champsim::phase_stats& stats)
         print(stat);
     }
 
+    // The confidence of the IPC of a sampled phase
+    for (std::size_t cpu = 0; cpu < std::size(stats.sample_cpi); cpu++)
+    {
+        auto estimate = champsim::estimate_ipc(stats.sample_cpi[cpu]);
+        fmt::print(stream, "CPU {} sampled IPC: {:.4g} {:.0f}% confidence interval: [{:.4g}, {:.4g}] relative error: {:.4g}% windows: {}\n", cpu, estimate.ipc,
+            100 * champsim::SAMPLING_CONFIDENCE, estimate.ipc_low, estimate.ipc_high, 100 * estimate.relative_error, estimate.windows);
+#if (PRINT_STATISTICS_INTO_FILE == ENABLE)
+        std::fprintf(output_statistics.file_handler, "CPU %zu sampled IPC: %.4f %.0f%% confidence interval: [%.4f, %.4f] relative error: %.4f%% windows: %zu\n", cpu,
+            estimate.ipc, 100 * champsim::SAMPLING_CONFIDENCE, estimate.ipc_low, estimate.ipc_high, 100 * estimate.relative_error, estimate.windows);
+#endif // PRINT_STATISTICS_INTO_FILE
+    }
+
     for (const auto& stat : stats.roi_cache_stats)
     {
         /** @note Call void print(CACHE::stats_type); */
@@ -203,6 +216,18 @@ void champsim::plain_printer::print(champsim::phase_stats& stats)
         /** @note Call void print(DRAM_CHANNEL::stats_type); */
         print(stat);
     }
+
+    // The host time spent by the components, with --profile
+    if (! std::empty(stats.profile.records))
+    {
+        fmt::print(stream, "\nProfile of {:.4g} seconds of host time (nested entries are included in the entries around them)\n", stats.profile.seconds);
+        fmt::print(stream, "{:<48} {:>12} {:>12} {:>8} {:>12}\n", "Name", "Calls", "Seconds", "Share", "ns/call");
+        for (const auto& record : stats.profile.records)
+        {
+            fmt::print(stream, "{:<48} {:>12} {:>12.4f} {:>7.2f}% {:>12.1f}\n", record.name, record.calls, record.seconds, 100 * record.seconds / stats.profile.seconds,
+                1e9 * record.seconds / static_cast<double>(record.calls));
+        }
+    }
 }
 
 void champsim::plain_printer::print(std::vector<phase_stats>& stats)
@@ -0,0 +1,111 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ChampSim/profiler.h"
+
+#include <fmt/core.h>
+
+#include <algorithm>
+#include <deque>
+#include <mutex>
+
+#include "ChampSim/environment.h"
+
+#if (USER_CODES == ENABLE)
+
+bool champsim::profiler::enabled = false;
+
+namespace
+{
+// A deque doesn't move its elements when it grows, so the entries can be referred to by the profiled code
+std::deque<champsim::profiler::entry>& entries()
+{
+    static std::deque<champsim::profiler::entry> registered {};
+    return registered;
+}
+
+// Guard the entries while they are added, which may happen on several threads
+std::mutex& entries_mutex()
+{
+    static std::mutex mutex {};
+    return mutex;
+}
+} // namespace
+
+champsim::profiler::entry& champsim::profiler::get(const std::string& name)
+{
+    std::lock_guard<std::mutex> lock {entries_mutex()};
+    auto& registered = entries();
+    auto found       = std::find_if(std::begin(registered), std::end(registered), [&name](const entry& e) { return e.name == name; });
+    if (found != std::end(registered))
+        return *found;
+
+    auto& added = registered.emplace_back();
+    added.name  = name;
+    return added;
+}
+
+void champsim::profiler::attach(environment& env)
+{
+    for (O3_CPU& cpu : env.cpu_view())
+        cpu.profile_entry = &get(fmt::format("cpu{}", cpu.cpu));
+
+    for (CACHE& cache : env.cache_view())
+        cache.profile_entry = &get(cache.NAME);
+
+    for (PageTableWalker& ptw : env.ptw_view())
+        ptw.profile_entry = &get(ptw.NAME);
+
+    env.dram_view().profile_entry = &get("MEMORY_CONTROLLER");
+}
+
+champsim::profiler::snapshot champsim::profiler::take_snapshot()
+{
+    std::lock_guard<std::mutex> lock {entries_mutex()};
+    std::vector<count> counts;
+    for (const entry& e : entries())
+        counts.push_back(count {e.calls.load(std::memory_order_relaxed), e.ticks.load(std::memory_order_relaxed)});
+    return snapshot {counts, now(), std::chrono::steady_clock::now()};
+}
+
+champsim::profiler::report champsim::profiler::since(const snapshot& start)
+{
+    auto end = take_snapshot();
+
+    report result;
+    result.seconds = std::chrono::duration<double>(end.time - start.time).count();
+
+    // Calibrate the ticks against the steady clock over the same interval
+    auto ticks              = end.ticks - start.ticks;
+    double seconds_per_tick = ticks > 0 ? result.seconds / static_cast<double>(ticks) : 0;
+
+    std::lock_guard<std::mutex> lock {entries_mutex()};
+    auto& registered = entries();
+    for (std::size_t i = 0; i < std::size(end.counts); i++)
+    {
+        // The entries are only appended, so the entries of the start are at the same positions
+        count before = i < std::size(start.counts) ? start.counts[i] : count {};
+        if (end.counts[i].calls == before.calls)
+            continue;
+
+        result.records.push_back(record {registered[i].name, end.counts[i].calls - before.calls, static_cast<double>(end.counts[i].ticks - before.ticks) * seconds_per_tick});
+    }
+
+    std::stable_sort(std::begin(result.records), std::end(result.records), [](const record& lhs, const record& rhs) { return lhs.seconds > rhs.seconds; });
+    return result;
+}
+
+#endif // USER_CODES
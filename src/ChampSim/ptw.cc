@@ -18,6 +18,7 @@
 
 #include <fmt/core.h>
 
+#include <algorithm>
 #include <numeric>
 
 #include "ChampSim/champsim.h"
@@ -229,6 +230,81 @@ void PageTableWalker::begin_phase()
     }
 }
 
+#if (IDLE_CYCLE_SKIPPING == ENABLE)
+uint64_t PageTableWalker::idle_cycles(uint64_t bound)
+{
+    // Requests and responses waiting in the channels are handled in the next cycle
+    if (! std::empty(lower_level->returned) || std::any_of(std::cbegin(upper_levels), std::cend(upper_levels), [](const channel_type* ul)
+                                                      { return ! std::empty(ul->RQ); }))
+        return 0;
+
+    auto wait_until = [&bound, cycle = current_cycle](uint64_t event_cycle)
+    {
+        bound = std::min(bound, event_cycle > cycle ? event_cycle - cycle : 0);
+    };
+
+    // The MSHR only waits for the lower level, so only the finished and completed steps have timers
+    for (const auto& entry : finished)
+        wait_until(entry.event_cycle);
+
+    for (const auto& entry : completed)
+        wait_until(entry.event_cycle);
+
+    return bound;
+}
+#endif // IDLE_CYCLE_SKIPPING
+
+#if (FUNCTIONAL_WARMUP == ENABLE)
+PageTableWalker::response_type PageTableWalker::functional_access(const request_type& packet)
+{
+    // Start from the deepest hit in the paging structure caches, like handle_read() does
+    pscl_entry walk_init = {packet.v_address, CR3_addr, std::size(pscl)};
+    std::vector<std::optional<pscl_entry>> pscl_hits;
+    std::transform(std::begin(pscl), std::end(pscl), std::back_inserter(pscl_hits), [walk_init](auto& x)
+        { return x.check_hit(walk_init); });
+    for (const auto& hit : pscl_hits)
+        walk_init = hit.value_or(walk_init);
+
+    auto address = champsim::splice_bits(walk_init.ptw_addr, vmem->get_offset(packet.address, walk_init.level) * PTE_BYTES, LOG2_PAGE_SIZE);
+    for (auto level = walk_init.level;; level--)
+    {
+        // Read the page table entry, like step_translation() does
+        request_type step_packet;
+        step_packet.address       = address;
+        step_packet.v_address     = packet.address;
+        step_packet.pf_metadata   = packet.pf_metadata;
+        step_packet.cpu           = packet.cpu;
+        step_packet.asid[0]       = packet.asid[0];
+        step_packet.asid[1]       = packet.asid[1];
+        step_packet.is_translated = true;
+        step_packet.type          = access_type::TRANSLATION;
+
+#if (TRACKING_LOAD_STORE_STATISTICS == ENABLE)
+        step_packet.type_origin = access_type::TRANSLATION;
+#endif // TRACKING_LOAD_STORE_STATISTICS
+
+        functional_lower_level(step_packet);
+
+        if (level == 0)
+            break;
+
+        // Move to the next level, like finish_packet() and handle_fill() do
+        address = vmem->get_pte_pa(packet.cpu, packet.address, level).first;
+        pscl.at(std::size(pscl) - level).fill({packet.address, address, level - 1});
+    }
+
+    return {packet.address, packet.address, vmem->va_to_pa(packet.cpu, packet.address).first, packet.pf_metadata, {}};
+}
+#endif // FUNCTIONAL_WARMUP
+
+#if (USER_CODES == ENABLE)
+void PageTableWalker::checkpoint(champsim::checkpoint_archive& archive)
+{
+    champsim::operable::checkpoint(archive);
+    archive & pscl;
+}
+#endif // USER_CODES
+
 // LCOV_EXCL_START Exclude the following function from LCOV
 void PageTableWalker::print_deadlock()
 {
@@ -21,6 +21,20 @@ std::map<CACHE*, unsigned> bip_counter;
 std::map<CACHE*, std::vector<std::size_t>> rand_sets;
 std::map<std::pair<CACHE*, std::size_t>, champsim::msl::fwcounter<PSEL_WIDTH>> PSEL;
 std::map<CACHE*, std::vector<unsigned>> rrpv;
+
+// Keep the RRPVs, the sampled sets and the policy selectors in checkpoints
+champsim::checkpoint_archive::participant drrip_checkpoint {[](champsim::checkpoint_archive& archive)
+    {
+        for (auto& [cache, values] : ::rrpv)
+        {
+            if (! archive.section(cache->NAME + ".drrip"))
+                continue;
+
+            archive & ::bip_counter[cache] & ::rand_sets[cache] & values;
+            for (std::size_t cpu = 0; cpu < NUM_CPUS; cpu++)
+                archive & ::PSEL[std::make_pair(cache, cpu)];
+        }
+    }};
 } // namespace
 
 void CACHE::repl_replacementDdrrip_initialize_replacement()
@@ -43,6 +57,11 @@ void CACHE::repl_replacementDdrrip_initialize_replacement()
     }
 
     ::rrpv.insert({this, std::vector<unsigned>(NUM_SET * NUM_WAY)});
+
+    // Add the counters before the caches may operate on several threads
+    ::bip_counter[this];
+    for (std::size_t cpu = 0; cpu < NUM_CPUS; cpu++)
+        ::PSEL[std::make_pair(this, cpu)];
 }
 
 // called on every cache hit and cache fill
@@ -10,6 +10,16 @@
 namespace
 {
 std::map<CACHE*, std::vector<uint64_t>> last_used_cycles;
+
+// Keep the last use cycles in checkpoints
+champsim::checkpoint_archive::participant lru_checkpoint {[](champsim::checkpoint_archive& archive)
+    {
+        for (auto& [cache, cycles] : ::last_used_cycles)
+        {
+            if (archive.section(cache->NAME + ".lru"))
+                archive & cycles;
+        }
+    }};
 } // namespace
 
 void CACHE::repl_replacementDlru_initialize_replacement()
@@ -9,6 +9,16 @@ namespace
 {
 constexpr int maxRRPV = 3;
 std::unordered_map<CACHE*, std::vector<int>> rrpv_values;
+
+// Keep the RRPVs in checkpoints
+champsim::checkpoint_archive::participant srrip_checkpoint {[](champsim::checkpoint_archive& archive)
+    {
+        for (auto& [cache, values] : ::rrpv_values)
+        {
+            if (archive.section(cache->NAME + ".srrip"))
+                archive & values;
+        }
+    }};
 } // namespace
 
 // initialize replacement state
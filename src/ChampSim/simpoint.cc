@@ -0,0 +1,263 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ChampSim/simpoint.h"
+
+#include <fmt/core.h>
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <fstream>
+#include <iterator>
+#include <numeric>
+#include <sstream>
+
+#if (USER_CODES == ENABLE)
+
+namespace
+{
+// Scale a counter of a region by its factor
+template<typename T>
+T scale(T value, double factor)
+{
+    return static_cast<T>(std::llround(static_cast<double>(value) * factor));
+}
+
+/** @brief
+ *  Combine one kind of statistics (ROI or simulation) of the regions. Each region is scaled to the weighted mean number of instructions,
+ *  per CPU for the statistics of each CPU, and over all CPUs for the statistics shared by the CPUs.
+ */
+void combine(const std::vector<champsim::phase_stats>& regions, double total_weight, std::vector<O3_CPU::stats_type> champsim::phase_stats::*cpu_stats,
+    std::vector<CACHE::stats_type> champsim::phase_stats::*cache_stats, std::vector<DRAM_CHANNEL::stats_type> champsim::phase_stats::*dram_stats,
+    champsim::phase_stats& result)
+{
+    const auto& first = regions.front();
+    auto number_of_cpus = std::size(first.*cpu_stats);
+
+    // The weighted mean number of instructions of each CPU, and of all CPUs
+    std::vector<double> mean_instrs(number_of_cpus, 0);
+    for (const auto& region : regions)
+    {
+        for (std::size_t cpu = 0; cpu < number_of_cpus; cpu++)
+            mean_instrs[cpu] += region.weight / total_weight * static_cast<double>((region.*cpu_stats).at(cpu).instrs());
+    }
+    auto total_mean_instrs = std::accumulate(std::begin(mean_instrs), std::end(mean_instrs), 0.0);
+
+    for (std::size_t cpu = 0; cpu < number_of_cpus; cpu++)
+    {
+        O3_CPU::stats_type stats;
+        stats.name       = (first.*cpu_stats).at(cpu).name;
+        stats.end_instrs = static_cast<uint64_t>(std::llround(mean_instrs[cpu]));
+        (result.*cpu_stats).push_back(stats);
+    }
+
+    for (const auto& cache : first.*cache_stats)
+    {
+        CACHE::stats_type stats;
+        stats.name = cache.name;
+        (result.*cache_stats).push_back(stats);
+    }
+
+    for (const auto& channel : first.*dram_stats)
+    {
+        DRAM_CHANNEL::stats_type stats;
+        stats.name = channel.name;
+        (result.*dram_stats).push_back(stats);
+    }
+
+    for (const auto& region : regions)
+    {
+        // The factors that scale this region to the weighted mean number of instructions
+        std::vector<double> factors(number_of_cpus, 0);
+        uint64_t region_instrs = 0;
+        for (std::size_t cpu = 0; cpu < number_of_cpus; cpu++)
+        {
+            auto instrs = (region.*cpu_stats).at(cpu).instrs();
+            if (instrs > 0)
+                factors[cpu] = region.weight / total_weight * mean_instrs[cpu] / static_cast<double>(instrs);
+            region_instrs += instrs;
+        }
+        double factor = region_instrs > 0 ? region.weight / total_weight * total_mean_instrs / static_cast<double>(region_instrs) : 0;
+
+        for (std::size_t cpu = 0; cpu < number_of_cpus; cpu++)
+        {
+            const auto& from = (region.*cpu_stats).at(cpu);
+            auto& to         = (result.*cpu_stats).at(cpu);
+
+            to.end_cycles += scale(from.cycles(), factors[cpu]);
+            to.total_rob_occupancy_at_branch_mispredict += scale(from.total_rob_occupancy_at_branch_mispredict, factors[cpu]);
+            for (std::size_t type = 0; type < std::size(to.total_branch_types); type++)
+            {
+                to.total_branch_types[type] += scale(from.total_branch_types[type], factors[cpu]);
+                to.branch_type_misses[type] += scale(from.branch_type_misses[type], factors[cpu]);
+            }
+        }
+
+        for (std::size_t i = 0; i < std::size(result.*cache_stats); i++)
+        {
+            const auto& from = (region.*cache_stats).at(i);
+            auto& to         = (result.*cache_stats).at(i);
+
+            to.pf_requested += scale(from.pf_requested, factor);
+            to.pf_issued += scale(from.pf_issued, factor);
+            to.pf_useful += scale(from.pf_useful, factor);
+            to.pf_useless += scale(from.pf_useless, factor);
+            to.pf_fill += scale(from.pf_fill, factor);
+            to.total_miss_latency += scale(from.total_miss_latency, factor);
+
+            for (std::size_t type = 0; type < std::size(to.hits); type++)
+            {
+                for (std::size_t cpu = 0; cpu < number_of_cpus; cpu++)
+                {
+                    to.hits[type][cpu] += scale(from.hits[type][cpu], factors[cpu]);
+                    to.misses[type][cpu] += scale(from.misses[type][cpu], factors[cpu]);
+                }
+            }
+        }
+
+        for (std::size_t i = 0; i < std::size(result.*dram_stats); i++)
+        {
+            const auto& from = (region.*dram_stats).at(i);
+            auto& to         = (result.*dram_stats).at(i);
+
+            to.dbus_cycle_congested += scale(from.dbus_cycle_congested, factor);
+            to.dbus_count_congested += scale(from.dbus_count_congested, factor);
+            to.WQ_ROW_BUFFER_HIT += scale(from.WQ_ROW_BUFFER_HIT, factor);
+            to.WQ_ROW_BUFFER_MISS += scale(from.WQ_ROW_BUFFER_MISS, factor);
+            to.RQ_ROW_BUFFER_HIT += scale(from.RQ_ROW_BUFFER_HIT, factor);
+            to.RQ_ROW_BUFFER_MISS += scale(from.RQ_ROW_BUFFER_MISS, factor);
+            to.WQ_FULL += scale(from.WQ_FULL, factor);
+        }
+    }
+
+    // Same as CACHE::end_phase()
+    for (auto& stats : result.*cache_stats)
+    {
+        uint64_t total_miss = 0;
+        for (const auto& misses : stats.misses)
+            total_miss = std::accumulate(std::begin(misses), std::end(misses), total_miss);
+        stats.avg_miss_latency = std::ceil(stats.total_miss_latency) / std::ceil(total_miss);
+    }
+}
+} // namespace
+
+std::vector<champsim::simpoint> champsim::read_simpoints(const std::string& file_name)
+{
+    std::ifstream file {file_name};
+    if (! file)
+    {
+        std::printf("%s: Cannot open simpoints file %s.\n", __func__, file_name.c_str());
+        abort();
+    }
+
+    std::vector<simpoint> simpoints;
+    std::string line;
+    for (std::size_t line_number = 1; std::getline(file, line); line_number++)
+    {
+        std::istringstream fields {line};
+        std::string first;
+        if (! (fields >> first) || first.front() == '#')
+            continue;
+
+        simpoint region;
+        fields.str(line);
+        fields.clear();
+        if (! (fields >> region.start >> region.weight) || region.weight < 0)
+        {
+            std::printf("%s: Line %zu of %s is not \"<start instruction> <weight>\".\n", __func__, line_number, file_name.c_str());
+            abort();
+        }
+
+        simpoints.push_back(region);
+    }
+
+    auto total_weight = std::accumulate(std::begin(simpoints), std::end(simpoints), 0.0, [](double sum, const simpoint& region)
+        { return sum + region.weight; });
+    if (total_weight <= 0)
+    {
+        std::printf("%s: %s has no region with a weight.\n", __func__, file_name.c_str());
+        abort();
+    }
+
+    for (auto& region : simpoints)
+        region.weight /= total_weight;
+
+    std::sort(std::begin(simpoints), std::end(simpoints), [](const simpoint& lhs, const simpoint& rhs)
+        { return lhs.start < rhs.start; });
+    return simpoints;
+}
+
+std::vector<champsim::phase_info> champsim::simpoint_phases(const std::vector<simpoint>& simpoints, uint64_t warmup_instructions,
+    uint64_t simulation_instructions, const std::vector<std::string>& trace_names)
+{
+    std::vector<std::size_t> trace_index(std::size(trace_names));
+    std::iota(std::begin(trace_index), std::end(trace_index), 0);
+
+    std::vector<phase_info> phases;
+    uint64_t position = 0; // The instructions of each trace before the next phase
+    for (std::size_t i = 0; i < std::size(simpoints); i++)
+    {
+        // A region that overlaps the previous one starts at its end
+        auto region_start = std::max(position, simpoints[i].start);
+        auto warmup_start = std::max(position, region_start - std::min(region_start, warmup_instructions));
+
+        phase_info warmup {fmt::format("Warmup region {}", i), true, region_start - warmup_start, trace_index, trace_names};
+        warmup.skip_instructions = warmup_start - position;
+        phases.push_back(warmup);
+
+        phase_info simulation {fmt::format("Simulation region {}", i), false, simulation_instructions, trace_index, trace_names};
+        simulation.weight = simpoints[i].weight;
+        phases.push_back(simulation);
+
+        position = region_start + simulation_instructions;
+    }
+
+    return phases;
+}
+
+champsim::phase_stats champsim::weighted_phase_stats(const std::vector<phase_stats>& regions)
+{
+    assert(! std::empty(regions));
+
+    // The regions after any trace reaches EOF retire no instruction, so leave them out and normalize the weights of the others again
+    std::vector<phase_stats> simulated;
+    std::copy_if(std::begin(regions), std::end(regions), std::back_inserter(simulated), [](const phase_stats& region)
+        { return std::any_of(std::begin(region.sim_cpu_stats), std::end(region.sim_cpu_stats), [](const O3_CPU::stats_type& cpu) { return cpu.instrs() > 0; }); });
+    if (std::empty(simulated))
+        simulated = regions;
+
+    auto total_weight = std::accumulate(std::begin(simulated), std::end(simulated), 0.0, [](double sum, const phase_stats& region)
+        { return sum + region.weight; });
+
+    // Only regions without weight are left (e.g., the weighted ones were after an EOF), so weigh them equally rather than divide by 0
+    if (total_weight <= 0)
+    {
+        std::printf("%s: The simulated regions have no weight, so they are weighted equally.\n", __func__);
+        for (auto& region : simulated)
+            region.weight = 1;
+        total_weight = static_cast<double>(std::size(simulated));
+    }
+
+    phase_stats result;
+    result.name        = "Weighted";
+    result.trace_names = regions.front().trace_names;
+    combine(simulated, total_weight, &phase_stats::roi_cpu_stats, &phase_stats::roi_cache_stats, &phase_stats::roi_dram_stats, result);
+    combine(simulated, total_weight, &phase_stats::sim_cpu_stats, &phase_stats::sim_cache_stats, &phase_stats::sim_dram_stats, result);
+    return result;
+}
+
+#endif // USER_CODES
@@ -121,6 +121,12 @@ std::pair<uint64_t, uint64_t> VirtualMemory::get_pte_pa(uint32_t cpu_num, uint64
     return {paddr, fault ? minor_fault_penalty : 0};
 }
 
+void VirtualMemory::checkpoint(champsim::checkpoint_archive& archive)
+{
+    archive.expect(std::pair {last_ppage, pte_page_size}, "virtual memory geometry");
+    archive & vpage_to_ppage_map & page_table & next_pte_page & next_ppage;
+}
+
 #else
 VirtualMemory::VirtualMemory(uint64_t page_table_page_size, std::size_t page_table_levels, uint64_t minor_penalty, MEMORY_CONTROLLER& dram)
 : next_ppage(VMEM_RESERVE_CAPACITY), last_ppage(1ull << (LOG2_PAGE_SIZE + champsim::lg2(page_table_page_size / PTE_BYTES) * page_table_levels)),
@@ -216,6 +222,12 @@ std::pair<uint64_t, uint64_t> VirtualMemory::get_pte_pa(uint32_t cpu_num, uint64
     return {paddr, fault ? minor_fault_penalty : 0};
 }
 
+void VirtualMemory::checkpoint(champsim::checkpoint_archive& archive)
+{
+    archive.expect(std::pair {last_ppage, pte_page_size}, "virtual memory geometry");
+    archive & vpage_to_ppage_map & page_table & next_pte_page & next_ppage;
+}
+
 #endif // RAMULATOR
 
 #else
@@ -1,10 +1,14 @@
-#include "os_transparent_management.h"
+#include "cameo.h"
 
 #if (MEMORY_USE_OS_TRANSPARENT_MANAGEMENT == ENABLE)
 
-#if (IDEAL_LINE_LOCATION_TABLE == ENABLE) || (COLOCATED_LINE_LOCATION_TABLE == ENABLE)
-OS_TRANSPARENT_MANAGEMENT::OS_TRANSPARENT_MANAGEMENT(uint64_t max_address, uint64_t fast_memory_max_address)
-: total_capacity(max_address), fast_memory_capacity(fast_memory_max_address),
+OS_TRANSPARENT_MANAGEMENT* make_cameo(uint64_t max_address, uint64_t fast_memory_max_address, bool colocated_line_location_table)
+{
+    return new CAMEO(max_address, fast_memory_max_address, colocated_line_location_table);
+}
+
+CAMEO::CAMEO(uint64_t max_address, uint64_t fast_memory_max_address, bool colocated_line_location_table)
+: colocated_line_location_table(colocated_line_location_table), total_capacity(max_address), fast_memory_capacity(fast_memory_max_address),
   total_capacity_at_data_block_granularity(max_address >> DATA_MANAGEMENT_OFFSET_BITS),
   fast_memory_capacity_at_data_block_granularity(fast_memory_max_address >> DATA_MANAGEMENT_OFFSET_BITS),
   fast_memory_offset_bit(champsim::lg2(fast_memory_max_address)), // Note here only support integers of 2's power.
@@ -17,8 +21,7 @@ OS_TRANSPARENT_MANAGEMENT::OS_TRANSPARENT_MANAGEMENT(uint64_t max_address, uint6
   line_location_table(*(new std::vector<LocationTableEntry>(fast_memory_max_address >> DATA_MANAGEMENT_OFFSET_BITS)))
 #endif // BITS_MANIPULATION
 {
-    hotness_threshold                            = HOTNESS_THRESHOLD;
-    remapping_request_queue_congestion           = 0;
+    hotness_threshold                            = project_configuration.hotness_threshold;
 
     uint64_t expected_number_in_congruence_group = total_capacity / fast_memory_capacity;
     if (expected_number_in_congruence_group > REMAPPING_LOCATION_WIDTH(RemappingLocation::Max))
@@ -31,7 +34,7 @@ OS_TRANSPARENT_MANAGEMENT::OS_TRANSPARENT_MANAGEMENT(uint64_t max_address, uint6
     }
 };
 
-OS_TRANSPARENT_MANAGEMENT::~OS_TRANSPARENT_MANAGEMENT()
+CAMEO::~CAMEO()
 {
     output_statistics.remapping_request_queue_congestion = remapping_request_queue_congestion;
 
@@ -41,21 +44,17 @@ OS_TRANSPARENT_MANAGEMENT::~OS_TRANSPARENT_MANAGEMENT()
 };
 
 #if (TRACKING_LOAD_STORE_STATISTICS == ENABLE)
-bool OS_TRANSPARENT_MANAGEMENT::memory_activity_tracking(uint64_t address, ramulator::Request::Type type, access_type type_origin, float queue_busy_degree)
+bool CAMEO::memory_activity_tracking(uint64_t address, ramulator::Request::Type type, access_type type_origin, float queue_busy_degree)
 {
-#if (TRACKING_LOAD_ONLY)
-    if (type_origin == access_type::RFO || type_origin == access_type::WRITE) // CPU Store Instruction and LLC Writeback is ignored
+    if (project_configuration.tracking_load_only && (type_origin == access_type::RFO || type_origin == access_type::WRITE)) // CPU Store Instruction and LLC Writeback is ignored
     {
         return true;
     }
-#endif // TRACKING_LOAD_ONLY
 
-#if (TRACKING_READ_ONLY)
-    if (type == ramulator::Request::Type::WRITE) // Memory Write is ignored
+    if (project_configuration.tracking_read_only && (type == ramulator::Request::Type::WRITE)) // Memory Write is ignored
     {
         return true;
     }
-#endif // TRACKING_READ_ONLY
 
     if (address >= total_capacity)
     {
@@ -185,7 +184,7 @@ bool OS_TRANSPARENT_MANAGEMENT::memory_activity_tracking(uint64_t address, ramul
 };
 
 #else
-bool OS_TRANSPARENT_MANAGEMENT::memory_activity_tracking(uint64_t address, ramulator::Request::Type type, float queue_busy_degree)
+bool CAMEO::memory_activity_tracking(uint64_t address, ramulator::Request::Type type, float queue_busy_degree)
 {
     if (address >= total_capacity)
     {
@@ -315,7 +314,7 @@ bool OS_TRANSPARENT_MANAGEMENT::memory_activity_tracking(uint64_t address, ramul
 };
 #endif // TRACKING_LOAD_STORE_STATISTICS
 
-void OS_TRANSPARENT_MANAGEMENT::physical_to_hardware_address(request_type& packet)
+void CAMEO::physical_to_hardware_address(request_type& packet)
 {
     uint64_t data_block_address        = packet.address >> DATA_MANAGEMENT_OFFSET_BITS;
     uint64_t line_location_table_index = data_block_address % fast_memory_capacity_at_data_block_granularity;
@@ -332,12 +331,13 @@ void OS_TRANSPARENT_MANAGEMENT::physical_to_hardware_address(request_type& packe
 
     packet.h_address = champsim::replace_bits(champsim::replace_bits(line_location_table_index << DATA_MANAGEMENT_OFFSET_BITS, uint64_t(remapping_location) << fast_memory_offset_bit, congruence_group_msb, fast_memory_offset_bit), packet.address, DATA_MANAGEMENT_OFFSET_BITS - 1);
 
-#if (COLOCATED_LINE_LOCATION_TABLE == ENABLE)
-    packet.h_address_fm = champsim::replace_bits(champsim::replace_bits(line_location_table_index << DATA_MANAGEMENT_OFFSET_BITS, uint64_t(RemappingLocation::Zero) << fast_memory_offset_bit, congruence_group_msb, fast_memory_offset_bit), packet.address, DATA_MANAGEMENT_OFFSET_BITS - 1);
-#endif // COLOCATED_LINE_LOCATION_TABLE
+    if (colocated_line_location_table)
+    {
+        packet.h_address_fm = champsim::replace_bits(champsim::replace_bits(line_location_table_index << DATA_MANAGEMENT_OFFSET_BITS, uint64_t(RemappingLocation::Zero) << fast_memory_offset_bit, congruence_group_msb, fast_memory_offset_bit), packet.address, DATA_MANAGEMENT_OFFSET_BITS - 1);
+    }
 };
 
-void OS_TRANSPARENT_MANAGEMENT::physical_to_hardware_address(uint64_t& address)
+void CAMEO::physical_to_hardware_address(uint64_t& address)
 {
     uint64_t data_block_address        = address >> DATA_MANAGEMENT_OFFSET_BITS;
     uint64_t line_location_table_index = data_block_address % fast_memory_capacity_at_data_block_granularity;
@@ -355,18 +355,7 @@ void OS_TRANSPARENT_MANAGEMENT::physical_to_hardware_address(uint64_t& address)
     address = champsim::replace_bits(champsim::replace_bits(line_location_table_index << DATA_MANAGEMENT_OFFSET_BITS, uint64_t(remapping_location) << fast_memory_offset_bit, congruence_group_msb, fast_memory_offset_bit), address, DATA_MANAGEMENT_OFFSET_BITS - 1);
 };
 
-bool OS_TRANSPARENT_MANAGEMENT::issue_remapping_request(RemappingRequest& remapping_request)
-{
-    if (remapping_request_queue.empty() == false)
-    {
-        remapping_request = remapping_request_queue.front();
-        return true;
-    }
-
-    return false;
-};
-
-bool OS_TRANSPARENT_MANAGEMENT::finish_remapping_request()
+bool CAMEO::finish_remapping_request()
 {
     if (remapping_request_queue.empty() == false)
     {
@@ -439,17 +428,28 @@ bool OS_TRANSPARENT_MANAGEMENT::finish_remapping_request()
     return true;
 };
 
-void OS_TRANSPARENT_MANAGEMENT::cold_data_detection()
+void CAMEO::cold_data_detection()
 {
     cycle++;
 }
 
-bool OS_TRANSPARENT_MANAGEMENT::cold_data_eviction(uint64_t source_address, float queue_busy_degree)
+void CAMEO::checkpoint(champsim::checkpoint_archive& archive)
+{
+    archive & cycle;
+    // The tables of a warmed checkpoint keep serving a sweep of HOTNESS_THRESHOLD, under the threshold configured for this run
+    COUNTER_WIDTH archived_hotness_threshold = hotness_threshold;
+    archive & archived_hotness_threshold;
+    if (archived_hotness_threshold != hotness_threshold)
+        std::printf("%s: The checkpoint was taken with hotness threshold %u, this run continues with %u.\n", __func__, unsigned(archived_hotness_threshold), unsigned(hotness_threshold));
+    archive & counter_table & hotness_table & remapping_request_queue & line_location_table;
+}
+
+bool CAMEO::cold_data_eviction(uint64_t source_address, float queue_busy_degree)
 {
     return false;
 }
 
-bool OS_TRANSPARENT_MANAGEMENT::enqueue_remapping_request(RemappingRequest& remapping_request)
+bool CAMEO::enqueue_remapping_request(RemappingRequest& remapping_request)
 {
     uint64_t data_block_address        = remapping_request.address_in_fm >> DATA_MANAGEMENT_OFFSET_BITS;
     uint64_t line_location_table_index = data_block_address % fast_memory_capacity_at_data_block_granularity;
@@ -498,49 +498,4 @@ bool OS_TRANSPARENT_MANAGEMENT::enqueue_remapping_request(RemappingRequest& rema
     return true;
 }
 
-#if (COLOCATED_LINE_LOCATION_TABLE == ENABLE)
-bool OS_TRANSPARENT_MANAGEMENT::finish_fm_access_in_incomplete_read_request_queue(uint64_t h_address)
-{
-    for (size_t i = 0; i < incomplete_read_request_queue.size(); i++)
-    {
-        if (incomplete_read_request_queue[i].packet.h_address == h_address)
-        {
-            if (incomplete_read_request_queue[i].fm_access_finish == false)
-            {
-                incomplete_read_request_queue[i].fm_access_finish = true;
-                return true;
-            }
-            else
-            {
-                continue;
-            }
-        }
-    }
-
-    return false;
-}
-
-bool OS_TRANSPARENT_MANAGEMENT::finish_fm_access_in_incomplete_write_request_queue(uint64_t h_address)
-{
-    for (size_t i = 0; i < incomplete_write_request_queue.size(); i++)
-    {
-        if (incomplete_write_request_queue[i].packet.h_address == h_address)
-        {
-            if (incomplete_write_request_queue[i].fm_access_finish == false)
-            {
-                incomplete_write_request_queue[i].fm_access_finish = true;
-                return true;
-            }
-            else
-            {
-                continue;
-            }
-        }
-    }
-
-    return false;
-}
-#endif // COLOCATED_LINE_LOCATION_TABLE
-
-#endif // IDEAL_LINE_LOCATION_TABLE, COLOCATED_LINE_LOCATION_TABLE
 #endif // MEMORY_USE_OS_TRANSPARENT_MANAGEMENT
@@ -0,0 +1,91 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "ChampSim/block_trace.h"
+#include "ChampSim/inf_stream.h"
+#include "ChampSim/trace_instruction.h"
+
+// Copy the stream into the block trace, a few blocks of bytes at a time
+template<typename S>
+uint64_t convert(S&& input, champsim::block_trace::writer& output, std::size_t record_size)
+{
+    std::vector<char> buffer(record_size * champsim::block_trace::DEFAULT_RECORDS_PER_BLOCK);
+    uint64_t bytes = 0;
+    std::size_t count;
+    do
+    {
+        input.read(std::data(buffer), static_cast<std::streamsize>(std::size(buffer)));
+        count = static_cast<std::size_t>(input.gcount());
+        output.write(std::data(buffer), count);
+        bytes += count;
+    } while (count > 0 && ! input.eof());
+    return bytes / record_size;
+}
+
+int main(int argc, char** argv)
+{
+    bool is_cloudsuite         = false;
+    uint32_t records_per_block = champsim::block_trace::DEFAULT_RECORDS_PER_BLOCK;
+
+    int i = 1;
+    for (; i < argc && argv[i][0] == '-'; i++)
+    {
+        if (strcmp(argv[i], "-c") == 0)
+            is_cloudsuite = true;
+        else if (strcmp(argv[i], "-b") == 0 && i + 1 < argc)
+            records_per_block = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        else
+            break;
+    }
+
+    if (argc - i != 2 || records_per_block == 0)
+    {
+        std::printf("Usage: %s [-c] [-b <records per block>] <trace-filename> <output-filename>%s\n", argv[0], champsim::block_trace::FILE_EXTENSION);
+        std::printf("  -c  The trace is a cloudsuite trace\n");
+        std::printf("  -b  The records compressed together, i.e., the granularity of seeking (default: %u)\n", champsim::block_trace::DEFAULT_RECORDS_PER_BLOCK);
+        return EXIT_FAILURE;
+    }
+
+    std::string input_name {argv[i]};
+    std::size_t record_size = is_cloudsuite ? sizeof(cloudsuite_instr) : sizeof(input_instr);
+    champsim::block_trace::writer output {argv[i + 1], static_cast<uint32_t>(record_size), records_per_block};
+
+    auto ends_with = [&input_name](const std::string& suffix)
+    {
+        return std::size(input_name) >= std::size(suffix) && input_name.compare(std::size(input_name) - std::size(suffix), std::string::npos, suffix) == 0;
+    };
+
+    uint64_t records;
+    if (ends_with("gz"))
+        records = convert(champsim::inf_istream<champsim::decomp_tags::gzip_tag_t<>> {input_name}, output, record_size);
+    else if (ends_with("xz"))
+        records = convert(champsim::inf_istream<champsim::decomp_tags::lzma_tag_t<LZMA_CONCATENATED>> {input_name}, output, record_size);
+    else if (ends_with("bz2"))
+        records = convert(champsim::inf_istream<champsim::decomp_tags::bzip2_tag_t> {input_name}, output, record_size);
+    else
+        records = convert(std::ifstream {input_name, std::ios::binary}, output, record_size);
+
+    output.close();
+    std::printf("Converted %lu records of %s into %s.\n", records, input_name.c_str(), argv[i + 1]);
+    return EXIT_SUCCESS;
+}
@@ -20,26 +20,38 @@
 #include <string.h>
 
 #include <algorithm>
+#include <condition_variable>
 #include <cstdint>
-#include <map>
-
-#include "../../inc/trace_instruction.h"
-
-// defines for the paths for the various decompression programs and Apple/Linux differences
+#include <deque>
+#include <fstream>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "ChampSim/block_trace.h"
+#include "ChampSim/inf_stream.h"
+#include "ChampSim/trace_instruction.h"
+
+// Apple/Linux differences
 
 #ifdef __APPLE__
-#define XZ_PATH   "/opt/local/bin/xz"
-#define GZIP_PATH "/usr/bin/gzip"
-#define CAT_PATH  "/bin/cat"
-#define UINT64    uint64_t
+#define UINT64 uint64_t
 #else
-#define XZ_PATH   "/usr/bin/xz"
-#define GZIP_PATH "/bin/gzip"
-#define CAT_PATH  "/bin/cat"
-#define UINT64    unsigned long long int
+#define UINT64 unsigned long long int
 #endif
 
-bool verbose             = false;
+bool verbose = false;
+
+// The output trace, the standard output unless given
+std::string output_name;
+uint32_t records_per_block   = champsim::block_trace::DEFAULT_RECORDS_PER_BLOCK;
+unsigned compression_threads = std::max(std::thread::hardware_concurrency(), 1u);
 
 // use non-cloudsuite ChampSim trace format
 using trace_instr_format = input_instr;
@@ -98,7 +110,19 @@ const char* branch_names[] = {
 
 long long int counts[OPTYPE_MAX];
 
-// one record from the CVP-1 trace file format
+// read a field of a record, which the trace must not end in the middle of
+
+template<typename R>
+void read_field(R& f, void* field, std::size_t bytes)
+{
+    if (! f.read(field, bytes))
+    {
+        fprintf(stderr, "the trace ends in the middle of a record\n");
+        exit(1);
+    }
+}
+
+// one record from the CVP-1 trace file format, without the values of the output registers
 
 struct trace
 {
@@ -110,14 +134,12 @@ struct trace
         taken, // branch was taken
         num_input_regs, num_output_regs, input_reg_names[256], output_reg_names[256];
 
-    // output register values could be up to 128 bits each
-    UINT64 output_reg_values[256][2];
-
     InstClass type; // instruction type
 
     // read a single record from the trace file, return true on success, false on EOF
 
-    bool read(FILE* f)
+    template<typename R>
+    bool read(R& f)
     {
         // initialize
 
@@ -130,17 +152,14 @@ struct trace
 
         // get the PC
 
-        int n;
-        n = fread(&PC, 8, 1, f);
-        if (! n)
-            return false;
-        if (feof(f))
+        if (! f.read(&PC, 8))
             return false;
-        assert(n == 1);
 
         // get the instruction type
 
-        assert(fread(&type, 1, 1, f) == 1);
+        uint8_t inst_class;
+        read_field(f, &inst_class, 1);
+        type = static_cast<InstClass>(inst_class);
 
         // base on the type, read in different stuff
 
@@ -150,8 +169,8 @@ struct trace
         case storeInstClass:
             // load or store? get the effective address and access size
 
-            assert(fread(&EA, 8, 1, f) == 1);
-            assert(fread(&access_size, 1, 1, f) == 1);
+            read_field(f, &EA, 8);
+            read_field(f, &access_size, 1);
             break;
         case condBranchInstClass:
         case uncondDirectBranchInstClass:
@@ -159,10 +178,10 @@ struct trace
 
             // branch? get "taken" and the target
 
-            assert(fread(&taken, 1, 1, f) == 1);
+            read_field(f, &taken, 1);
             if (taken)
             {
-                assert(fread(&target, 8, 1, f) == 1);
+                read_field(f, &target, 8);
             }
             else
             {
@@ -180,34 +199,28 @@ struct trace
 
         // get the number of input registers and their names
 
-        assert(fread(&num_input_regs, 1, 1, f) == 1);
-        for (int i = 0; i < num_input_regs; i++)
-        {
-            assert(fread(&input_reg_names[i], 1, 1, f) == 1);
-        }
+        read_field(f, &num_input_regs, 1);
+        read_field(f, input_reg_names, num_input_regs);
 
         // get the number of output registers and their names
 
-        assert(fread(&num_output_regs, 1, 1, f) == 1);
-        for (int i = 0; i < num_output_regs; i++)
-        {
-            assert(fread(&output_reg_names[i], 1, 1, f) == 1);
-        }
+        read_field(f, &num_output_regs, 1);
+        read_field(f, output_reg_names, num_output_regs);
 
-        // read the output registers
+        // skip the values of the output registers, which are not converted
 
-        memset(output_reg_values, 0, sizeof(output_reg_values));
         for (int i = 0; i < num_output_regs; i++)
         {
+            UINT64 value[2];
             if (output_reg_names[i] <= 31 || output_reg_names[i] == 64)
             {
                 // scalars or flags?
-                assert(fread(&output_reg_values[i][0], 8, 1, f) == 1);
+                read_field(f, value, 8);
             }
             else if (output_reg_names[i] >= 32 && output_reg_names[i] < 64)
             {
                 // SIMD values?
-                assert(fread(&output_reg_values[i][0], 16, 1, f) == 1);
+                read_field(f, value, 16);
             }
             else
                 assert(0);
@@ -223,120 +236,199 @@ struct trace
 
 bool is_branch(InstClass t) { return (t == uncondIndirectBranchInstClass || t == uncondDirectBranchInstClass || t == condBranchInstClass); }
 
-std::map<UINT64, bool> code_pages, data_pages;
-std::map<UINT64, UINT64> remapped_pages;
+std::unordered_set<UINT64> code_pages, data_pages;
+std::unordered_map<UINT64, UINT64> remapped_pages;
 UINT64 bump_page = 0x1000;
 
-// this string will contain the trace file name, or "-" if we want to read from standard input
+// this string will contain the trace file name
 
-char tracefilename[1000];
+std::string tracefilename;
 
 namespace
 {
 constexpr char REG_AX = 56;
 } // namespace
 
-auto open_trace_file(void)
+/* The conversion is a pipeline of three stages on threads of their own, which hand batches to each other through bounded queues:
+ *
+ *     decode (decompress and read the CVP records) -> convert (into ChampSim instructions) -> compress and write
+ *
+ * The last stage compresses the blocks of instructions on up to compression_threads threads at a time, and writes them in order. The records
+ * are decoded twice, since the conversion needs all code pages of the trace first.
+ */
+constexpr std::size_t DECODED_BATCH  = 4096; // CVP records handed to the convert stage at a time
+constexpr std::size_t QUEUED_BATCHES = 16;
+
+// A bounded queue between two stages
+template<typename T>
+class stage_queue
+{
+    std::mutex mutex;
+    std::condition_variable changed;
+    std::deque<T> batches {};
+    std::size_t capacity;
+    bool closed = false;
+
+public:
+    explicit stage_queue(std::size_t capacity): capacity(std::max<std::size_t>(capacity, 1)) {}
+
+    void push(T batch)
+    {
+        std::unique_lock lock {mutex};
+        changed.wait(lock, [this] { return std::size(batches) < capacity; });
+        batches.push_back(std::move(batch));
+        lock.unlock();
+        changed.notify_all();
+    }
+
+    // No more batches
+    void close()
+    {
+        std::unique_lock lock {mutex};
+        closed = true;
+        lock.unlock();
+        changed.notify_all();
+    }
+
+    std::optional<T> pop()
+    {
+        std::unique_lock lock {mutex};
+        changed.wait(lock, [this] { return ! std::empty(batches) || closed; });
+        if (std::empty(batches))
+            return std::nullopt;
+
+        T batch = std::move(batches.front());
+        batches.pop_front();
+        lock.unlock();
+        changed.notify_all();
+        return batch;
+    }
+};
+
+// Read the records from a stream a large buffer at a time instead of a field at a time
+template<typename S>
+class record_reader
+{
+    S& stream;
+    std::vector<char> buffer = std::vector<char>(1 << 20);
+    std::size_t begin        = 0;
+    std::size_t end          = 0;
+
+public:
+    explicit record_reader(S& stream): stream(stream) {}
+
+    bool read(void* field, std::size_t bytes)
+    {
+        while (end - begin < bytes)
+        {
+            std::copy(std::begin(buffer) + begin, std::begin(buffer) + end, std::begin(buffer));
+            end -= begin;
+            begin = 0;
+
+            stream.read(std::data(buffer) + end, static_cast<std::streamsize>(std::size(buffer) - end));
+            if (stream.gcount() <= 0)
+                return false;
+            end += static_cast<std::size_t>(stream.gcount());
+        }
+
+        memcpy(field, std::data(buffer) + begin, bytes);
+        begin += bytes;
+        return true;
+    }
+};
+
+// The decode stage
+template<typename S>
+void decode(S&& input, stage_queue<std::vector<trace>>& decoded)
 {
-    // read from standard input?
-    if (! strcmp(tracefilename, "-"))
+    record_reader<std::remove_reference_t<S>> reader {input};
+    std::vector<trace> batch;
+    batch.reserve(DECODED_BATCH);
+
+    trace t;
+    while (t.read(reader))
     {
-        fprintf(stderr, "reading from standard input\n");
-        fflush(stderr);
-        return stdin;
+        batch.push_back(t);
+        if (std::size(batch) == DECODED_BATCH)
+        {
+            decoded.push(std::move(batch));
+            batch = std::vector<trace> {};
+            batch.reserve(DECODED_BATCH);
+        }
     }
 
+    if (! std::empty(batch))
+        decoded.push(std::move(batch));
+    decoded.close();
+}
+
+// Open the trace, decompressing it by its magic number, and decode it on a thread of its own
+std::thread start_decoding(stage_queue<std::vector<trace>>& decoded)
+{
     // see what kind of file this is by reading the magic number
-    auto magic_tester = fopen(tracefilename, "r");
+    std::ifstream magic_tester {tracefilename, std::ios::binary};
     if (! magic_tester)
     {
-        perror(tracefilename);
+        perror(tracefilename.c_str());
         exit(1);
     }
 
     // read six bytes from the beginning of the file
     unsigned char s[6];
-    int n = fread(s, 1, 6, magic_tester);
-    fclose(magic_tester);
-    assert(n == 6);
-
-    constexpr auto cmd_size = 5 + std::max({sizeof(XZ_PATH), sizeof(GZIP_PATH), sizeof(CAT_PATH)}) + sizeof(tracefilename);
-    char cmd[cmd_size];
+    magic_tester.read(reinterpret_cast<char*>(s), 6);
+    assert(magic_tester.gcount() == 6);
 
     // is this the magic number for XZ compression?
     if (s[0] == 0xfd && s[1] == '7' && s[2] == 'z' && s[3] == 'X' && s[4] == 'Z' && s[5] == 0)
     {
         // it is an XZ file or doing a good impression of one
-
-        fprintf(stderr, "opening xz file \"%s\"\n", tracefilename);
-        fflush(stderr);
-
-        // start up an xz decompression and open a pipe to our standard input
-
-        sprintf(cmd, "%s -dc %s", XZ_PATH, tracefilename);
+        fprintf(stderr, "opening xz file \"%s\"\n", tracefilename.c_str());
+        return std::thread {[&decoded] { decode(champsim::inf_istream<champsim::decomp_tags::lzma_tag_t<LZMA_CONCATENATED>> {tracefilename}, decoded); }};
     }
 
     // check for the magic number for GZIP compression
-    else if (s[0] == 0x1f && s[1] == 0x8b)
-    {
-        // it is a GZ file
-        fprintf(stderr, "opening gz file \"%s\"\n", tracefilename);
-        fflush(stderr);
-
-        // open a pipe to a gzip decompression process
-
-        sprintf(cmd, "%s -dc %s", GZIP_PATH, tracefilename);
-    }
-    else
+    if (s[0] == 0x1f && s[1] == 0x8b)
     {
-        // no magic number? maybe it's uncompressed?
-        fprintf(stderr, "opening file \"%s\"\n", tracefilename);
-        fflush(stderr);
-
-        // use Unix cat to open and read this file. we could just fopen the file
-        // but then we're pclosing it later so that could get weird
-
-        sprintf(cmd, "%s %s", CAT_PATH, tracefilename);
+        fprintf(stderr, "opening gz file \"%s\"\n", tracefilename.c_str());
+        return std::thread {[&decoded] { decode(champsim::inf_istream<champsim::decomp_tags::gzip_tag_t<>> {tracefilename}, decoded); }};
     }
 
-    auto f = popen(cmd, "r");
-    if (f)
-        return f;
-
-    perror(cmd);
-    return f;
+    // no magic number? maybe it's uncompressed?
+    fprintf(stderr, "opening file \"%s\"\n", tracefilename.c_str());
+    return std::thread {[&decoded] { decode(std::ifstream {tracefilename, std::ios::binary}, decoded); }};
 }
 
 void preprocess_file(void)
 {
-    trace t;
     fprintf(stderr, "preprocessing to find code and data pages...\n");
     fflush(stderr);
-    FILE* f = open_trace_file();
-    if (! f)
-        return;
+
+    stage_queue<std::vector<trace>> decoded {QUEUED_BATCHES};
+    auto decoder = start_decoding(decoded);
+
     int count = 0;
-    for (;;)
+    while (auto batch = decoded.pop())
     {
-        bool good = t.read(f);
-        if (! good)
-            break;
-        code_pages[t.PC >> 12] = true;
-        if (t.type == loadInstClass || t.type == storeInstClass)
-            data_pages[t.EA >> 12] = true;
-        count++;
-        if (count % 10000000 == 0)
+        for (const auto& t : *batch)
         {
-            fprintf(stderr, ".");
-            fflush(stderr);
-            if (count % 600000000 == 0)
+            code_pages.insert(t.PC >> 12);
+            if (t.type == loadInstClass || t.type == storeInstClass)
+                data_pages.insert(t.EA >> 12);
+            count++;
+            if (count % 10000000 == 0)
             {
-                fprintf(stderr, "\n");
+                fprintf(stderr, ".");
                 fflush(stderr);
+                if (count % 600000000 == 0)
+                {
+                    fprintf(stderr, "\n");
+                    fflush(stderr);
+                }
             }
         }
     }
-    pclose(f);
+    decoder.join();
+
     fprintf(stderr, "%ld code pages, %ld data pages\n", code_pages.size(), data_pages.size());
     fflush(stderr);
 }
@@ -373,293 +465,383 @@ UINT64 transform(UINT64 a)
     return a;
 }
 
-int main(int argc, char** argv)
+// Convert a CVP record into a ChampSim instruction
+trace_instr_format convert(trace& t)
 {
-    trace t;
-
-    // for fun we will keep a register file up to date
-
-    UINT64 registers[256][2];
-    memset(registers, 0, sizeof(registers));
-
-    // defaults to reading from standard input
-
-    strcpy(tracefilename, "-");
-
-    for (int i = 1; i < argc; i++)
-    {
-        if (! strcmp(argv[i], "-v"))
-            verbose = true;
-        else
-            strcpy(tracefilename, argv[i]);
-    }
-
-    preprocess_file();
-
-    // open the trace file
-
-    FILE* f = open_trace_file();
-
-    if (! f)
-        return 1;
+    trace_instr_format ct {};
+    ct.ip        = t.PC;
+    ct.is_branch = false;
+    // we are going to figure out the op type
 
-    // number of records read so far
-    long long int n = 0;
-    trace oldt;
-    oldt.PC = 0;
+    OpType c     = OPTYPE_OP;
 
-    // loop getting records until we're done
+    // if this is a branch then do more stuff; we don't care about non-branches
 
-    for (;;)
+    if (is_branch(t.type))
     {
-        // one more record
+        ct.is_branch = true;
 
-        n++;
+        // if this is a conditional branch then it's direct and we're done figuring out the type
 
-        // print something to entertain the user while they wait
-
-        if (n % 1000000 == 0)
+        if (t.type == condBranchInstClass)
         {
-            fprintf(stderr, "%lld instructions\n", n);
-            fflush(stderr);
+            c = OPTYPE_JMP_DIRECT_COND;
         }
-
-        // read a record from the trace file
-
-        bool good = t.read(f);
-        if (t.PC == oldt.PC)
+        else
         {
-            fprintf(stderr, "hmm, that's weird\n");
-        }
+            // this is some other kind of branch. it should have a non-zero target
 
-        oldt = t;
-
-        // are we done? then stop.
-
-        if (! good)
-            break;
-        trace_instr_format ct;
-        ct.ip        = t.PC;
-        ct.is_branch = false;
-        // we are going to figure out the op type
-
-        OpType c     = OPTYPE_OP;
-
-        // if this is a branch then do more stuff; we don't care about non-branches
-
-        if (is_branch(t.type))
-        {
-            ct.is_branch = true;
+            assert(t.target);
 
-            // if this is a conditional branch then it's direct and we're done figuring out the type
+            // on ARM, calls link the return address in register X30. let's see if this
+            // instruction is doing that; if so, it's a call or wants us to believe it is
 
-            if (t.type == condBranchInstClass)
+            if (t.num_output_regs == 1 && t.output_reg_names[0] == 30)
             {
-                c = OPTYPE_JMP_DIRECT_COND;
+                // is it indirect?
+
+                if (t.type == uncondIndirectBranchInstClass)
+                    c = OPTYPE_CALL_INDIRECT_UNCOND;
+                else
+                    c = OPTYPE_CALL_DIRECT_UNCOND;
             }
             else
             {
-                // this is some other kind of branch. it should have a non-zero target
+                // no X30? then it's just an unconditional jump
+                // is it indirect?
 
-                assert(t.target);
-
-                // on ARM, calls link the return address in register X30. let's see if this
-                // instruction is doing that; if so, it's a call or wants us to believe it is
+                if (t.type == uncondIndirectBranchInstClass)
+                    c = OPTYPE_JMP_INDIRECT_UNCOND;
+                else
+                    c = OPTYPE_JMP_DIRECT_UNCOND;
+            }
 
-                if (t.num_output_regs == 1 && t.output_reg_names[0] == 30)
-                {
-                    // is it indirect?
+            // on ARM, returns are an indirect jump to X30. let's see if we're doing this
 
-                    if (t.type == uncondIndirectBranchInstClass)
-                        c = OPTYPE_CALL_INDIRECT_UNCOND;
-                    else
-                        c = OPTYPE_CALL_DIRECT_UNCOND;
-                }
-                else
+            if (t.num_input_regs == 1)
+                if (t.input_reg_names[0] == 30)
                 {
-                    // no X30? then it's just an unconditional jump
-                    // is it indirect?
+                    // yes. it's a return.
 
-                    if (t.type == uncondIndirectBranchInstClass)
-                        c = OPTYPE_JMP_INDIRECT_UNCOND;
-                    else
-                        c = OPTYPE_JMP_DIRECT_UNCOND;
+                    c = OPTYPE_RET_UNCOND;
                 }
+        }
+        counts[c]++;
 
-                // on ARM, returns are an indirect jump to X30. let's see if we're doing this
-
-                if (t.num_input_regs == 1)
-                    if (t.input_reg_names[0] == 30)
-                    {
-                        // yes. it's a return.
+        // OK now make a branch instruction out of this bad boy
 
-                        c = OPTYPE_RET_UNCOND;
-                    }
+        memset(ct.destination_registers, 0, sizeof(ct.destination_registers));
+        memset(ct.source_registers, 0, sizeof(ct.source_registers));
+        memset(ct.destination_memory, 0, sizeof(ct.destination_memory));
+        memset(ct.source_memory, 0, sizeof(ct.source_memory));
+        switch (c)
+        {
+        case OPTYPE_JMP_DIRECT_UNCOND:
+            // writes IP only
+            ct.destination_registers[0] = champsim::REG_INSTRUCTION_POINTER;
+            ct.branch_taken             = t.taken;
+            break;
+        case OPTYPE_JMP_DIRECT_COND:
+            ct.branch_taken             = t.taken;
+            // reads FLAGS, writes IP
+            ct.destination_registers[0] = champsim::REG_INSTRUCTION_POINTER;
+            // turns out pin records conditional direct branches as also reading IP. whatever.
+            ct.source_registers[0]      = champsim::REG_INSTRUCTION_POINTER;
+            ct.source_registers[1]      = champsim::REG_FLAGS;
+            break;
+        case OPTYPE_CALL_INDIRECT_UNCOND:
+            ct.branch_taken             = true;
+            // reads something else, reads IP, reads SP, writes SP, writes IP
+            ct.destination_registers[0] = champsim::REG_INSTRUCTION_POINTER;
+            ct.destination_registers[1] = champsim::REG_STACK_POINTER;
+            ct.source_registers[0]      = champsim::REG_INSTRUCTION_POINTER;
+            ct.source_registers[1]      = champsim::REG_STACK_POINTER;
+            ct.source_registers[2]      = ::REG_AX;
+            break;
+        case OPTYPE_CALL_DIRECT_UNCOND:
+            ct.branch_taken             = true;
+            // reads IP, reads SP, writes SP, writes IP
+            ct.destination_registers[0] = champsim::REG_INSTRUCTION_POINTER;
+            ct.destination_registers[1] = champsim::REG_STACK_POINTER;
+            ct.source_registers[0]      = champsim::REG_INSTRUCTION_POINTER;
+            ct.source_registers[1]      = champsim::REG_STACK_POINTER;
+            break;
+        case OPTYPE_JMP_INDIRECT_UNCOND:
+            ct.branch_taken             = true;
+            // reads something else, writes IP
+            ct.destination_registers[0] = champsim::REG_INSTRUCTION_POINTER;
+            ct.source_registers[0]      = ::REG_AX;
+            break;
+        case OPTYPE_RET_UNCOND:
+            ct.branch_taken             = true;
+            // reads SP, writes SP, writes IP
+            ct.source_registers[0]      = champsim::REG_STACK_POINTER;
+            ct.destination_registers[0] = champsim::REG_INSTRUCTION_POINTER;
+            ct.destination_registers[1] = champsim::REG_STACK_POINTER;
+            break;
+        default:
+            assert(0);
+        }
+    }
+    else
+    {
+        memset(ct.destination_registers, 0, sizeof(ct.destination_registers));
+        memset(ct.source_registers, 0, sizeof(ct.source_registers));
+        memset(ct.destination_memory, 0, sizeof(ct.destination_memory));
+        memset(ct.source_memory, 0, sizeof(ct.source_memory));
+        counts[OPTYPE_OP]++;
+        if (t.num_input_regs > NUM_INSTR_SOURCES)
+            t.num_input_regs = NUM_INSTR_SOURCES;
+        if (t.num_output_regs == 0)
+        {
+            t.num_output_regs     = 1;
+            t.output_reg_names[0] = 0;
+        }
+        // for (int a=0; a<t.num_output_regs; a++) {
+        for (int a = 0; a < 1; a++)
+        {
+            int x = t.output_reg_names[a];
+            if (x == champsim::REG_INSTRUCTION_POINTER)
+                x = 64;
+            if (x == champsim::REG_STACK_POINTER)
+                x = 65;
+            if (x == champsim::REG_FLAGS)
+                x = 66;
+            if (x == 0)
+                x = 67;
+            ct.destination_registers[a] = x;
+            for (int i = 0; i < t.num_input_regs; i++)
+            {
+                int x = t.input_reg_names[i];
+                if (x == champsim::REG_INSTRUCTION_POINTER)
+                    x = 64;
+                if (x == champsim::REG_STACK_POINTER)
+                    x = 65;
+                if (x == champsim::REG_FLAGS)
+                    x = 66;
+                if (x == 0)
+                    x = 67;
+                ct.source_registers[i] = x;
             }
-            counts[c]++;
-
-            // OK now make a branch instruction out of this bad boy
-
-            memset(ct.destination_registers, 0, sizeof(ct.destination_registers));
-            memset(ct.source_registers, 0, sizeof(ct.source_registers));
-            memset(ct.destination_memory, 0, sizeof(ct.destination_memory));
-            memset(ct.source_memory, 0, sizeof(ct.source_memory));
-            switch (c)
+            switch (t.type)
             {
-            case OPTYPE_JMP_DIRECT_UNCOND:
-                // writes IP only
-                ct.destination_registers[0] = champsim::REG_INSTRUCTION_POINTER;
-                ct.branch_taken             = t.taken;
+            case loadInstClass:
+                ct.source_memory[0] = transform(t.EA);
                 break;
-            case OPTYPE_JMP_DIRECT_COND:
-                ct.branch_taken             = t.taken;
-                // reads FLAGS, writes IP
-                ct.destination_registers[0] = champsim::REG_INSTRUCTION_POINTER;
-                // turns out pin records conditional direct branches as also reading IP. whatever.
-                ct.source_registers[0]      = champsim::REG_INSTRUCTION_POINTER;
-                ct.source_registers[1]      = champsim::REG_FLAGS;
+            case storeInstClass:
+                ct.destination_memory[0] = transform(t.EA);
                 break;
-            case OPTYPE_CALL_INDIRECT_UNCOND:
-                ct.branch_taken             = true;
-                // reads something else, reads IP, reads SP, writes SP, writes IP
-                ct.destination_registers[0] = champsim::REG_INSTRUCTION_POINTER;
-                ct.destination_registers[1] = champsim::REG_STACK_POINTER;
-                ct.source_registers[0]      = champsim::REG_INSTRUCTION_POINTER;
-                ct.source_registers[1]      = champsim::REG_STACK_POINTER;
-                ct.source_registers[2]      = ::REG_AX;
+            case aluInstClass:
+            case fpInstClass:
+            case slowAluInstClass:
                 break;
-            case OPTYPE_CALL_DIRECT_UNCOND:
-                ct.branch_taken             = true;
-                // reads IP, reads SP, writes SP, writes IP
-                ct.destination_registers[0] = champsim::REG_INSTRUCTION_POINTER;
-                ct.destination_registers[1] = champsim::REG_STACK_POINTER;
-                ct.source_registers[0]      = champsim::REG_INSTRUCTION_POINTER;
-                ct.source_registers[1]      = champsim::REG_STACK_POINTER;
+            case uncondDirectBranchInstClass:
+            case condBranchInstClass:
+            case uncondIndirectBranchInstClass:
+            case undefInstClass:
+                assert(0);
+            }
+        }
+    }
+
+    if (verbose)
+    {
+        static long long int n = 0;
+        fprintf(stderr, "%lld %llx ", ++n, t.PC);
+        if (c == OPTYPE_OP)
+        {
+            switch (t.type)
+            {
+            case loadInstClass:
+                fprintf(stderr, "LOAD (0x%llx)", t.EA);
                 break;
-            case OPTYPE_JMP_INDIRECT_UNCOND:
-                ct.branch_taken             = true;
-                // reads something else, writes IP
-                ct.destination_registers[0] = champsim::REG_INSTRUCTION_POINTER;
-                ct.source_registers[0]      = ::REG_AX;
+            case storeInstClass:
+                fprintf(stderr, "STORE (0x%llx)", t.EA);
                 break;
-            case OPTYPE_RET_UNCOND:
-                ct.branch_taken             = true;
-                // reads SP, writes SP, writes IP
-                ct.source_registers[0]      = champsim::REG_STACK_POINTER;
-                ct.destination_registers[0] = champsim::REG_INSTRUCTION_POINTER;
-                ct.destination_registers[1] = champsim::REG_STACK_POINTER;
+            case aluInstClass:
+                fprintf(stderr, "ALU");
+                break;
+            case fpInstClass:
+                fprintf(stderr, "FP");
+                break;
+            case slowAluInstClass:
+                fprintf(stderr, "SLOWALU");
                 break;
-            default:
-                assert(0);
             }
-            fwrite(&ct, sizeof(ct), 1, stdout); // write a branch trace
+            for (int i = 0; i < t.num_input_regs; i++)
+                fprintf(stderr, " I%d", t.input_reg_names[i]);
+            for (int i = 0; i < t.num_output_regs; i++)
+                fprintf(stderr, " O%d", t.output_reg_names[i]);
         }
         else
         {
-            memset(ct.destination_registers, 0, sizeof(ct.destination_registers));
-            memset(ct.source_registers, 0, sizeof(ct.source_registers));
-            memset(ct.destination_memory, 0, sizeof(ct.destination_memory));
-            memset(ct.source_memory, 0, sizeof(ct.source_memory));
-            counts[OPTYPE_OP]++;
-            if (t.num_input_regs > NUM_INSTR_SOURCES)
-                t.num_input_regs = NUM_INSTR_SOURCES;
-            if (t.num_output_regs == 0)
+            fprintf(stderr, "%s %llx", branch_names[c], t.target);
+        }
+        fprintf(stderr, "\n");
+    }
+
+    return ct;
+}
+
+// The convert stage, which hands the instructions on in blocks of records_per_block
+void convert_all(stage_queue<std::vector<trace>>& decoded, stage_queue<std::vector<trace_instr_format>>& converted, long long int& n)
+{
+    std::vector<trace_instr_format> block;
+    block.reserve(records_per_block);
+    UINT64 old_pc = 0;
+
+    while (auto batch = decoded.pop())
+    {
+        for (auto& t : *batch)
+        {
+            // one more record
+
+            n++;
+
+            // print something to entertain the user while they wait
+
+            if (n % 1000000 == 0)
             {
-                t.num_output_regs     = 1;
-                t.output_reg_names[0] = 0;
+                fprintf(stderr, "%lld instructions\n", n);
+                fflush(stderr);
             }
-            // for (int a=0; a<t.num_output_regs; a++) {
-            for (int a = 0; a < 1; a++)
+
+            if (t.PC == old_pc)
             {
-                int x = t.output_reg_names[a];
-                if (x == champsim::REG_INSTRUCTION_POINTER)
-                    x = 64;
-                if (x == champsim::REG_STACK_POINTER)
-                    x = 65;
-                if (x == champsim::REG_FLAGS)
-                    x = 66;
-                if (x == 0)
-                    x = 67;
-                ct.destination_registers[a] = x;
-                for (int i = 0; i < t.num_input_regs; i++)
-                {
-                    int x = t.input_reg_names[i];
-                    if (x == champsim::REG_INSTRUCTION_POINTER)
-                        x = 64;
-                    if (x == champsim::REG_STACK_POINTER)
-                        x = 65;
-                    if (x == champsim::REG_FLAGS)
-                        x = 66;
-                    if (x == 0)
-                        x = 67;
-                    ct.source_registers[i] = x;
-                }
-                switch (t.type)
-                {
-                case loadInstClass:
-                    ct.source_memory[0] = transform(t.EA);
-                    break;
-                case storeInstClass:
-                    ct.destination_memory[0] = transform(t.EA);
-                    break;
-                case aluInstClass:
-                case fpInstClass:
-                case slowAluInstClass:
-                    break;
-                case uncondDirectBranchInstClass:
-                case condBranchInstClass:
-                case uncondIndirectBranchInstClass:
-                case undefInstClass:
-                    assert(0);
-                }
-                fwrite(&ct, sizeof(ct), 1, stdout); // write a non-branch trace
+                fprintf(stderr, "hmm, that's weird\n");
+            }
+            old_pc = t.PC;
+
+            block.push_back(convert(t));
+            if (std::size(block) == records_per_block)
+            {
+                converted.push(std::move(block));
+                block = std::vector<trace_instr_format> {};
+                block.reserve(records_per_block);
             }
         }
+    }
+
+    if (! std::empty(block))
+        converted.push(std::move(block));
+    converted.close();
+}
+
+bool ends_with(const std::string& name, const std::string& suffix)
+{
+    return std::size(name) >= std::size(suffix) && name.compare(std::size(name) - std::size(suffix), std::string::npos, suffix) == 0;
+}
+
+// The compress stage. A .xz trace is made of an xz stream for each block one after another, and a .cbt trace of the blocks and their index;
+// other traces are not compressed.
+void write_all(stage_queue<std::vector<trace_instr_format>>& converted)
+{
+    bool is_block_trace = ends_with(output_name, champsim::block_trace::FILE_EXTENSION);
+    bool is_xz          = ends_with(output_name, ".xz");
+
+    std::unique_ptr<champsim::block_trace::writer> block_output;
+    std::ofstream file_output;
+    if (is_block_trace)
+        block_output = std::make_unique<champsim::block_trace::writer>(output_name, sizeof(trace_instr_format), records_per_block);
+    else if (! std::empty(output_name))
+        file_output.open(output_name, std::ios::binary);
+
+    if (! std::empty(output_name) && ! is_block_trace && ! file_output)
+    {
+        perror(output_name.c_str());
+        exit(1);
+    }
 
-        // for fun, update the register values
+    // The blocks being compressed, in order
+    std::deque<std::pair<std::future<std::vector<uint8_t>>, uint64_t>> compressing;
+    auto write_oldest = [&]
+    {
+        auto compressed = compressing.front().first.get();
+        if (is_block_trace)
+            block_output->write_compressed(compressed, compressing.front().second);
+        else
+            file_output.write(reinterpret_cast<const char*>(std::data(compressed)), static_cast<std::streamsize>(std::size(compressed)));
+        compressing.pop_front();
+    };
 
-        for (int i = 0; i < t.num_output_regs; i++)
+    while (auto block = converted.pop())
+    {
+        if (! is_block_trace && ! is_xz)
         {
-            int x           = t.output_reg_names[i];
-            registers[x][0] = t.output_reg_values[x][0];
-            registers[x][1] = t.output_reg_values[x][1];
+            if (std::empty(output_name))
+                fwrite(std::data(*block), sizeof(trace_instr_format), std::size(*block), stdout);
+            else
+                file_output.write(reinterpret_cast<const char*>(std::data(*block)), static_cast<std::streamsize>(std::size(*block) * sizeof(trace_instr_format)));
+            continue;
         }
-        if (verbose)
+
+        if (std::size(compressing) == compression_threads)
+            write_oldest();
+
+        uint64_t records = std::size(*block);
+        compressing.emplace_back(std::async(std::launch::async,
+                                     [block = std::move(*block)]
+                                     {
+                                         return champsim::block_trace::writer::compress(reinterpret_cast<const char*>(std::data(block)),
+                                             std::size(block) * sizeof(trace_instr_format));
+                                     }),
+            records);
+    }
+
+    while (! std::empty(compressing))
+        write_oldest();
+
+    if (is_block_trace)
+        block_output->close();
+    else if (! std::empty(output_name))
+    {
+        file_output.close();
+        if (! file_output)
         {
-            static long long int n = 0;
-            fprintf(stderr, "%lld %llx ", ++n, t.PC);
-            if (c == OPTYPE_OP)
-            {
-                switch (t.type)
-                {
-                case loadInstClass:
-                    fprintf(stderr, "LOAD (0x%llx)", t.EA);
-                    break;
-                case storeInstClass:
-                    fprintf(stderr, "STORE (0x%llx)", t.EA);
-                    break;
-                case aluInstClass:
-                    fprintf(stderr, "ALU");
-                    break;
-                case fpInstClass:
-                    fprintf(stderr, "FP");
-                    break;
-                case slowAluInstClass:
-                    fprintf(stderr, "SLOWALU");
-                    break;
-                }
-                for (int i = 0; i < t.num_input_regs; i++)
-                    fprintf(stderr, " I%d", t.input_reg_names[i]);
-                for (int i = 0; i < t.num_output_regs; i++)
-                    fprintf(stderr, " O%d", t.output_reg_names[i]);
-            }
-            else
-            {
-                fprintf(stderr, "%s %llx", branch_names[c], t.target);
-            }
-            fprintf(stderr, "\n");
+            perror(output_name.c_str());
+            exit(1);
         }
     }
+}
+
+int main(int argc, char** argv)
+{
+    for (int i = 1; i < argc; i++)
+    {
+        if (! strcmp(argv[i], "-v"))
+            verbose = true;
+        else if (! strcmp(argv[i], "-o") && i + 1 < argc)
+            output_name = argv[++i];
+        else if (! strcmp(argv[i], "-t") && i + 1 < argc)
+            compression_threads = std::max(static_cast<unsigned>(strtoul(argv[++i], nullptr, 10)), 1u);
+        else if (! strcmp(argv[i], "-b") && i + 1 < argc)
+            records_per_block = std::max(static_cast<uint32_t>(strtoul(argv[++i], nullptr, 10)), 1u);
+        else
+            tracefilename = argv[i];
+    }
+
+    // the records are read twice, which standard input cannot be
+    if (std::empty(tracefilename) || tracefilename == "-")
+    {
+        fprintf(stderr, "Usage: %s [-v] [-o <output-filename>[.xz|%s]] [-t <compression threads>] [-b <records per block>] <trace-filename>\n", argv[0],
+            champsim::block_trace::FILE_EXTENSION);
+        return 1;
+    }
+
+    preprocess_file();
+
+    stage_queue<std::vector<trace>> decoded {QUEUED_BATCHES};
+    stage_queue<std::vector<trace_instr_format>> converted {compression_threads};
+
+    // number of records converted so far
+    long long int n = 0;
+
+    auto decoder = start_decoding(decoded);
+    std::thread converter {[&] { convert_all(decoded, converted, n); }};
+    write_all(converted);
+    converter.join();
+    decoder.join();
+
     fprintf(stderr, "converted %lld instructions\n", n);
     OpType lim = OPTYPE_MAX;
     for (int i = 2; i < (int) lim; i++)
@@ -668,9 +850,5 @@ int main(int argc, char** argv)
             fprintf(stderr, "%s %lld %f%%\n", branch_names[i], counts[i], 100 * counts[i] / (double) n);
     }
 
-    // close the pipe, if any
-
-    if (f != stdin)
-        pclose(f);
     return 0;
 }
@@ -0,0 +1,81 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <array>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+#include "ChampSim/memory_trace.h"
+
+// The names of access_type, as in channel.h
+constexpr std::array<const char*, 5> ORIGIN_NAMES = {"LOAD", "RFO", "PREFETCH", "WRITE", "TRANSLATION"};
+
+const char* origin_name(uint8_t origin)
+{
+    if (origin == champsim::memory_trace::ORIGIN_SWAPPING)
+        return "SWAPPING";
+    return origin < std::size(ORIGIN_NAMES) ? ORIGIN_NAMES[origin] : "UNKNOWN";
+}
+
+int main(int argc, char** argv)
+{
+    bool hexadecimal   = false;
+    bool accepted_only = false;
+
+    int i = 1;
+    for (; i < argc && argv[i][0] == '-'; i++)
+    {
+        if (strcmp(argv[i], "-x") == 0)
+            hexadecimal = true;
+        else if (strcmp(argv[i], "-a") == 0)
+            accepted_only = true;
+        else
+            break;
+    }
+
+    if (argc - i != 1)
+    {
+        std::printf("Usage: %s [-x] [-a] <memory-trace-filename>%s\n", argv[0], champsim::memory_trace::FILE_EXTENSION);
+        std::printf("  -x  Print only the address and type of each request, as the text memory trace does\n");
+        std::printf("  -a  Print only the requests taken by the memories, without the attempts sent again later\n");
+        return EXIT_FAILURE;
+    }
+
+    champsim::memory_trace::reader input {argv[i]};
+    if (! hexadecimal)
+        std::printf("cycle,cpu,memory,type,origin,accepted,address,physical_address\n");
+
+    uint64_t records = 0;
+    while (auto r = input.next())
+    {
+        records++;
+        if (accepted_only && ! r->accepted)
+            continue;
+
+        if (hexadecimal)
+            std::printf("0x%lx %c\n", r->address, r->type);
+        else if (r->cpu == champsim::memory_trace::NO_CPU)
+            std::printf("%lu,-,%u,%c,%s,%u,0x%lx,0x%lx\n", r->cycle, r->memory, r->type, origin_name(r->origin), r->accepted, r->address, r->physical_address);
+        else
+            std::printf("%lu,%u,%u,%c,%s,%u,0x%lx,0x%lx\n", r->cycle, r->cpu, r->memory, r->type, origin_name(r->origin), r->accepted, r->address,
+                r->physical_address);
+    }
+
+    std::fprintf(stderr, "Decoded %lu records of %s.\n", records, argv[i]);
+    return EXIT_SUCCESS;
+}
@@ -19,27 +19,85 @@
  *  and could serve as the starting point for developing your first PIN tool
  */
 
+#include <lzma.h>
 #include <stdlib.h>
 #include <string.h>
 
+#include <algorithm>
+#include <atomic>
+#include <deque>
 #include <fstream>
 #include <iostream>
 #include <string>
+#include <vector>
 
-#include "../../inc/trace_instruction.h"
+#include "../../inc/ChampSim/block_trace_format.h"
+#include "../../inc/ChampSim/trace_instruction.h"
 #include "pin.H"
 
 using trace_instr_format_t = input_instr;
 
+/* ================================================================== */
+// Output files
+/* ================================================================== */
+
+enum class trace_format { RAW, XZ, BLOCK };
+
+struct output_file;
+
+// A buffer of records, compressed by a helper thread and written in the order the buffers were filled
+struct chunk
+{
+    output_file* output;
+    std::vector<trace_instr_format_t> records;
+    std::vector<uint8_t> compressed {};
+    bool done = false;
+};
+
+struct output_file
+{
+    std::ofstream file;
+    std::string name;
+    PIN_MUTEX lock;
+    std::deque<chunk*> in_order {}; // The chunks of the file not written yet, in order
+    std::vector<champsim::block_trace::index_entry> index {};
+    uint64_t records = 0;
+};
+
 /* ================================================================== */
 // Global variables
 /* ================================================================== */
 
-UINT64 instrCount          = 0;
+std::atomic<UINT64> instrCount {0};
+
+trace_format format = trace_format::RAW;
+std::string output_base; // The output name without the extension of its format
+std::string output_extension;
+
+PIN_MUTEX outputs_lock;
+std::vector<output_file*> outputs;
+output_file* shared_output = nullptr;
+
+// The chunks waiting for a helper thread, and at most max_pending of them before the application threads wait
+PIN_MUTEX queue_lock;
+PIN_SEMAPHORE work_ready;
+PIN_SEMAPHORE space_ready;
+std::deque<chunk*> to_compress;
+std::size_t max_pending = 0;
+bool exiting            = false; // The helper threads finish the queue and stop, and the chunks after it are written by the thread filling them
+std::vector<PIN_THREAD_UID> helpers;
 
-std::ofstream outfile;
+// Each application thread traces into a buffer of its own
+struct thread_data
+{
+    trace_instr_format_t curr_instr {};
+    std::vector<trace_instr_format_t> buffer {};
+    UINT64 instrCount = 0;
+    output_file* output;
+};
 
-trace_instr_format_t curr_instr;
+TLS_KEY thread_key;
+std::vector<thread_data*> threads; // Under outputs_lock
 
 /* ===================================================================== */
 // Command line switches
@@ -50,6 +108,14 @@ KNOB<UINT64> KnobSkipInstructions(KNOB_MODE_WRITEONCE, "pintool", "s", "0", "How
 
 KNOB<UINT64> KnobTraceInstructions(KNOB_MODE_WRITEONCE, "pintool", "t", "1000000", "How many instructions to trace");
 
+KNOB<BOOL> KnobPerThread(KNOB_MODE_WRITEONCE, "pintool", "p", "0", "Trace each thread into a file of its own");
+
+KNOB<UINT32> KnobHelperThreads(KNOB_MODE_WRITEONCE, "pintool", "c", "2", "How many threads compress and write the trace");
+
+KNOB<UINT32> KnobBufferRecords(KNOB_MODE_WRITEONCE, "pintool", "b", "65536", "How many instructions each buffer (block of a .cbt trace) holds");
+
+KNOB<UINT32> KnobCompressionLevel(KNOB_MODE_WRITEONCE, "pintool", "l", "6", "The xz compression level (0-9)");
+
 /* ===================================================================== */
 // Utilities
 /* ===================================================================== */
@@ -60,9 +126,11 @@ KNOB<UINT64> KnobTraceInstructions(KNOB_MODE_WRITEONCE, "pintool", "t", "1000000
 INT32 Usage()
 {
     std::cerr << "This tool creates a register and memory access trace" << std::endl
-              << "Specify the output trace file with -o" << std::endl
+              << "Specify the output trace file with -o, which is compressed with xz if it ends with .xz, or into a block trace if it ends with .cbt"
+              << std::endl
               << "Specify the number of instructions to skip before tracing with -s" << std::endl
               << "Specify the number of instructions to trace with -t" << std::endl
+              << "Specify -p to trace each thread into a file of its own" << std::endl
               << std::endl;
 
     std::cerr << KNOB_BASE::StringKnobSummary() << std::endl;
@@ -70,43 +138,237 @@ INT32 Usage()
     return -1;
 }
 
+bool EndsWith(const std::string& name, const std::string& suffix)
+{
+    return name.size() >= suffix.size() && name.compare(name.size() - suffix.size(), std::string::npos, suffix) == 0;
+}
+
+output_file* OpenOutput(const std::string& name)
+{
+    auto output = new output_file;
+    output->name = name;
+    output->file.open(name.c_str(), std::ios_base::binary | std::ios_base::trunc);
+    if (! output->file)
+    {
+        std::cout << "Couldn't open output trace file " << name << ". Exiting." << std::endl;
+        exit(1);
+    }
+    PIN_MutexInit(&output->lock);
+
+    if (format == trace_format::BLOCK)
+    {
+        champsim::block_trace::header head {champsim::block_trace::MAGIC, champsim::block_trace::VERSION, sizeof(trace_instr_format_t),
+                                            KnobBufferRecords.Value(), 0};
+        output->file.write(reinterpret_cast<const char*>(&head), sizeof(head));
+    }
+
+    PIN_MutexLock(&outputs_lock);
+    outputs.push_back(output);
+    PIN_MutexUnlock(&outputs_lock);
+    return output;
+}
+
+void CloseOutput(output_file* output)
+{
+    if (format == trace_format::BLOCK)
+    {
+        champsim::block_trace::footer foot {static_cast<uint64_t>(output->file.tellp()), output->index.size(), output->records,
+                                            champsim::block_trace::MAGIC};
+        output->file.write(reinterpret_cast<const char*>(output->index.data()),
+            static_cast<std::streamsize>(output->index.size() * sizeof(champsim::block_trace::index_entry)));
+        output->file.write(reinterpret_cast<const char*>(&foot), sizeof(foot));
+    }
+
+    output->file.close();
+    if (! output->file)
+        std::cout << "Couldn't write output trace file " << output->name << "." << std::endl;
+}
+
+// Both .xz and .cbt traces are made of xz streams, each of a buffer, so the buffers are compressed independently
+void Compress(chunk* c)
+{
+    if (format == trace_format::RAW)
+        return;
+
+    auto bytes = c->records.size() * sizeof(trace_instr_format_t);
+    c->compressed.resize(lzma_stream_buffer_bound(bytes));
+    size_t compressed_size = 0;
+    auto ret = lzma_easy_buffer_encode(KnobCompressionLevel.Value(), LZMA_CHECK_CRC64, nullptr, reinterpret_cast<const uint8_t*>(c->records.data()),
+        bytes, c->compressed.data(), &compressed_size, c->compressed.size());
+    if (ret != LZMA_OK)
+    {
+        std::cout << "Couldn't compress the trace (lzma error " << static_cast<int>(ret) << "). Exiting." << std::endl;
+        exit(1);
+    }
+    c->compressed.resize(compressed_size);
+}
+
+// Write the compressed chunks at the front of their file
+void WriteReady(output_file* output)
+{
+    PIN_MutexLock(&output->lock);
+    while (! output->in_order.empty() && output->in_order.front()->done)
+    {
+        chunk* c = output->in_order.front();
+        output->in_order.pop_front();
+
+        if (format == trace_format::RAW)
+        {
+            output->file.write(reinterpret_cast<const char*>(c->records.data()), static_cast<std::streamsize>(c->records.size() * sizeof(trace_instr_format_t)));
+        }
+        else
+        {
+            if (format == trace_format::BLOCK)
+                output->index.push_back(champsim::block_trace::index_entry {static_cast<uint64_t>(output->file.tellp()), c->compressed.size(), output->records,
+                                                                            c->records.size()});
+            output->file.write(reinterpret_cast<const char*>(c->compressed.data()), static_cast<std::streamsize>(c->compressed.size()));
+        }
+
+        output->records += c->records.size();
+        delete c;
+    }
+    PIN_MutexUnlock(&output->lock);
+}
+
+// Hand the buffer of the thread to a helper thread, or compress it here once the helper threads have stopped
+void Submit(thread_data* data)
+{
+    if (data->buffer.empty())
+        return;
+
+    auto c = new chunk {data->output, std::move(data->buffer)};
+    data->buffer = std::vector<trace_instr_format_t> {};
+    data->buffer.reserve(KnobBufferRecords.Value());
+
+    PIN_MutexLock(&c->output->lock);
+    c->output->in_order.push_back(c);
+    PIN_MutexUnlock(&c->output->lock);
+
+    PIN_MutexLock(&queue_lock);
+    while (to_compress.size() >= max_pending && ! exiting)
+    {
+        PIN_SemaphoreClear(&space_ready);
+        PIN_MutexUnlock(&queue_lock);
+        PIN_SemaphoreWait(&space_ready);
+        PIN_MutexLock(&queue_lock);
+    }
+
+    if (! exiting)
+    {
+        to_compress.push_back(c);
+        PIN_SemaphoreSet(&work_ready);
+        PIN_MutexUnlock(&queue_lock);
+        return;
+    }
+    PIN_MutexUnlock(&queue_lock);
+
+    Compress(c);
+    PIN_MutexLock(&c->output->lock);
+    c->done = true;
+    PIN_MutexUnlock(&c->output->lock);
+    WriteReady(c->output);
+}
+
+VOID CompressTrace(VOID* arg)
+{
+    while (true)
+    {
+        PIN_MutexLock(&queue_lock);
+        while (to_compress.empty() && ! exiting)
+        {
+            PIN_SemaphoreClear(&work_ready);
+            PIN_MutexUnlock(&queue_lock);
+            PIN_SemaphoreWait(&work_ready);
+            PIN_MutexLock(&queue_lock);
+        }
+
+        if (to_compress.empty())
+        {
+            PIN_MutexUnlock(&queue_lock);
+            return;
+        }
+
+        chunk* c = to_compress.front();
+        to_compress.pop_front();
+        PIN_SemaphoreSet(&space_ready);
+        PIN_MutexUnlock(&queue_lock);
+
+        Compress(c);
+        output_file* output = c->output;
+        PIN_MutexLock(&output->lock);
+        c->done = true;
+        PIN_MutexUnlock(&output->lock);
+        WriteReady(output);
+    }
+}
+
+thread_data* GetThreadData(THREADID tid) { return static_cast<thread_data*>(PIN_GetThreadData(thread_key, tid)); }
+
 /* ===================================================================== */
 // Analysis routines
 /* ===================================================================== */
 
-void ResetCurrentInstruction(VOID* ip)
+void ResetCurrentInstruction(THREADID tid, VOID* ip)
 {
-    curr_instr    = {};
-    curr_instr.ip = (unsigned long long int) ip;
+    auto data           = GetThreadData(tid);
+    data->curr_instr    = {};
+    data->curr_instr.ip = (unsigned long long int) ip;
 }
 
-BOOL ShouldWrite()
+BOOL ShouldWrite(THREADID tid)
 {
-    ++instrCount;
-    return (instrCount > KnobSkipInstructions.Value()) && (instrCount <= (KnobTraceInstructions.Value() + KnobSkipInstructions.Value()));
+    // The instructions are counted for each thread when it has a trace of its own
+    UINT64 count = KnobPerThread.Value() ? ++GetThreadData(tid)->instrCount : ++instrCount;
+    return (count > KnobSkipInstructions.Value()) && (count <= (KnobTraceInstructions.Value() + KnobSkipInstructions.Value()));
 }
 
-void WriteCurrentInstruction()
+void WriteCurrentInstruction(THREADID tid)
 {
-    typename decltype(outfile)::char_type buf[sizeof(trace_instr_format_t)];
-    std::memcpy(buf, &curr_instr, sizeof(trace_instr_format_t));
-    outfile.write(buf, sizeof(trace_instr_format_t));
+    auto data = GetThreadData(tid);
+    data->buffer.push_back(data->curr_instr);
+    if (data->buffer.size() == KnobBufferRecords.Value())
+        Submit(data);
 }
 
-void BranchOrNot(UINT32 taken)
+void BranchOrNot(THREADID tid, UINT32 taken)
 {
-    curr_instr.is_branch    = 1;
-    curr_instr.branch_taken = taken;
+    auto data                     = GetThreadData(tid);
+    data->curr_instr.is_branch    = 1;
+    data->curr_instr.branch_taken = taken;
 }
 
 template<typename T>
-void WriteToSet(T* begin, T* end, UINT32 r)
+void WriteToSet(T* begin, T* end, UINT64 r)
 {
     auto set_end   = std::find(begin, end, 0);
     auto found_reg = std::find(begin, set_end, r); // check to see if this register is already in the list
     *found_reg     = r;
 }
 
+void ReadRegister(THREADID tid, UINT32 r)
+{
+    auto& instr = GetThreadData(tid)->curr_instr;
+    WriteToSet<unsigned char>(instr.source_registers, instr.source_registers + NUM_INSTR_SOURCES, r);
+}
+
+void WriteRegister(THREADID tid, UINT32 r)
+{
+    auto& instr = GetThreadData(tid)->curr_instr;
+    WriteToSet<unsigned char>(instr.destination_registers, instr.destination_registers + NUM_INSTR_DESTINATIONS, r);
+}
+
+void ReadMemory(THREADID tid, ADDRINT address)
+{
+    auto& instr = GetThreadData(tid)->curr_instr;
+    WriteToSet<unsigned long long int>(instr.source_memory, instr.source_memory + NUM_INSTR_SOURCES, address);
+}
+
+void WriteMemory(THREADID tid, ADDRINT address)
+{
+    auto& instr = GetThreadData(tid)->curr_instr;
+    WriteToSet<unsigned long long int>(instr.destination_memory, instr.destination_memory + NUM_INSTR_DESTINATIONS, address);
+}
+
 /* ===================================================================== */
 // Instrumentation callbacks
 /* ===================================================================== */
@@ -115,19 +377,18 @@ void WriteToSet(T* begin, T* end, UINT32 r)
 VOID Instruction(INS ins, VOID* v)
 {
     // begin each instruction with this function
-    INS_InsertCall(ins, IPOINT_BEFORE, (AFUNPTR) ResetCurrentInstruction, IARG_INST_PTR, IARG_END);
+    INS_InsertCall(ins, IPOINT_BEFORE, (AFUNPTR) ResetCurrentInstruction, IARG_THREAD_ID, IARG_INST_PTR, IARG_END);
 
     // instrument branch instructions
     if (INS_IsBranch(ins))
-        INS_InsertCall(ins, IPOINT_BEFORE, (AFUNPTR) BranchOrNot, IARG_BRANCH_TAKEN, IARG_END);
+        INS_InsertCall(ins, IPOINT_BEFORE, (AFUNPTR) BranchOrNot, IARG_THREAD_ID, IARG_BRANCH_TAKEN, IARG_END);
 
     // instrument register reads
     UINT32 readRegCount = INS_MaxNumRRegs(ins);
     for (UINT32 i = 0; i < readRegCount; i++)
     {
         UINT32 regNum = INS_RegR(ins, i);
-        INS_InsertCall(ins, IPOINT_BEFORE, (AFUNPTR) WriteToSet<unsigned char>, IARG_PTR, curr_instr.source_registers, IARG_PTR,
-            curr_instr.source_registers + NUM_INSTR_SOURCES, IARG_UINT32, regNum, IARG_END);
+        INS_InsertCall(ins, IPOINT_BEFORE, (AFUNPTR) ReadRegister, IARG_THREAD_ID, IARG_UINT32, regNum, IARG_END);
     }
 
     // instrument register writes
@@ -135,8 +396,7 @@ VOID Instruction(INS ins, VOID* v)
     for (UINT32 i = 0; i < writeRegCount; i++)
     {
         UINT32 regNum = INS_RegW(ins, i);
-        INS_InsertCall(ins, IPOINT_BEFORE, (AFUNPTR) WriteToSet<unsigned char>, IARG_PTR, curr_instr.destination_registers, IARG_PTR,
-            curr_instr.destination_registers + NUM_INSTR_DESTINATIONS, IARG_UINT32, regNum, IARG_END);
+        INS_InsertCall(ins, IPOINT_BEFORE, (AFUNPTR) WriteRegister, IARG_THREAD_ID, IARG_UINT32, regNum, IARG_END);
     }
 
     // instrument memory reads and writes
@@ -146,16 +406,38 @@ VOID Instruction(INS ins, VOID* v)
     for (UINT32 memOp = 0; memOp < memOperands; memOp++)
     {
         if (INS_MemoryOperandIsRead(ins, memOp))
-            INS_InsertCall(ins, IPOINT_BEFORE, (AFUNPTR) WriteToSet<unsigned long long int>, IARG_PTR, curr_instr.source_memory, IARG_PTR,
-                curr_instr.source_memory + NUM_INSTR_SOURCES, IARG_MEMORYOP_EA, memOp, IARG_END);
+            INS_InsertCall(ins, IPOINT_BEFORE, (AFUNPTR) ReadMemory, IARG_THREAD_ID, IARG_MEMORYOP_EA, memOp, IARG_END);
         if (INS_MemoryOperandIsWritten(ins, memOp))
-            INS_InsertCall(ins, IPOINT_BEFORE, (AFUNPTR) WriteToSet<unsigned long long int>, IARG_PTR, curr_instr.destination_memory, IARG_PTR,
-                curr_instr.destination_memory + NUM_INSTR_DESTINATIONS, IARG_MEMORYOP_EA, memOp, IARG_END);
+            INS_InsertCall(ins, IPOINT_BEFORE, (AFUNPTR) WriteMemory, IARG_THREAD_ID, IARG_MEMORYOP_EA, memOp, IARG_END);
     }
 
     // finalize each instruction with this function
-    INS_InsertIfCall(ins, IPOINT_BEFORE, (AFUNPTR) ShouldWrite, IARG_END);
-    INS_InsertThenCall(ins, IPOINT_BEFORE, (AFUNPTR) WriteCurrentInstruction, IARG_END);
+    INS_InsertIfCall(ins, IPOINT_BEFORE, (AFUNPTR) ShouldWrite, IARG_THREAD_ID, IARG_END);
+    INS_InsertThenCall(ins, IPOINT_BEFORE, (AFUNPTR) WriteCurrentInstruction, IARG_THREAD_ID, IARG_END);
+}
+
+VOID ThreadStart(THREADID tid, CONTEXT* ctxt, INT32 flags, VOID* v)
+{
+    auto data = new thread_data;
+    data->buffer.reserve(KnobBufferRecords.Value());
+    data->output = KnobPerThread.Value() ? OpenOutput(output_base + ".thread" + decstr(tid) + output_extension) : shared_output;
+    PIN_SetThreadData(thread_key, data, tid);
+
+    PIN_MutexLock(&outputs_lock);
+    threads.push_back(data);
+    PIN_MutexUnlock(&outputs_lock);
+}
+
+VOID ThreadFini(THREADID tid, const CONTEXT* ctxt, INT32 code, VOID* v) { Submit(GetThreadData(tid)); }
+
+// Let the helper threads finish the queued buffers and stop
+VOID PrepareForFini(VOID* v)
+{
+    PIN_MutexLock(&queue_lock);
+    exiting = true;
+    PIN_SemaphoreSet(&work_ready);
+    PIN_SemaphoreSet(&space_ready);
+    PIN_MutexUnlock(&queue_lock);
 }
 
 /*!
@@ -165,7 +447,18 @@ VOID Instruction(INS ins, VOID* v)
  * @param[in]   v               value specified by the tool in the
  *                              PIN_AddFiniFunction function call
  */
-VOID Fini(INT32 code, VOID* v) { outfile.close(); }
+VOID Fini(INT32 code, VOID* v)
+{
+    for (auto& uid : helpers)
+        PIN_WaitForThreadTermination(uid, PIN_INFINITE_TIMEOUT, nullptr);
+
+    // The threads still running have instructions in their buffers
+    for (auto data : threads)
+        Submit(data);
+
+    for (auto output : outputs)
+        CloseOutput(output);
+}
 
 /*!
  * The main procedure of the tool.
@@ -178,20 +471,50 @@ int main(int argc, char* argv[])
 {
     // Initialize PIN library. Print help message if -h(elp) is specified
     // in the command line or the command line is invalid
-    if (PIN_Init(argc, argv))
+    if (PIN_Init(argc, argv) || KnobBufferRecords.Value() == 0 || KnobCompressionLevel.Value() > 9)
         return Usage();
 
-    outfile.open(KnobOutputFile.Value().c_str(), std::ios_base::binary | std::ios_base::trunc);
-    if (! outfile)
+    output_base = KnobOutputFile.Value();
+    if (EndsWith(output_base, ".xz"))
+        format = trace_format::XZ;
+    else if (EndsWith(output_base, champsim::block_trace::FILE_EXTENSION))
+        format = trace_format::BLOCK;
+    if (format != trace_format::RAW)
     {
-        std::cout << "Couldn't open output trace file. Exiting." << std::endl;
-        exit(1);
+        output_extension = output_base.substr(output_base.find_last_of('.'));
+        output_base.resize(output_base.size() - output_extension.size());
+    }
+
+    PIN_MutexInit(&outputs_lock);
+    PIN_MutexInit(&queue_lock);
+    PIN_SemaphoreInit(&work_ready);
+    PIN_SemaphoreInit(&space_ready);
+    thread_key = PIN_CreateThreadDataKey(nullptr);
+
+    if (! KnobPerThread.Value())
+        shared_output = OpenOutput(KnobOutputFile.Value());
+
+    // A few buffers for each helper thread, so the application only waits when the helper threads fall behind
+    UINT32 helper_threads = std::max<UINT32>(KnobHelperThreads.Value(), 1);
+    max_pending           = 2 * helper_threads;
+    helpers.resize(helper_threads);
+    for (auto& uid : helpers)
+    {
+        if (PIN_SpawnInternalThread(CompressTrace, nullptr, 0, &uid) == INVALID_THREADID)
+        {
+            std::cout << "Couldn't start the threads compressing the trace. Exiting." << std::endl;
+            exit(1);
+        }
     }
 
     // Register function to be called to instrument instructions
     INS_AddInstrumentFunction(Instruction, 0);
 
+    PIN_AddThreadStartFunction(ThreadStart, 0);
+    PIN_AddThreadFiniFunction(ThreadFini, 0);
+
     // Register function to be called when the application exits
+    PIN_AddPrepareForFiniFunction(PrepareForFini, 0);
     PIN_AddFiniFunction(Fini, 0);
 
     // Start the program, never returns